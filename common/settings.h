@@ -59,6 +59,11 @@ class FrameTiming {
   uint64_t GetLayerCacheBytes() const { return layer_cache_bytes_; }
   uint64_t GetPictureCacheCount() const { return picture_cache_count_; }
   uint64_t GetPictureCacheBytes() const { return picture_cache_bytes_; }
+  fml::TimeDelta GetPipelineAge() const { return pipeline_age_; }
+  uint64_t GetPipelineQueuedFrames() const { return pipeline_queued_frames_; }
+  uint64_t GetPipelineDroppedFrames() const {
+    return pipeline_dropped_frames_;
+  }
   void SetRasterCacheStatistics(size_t layer_cache_count,
                                 size_t layer_cache_bytes,
                                 size_t picture_cache_count,
@@ -68,6 +73,16 @@ class FrameTiming {
     picture_cache_count_ = picture_cache_count;
     picture_cache_bytes_ = picture_cache_bytes;
   }
+  /// Records how long the frame waited in the frame pipeline before being
+  /// rasterized, how many frames were queued behind it at that time and how
+  /// many stale frames were dropped in its favor.
+  void SetPipelineStatistics(fml::TimeDelta pipeline_age,
+                             size_t pipeline_queued_frames,
+                             size_t pipeline_dropped_frames) {
+    pipeline_age_ = pipeline_age;
+    pipeline_queued_frames_ = pipeline_queued_frames;
+    pipeline_dropped_frames_ = pipeline_dropped_frames;
+  }
 
  private:
   fml::TimePoint data_[kCount];
@@ -76,6 +91,9 @@ class FrameTiming {
   size_t layer_cache_bytes_;
   size_t picture_cache_count_;
   size_t picture_cache_bytes_;
+  fml::TimeDelta pipeline_age_;
+  size_t pipeline_queued_frames_ = 0;
+  size_t pipeline_dropped_frames_ = 0;
 };
 
 using TaskObserverAdd =
@@ -258,6 +276,14 @@ struct Settings {
   // Enable GPU tracing in Vulkan backends.
   bool enable_vulkan_gpu_tracing = false;
 
+  // Persist the glyph bitmaps rasterized by Impeller in the caches directory
+  // so that they are not rasterized again on the next launch.
+  bool enable_impeller_glyph_cache = false;
+
+  // Record the pipeline variants created by Impeller in the caches directory
+  // so that they are compiled before the first frame of the next launch.
+  bool enable_impeller_pipeline_variant_manifest = false;
+
   // Data set by platform-specific embedders for use in font initialization.
   uint32_t font_initialization_data = 0;
 
@@ -316,6 +342,9 @@ struct Settings {
   LogMessageCallback log_message_callback;
   bool enable_software_rendering = false;
   bool skia_deterministic_rendering_on_cpu = false;
+  // Store the records of the display lists recorded by ui.PictureRecorder in
+  // chunks from a per-thread pool instead of a single growing buffer.
+  bool enable_chunked_display_list_storage = false;
   bool verbose_logging = false;
   std::string log_tag = "flutter";
 
@@ -336,6 +365,15 @@ struct Settings {
   // soon as a frame is rasterized.
   FrameRasterizedCallback frame_rasterized_callback;
 
+  // The maximum number of frames that the UI thread may build ahead of the
+  // raster thread, or 0 to use the default for the platform.
+  uint32_t frame_pipeline_depth = 0;
+
+  // Whether the raster thread skips queued frames that have missed their
+  // vsync target when a newer frame is queued, trading throughput for
+  // latency.
+  bool frame_pipeline_low_latency = false;
+
   // This data will be available to the isolate immediately on launch via the
   // PlatformDispatcher.getPersistentIsolateData callback. This is meant for
   // information that the isolate cannot request asynchronously (platform
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "flutter/benchmarking/benchmarking.h"
+#include "flutter/display_list/geometry/dl_rtree.h"
 #include "flutter/display_list/testing/dl_test_snippets.h"
 #include "flutter/display_list/utils/dl_receiver_utils.h"
 
@@ -200,6 +201,42 @@ static void BM_DisplayListBuilderWithSaveLayerAndImageFilter(
   }
 }
 
+// Simulates the recording of consecutive frames of a long scrolling list
+// where each frame records many copies of the same rendering ops, and
+// reports the heap traffic incurred by the op storage for each frame.
+static void BM_DisplayListBuilderStorage(benchmark::State& state,
+                                         DlStorageMode storage_mode) {
+  const int kItemsPerFrame = 50;
+  size_t frames = 0u;
+  size_t allocations = 0u;
+  size_t copied_bytes = 0u;
+  size_t storage_bytes = 0u;
+  while (state.KeepRunning()) {
+    DisplayListBuilder builder(DisplayListBuilder::kMaxCullRect, false,
+                               storage_mode);
+    for (int i = 0; i < kItemsPerFrame; i++) {
+      builder.Save();
+      builder.Translate(0, i * 20.0f);
+      InvokeAllRenderingOps(builder);
+      builder.Restore();
+    }
+    auto display_list = builder.Build();
+    const DisplayListStorage& storage = display_list->GetStorage();
+    frames++;
+    allocations += storage.allocation_count();
+    copied_bytes += storage.copied_bytes();
+    storage_bytes += storage.size();
+  }
+  if (frames > 0u) {
+    state.counters["AllocationsPerFrame"] =
+        static_cast<double>(allocations) / frames;
+    state.counters["CopiedBytesPerFrame"] =
+        static_cast<double>(copied_bytes) / frames;
+    state.counters["StorageBytesPerFrame"] =
+        static_cast<double>(storage_bytes) / frames;
+  }
+}
+
 class DlOpReceiverIgnore : public IgnoreAttributeDispatchHelper,
                            public IgnoreTransformDispatchHelper,
                            public IgnoreClipDispatchHelper,
@@ -310,6 +347,66 @@ static void BM_DisplayListDispatchByVectorCull(
   }
 }
 
+// Records a large scene of small scattered rects, similar to the markers
+// of a map or the points of a chart, and pans a viewport over it.
+static std::vector<SkRect> CreateScatteredRects(int count) {
+  std::vector<SkRect> rects;
+  rects.reserve(count);
+  uint32_t seed = 0x5eed;
+  auto next = [&seed]() {
+    seed = seed * 1664525u + 1013904223u;
+    return static_cast<float>(seed >> 8) / (1 << 24);
+  };
+  for (int i = 0; i < count; i++) {
+    rects.push_back(SkRect::MakeXYWH(next() * 4000.0f, next() * 4000.0f,
+                                     2.0f + next() * 20.0f,
+                                     2.0f + next() * 20.0f));
+  }
+  return rects;
+}
+
+static SkRect PanningViewport(int frame) {
+  float x = static_cast<float>((frame * 37) % 3500);
+  float y = static_cast<float>((frame * 53) % 3500);
+  return SkRect::MakeXYWH(x, y, 500.0f, 500.0f);
+}
+
+static void BM_DisplayListDispatchCullLarge(benchmark::State& state) {
+  const int kOpCount = 100000;
+  DisplayListBuilder builder(true);
+  DlPaint paint;
+  for (const SkRect& rect : CreateScatteredRects(kOpCount)) {
+    builder.DrawRect(rect, paint);
+  }
+  auto display_list = builder.Build();
+  DlOpReceiverIgnore receiver;
+  int frame = 0;
+  while (state.KeepRunning()) {
+    display_list->Dispatch(receiver, PanningViewport(frame++));
+  }
+}
+
+// Measures the search of the RTree of the large scene above on its own
+// for each build strategy, reusing the same result vector between frames.
+static void BM_DlRTreeSearchLarge(benchmark::State& state,
+                                  DlRTree::BuildStrategy strategy) {
+  const int kOpCount = 100000;
+  std::vector<SkRect> rects = CreateScatteredRects(kOpCount);
+  DlRTree rtree(rects.data(), kOpCount, nullptr, [](int) { return true; }, -1,
+                strategy);
+  std::vector<int> results;
+  size_t frames = 0u;
+  size_t found = 0u;
+  while (state.KeepRunning()) {
+    results.clear();
+    rtree.search(PanningViewport(frames++), &results);
+    found += results.size();
+  }
+  if (frames > 0u) {
+    state.counters["ResultsPerSearch"] = static_cast<double>(found) / frames;
+  }
+}
+
 BENCHMARK_CAPTURE(BM_DisplayListBuilderDefault,
                   kDefault,
                   DisplayListBuilderBenchmarkType::kDefault)
@@ -429,6 +526,15 @@ BENCHMARK_CAPTURE(BM_DisplayListBuilderWithSaveLayerAndImageFilter,
                   DisplayListBuilderBenchmarkType::kBoundsAndRtree)
     ->Unit(benchmark::kMicrosecond);
 
+BENCHMARK_CAPTURE(BM_DisplayListBuilderStorage,
+                  kContiguous,
+                  DlStorageMode::kContiguous)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DisplayListBuilderStorage,
+                  kChunked,
+                  DlStorageMode::kChunked)
+    ->Unit(benchmark::kMicrosecond);
+
 BENCHMARK_CAPTURE(BM_DisplayListDispatchDefault,
                   kDefaultNoRtree,
                   DisplayListDispatchBenchmarkType::kDefaultNoRtree)
@@ -464,4 +570,16 @@ BENCHMARK_CAPTURE(BM_DisplayListDispatchByVectorCull,
                   DisplayListDispatchBenchmarkType::kCulledWithRtree)
     ->Unit(benchmark::kMicrosecond);
 
+BENCHMARK(BM_DisplayListDispatchCullLarge)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_DlRTreeSearchLarge,
+                  kInsertionOrder,
+                  DlRTree::BuildStrategy::kInsertionOrder)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_DlRTreeSearchLarge,
+                  kSortTileRecursive,
+                  DlRTree::BuildStrategy::kSortTileRecursive)
+    ->Unit(benchmark::kMicrosecond);
+
 }  // namespace flutter
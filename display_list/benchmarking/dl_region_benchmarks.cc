@@ -253,6 +253,134 @@ void RunIntersectsSingleRectBenchmark(benchmark::State& state, int maxSize) {
   }
 }
 
+enum IncrementalMode { kMakeUnion, kAccumulator, kSkRegionOp };
+
+// Simulates the damage or coverage of a frame being accumulated one leaf
+// rect at a time, with the accumulated region being queried periodically
+// in between as the layer tree is walked. The accumulator persists across
+// frames the way a long-lived owner would keep it.
+void RunIncrementalUnionBenchmark(benchmark::State& state,
+                                  IncrementalMode mode,
+                                  int maxSize) {
+  std::seed_seq seed{2, 1, 3};
+  std::mt19937 rng(seed);
+
+  const int kRectCount = 1000;
+  const int kQueryInterval = 20;
+  auto rects = GenerateRects(rng, SkIRect::MakeWH(4000, 4000), kRectCount,
+                             maxSize);
+  auto queries = GenerateRects(rng, SkIRect::MakeWH(4000, 4000),
+                               kRectCount / kQueryInterval, maxSize);
+
+  flutter::DlRegionAccumulator accumulator;
+  while (state.KeepRunning()) {
+    switch (mode) {
+      case kMakeUnion: {
+        flutter::DlRegion region;
+        for (int i = 0; i < kRectCount; i++) {
+          region = flutter::DlRegion::MakeUnion(region,
+                                                flutter::DlRegion(rects[i]));
+          if ((i + 1) % kQueryInterval == 0) {
+            benchmark::DoNotOptimize(
+                region.intersects(queries[i / kQueryInterval]));
+          }
+        }
+        benchmark::DoNotOptimize(region.bounds());
+        break;
+      }
+      case kAccumulator: {
+        accumulator.reset();
+        for (int i = 0; i < kRectCount; i++) {
+          accumulator.addRect(rects[i]);
+          if ((i + 1) % kQueryInterval == 0) {
+            benchmark::DoNotOptimize(
+                accumulator.intersects(queries[i / kQueryInterval]));
+          }
+        }
+        benchmark::DoNotOptimize(accumulator.region().bounds());
+        break;
+      }
+      case kSkRegionOp: {
+        SkRegion region;
+        for (int i = 0; i < kRectCount; i++) {
+          region.op(rects[i], SkRegion::kUnion_Op);
+          if ((i + 1) % kQueryInterval == 0) {
+            benchmark::DoNotOptimize(
+                region.intersects(queries[i / kQueryInterval]));
+          }
+        }
+        benchmark::DoNotOptimize(region.getBounds());
+        break;
+      }
+    }
+  }
+}
+
+enum DamageMode { kJoinedRect, kAccumulatorBounds, kAccumulatorRegion };
+
+// Simulates DiffContext accumulating the damage of a frame from the paint
+// regions of changed layers and then checking the damage against the paint
+// and readback rects of backdrop filters.
+void RunDamageBenchmark(benchmark::State& state,
+                        DamageMode mode,
+                        int damage_count) {
+  std::seed_seq seed{2, 1, 3};
+  std::mt19937 rng(seed);
+
+  const SkIRect kFrame = SkIRect::MakeWH(1080, 2400);
+  const int kReadbackCount = 4;
+  auto damage = GenerateRects(rng, kFrame, damage_count, 200);
+  auto readbacks = GenerateRects(rng, kFrame, kReadbackCount * 2, 400);
+
+  flutter::DlRegionAccumulator accumulator;
+  while (state.KeepRunning()) {
+    switch (mode) {
+      case kJoinedRect: {
+        SkRect frame_damage = SkRect::MakeEmpty();
+        for (const SkIRect& rect : damage) {
+          frame_damage.join(SkRect::Make(rect));
+        }
+        for (int i = 0; i < kReadbackCount; i++) {
+          SkRect paint_rect = SkRect::Make(readbacks[i * 2]);
+          SkRect readback_rect = SkRect::Make(readbacks[i * 2 + 1]);
+          if (paint_rect.intersects(frame_damage) ||
+              readback_rect.intersects(frame_damage)) {
+            frame_damage.join(paint_rect);
+            frame_damage.join(readback_rect);
+          }
+        }
+        SkIRect result;
+        frame_damage.roundOut(&result);
+        benchmark::DoNotOptimize(result);
+        break;
+      }
+      case kAccumulatorBounds:
+      case kAccumulatorRegion: {
+        accumulator.reset();
+        for (const SkIRect& rect : damage) {
+          accumulator.addRect(rect);
+        }
+        for (int i = 0; i < kReadbackCount; i++) {
+          const SkIRect& paint_rect = readbacks[i * 2];
+          const SkIRect& readback_rect = readbacks[i * 2 + 1];
+          bool intersects =
+              mode == kAccumulatorBounds
+                  ? SkIRect::Intersects(paint_rect, accumulator.bounds()) ||
+                        SkIRect::Intersects(readback_rect, accumulator.bounds())
+                  : accumulator.intersects(paint_rect) ||
+                        accumulator.intersects(readback_rect);
+          if (intersects) {
+            accumulator.addRect(paint_rect);
+            accumulator.addRect(readback_rect);
+          }
+        }
+        benchmark::DoNotOptimize(accumulator.bounds());
+        break;
+      }
+    }
+  }
+}
+
 }  // namespace
 
 namespace flutter {
@@ -313,8 +441,73 @@ static void BM_SkRegion_IntersectsSingleRect(benchmark::State& state,
   RunIntersectsSingleRectBenchmark<SkRegionAdapter>(state, maxSize);
 }
 
+static void BM_DlRegion_IncrementalUnion(benchmark::State& state,
+                                         int maxSize) {
+  RunIncrementalUnionBenchmark(state, kMakeUnion, maxSize);
+}
+
+static void BM_DlRegionAccumulator_IncrementalUnion(benchmark::State& state,
+                                                    int maxSize) {
+  RunIncrementalUnionBenchmark(state, kAccumulator, maxSize);
+}
+
+static void BM_SkRegion_IncrementalUnion(benchmark::State& state,
+                                         int maxSize) {
+  RunIncrementalUnionBenchmark(state, kSkRegionOp, maxSize);
+}
+
+static void BM_SkRect_Damage(benchmark::State& state, int damage_count) {
+  RunDamageBenchmark(state, kJoinedRect, damage_count);
+}
+
+static void BM_DlRegionAccumulator_DamageBounds(benchmark::State& state,
+                                                int damage_count) {
+  RunDamageBenchmark(state, kAccumulatorBounds, damage_count);
+}
+
+static void BM_DlRegionAccumulator_DamageRegion(benchmark::State& state,
+                                                int damage_count) {
+  RunDamageBenchmark(state, kAccumulatorRegion, damage_count);
+}
+
 const double kSizeFactorSmall = 0.3;
 
+BENCHMARK_CAPTURE(BM_SkRect_Damage, Few, 10)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRegionAccumulator_DamageBounds, Few, 10)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRegionAccumulator_DamageRegion, Few, 10)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRect_Damage, Many, 100)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRegionAccumulator_DamageBounds, Many, 100)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRegionAccumulator_DamageRegion, Many, 100)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRect_Damage, Lots, 1000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRegionAccumulator_DamageBounds, Lots, 1000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRegionAccumulator_DamageRegion, Lots, 1000)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_DlRegion_IncrementalUnion, Tiny, 30)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRegionAccumulator_IncrementalUnion, Tiny, 30)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRegion_IncrementalUnion, Tiny, 30)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRegion_IncrementalUnion, Small, 100)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRegionAccumulator_IncrementalUnion, Small, 100)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRegion_IncrementalUnion, Small, 100)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRegion_IncrementalUnion, Medium, 400)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRegionAccumulator_IncrementalUnion, Medium, 400)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRegion_IncrementalUnion, Medium, 400)
+    ->Unit(benchmark::kMicrosecond);
+
 BENCHMARK_CAPTURE(BM_DlRegion_IntersectsSingleRect, Tiny, 30)
     ->Unit(benchmark::kNanosecond);
 BENCHMARK_CAPTURE(BM_SkRegion_IntersectsSingleRect, Tiny, 30)
@@ -20,6 +20,7 @@ DisplayList::DisplayList()
       nested_op_count_(0),
       total_depth_(0),
       unique_id_(0),
+      content_hash_(0),
       bounds_({0, 0, 0, 0}),
       can_apply_group_opacity_(true),
       is_ui_thread_safe_(true),
@@ -44,7 +45,8 @@ DisplayList::DisplayList(DisplayListStorage&& storage,
                          DlBlendMode max_root_blend_mode,
                          bool root_has_backdrop_filter,
                          bool root_is_unbounded,
-                         sk_sp<const DlRTree> rtree)
+                         sk_sp<const DlRTree> rtree,
+                         uint64_t content_hash)
     : storage_(std::move(storage)),
       offsets_(std::move(offsets)),
       op_count_(op_count),
@@ -52,6 +54,7 @@ DisplayList::DisplayList(DisplayListStorage&& storage,
       nested_op_count_(nested_op_count),
       total_depth_(total_depth),
       unique_id_(next_unique_id()),
+      content_hash_(content_hash),
       bounds_(bounds),
       can_apply_group_opacity_(can_apply_group_opacity),
       is_ui_thread_safe_(is_ui_thread_safe),
@@ -60,7 +63,8 @@ DisplayList::DisplayList(DisplayListStorage&& storage,
       root_is_unbounded_(root_is_unbounded),
       max_root_blend_mode_(max_root_blend_mode),
       rtree_(std::move(rtree)) {
-  FML_DCHECK(storage_.capacity() == storage_.size());
+  FML_DCHECK(storage_.is_chunked() ||
+             storage_.capacity() == storage_.size());
 }
 
 DisplayList::~DisplayList() {
@@ -119,7 +123,7 @@ void DisplayList::RTreeResultsToIndexVector(
         return;
       }
     }
-    const uint8_t* ptr = storage_.base() + offsets_[index];
+    const uint8_t* ptr = storage_.ptr(offsets_[index]);
     const DLOp* op = reinterpret_cast<const DLOp*>(ptr);
     switch (GetOpCategory(op->type)) {
       case DisplayListOpCategory::kAttribute:
@@ -180,6 +184,12 @@ void DisplayList::RTreeResultsToIndexVector(
 }
 
 void DisplayList::Dispatch(DlOpReceiver& receiver) const {
+  if (storage_.is_chunked()) {
+    for (size_t offset : offsets_) {
+      DispatchOneOp(receiver, storage_.ptr(offset));
+    }
+    return;
+  }
   const uint8_t* base = storage_.base();
   for (size_t offset : offsets_) {
     DispatchOneOp(receiver, base + offset);
@@ -200,9 +210,8 @@ void DisplayList::Dispatch(DlOpReceiver& receiver,
     Dispatch(receiver);
   } else {
     auto op_indices = GetCulledIndices(cull_rect);
-    const uint8_t* base = storage_.base();
     for (DlIndex index : op_indices) {
-      DispatchOneOp(receiver, base + offsets_[index]);
+      DispatchOneOp(receiver, storage_.ptr(offsets_[index]));
     }
   }
 }
@@ -229,12 +238,11 @@ void DisplayList::DispatchOneOp(DlOpReceiver& receiver,
 
 void DisplayList::DisposeOps(const DisplayListStorage& storage,
                              const std::vector<size_t>& offsets) {
-  const uint8_t* base = storage.base();
-  if (!base) {
+  if (storage.size() == 0u) {
     return;
   }
   for (size_t offset : offsets) {
-    auto op = reinterpret_cast<const DLOp*>(base + offset);
+    auto op = reinterpret_cast<const DLOp*>(storage.ptr(offset));
     switch (op->type) {
 #define DL_OP_DISPOSE(name)                            \
   case DisplayListOpType::k##name:                     \
@@ -353,7 +361,7 @@ DisplayListOpType DisplayList::GetOpType(DlIndex index) const {
 
   size_t offset = offsets_[index];
   FML_DCHECK(offset < storage_.size());
-  auto ptr = storage_.base() + offset;
+  auto ptr = storage_.ptr(offset);
   auto op = reinterpret_cast<const DLOp*>(ptr);
   return op->type;
 }
@@ -370,9 +378,13 @@ std::vector<DlIndex> DisplayList::GetCulledIndices(
   std::vector<DlIndex> indices;
   if (!cull_rect.isEmpty()) {
     if (rtree_) {
-      std::vector<int> rect_indices;
-      rtree_->search(cull_rect, &rect_indices);
-      RTreeResultsToIndexVector(indices, rect_indices);
+      // The RTree results are only needed until they are converted into
+      // op indices, so a per-thread scratch vector saves an allocation on
+      // every culled dispatch.
+      static thread_local std::vector<int> tls_rect_indices;
+      tls_rect_indices.clear();
+      rtree_->search(cull_rect, &tls_rect_indices);
+      RTreeResultsToIndexVector(indices, tls_rect_indices);
     } else {
       FillAllIndices(indices, offsets_.size());
     }
@@ -389,7 +401,7 @@ bool DisplayList::Dispatch(DlOpReceiver& receiver, DlIndex index) const {
 
   size_t offset = offsets_[index];
   FML_DCHECK(offset < storage_.size());
-  auto ptr = storage_.base() + offset;
+  auto ptr = storage_.ptr(offset);
 
   DispatchOneOp(receiver, ptr);
 
@@ -400,17 +412,22 @@ static bool CompareOps(const DisplayListStorage& storageA,
                        const std::vector<size_t>& offsetsA,
                        const DisplayListStorage& storageB,
                        const std::vector<size_t>& offsetsB) {
-  const uint8_t* base_a = storageA.base();
-  const uint8_t* base_b = storageB.base();
   // These conditions are checked by the caller...
   FML_DCHECK(offsetsA.size() == offsetsB.size());
-  FML_DCHECK(base_a != base_b);
+  FML_DCHECK(storageA.size() == storageB.size());
+  // Storage of the same mode lays out identical records at identical
+  // offsets, but chunked storage may skip the tail of a chunk where
+  // contiguous storage would not.
+  bool same_layout = storageA.mode() == storageB.mode();
   size_t bulk_start = 0u;
   for (size_t i = 0; i < offsetsA.size(); i++) {
     size_t offset = offsetsA[i];
-    FML_DCHECK(offsetsB[i] == offset);
-    auto opA = reinterpret_cast<const DLOp*>(base_a + offset);
-    auto opB = reinterpret_cast<const DLOp*>(base_b + offset);
+    if (offsetsB[i] != offset) {
+      FML_DCHECK(!same_layout);
+      return false;
+    }
+    auto opA = reinterpret_cast<const DLOp*>(storageA.ptr(offset));
+    auto opB = reinterpret_cast<const DLOp*>(storageB.ptr(offset));
     if (opA->type != opB->type) {
       return false;
     }
@@ -439,9 +456,8 @@ static bool CompareOps(const DisplayListStorage& storageA,
         // Check if we have a backlog of bytes to bulk compare and then
         // reset the bulk compare pointers to the address following this op
         if (bulk_start < offset) {
-          const uint8_t* bulk_start_a = base_a + bulk_start;
-          const uint8_t* bulk_start_b = base_b + bulk_start;
-          if (memcmp(bulk_start_a, bulk_start_b, offset - bulk_start) != 0) {
+          if (!DisplayListStorage::BytesEqual(storageA, storageB, bulk_start,
+                                              offset)) {
             return false;
           }
         }
@@ -452,9 +468,8 @@ static bool CompareOps(const DisplayListStorage& storageA,
   }
   if (bulk_start < storageA.size()) {
     // Perform a final bulk compare if we have remaining bytes waiting
-    const uint8_t* bulk_start_a = base_a + bulk_start;
-    const uint8_t* bulk_start_b = base_b + bulk_start;
-    if (memcmp(bulk_start_a, bulk_start_b, storageA.size() - bulk_start) != 0) {
+    if (!DisplayListStorage::BytesEqual(storageA, storageB, bulk_start,
+                                        storageA.size())) {
       return false;
     }
   }
@@ -470,7 +485,8 @@ bool DisplayList::Equals(const DisplayList* other) const {
       op_count_ != other->op_count_) {
     return false;
   }
-  if (storage_.base() == other->storage_.base()) {
+  if (storage_.size() == 0u ||
+      storage_.ptr(0u) == other->storage_.ptr(0u)) {
     return true;
   }
   return CompareOps(storage_, offsets_, other->storage_, other->offsets_);
@@ -290,6 +290,19 @@ class DisplayList : public SkRefCnt {
 
   uint32_t unique_id() const { return unique_id_; }
 
+  /// Returns a hash of the recorded ops that the |DisplayListBuilder|
+  /// accumulates as the ops are recorded. It covers the final bytes of
+  /// the op records, including their inline attribute objects, the
+  /// fields of save records that are written when they are restored, and
+  /// the identity of any shared objects (images, paths, filters) that
+  /// they reference.
+  ///
+  /// Two lists with different hashes may still be |Equals| if they hold
+  /// distinct but equivalent shared objects. Two lists with the same hash
+  /// are very likely, but not guaranteed, to be |Equals|. Layer diffing
+  /// trusts a match for lists too large to compare op by op.
+  uint64_t content_hash() const { return content_hash_; }
+
   const SkRect& bounds() const { return bounds_; }
   const DlRect& GetBounds() const { return ToDlRect(bounds_); }
 
@@ -516,7 +529,8 @@ class DisplayList : public SkRefCnt {
               DlBlendMode max_root_blend_mode,
               bool root_has_backdrop_filter,
               bool root_is_unbounded,
-              sk_sp<const DlRTree> rtree);
+              sk_sp<const DlRTree> rtree,
+              uint64_t content_hash);
 
   static uint32_t next_unique_id();
 
@@ -533,6 +547,7 @@ class DisplayList : public SkRefCnt {
   const uint32_t total_depth_;
 
   const uint32_t unique_id_;
+  const uint64_t content_hash_;
   const SkRect bounds_;
 
   const bool can_apply_group_opacity_;
@@ -346,6 +346,120 @@ TEST_F(DisplayListTest, BuilderCanBeReused) {
   ASSERT_TRUE(dl->Equals(dl2));
 }
 
+TEST_F(DisplayListTest, ChunkedStorageMatchesContiguousStorage) {
+  DisplayListBuilder contiguous_builder(kTestSkBounds);
+  DisplayListBuilder chunked_builder(kTestSkBounds, false,
+                                     DlStorageMode::kChunked);
+  // Record enough ops to span several storage chunks.
+  for (int i = 0; i < 2000; i++) {
+    for (DisplayListBuilder* builder : {&contiguous_builder, &chunked_builder}) {
+      builder->Save();
+      builder->Translate(i * 1.0f, i * 1.0f);
+      builder->DrawRect(kTestSkBounds, DlPaint(DlColor::kBlue()));
+      builder->Restore();
+    }
+  }
+  auto contiguous_dl = contiguous_builder.Build();
+  auto chunked_dl = chunked_builder.Build();
+  ASSERT_TRUE(chunked_dl->GetStorage().is_chunked());
+  EXPECT_GT(chunked_dl->GetStorage().size(),
+            DisplayListStorage::kDLChunkSize);
+  EXPECT_EQ(chunked_dl->GetRecordCount(), contiguous_dl->GetRecordCount());
+  EXPECT_EQ(chunked_dl->op_count(), contiguous_dl->op_count());
+  EXPECT_EQ(chunked_dl->bounds(), contiguous_dl->bounds());
+  for (DlIndex i : *chunked_dl) {
+    EXPECT_EQ(chunked_dl->GetOpType(i), contiguous_dl->GetOpType(i));
+  }
+
+  DisplayListBuilder chunked_builder2(kTestSkBounds, false,
+                                      DlStorageMode::kChunked);
+  chunked_dl->Dispatch(DisplayListBuilderTestingAccessor(chunked_builder2));
+  auto chunked_dl2 = chunked_builder2.Build();
+  EXPECT_TRUE(chunked_dl->Equals(chunked_dl2));
+}
+
+TEST_F(DisplayListTest, ContentHashMatchesForEqualContent) {
+  auto record = [](DisplayListBuilder& builder, DlColor color) {
+    builder.Save();
+    builder.Translate(10.0f, 10.0f);
+    builder.SaveLayer(nullptr, nullptr);
+    builder.DrawRect(kTestSkBounds, DlPaint(color));
+    builder.DrawImage(TestImage1, SkPoint::Make(5, 5),
+                      DlImageSampling::kLinear);
+    builder.Restore();
+    builder.Restore();
+  };
+  DisplayListBuilder builder1(kTestSkBounds);
+  record(builder1, DlColor::kBlue());
+  auto dl1 = builder1.Build();
+
+  DisplayListBuilder builder2(kTestSkBounds);
+  record(builder2, DlColor::kBlue());
+  auto dl2 = builder2.Build();
+
+  DisplayListBuilder builder3(kTestSkBounds);
+  record(builder3, DlColor::kRed());
+  auto dl3 = builder3.Build();
+
+  // The builder is reusable and starts a new hash after each Build.
+  record(builder1, DlColor::kBlue());
+  auto dl4 = builder1.Build();
+
+  EXPECT_NE(dl1->unique_id(), dl2->unique_id());
+  EXPECT_EQ(dl1->content_hash(), dl2->content_hash());
+  EXPECT_NE(dl1->content_hash(), dl3->content_hash());
+  EXPECT_EQ(dl1->content_hash(), dl4->content_hash());
+  EXPECT_NE(dl1->content_hash(), DisplayListBuilder().Build()->content_hash());
+}
+
+TEST_F(DisplayListTest, ContentHashCoversImageIdentityAndPodData) {
+  DisplayListBuilder builder1;
+  builder1.DrawImage(TestImage1, SkPoint::Make(5, 5), DlImageSampling::kLinear);
+  DisplayListBuilder builder2;
+  builder2.DrawImage(TestImage2, SkPoint::Make(5, 5), DlImageSampling::kLinear);
+  EXPECT_NE(builder1.Build()->content_hash(), builder2.Build()->content_hash());
+
+  // The points are copied into the record after it is allocated.
+  SkPoint points1[] = {{10, 10}, {20, 20}, {30, 30}};
+  SkPoint points2[] = {{10, 10}, {20, 20}, {30, 40}};
+  DisplayListBuilder builder3;
+  builder3.DrawPoints(DlCanvas::PointMode::kPoints, 3, points1, DlPaint());
+  DisplayListBuilder builder4;
+  builder4.DrawPoints(DlCanvas::PointMode::kPoints, 3, points2, DlPaint());
+  EXPECT_NE(builder3.Build()->content_hash(), builder4.Build()->content_hash());
+}
+
+TEST_F(DisplayListTest, ContentHashCoversRestoredLayerBounds) {
+  // The records are identical when pushed, but the cull rect clips the
+  // content bounds that are written into the saveLayer when it is restored.
+  auto record = [](DisplayListBuilder& builder) {
+    builder.SaveLayer(nullptr, nullptr);
+    builder.DrawRect(SkRect::MakeLTRB(0, 0, 100, 100), DlPaint());
+    builder.Restore();
+  };
+  DisplayListBuilder builder1(SkRect::MakeLTRB(0, 0, 50, 50));
+  record(builder1);
+  DisplayListBuilder builder2(SkRect::MakeLTRB(0, 0, 60, 60));
+  record(builder2);
+  EXPECT_NE(builder1.Build()->content_hash(), builder2.Build()->content_hash());
+}
+
+TEST_F(DisplayListTest, ContentHashMatchesAcrossStorageModes) {
+  DisplayListBuilder contiguous_builder(kTestSkBounds);
+  DisplayListBuilder chunked_builder(kTestSkBounds, false,
+                                     DlStorageMode::kChunked);
+  for (int i = 0; i < 2000; i++) {
+    for (DisplayListBuilder* builder : {&contiguous_builder, &chunked_builder}) {
+      builder->Save();
+      builder->Translate(i * 1.0f, i * 1.0f);
+      builder->DrawRect(kTestSkBounds, DlPaint(DlColor::kBlue()));
+      builder->Restore();
+    }
+  }
+  EXPECT_EQ(contiguous_builder.Build()->content_hash(),
+            chunked_builder.Build()->content_hash());
+}
+
 TEST_F(DisplayListTest, SaveRestoreRestoresTransform) {
   DlRect cull_rect = DlRect::MakeLTRB(-10.0f, -10.0f, 500.0f, 500.0f);
   DisplayListBuilder builder(cull_rect);
@@ -35,15 +35,52 @@ static void CopyV(void* dst, const S* src, int n, Rest&&... rest) {
   CopyV(dst, std::forward<Rest>(rest)...);
 }
 
+// Mixes the bytes of an op record into a running hash a word at a time.
+// Records are pointer aligned and zero filled, including any padding
+// within the op structures, so the hash only depends on their contents.
+static uint64_t HashRecordBytes(uint64_t hash,
+                                const uint8_t* bytes,
+                                size_t size) {
+  constexpr uint64_t kMultiplier = 0x9e3779b97f4a7c15u;
+  size_t i = 0u;
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, bytes + i, sizeof(word));
+    hash = (hash ^ word) * kMultiplier;
+    hash ^= hash >> 32;
+  }
+  if (i < size) {
+    uint64_t word = 0u;
+    memcpy(&word, bytes + i, size - i);
+    hash = (hash ^ word) * kMultiplier;
+    hash ^= hash >> 32;
+  }
+  return hash;
+}
+
+void DisplayListBuilder::HashPendingOp() {
+  if (unhashed_op_size_ > 0u) {
+    content_hash_ =
+        HashRecordBytes(content_hash_, storage_.ptr(unhashed_op_offset_),
+                        unhashed_op_size_);
+    unhashed_op_size_ = 0u;
+  }
+}
+
 template <typename T, typename... Args>
 void* DisplayListBuilder::Push(size_t pod, Args&&... args) {
+  // The previous record is complete now, fold it into the content hash
+  // before the allocation below can move the storage.
+  HashPendingOp();
+
   // Plan out where and how large a space we need
   size_t size = SkAlignPtr(sizeof(T) + pod);
-  size_t offset = storage_.size();
 
-  // Allocate the space
+  // Allocate the space (chunked storage may start the record at the
+  // beginning of a new chunk rather than at the previous size)
   auto ptr = storage_.allocate(size);
   FML_CHECK(ptr);
+  size_t offset = storage_.size() - size;
 
   // Initialize the space via the constructor
   auto op = reinterpret_cast<T*>(ptr);
@@ -54,6 +91,8 @@ void* DisplayListBuilder::Push(size_t pod, Args&&... args) {
   // at this point except that the caller might do some pod-based copying
   // past the end of the DlOp structure itself when we return)
   offsets_.push_back(offset);
+  unhashed_op_offset_ = offset;
+  unhashed_op_size_ = size;
   render_op_count_ += T::kRenderOpInc;
   depth_ += T::kDepthInc * render_op_depth_cost_;
   op_index_++;
@@ -66,6 +105,13 @@ sk_sp<DisplayList> DisplayListBuilder::Build() {
     restore();
   }
 
+  HashPendingOp();
+  uint64_t content_hash = content_hash_;
+  uint64_t record_count = offsets_.size();
+  content_hash =
+      HashRecordBytes(content_hash, reinterpret_cast<uint8_t*>(&record_count),
+                      sizeof(record_count));
+
   int count = render_op_count_;
   size_t nested_bytes = nested_bytes_;
   int nested_count = nested_op_count_;
@@ -82,8 +128,14 @@ sk_sp<DisplayList> DisplayListBuilder::Build() {
   if (rtree_data_.has_value()) {
     auto& rects = rtree_data_->rects;
     auto& indices = rtree_data_->indices;
+    // Large lists are bulk loaded, which costs a little more to build but
+    // keeps the culling searches fast for content that is not laid out
+    // in a top to bottom fashion.
+    auto strategy = rects.size() > kBulkLoadRTreeThreshold
+                        ? DlRTree::BuildStrategy::kSortTileRecursive
+                        : DlRTree::BuildStrategy::kInsertionOrder;
     rtree = sk_make_sp<DlRTree>(rects.data(), rects.size(), indices.data(),
-                                [](int id) { return id >= 0; });
+                                [](int id) { return id >= 0; }, -1, strategy);
     // RTree bounds may be tighter due to applying filter bounds
     // adjustments to each op as we restore layers rather than to
     // the entire layer bounds.
@@ -95,6 +147,7 @@ sk_sp<DisplayList> DisplayListBuilder::Build() {
 
   render_op_count_ = op_index_ = 0;
   nested_bytes_ = nested_op_count_ = 0;
+  content_hash_ = kInitialContentHash;
   depth_ = 0;
   is_ui_thread_safe_ = true;
   current_opacity_compatibility_ = true;
@@ -105,7 +158,7 @@ sk_sp<DisplayList> DisplayListBuilder::Build() {
   Init(rtree != nullptr);
 
   storage_.trim();
-  DisplayListStorage storage;
+  DisplayListStorage storage(storage_mode_);
   std::vector<size_t> offsets;
   std::swap(offsets, offsets_);
   std::swap(storage, storage_);
@@ -114,7 +167,7 @@ sk_sp<DisplayList> DisplayListBuilder::Build() {
       std::move(storage), std::move(offsets), count, nested_bytes, nested_count,
       total_depth, bounds, opacity_compatible, is_safe, affects_transparency,
       max_root_blend_mode, root_has_backdrop_filter, root_is_unbounded,
-      std::move(rtree)));
+      std::move(rtree), content_hash));
 }
 
 static constexpr DlRect kEmpty = DlRect();
@@ -125,8 +178,11 @@ static const DlRect& ProtectEmpty(const DlRect& rect) {
 }
 
 DisplayListBuilder::DisplayListBuilder(const DlRect& cull_rect,
-                                       bool prepare_rtree)
-    : original_cull_rect_(ProtectEmpty(cull_rect)) {
+                                       bool prepare_rtree,
+                                       DlStorageMode storage_mode)
+    : storage_mode_(storage_mode),
+      storage_(storage_mode),
+      original_cull_rect_(ProtectEmpty(cull_rect)) {
   Init(prepare_rtree);
 }
 
@@ -385,9 +441,8 @@ void DisplayListBuilder::SetAttributesFromPaint(
 
 void DisplayListBuilder::checkForDeferredSave() {
   if (current_info().has_deferred_save_op) {
-    size_t save_offset = storage_.size();
     Push<SaveOp>(0);
-    current_info().save_offset = save_offset;
+    current_info().save_offset = offsets_.back();
     current_info().save_depth = depth_;
     current_info().has_deferred_save_op = false;
   }
@@ -430,7 +485,6 @@ void DisplayListBuilder::saveLayer(const DlRect& bounds,
   // Snapshot these values before we do any work as we need the values
   // from before the method was called, but some of the operations below
   // might update them.
-  size_t save_offset = storage_.size();
   uint32_t save_depth = depth_;
 
   // A backdrop will affect up to the entire surface, bounded by the clip
@@ -476,7 +530,6 @@ void DisplayListBuilder::saveLayer(const DlRect& bounds,
     FML_DCHECK(current_info().is_save_layer);
     FML_DCHECK(!current_info().is_nop);
     FML_DCHECK(!current_info().has_deferred_save_op);
-    current_info().save_offset = save_offset;
     current_info().save_depth = save_depth;
 
     // If we inherit some culling bounds and we have a filter then we need
@@ -526,6 +579,7 @@ void DisplayListBuilder::saveLayer(const DlRect& bounds,
     } else {
       Push<SaveLayerOp>(0, options, record_bounds);
     }
+    current_info().save_offset = offsets_.back();
   }
 
   if (options.renders_with_attributes()) {
@@ -564,8 +618,8 @@ void DisplayListBuilder::Restore() {
   }
 
   if (!current_info().has_deferred_save_op) {
-    SaveOpBase* op = reinterpret_cast<SaveOpBase*>(storage_.base() +
-                                                   current_info().save_offset);
+    SaveOpBase* op = reinterpret_cast<SaveOpBase*>(
+        storage_.ptr(current_info().save_offset));
     FML_CHECK(op->type == DisplayListOpType::kSave ||
               op->type == DisplayListOpType::kSaveLayer ||
               op->type == DisplayListOpType::kSaveLayerBackdrop);
@@ -577,6 +631,24 @@ void DisplayListBuilder::Restore() {
       RestoreLayer();
     }
 
+    // The save record was hashed when the next record was pushed, before
+    // its restore index, depth and any layer bounds and options were known.
+    // Fold its final contents in now that they have all been written.
+    size_t save_op_size;
+    switch (op->type) {
+      case DisplayListOpType::kSave:
+        save_op_size = sizeof(SaveOp);
+        break;
+      case DisplayListOpType::kSaveLayer:
+        save_op_size = sizeof(SaveLayerOp);
+        break;
+      default:
+        save_op_size = sizeof(SaveLayerBackdropOp);
+        break;
+    }
+    content_hash_ = HashRecordBytes(
+        content_hash_, reinterpret_cast<const uint8_t*>(op), save_op_size);
+
     // Wait until all outgoing bounds information for the saveLayer is
     // recorded before pushing the record to the buffer so that any rtree
     // bounds will be attributed to the op_index of the restore op.
@@ -601,7 +673,7 @@ void DisplayListBuilder::RestoreLayer() {
   SkRect content_bounds = current_layer().layer_local_accumulator.bounds();
 
   SaveLayerOpBase* layer_op = reinterpret_cast<SaveLayerOpBase*>(
-      storage_.base() + current_info().save_offset);
+      storage_.ptr(current_info().save_offset));
   FML_CHECK(layer_op->type == DisplayListOpType::kSaveLayer ||
             layer_op->type == DisplayListOpType::kSaveLayerBackdrop);
 
@@ -32,18 +32,26 @@ class DisplayListBuilder final : public virtual DlCanvas,
   static constexpr DlRect kMaxCullRect =
       DlRect::MakeLTRB(-1E9F, -1E9F, 1E9F, 1E9F);
 
+  /// The number of recorded bounds above which the RTree of the built
+  /// DisplayList is bulk loaded rather than built in insertion order.
+  static constexpr size_t kBulkLoadRTreeThreshold = 4096u;
+
   explicit DisplayListBuilder(bool prepare_rtree)
       : DisplayListBuilder(kMaxCullRect, prepare_rtree) {}
 
-  explicit DisplayListBuilder(const DlRect& cull_rect = kMaxCullRect,
-                              bool prepare_rtree = false);
+  explicit DisplayListBuilder(
+      const DlRect& cull_rect = kMaxCullRect,
+      bool prepare_rtree = false,
+      DlStorageMode storage_mode = DlStorageMode::kContiguous);
 
   DisplayListBuilder(DlScalar width, DlScalar height)
       : DisplayListBuilder(DlRect::MakeWH(width, height)) {}
 
-  explicit DisplayListBuilder(const SkRect& cull_rect,
-                              bool prepare_rtree = false)
-      : DisplayListBuilder(ToDlRect(cull_rect), prepare_rtree) {}
+  explicit DisplayListBuilder(
+      const SkRect& cull_rect,
+      bool prepare_rtree = false,
+      DlStorageMode storage_mode = DlStorageMode::kContiguous)
+      : DisplayListBuilder(ToDlRect(cull_rect), prepare_rtree, storage_mode) {}
 
   ~DisplayListBuilder();
 
@@ -500,6 +508,7 @@ class DisplayListBuilder final : public virtual DlCanvas,
 
   void checkForDeferredSave();
 
+  const DlStorageMode storage_mode_;
   DisplayListStorage storage_;
   std::vector<size_t> offsets_;
   uint32_t render_op_count_ = 0u;
@@ -515,6 +524,19 @@ class DisplayListBuilder final : public virtual DlCanvas,
 
   bool is_ui_thread_safe_ = true;
 
+  // The content hash of the ops recorded so far. Each record is folded
+  // into the hash when the next record is pushed (or the list is built)
+  // so that any pod data the caller copies after |Push| is included.
+  // Save records are folded in again by |Restore| once the fields that
+  // it back-patches have been written.
+  uint64_t content_hash_ = kInitialContentHash;
+  size_t unhashed_op_offset_ = 0u;
+  size_t unhashed_op_size_ = 0u;
+
+  static constexpr uint64_t kInitialContentHash = 0xcbf29ce484222325u;
+
+  void HashPendingOp();
+
   template <typename T, typename... Args>
   void* Push(size_t extra, Args&&... args);
 
@@ -4,19 +4,115 @@
 
 #include "flutter/display_list/dl_storage.h"
 
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
 namespace flutter {
 
 static constexpr inline bool is_power_of_two(int value) {
   return (value & (value - 1)) == 0;
 }
 
+namespace {
+
+// Chunks released on a thread are kept in a thread local list so that
+// the next DisplayList recorded on that thread can reuse them without a
+// trip to the heap. Threads that release more chunks than they record
+// (such as the raster thread releasing frames recorded on the UI thread)
+// spill their excess into a shared depot from which recording threads
+// refill their own lists in batches.
+class DlChunkPool {
+ public:
+  static constexpr size_t kMaxLocalChunks = 64u;
+  static constexpr size_t kMaxDepotChunks = 256u;
+  static constexpr size_t kBatchSize = kMaxLocalChunks / 2;
+
+  static DlChunkPool& ForCurrentThread() {
+    static thread_local std::unique_ptr<DlChunkPool> tls_chunk_pool;
+    if (!tls_chunk_pool) {
+      tls_chunk_pool = std::make_unique<DlChunkPool>();
+    }
+    return *tls_chunk_pool;
+  }
+
+  ~DlChunkPool() {
+    for (uint8_t* chunk : chunks_) {
+      std::free(chunk);
+    }
+  }
+
+  // Returns a zero-filled chunk and sets |from_heap| if the chunk could
+  // not be satisfied from either the local list or the shared depot.
+  uint8_t* Acquire(bool* from_heap) {
+    if (chunks_.empty()) {
+      Depot& depot = GetDepot();
+      std::scoped_lock lock(depot.mutex);
+      size_t count = std::min(kBatchSize, depot.chunks.size());
+      chunks_.insert(chunks_.end(), depot.chunks.end() - count,
+                     depot.chunks.end());
+      depot.chunks.resize(depot.chunks.size() - count);
+    }
+    if (chunks_.empty()) {
+      *from_heap = true;
+      uint8_t* chunk = static_cast<uint8_t*>(
+          std::calloc(1u, DisplayListStorage::kDLChunkSize));
+      FML_CHECK(chunk);
+      return chunk;
+    }
+    *from_heap = false;
+    uint8_t* chunk = chunks_.back();
+    chunks_.pop_back();
+    memset(chunk, 0, DisplayListStorage::kDLChunkSize);
+    return chunk;
+  }
+
+  void Release(uint8_t* chunk) {
+    if (chunks_.size() >= kMaxLocalChunks) {
+      Depot& depot = GetDepot();
+      std::scoped_lock lock(depot.mutex);
+      while (chunks_.size() > kMaxLocalChunks - kBatchSize) {
+        if (depot.chunks.size() < kMaxDepotChunks) {
+          depot.chunks.push_back(chunks_.back());
+        } else {
+          std::free(chunks_.back());
+        }
+        chunks_.pop_back();
+      }
+    }
+    chunks_.push_back(chunk);
+  }
+
+ private:
+  struct Depot {
+    std::mutex mutex;
+    std::vector<uint8_t*> chunks;
+  };
+
+  static Depot& GetDepot() {
+    static Depot* depot = new Depot();
+    return *depot;
+  }
+
+  std::vector<uint8_t*> chunks_;
+};
+
+}  // namespace
+
 void DisplayListStorage::realloc(size_t count) {
+  if (ptr_) {
+    copied_bytes_ += std::min(used_, count);
+  }
+  allocation_count_++;
   ptr_.reset(static_cast<uint8_t*>(std::realloc(ptr_.release(), count)));
   FML_CHECK(ptr_);
   allocated_ = count;
 }
 
 uint8_t* DisplayListStorage::allocate(size_t needed) {
+  if (is_chunked()) {
+    return allocate_chunked(needed);
+  }
   if (used_ + needed > allocated_) {
     static_assert(is_power_of_two(kDLPageSize),
                   "This math needs updating for non-pow2.");
@@ -36,26 +132,114 @@ uint8_t* DisplayListStorage::allocate(size_t needed) {
   return ret;
 }
 
+uint8_t* DisplayListStorage::allocate_chunked(size_t needed) {
+  static_assert(is_power_of_two(kDLChunkSize),
+                "This math needs updating for non-pow2.");
+  FML_DCHECK((allocated_ & (kDLChunkSize - 1)) == 0);
+  if (used_ + needed > allocated_) {
+    // The record does not fit in the remainder of the last chunk, so we
+    // leave the (zero-filled) tail of that chunk unused and start the
+    // record at the beginning of a new chunk slot.
+    used_ = allocated_;
+    if (needed <= kDLChunkSize) {
+      bool from_heap;
+      uint8_t* chunk = DlChunkPool::ForCurrentThread().Acquire(&from_heap);
+      if (from_heap) {
+        allocation_count_++;
+      }
+      chunks_.push_back(chunk);
+      pooled_.push_back(chunk);
+      allocated_ += kDLChunkSize;
+    } else {
+      size_t slots = (needed + kDLChunkSize - 1) >> kDLChunkShift;
+      uint8_t* big =
+          static_cast<uint8_t*>(std::calloc(slots, kDLChunkSize));
+      FML_CHECK(big);
+      allocation_count_++;
+      for (size_t i = 0; i < slots; i++) {
+        chunks_.push_back(big + (i << kDLChunkShift));
+      }
+      oversized_.push_back(big);
+      allocated_ += slots << kDLChunkShift;
+    }
+  }
+  uint8_t* ret = ptr(used_);
+  used_ += needed;
+  FML_CHECK(used_ <= allocated_);
+  return ret;
+}
+
+void DisplayListStorage::release_chunks() {
+  if (!pooled_.empty()) {
+    DlChunkPool& pool = DlChunkPool::ForCurrentThread();
+    for (uint8_t* chunk : pooled_) {
+      pool.Release(chunk);
+    }
+    pooled_.clear();
+  }
+  for (uint8_t* big : oversized_) {
+    std::free(big);
+  }
+  oversized_.clear();
+  chunks_.clear();
+}
+
+bool DisplayListStorage::BytesEqual(const DisplayListStorage& a,
+                                    const DisplayListStorage& b,
+                                    size_t start,
+                                    size_t end) {
+  FML_DCHECK(end <= a.size() && end <= b.size());
+  if (!a.is_chunked() && !b.is_chunked()) {
+    return start >= end ||
+           memcmp(a.ptr(start), b.ptr(start), end - start) == 0;
+  }
+  // Compare one chunk slot at a time as consecutive slots are not
+  // necessarily adjacent in memory.
+  while (start < end) {
+    size_t slot_end = std::min(end, (start | (kDLChunkSize - 1)) + 1);
+    if (memcmp(a.ptr(start), b.ptr(start), slot_end - start) != 0) {
+      return false;
+    }
+    start = slot_end;
+  }
+  return true;
+}
+
 DisplayListStorage::DisplayListStorage(DisplayListStorage&& source) {
-  ptr_ = std::move(source.ptr_);
-  used_ = source.used_;
-  allocated_ = source.allocated_;
-  source.used_ = 0u;
-  source.allocated_ = 0u;
+  *this = std::move(source);
+}
+
+DisplayListStorage::~DisplayListStorage() {
+  release_chunks();
 }
 
 void DisplayListStorage::reset() {
+  release_chunks();
   ptr_.reset();
   used_ = 0u;
   allocated_ = 0u;
+  allocation_count_ = 0u;
+  copied_bytes_ = 0u;
 }
 
 DisplayListStorage& DisplayListStorage::operator=(DisplayListStorage&& source) {
+  release_chunks();
   ptr_ = std::move(source.ptr_);
+  chunks_ = std::move(source.chunks_);
+  pooled_ = std::move(source.pooled_);
+  oversized_ = std::move(source.oversized_);
+  mode_ = source.mode_;
   used_ = source.used_;
   allocated_ = source.allocated_;
+  allocation_count_ = source.allocation_count_;
+  copied_bytes_ = source.copied_bytes_;
+  source.chunks_.clear();
+  source.pooled_.clear();
+  source.oversized_.clear();
   source.used_ = 0u;
   source.allocated_ = 0u;
+  source.allocation_count_ = 0u;
+  source.copied_bytes_ = 0u;
   return *this;
 }
 
@@ -6,22 +6,71 @@
 #define FLUTTER_DISPLAY_LIST_DL_STORAGE_H_
 
 #include <memory>
+#include <vector>
 
 #include "flutter/fml/logging.h"
 
 namespace flutter {
 
-// Manages a buffer allocated with malloc.
+/// The strategy used by a |DisplayListStorage| to hold its op records.
+enum class DlStorageMode {
+  /// A single buffer allocated with malloc that grows by |kDLPageSize|
+  /// increments via realloc and is trimmed to its final size when the
+  /// DisplayList is built.
+  kContiguous,
+
+  /// A sequence of fixed size chunks obtained from a per-thread pool of
+  /// recycled chunks. Growing the storage never copies existing records
+  /// and the chunks are returned to the pool of the thread that releases
+  /// the storage.
+  kChunked,
+};
+
+// Manages the memory used to store the op records of a DisplayList.
+//
+// The records are addressed by offset. In contiguous mode the offsets
+// are relative to a single malloc'd buffer. In chunked mode the offsets
+// address a virtual space of |kDLChunkSize| slots in which each record
+// lies entirely within a single chunk (records larger than a chunk get
+// a dedicated allocation spanning several slots).
 class DisplayListStorage {
  public:
   static const constexpr size_t kDLPageSize = 4096u;
+  static const constexpr size_t kDLChunkShift = 14u;
+  static const constexpr size_t kDLChunkSize = 1u << kDLChunkShift;
 
   DisplayListStorage() = default;
+  explicit DisplayListStorage(DlStorageMode mode) : mode_(mode) {}
   DisplayListStorage(DisplayListStorage&&);
 
+  ~DisplayListStorage();
+
+  DlStorageMode mode() const { return mode_; }
+  bool is_chunked() const { return mode_ == DlStorageMode::kChunked; }
+
   /// Returns a pointer to the base of the storage.
-  uint8_t* base() { return ptr_.get(); }
-  const uint8_t* base() const { return ptr_.get(); }
+  ///
+  /// Only valid for contiguous storage, use |ptr(offset)| to address
+  /// records in a storage of either mode.
+  uint8_t* base() {
+    FML_DCHECK(!is_chunked());
+    return ptr_.get();
+  }
+  const uint8_t* base() const {
+    FML_DCHECK(!is_chunked());
+    return ptr_.get();
+  }
+
+  /// Returns a pointer to the record stored at the indicated offset.
+  uint8_t* ptr(size_t offset) {
+    if (is_chunked()) {
+      return chunks_[offset >> kDLChunkShift] + (offset & (kDLChunkSize - 1));
+    }
+    return ptr_.get() + offset;
+  }
+  const uint8_t* ptr(size_t offset) const {
+    return const_cast<DisplayListStorage*>(this)->ptr(offset);
+  }
 
   /// Returns the currently allocated size
   size_t size() const { return used_; }
@@ -29,30 +78,69 @@ class DisplayListStorage {
   /// Returns the maximum currently allocated space
   size_t capacity() const { return allocated_; }
 
+  /// Returns the number of times this storage has had to go to the heap
+  /// for more memory. Chunks satisfied from the recycling pool do not
+  /// count as allocations.
+  size_t allocation_count() const { return allocation_count_; }
+
+  /// Returns the number of bytes of existing records that were subject
+  /// to being copied when the storage grew.
+  size_t copied_bytes() const { return copied_bytes_; }
+
   /// Ensures the indicated number of bytes are available and returns
   /// a pointer to that memory within the storage while also invalidating
   /// any other outstanding pointers into the storage.
+  ///
+  /// Chunked storage never invalidates outstanding pointers, but it may
+  /// skip to the next chunk so the returned memory always starts at
+  /// offset |size() - needed| after the call.
   uint8_t* allocate(size_t needed);
 
   /// Trims the storage to the currently allocated size and invalidates
   /// any outstanding pointers into the storage.
-  void trim() { realloc(used_); }
+  ///
+  /// Chunked storage keeps its chunks until it is reset or destroyed.
+  void trim() {
+    if (!is_chunked()) {
+      realloc(used_);
+    }
+  }
 
   /// Resets the storage and allocation of the object to an empty state
   void reset();
 
+  /// Compares the bytes in the range [start, end) of two storage
+  /// objects which have identical record layouts over that range.
+  static bool BytesEqual(const DisplayListStorage& a,
+                         const DisplayListStorage& b,
+                         size_t start,
+                         size_t end);
+
   DisplayListStorage& operator=(DisplayListStorage&& other);
 
  private:
   void realloc(size_t count);
+  uint8_t* allocate_chunked(size_t needed);
+  void release_chunks();
 
   struct FreeDeleter {
     void operator()(uint8_t* p) { std::free(p); }
   };
   std::unique_ptr<uint8_t, FreeDeleter> ptr_;
 
+  // One entry per chunk slot. Slots covered by an oversized record point
+  // into the allocation owned by the first slot of that record.
+  std::vector<uint8_t*> chunks_;
+  // The chunks that were obtained from the recycling pool.
+  std::vector<uint8_t*> pooled_;
+  // The dedicated allocations made for records larger than a chunk.
+  std::vector<uint8_t*> oversized_;
+
+  DlStorageMode mode_ = DlStorageMode::kContiguous;
   size_t used_ = 0u;
   size_t allocated_ = 0u;
+  size_t allocation_count_ = 0u;
+  size_t copied_bytes_ = 0u;
 };
 
 }  // namespace flutter
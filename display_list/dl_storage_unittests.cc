@@ -43,5 +43,97 @@ TEST(DisplayListStorage, PostMove) {
   EXPECT_EQ(moved.capacity(), DisplayListStorage::kDLPageSize);
 }
 
+TEST(DisplayListStorage, ChunkedAllocation) {
+  DisplayListStorage storage(DlStorageMode::kChunked);
+  EXPECT_TRUE(storage.is_chunked());
+  EXPECT_EQ(storage.size(), 0u);
+  EXPECT_EQ(storage.capacity(), 0u);
+
+  uint8_t* first = storage.allocate(10u);
+  EXPECT_NE(first, nullptr);
+  EXPECT_EQ(storage.ptr(0u), first);
+  EXPECT_EQ(storage.size(), 10u);
+  EXPECT_EQ(storage.capacity(), DisplayListStorage::kDLChunkSize);
+}
+
+TEST(DisplayListStorage, ChunkedAllocationSkipsToNextChunk) {
+  DisplayListStorage storage(DlStorageMode::kChunked);
+  const size_t chunk_size = DisplayListStorage::kDLChunkSize;
+
+  uint8_t* first = storage.allocate(chunk_size - 8u);
+  first[0] = 42u;
+  uint8_t* second = storage.allocate(16u);
+  EXPECT_NE(second, nullptr);
+  EXPECT_EQ(storage.size(), chunk_size + 16u);
+  EXPECT_EQ(storage.ptr(chunk_size), second);
+  EXPECT_EQ(storage.capacity(), chunk_size * 2);
+
+  // Growing chunked storage must not move existing records.
+  EXPECT_EQ(storage.ptr(0u), first);
+  EXPECT_EQ(first[0], 42u);
+  EXPECT_EQ(storage.copied_bytes(), 0u);
+}
+
+TEST(DisplayListStorage, ChunkedOversizedAllocation) {
+  DisplayListStorage storage(DlStorageMode::kChunked);
+  const size_t chunk_size = DisplayListStorage::kDLChunkSize;
+
+  storage.allocate(16u);
+  uint8_t* big = storage.allocate(chunk_size * 2 + 16u);
+  EXPECT_NE(big, nullptr);
+  EXPECT_EQ(storage.ptr(chunk_size), big);
+  EXPECT_EQ(storage.capacity(), chunk_size * 4);
+  for (size_t i = 0; i < chunk_size * 2 + 16u; i++) {
+    EXPECT_EQ(big[i], 0u);
+  }
+}
+
+TEST(DisplayListStorage, ChunkedStorageRecyclesChunks) {
+  uint8_t* first;
+  {
+    DisplayListStorage storage(DlStorageMode::kChunked);
+    first = storage.allocate(10u);
+    first[0] = 42u;
+  }
+  DisplayListStorage storage(DlStorageMode::kChunked);
+  uint8_t* recycled = storage.allocate(10u);
+  EXPECT_EQ(recycled, first);
+  EXPECT_EQ(recycled[0], 0u);
+  EXPECT_EQ(storage.allocation_count(), 0u);
+}
+
+TEST(DisplayListStorage, ChunkedPostMove) {
+  DisplayListStorage original(DlStorageMode::kChunked);
+  uint8_t* ptr = original.allocate(10u);
+
+  DisplayListStorage moved = std::move(original);
+
+  // NOLINTBEGIN(bugprone-use-after-move)
+  // NOLINTBEGIN(clang-analyzer-cplusplus.Move)
+  EXPECT_EQ(original.size(), 0u);
+  EXPECT_EQ(original.capacity(), 0u);
+  // NOLINTEND(clang-analyzer-cplusplus.Move)
+  // NOLINTEND(bugprone-use-after-move)
+
+  EXPECT_TRUE(moved.is_chunked());
+  EXPECT_EQ(moved.ptr(0u), ptr);
+  EXPECT_EQ(moved.size(), 10u);
+  EXPECT_EQ(moved.capacity(), DisplayListStorage::kDLChunkSize);
+}
+
+TEST(DisplayListStorage, BytesEqualAcrossModes) {
+  DisplayListStorage contiguous;
+  DisplayListStorage chunked(DlStorageMode::kChunked);
+  uint8_t* a = contiguous.allocate(64u);
+  uint8_t* b = chunked.allocate(64u);
+  for (int i = 0; i < 64; i++) {
+    a[i] = b[i] = static_cast<uint8_t>(i);
+  }
+  EXPECT_TRUE(DisplayListStorage::BytesEqual(contiguous, chunked, 0u, 64u));
+  b[63] = 0u;
+  EXPECT_TRUE(DisplayListStorage::BytesEqual(contiguous, chunked, 0u, 63u));
+  EXPECT_FALSE(DisplayListStorage::BytesEqual(contiguous, chunked, 0u, 64u));
+}
+
 }  // namespace testing
 }  // namespace flutter
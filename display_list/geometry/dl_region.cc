@@ -414,10 +414,28 @@ DlRegion DlRegion::MakeUnion(const DlRegion& a, const DlRegion& b) {
   }
 
   DlRegion res;
-  res.bounds_ = a.bounds_;
-  res.bounds_.join(b.bounds_);
   res.span_buffer_.reserve(a.span_buffer_.capacity() +
                            b.span_buffer_.capacity());
+  std::vector<Span> tmp;
+  unionInto(res, a, b, tmp);
+  return res;
+}
+
+void DlRegion::clearRetainingStorage() {
+  lines_.clear();
+  bounds_ = SkIRect::MakeEmpty();
+  span_buffer_.clear();
+}
+
+void DlRegion::unionInto(DlRegion& res,
+                         const DlRegion& a,
+                         const DlRegion& b,
+                         std::vector<Span>& tmp) {
+  FML_DCHECK(res.isEmpty());
+  FML_DCHECK(&res != &a && &res != &b);
+
+  res.bounds_ = a.bounds_;
+  res.bounds_.join(b.bounds_);
 
   auto& lines = res.lines_;
   lines.reserve(a.lines_.size() + b.lines_.size());
@@ -427,13 +445,9 @@ DlRegion DlRegion::MakeUnion(const DlRegion& a, const DlRegion& b) {
   auto a_end = a.lines_.end();
   auto b_end = b.lines_.end();
 
-  FML_DCHECK(a_it != a_end && b_it != b_end);
-
   auto& a_buffer = a.span_buffer_;
   auto& b_buffer = b.span_buffer_;
 
-  std::vector<Span> tmp;
-
   int32_t cur_top = std::numeric_limits<int32_t>::min();
 
   while (a_it != a_end && b_it != b_end) {
@@ -490,8 +504,6 @@ DlRegion DlRegion::MakeUnion(const DlRegion& a, const DlRegion& b) {
     res.appendLine(b_top, b_it->bottom, b_buffer, b_it->chunk_handle);
     ++b_it;
   }
-
-  return res;
 }
 
 DlRegion DlRegion::MakeIntersection(const DlRegion& a, const DlRegion& b) {
@@ -757,4 +769,71 @@ bool DlRegion::intersects(const DlRegion& region) const {
   return false;
 }
 
+void DlRegionAccumulator::addRect(const SkIRect& rect) {
+  if (rect.isEmpty()) {
+    return;
+  }
+  if (pending_rects_.empty() && region_.isSimple() &&
+      region_.bounds().contains(rect)) {
+    return;
+  }
+  pending_rects_.push_back(rect);
+  bounds_.join(rect);
+}
+
+void DlRegionAccumulator::addRegion(const DlRegion& region) {
+  if (region.isEmpty()) {
+    return;
+  }
+  resolve();
+  merge(region);
+  bounds_.join(region.bounds());
+}
+
+const DlRegion& DlRegionAccumulator::region() {
+  resolve();
+  FML_DCHECK(region_.bounds() == bounds_);
+  return region_;
+}
+
+bool DlRegionAccumulator::intersects(const SkIRect& rect) {
+  if (!SkIRect::Intersects(bounds_, rect)) {
+    return false;
+  }
+  return region().intersects(rect);
+}
+
+bool DlRegionAccumulator::intersects(const DlRegion& region) {
+  if (!SkIRect::Intersects(bounds_, region.bounds())) {
+    return false;
+  }
+  return this->region().intersects(region);
+}
+
+void DlRegionAccumulator::reset() {
+  pending_rects_.clear();
+  bounds_ = SkIRect::MakeEmpty();
+  region_.clearRetainingStorage();
+}
+
+void DlRegionAccumulator::resolve() {
+  if (pending_rects_.empty()) {
+    return;
+  }
+  pending_region_.clearRetainingStorage();
+  pending_region_.setRects(pending_rects_);
+  pending_rects_.clear();
+  merge(pending_region_);
+}
+
+void DlRegionAccumulator::merge(const DlRegion& other) {
+  if (!region_.isEmpty() && region_.isSimple() &&
+      region_.bounds().contains(other.bounds())) {
+    return;
+  }
+  merged_region_.clearRetainingStorage();
+  DlRegion::unionInto(merged_region_, region_, other, tmp_spans_);
+  std::swap(region_, merged_region_);
+}
+
 }  // namespace flutter
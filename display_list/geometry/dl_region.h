@@ -69,6 +69,8 @@ class DlRegion {
   bool isSimple() const { return !isComplex(); }
 
  private:
+  friend class DlRegionAccumulator;
+
   typedef std::uint32_t SpanChunkHandle;
 
   struct Span {
@@ -93,6 +95,9 @@ class DlRegion {
     void reserve(size_t capacity);
     size_t capacity() const { return capacity_; }
 
+    /// Discards all chunks while keeping the allocated memory.
+    void clear() { size_ = 0; }
+
     SpanChunkHandle storeChunk(const Span* begin, const Span* end);
     size_t getChunkSize(SpanChunkHandle handle) const;
     void getSpans(SpanChunkHandle handle,
@@ -120,6 +125,18 @@ class DlRegion {
 
   void setRects(const std::vector<SkIRect>& rects);
 
+  /// Empties the region while keeping the memory allocated for its lines
+  /// and spans so that it can be rebuilt without allocating.
+  void clearRetainingStorage();
+
+  /// Stores the union of regions a and b in res, which must be empty and
+  /// must not be either of a or b. |tmp| is used as scratch space for the
+  /// spans of merged lines.
+  static void unionInto(DlRegion& res,
+                        const DlRegion& a,
+                        const DlRegion& b,
+                        std::vector<Span>& tmp);
+
   void appendLine(int32_t top,
                   int32_t bottom,
                   const Span* begin,
@@ -168,6 +185,70 @@ class DlRegion {
   SpanBuffer span_buffer_;
 };
 
+/// Accumulates the union of many rectangles and regions into a single
+/// DlRegion.
+///
+/// Unlike repeated calls to |DlRegion::MakeUnion|, which allocate a new
+/// region for every union, the accumulator batches the added rectangles
+/// and merges them into its region only when the region is needed. The
+/// memory used for the lines and spans of the region is kept across
+/// merges and across calls to |reset| so that an accumulator that is
+/// reused for every frame stops allocating once it has warmed up.
+class DlRegionAccumulator {
+ public:
+  DlRegionAccumulator() = default;
+
+  DlRegionAccumulator(DlRegionAccumulator&&) = default;
+  DlRegionAccumulator& operator=(DlRegionAccumulator&&) = default;
+
+  /// Adds the area of the rectangle to the accumulated region.
+  void addRect(const SkIRect& rect);
+
+  /// Adds the area of the region to the accumulated region.
+  void addRegion(const DlRegion& region);
+
+  /// Returns the union of everything added since construction or the
+  /// last call to |reset|.
+  ///
+  /// The returned reference is invalidated by the next call to any of
+  /// the non-const methods of the accumulator.
+  const DlRegion& region();
+
+  /// Returns the bounds of the accumulated region, which is kept up to
+  /// date without merging the pending rectangles.
+  const SkIRect& bounds() const { return bounds_; }
+
+  /// Returns true if nothing (or only empty rectangles) has been added.
+  bool isEmpty() const { return bounds_.isEmpty(); }
+
+  /// Returns whether the accumulated region intersects the rectangle.
+  bool intersects(const SkIRect& rect);
+
+  /// Returns whether the accumulated region intersects the region.
+  bool intersects(const DlRegion& region);
+
+  /// Empties the accumulator while keeping its memory for reuse.
+  void reset();
+
+ private:
+  /// Merges the pending rectangles into |region_|.
+  void resolve();
+
+  /// Replaces |region_| with its union with |other|.
+  void merge(const DlRegion& other);
+
+  std::vector<SkIRect> pending_rects_;
+  SkIRect bounds_ = SkIRect::MakeEmpty();
+
+  DlRegion region_;
+  // Holds the region built from the pending rects before it is merged.
+  DlRegion pending_region_;
+  // Receives the result of a merge, after which it is swapped with
+  // |region_| so that the storage of both is recycled.
+  DlRegion merged_region_;
+  std::vector<DlRegion::Span> tmp_spans_;
+};
+
 }  // namespace flutter
 
 #endif  // FLUTTER_DISPLAY_LIST_GEOMETRY_DL_REGION_H_
@@ -429,5 +429,80 @@ TEST(DisplayListRegion, TestAgainstSkRegion) {
   }
 }
 
+TEST(DisplayListRegion, AccumulatorEmpty) {
+  DlRegionAccumulator accumulator;
+  EXPECT_TRUE(accumulator.isEmpty());
+  accumulator.addRect(SkIRect::MakeEmpty());
+  accumulator.addRegion(DlRegion());
+  EXPECT_TRUE(accumulator.isEmpty());
+  EXPECT_TRUE(accumulator.region().isEmpty());
+  EXPECT_EQ(accumulator.bounds(), SkIRect::MakeEmpty());
+  EXPECT_FALSE(accumulator.intersects(SkIRect::MakeWH(10, 10)));
+}
+
+TEST(DisplayListRegion, AccumulatorMatchesSkRegion) {
+  std::seed_seq seed{::testing::UnitTest::GetInstance()->random_seed()};
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution pos(0, 4000);
+  std::uniform_int_distribution size(1, 400);
+
+  DlRegionAccumulator accumulator;
+  // The second round verifies that a reset accumulator is still valid.
+  for (int round = 0; round < 2; round++) {
+    accumulator.reset();
+    EXPECT_TRUE(accumulator.isEmpty());
+    SkRegion sk_region;
+    for (int batch = 0; batch < 20; batch++) {
+      // Alternate between adding loose rects and whole regions and
+      // query the accumulated region in between.
+      std::vector<SkIRect> rects;
+      for (int i = 0; i < 25; i++) {
+        rects.push_back(
+            SkIRect::MakeXYWH(pos(rng), pos(rng), size(rng), size(rng)));
+      }
+      if (batch % 2 == 0) {
+        for (const auto& rect : rects) {
+          accumulator.addRect(rect);
+        }
+      } else {
+        accumulator.addRegion(DlRegion(rects));
+      }
+      for (const auto& rect : rects) {
+        sk_region.op(rect, SkRegion::kUnion_Op);
+      }
+      EXPECT_EQ(accumulator.bounds(), sk_region.getBounds());
+      CheckEquality(accumulator.region(), sk_region);
+
+      auto probe = SkIRect::MakeXYWH(pos(rng), pos(rng), 50, 50);
+      EXPECT_EQ(accumulator.intersects(probe), sk_region.intersects(probe));
+    }
+  }
+}
+
+TEST(DisplayListRegion, AccumulatorMatchesMakeUnion) {
+  std::vector<SkIRect> rects{
+      SkIRect::MakeLTRB(0, 0, 10, 10),
+      SkIRect::MakeLTRB(5, 5, 20, 20),
+      SkIRect::MakeLTRB(30, 0, 40, 40),
+      SkIRect::MakeLTRB(0, 30, 40, 35),
+  };
+  DlRegion expected;
+  DlRegionAccumulator accumulator;
+  for (const auto& rect : rects) {
+    expected = DlRegion::MakeUnion(expected, DlRegion(rect));
+    accumulator.addRect(rect);
+  }
+  EXPECT_EQ(accumulator.region().getRects(false), expected.getRects(false));
+  EXPECT_EQ(accumulator.region().getRects(true), expected.getRects(true));
+
+  // Rectangles inside of a simple accumulated region change nothing.
+  DlRegionAccumulator simple;
+  simple.addRect(SkIRect::MakeLTRB(0, 0, 100, 100));
+  EXPECT_TRUE(simple.region().isSimple());
+  simple.addRect(SkIRect::MakeLTRB(10, 10, 20, 20));
+  EXPECT_TRUE(simple.region().isSimple());
+  EXPECT_EQ(simple.bounds(), SkIRect::MakeLTRB(0, 0, 100, 100));
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -5,15 +5,29 @@
 #include "flutter/display_list/geometry/dl_rtree.h"
 #include "flutter/display_list/geometry/dl_region.h"
 
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
 #include "flutter/fml/logging.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DL_RTREE_USE_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define DL_RTREE_USE_NEON 1
+#endif
+
 namespace flutter {
 
 DlRTree::DlRTree(const SkRect rects[],
                  int N,
                  const int ids[],
                  bool p(int),
-                 int invalid_id)
+                 int invalid_id,
+                 BuildStrategy strategy)
     : invalid_id_(invalid_id) {
   if (N <= 0) {
     FML_DCHECK(N >= 0);
@@ -61,6 +75,11 @@ DlRTree::DlRTree(const SkRect rects[],
   }
   FML_DCHECK(leaf_index == leaf_count);
 
+  if (strategy == BuildStrategy::kSortTileRecursive &&
+      leaf_count > kMaxChildren) {
+    computeSortTileRecursiveOrder();
+  }
+
   // --- Implementation note ---
   // Many R-Tree algorithms attempt to consolidate nearby rectangles
   // into branches of the tree in order to maximize the benefit of
@@ -77,6 +96,11 @@ DlRTree::DlRTree(const SkRect rects[],
   // are likely nearly sorted when they are delivered to this constructor
   // so leaving them in their original order should show similar results
   // to what Skia found in their empirical browser tests.
+  //
+  // Content that is scattered across the page (maps, charts, particle
+  // effects) does not fit that model, so callers can request a bulk load
+  // which only reorders the leaf level before the grouping below.
+  // @see |computeSortTileRecursiveOrder|
   // ---
 
   // Continually process the previous level (generation) of nodes,
@@ -127,8 +151,13 @@ DlRTree::DlRTree(const SkRect rects[],
         parent->child.count = 0;
       }
       FML_DCHECK(parent != nullptr);
-      parent->bounds.join(nodes_[sibling_index++].bounds);
+      uint32_t node_index =
+          sibling_index < static_cast<uint32_t>(leaf_count_)
+              ? leafAt(sibling_index)
+              : sibling_index;
+      parent->bounds.join(nodes_[node_index].bounds);
       parent->child.count++;
+      sibling_index++;
     }
     FML_DCHECK(D == 0);
     FML_DCHECK(sibling_index == gen_end);
@@ -137,10 +166,96 @@ DlRTree::DlRTree(const SkRect rects[],
     gen_count = family_count;
   }
   FML_DCHECK(gen_start + gen_count == total_node_count);
+
+  // Copy the bounds into the tree ordered arrays used by the searches,
+  // padding them so that the last group of 4 can always be loaded.
+  size_t padded_count = total_node_count + 3u;
+  lefts_.resize(padded_count);
+  tops_.resize(padded_count);
+  rights_.resize(padded_count);
+  bottoms_.resize(padded_count);
+  for (uint32_t i = 0; i < total_node_count; i++) {
+    uint32_t node_index =
+        i < static_cast<uint32_t>(leaf_count_) ? leafAt(i) : i;
+    const SkRect& bounds = nodes_[node_index].bounds;
+    lefts_[i] = bounds.fLeft;
+    tops_[i] = bounds.fTop;
+    rights_[i] = bounds.fRight;
+    bottoms_[i] = bounds.fBottom;
+  }
 }
 
-void DlRTree::search(const SkRect& query, std::vector<int>* results) const {
-  FML_DCHECK(results != nullptr);
+void DlRTree::computeSortTileRecursiveOrder() {
+  // Sort-Tile-Recursive: sort the leaves by the horizontal center of
+  // their bounds, cut them into roughly sqrt(groups) vertical slices,
+  // and sort each slice by the vertical center so that the consecutive
+  // runs of leaves grouped into parents below form compact tiles.
+  uint32_t leaf_count = leaf_count_;
+  std::vector<SkPoint> centers(leaf_count);
+  for (uint32_t i = 0; i < leaf_count; i++) {
+    centers[i] = nodes_[i].bounds.center();
+  }
+  leaf_order_.resize(leaf_count);
+  std::iota(leaf_order_.begin(), leaf_order_.end(), 0u);
+  std::stable_sort(leaf_order_.begin(), leaf_order_.end(),
+                   [&centers](uint32_t a, uint32_t b) {
+                     return centers[a].fX < centers[b].fX;
+                   });
+
+  uint32_t group_count = (leaf_count + kMaxChildren - 1u) / kMaxChildren;
+  uint32_t slice_count =
+      static_cast<uint32_t>(std::ceil(std::sqrt(group_count)));
+  uint32_t slice_size =
+      ((group_count + slice_count - 1u) / slice_count) * kMaxChildren;
+  for (uint32_t start = 0; start < leaf_count; start += slice_size) {
+    uint32_t end = std::min(start + slice_size, leaf_count);
+    std::stable_sort(leaf_order_.begin() + start, leaf_order_.begin() + end,
+                     [&centers](uint32_t a, uint32_t b) {
+                       return centers[a].fY < centers[b].fY;
+                     });
+  }
+}
+
+uint32_t DlRTree::intersectMask4(uint32_t index, const SkRect& query) const {
+  FML_DCHECK(index + 4u <= lefts_.size());
+#if defined(DL_RTREE_USE_SSE2)
+  __m128 l = _mm_loadu_ps(lefts_.data() + index);
+  __m128 t = _mm_loadu_ps(tops_.data() + index);
+  __m128 r = _mm_loadu_ps(rights_.data() + index);
+  __m128 b = _mm_loadu_ps(bottoms_.data() + index);
+  __m128 horizontal = _mm_and_ps(_mm_cmplt_ps(l, _mm_set1_ps(query.fRight)),
+                                 _mm_cmplt_ps(_mm_set1_ps(query.fLeft), r));
+  __m128 vertical = _mm_and_ps(_mm_cmplt_ps(t, _mm_set1_ps(query.fBottom)),
+                               _mm_cmplt_ps(_mm_set1_ps(query.fTop), b));
+  return static_cast<uint32_t>(
+      _mm_movemask_ps(_mm_and_ps(horizontal, vertical)));
+#elif defined(DL_RTREE_USE_NEON)
+  float32x4_t l = vld1q_f32(lefts_.data() + index);
+  float32x4_t t = vld1q_f32(tops_.data() + index);
+  float32x4_t r = vld1q_f32(rights_.data() + index);
+  float32x4_t b = vld1q_f32(bottoms_.data() + index);
+  uint32x4_t horizontal = vandq_u32(vcltq_f32(l, vdupq_n_f32(query.fRight)),
+                                    vcltq_f32(vdupq_n_f32(query.fLeft), r));
+  uint32x4_t vertical = vandq_u32(vcltq_f32(t, vdupq_n_f32(query.fBottom)),
+                                  vcltq_f32(vdupq_n_f32(query.fTop), b));
+  static const uint32_t kLaneBits[4] = {1u, 2u, 4u, 8u};
+  return vaddvq_u32(vandq_u32(vandq_u32(horizontal, vertical),
+                              vld1q_u32(kLaneBits)));
+#else
+  uint32_t mask = 0u;
+  for (uint32_t i = 0; i < 4u; i++) {
+    uint32_t j = index + i;
+    if (lefts_[j] < query.fRight && query.fLeft < rights_[j] &&
+        tops_[j] < query.fBottom && query.fTop < bottoms_[j]) {
+      mask |= 1u << i;
+    }
+  }
+  return mask;
+#endif
+}
+
+template <typename Sink>
+void DlRTree::searchRoot(const SkRect& query, Sink& sink) const {
   if (query.isEmpty()) {
     return;
   }
@@ -153,13 +268,30 @@ void DlRTree::search(const SkRect& query, std::vector<int>* results) const {
     if (nodes_.size() == 1) {
       FML_DCHECK(leaf_count_ == 1);
       // The root node is the only node and it is a leaf node
-      results->push_back(0);
+      sink(0);
     } else {
-      search(root, query, results);
+      search(root, query, sink);
     }
   }
 }
 
+void DlRTree::search(const SkRect& query, std::vector<int>* results) const {
+  FML_DCHECK(results != nullptr);
+  size_t start = results->size();
+  auto sink = [results](int index) { results->push_back(index); };
+  searchRoot(query, sink);
+  if (!leaf_order_.empty()) {
+    // A bulk loaded tree produces its results in spatial order, but
+    // callers rely on them being in insertion order.
+    std::sort(results->begin() + start, results->end());
+  }
+}
+
+void DlRTree::searchEach(const SkRect& query,
+                         const std::function<void(int)>& visitor) const {
+  searchRoot(query, visitor);
+}
+
 std::list<SkRect> DlRTree::searchAndConsolidateRects(const SkRect& query,
                                                      bool deband) const {
   // Get the indexes for the operations that intersect with the query rect.
@@ -183,19 +315,28 @@ std::list<SkRect> DlRTree::searchAndConsolidateRects(const SkRect& query,
   return final_results;
 }
 
+template <typename Sink>
 void DlRTree::search(const Node& parent,
                      const SkRect& query,
-                     std::vector<int>* results) const {
+                     Sink& sink) const {
   // Caller protects against empty query
-  int start = parent.child.index;
-  int end = start + parent.child.count;
-  for (int i = start; i < end; i++) {
-    const Node& node = nodes_[i];
-    if (node.bounds.intersects(query)) {
-      if (i < leaf_count_) {
-        results->push_back(i);
-      } else {
-        search(node, query, results);
+  uint32_t start = parent.child.index;
+  uint32_t end = start + parent.child.count;
+  // All children of a node belong to the same generation so they are
+  // either all leaves or all internal nodes.
+  bool leaves = start < static_cast<uint32_t>(leaf_count_);
+  for (uint32_t i = start; i < end; i += 4u) {
+    uint32_t mask = intersectMask4(i, query);
+    if (end - i < 4u) {
+      mask &= (1u << (end - i)) - 1u;
+    }
+    for (uint32_t lane = 0; mask != 0u; lane++, mask >>= 1) {
+      if (mask & 1u) {
+        if (leaves) {
+          sink(leafAt(i + lane));
+        } else {
+          search(nodes_[i + lane], query, sink);
+        }
       }
     }
   }
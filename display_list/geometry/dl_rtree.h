@@ -5,6 +5,7 @@
 #ifndef FLUTTER_DISPLAY_LIST_GEOMETRY_DL_RTREE_H_
 #define FLUTTER_DISPLAY_LIST_GEOMETRY_DL_RTREE_H_
 
+#include <functional>
 #include <list>
 #include <optional>
 #include <vector>
@@ -30,8 +31,12 @@ class DlRTree : public SkRefCnt {
  private:
   static constexpr int kMaxChildren = 11;
 
-  // Leaf nodes at start of vector have an ID,
-  // Internal nodes after that have child index and count.
+  // Leaf nodes at start of vector have an ID, in the order in which they
+  // were passed to the constructor.
+  // Internal nodes after that have child index and count. The child index
+  // refers to the tree layout of the nodes, which differs from the order
+  // of the leaf nodes only if the tree was bulk loaded.
+  // @see |leaf_order_|
   struct Node {
     SkRect bounds;
     union {
@@ -44,6 +49,20 @@ class DlRTree : public SkRefCnt {
   };
 
  public:
+  /// The strategy used to group the leaf rectangles into the internal
+  /// nodes of the R-Tree.
+  enum class BuildStrategy {
+    /// Groups the rectangles in the order in which they were provided,
+    /// which is cheap to build and works well for rendering operations
+    /// that proceed in a "page layout" fashion.
+    kInsertionOrder,
+
+    /// Groups the rectangles spatially using a Sort-Tile-Recursive bulk
+    /// load, which costs more to build but produces much tighter internal
+    /// nodes for scattered rectangles such as those of maps and charts.
+    kSortTileRecursive,
+  };
+
   /// Construct an R-Tree from the list of rectangles respecting the
   /// order in which they appear in the list. An optional array of
   /// IDs can be provided to tag each rectangle with information needed
@@ -61,12 +80,16 @@ class DlRTree : public SkRefCnt {
   /// Duplicate rectangles and IDs are allowed and not processed in any
   /// way except to eliminate invalid rectangles and IDs that are rejected
   /// by the optional predicate function.
+  ///
+  /// The |strategy| only affects the speed of the construction and
+  /// searches, the results of the searches are the same either way.
   DlRTree(
       const SkRect rects[],
       int N,
       const int ids[] = nullptr,
       bool predicate(int id) = [](int) { return true; },
-      int invalid_id = -1);
+      int invalid_id = -1,
+      BuildStrategy strategy = BuildStrategy::kInsertionOrder);
 
   /// Search the rectangles and return a vector of leaf node indices for
   /// rectangles that intersect the query.
@@ -78,8 +101,21 @@ class DlRTree : public SkRefCnt {
   /// which they were passed into the constructor. The actual rectangle
   /// and ID associated with each index can be retrieved using the
   /// |DlRTree::id| and |DlRTree::bounds| methods.
+  ///
+  /// The results are appended to the vector so that callers can avoid
+  /// allocating on every search by clearing and reusing the same vector.
   void search(const SkRect& query, std::vector<int>* results) const;
 
+  /// Search the rectangles and invoke the |visitor| with the leaf node
+  /// index of each rectangle that intersects the query without storing
+  /// the results.
+  ///
+  /// The indices are visited in the same order that |search| would return
+  /// them if the tree was built in insertion order. If the tree was bulk
+  /// loaded, they are visited in the spatial order of the tree instead.
+  void searchEach(const SkRect& query,
+                  const std::function<void(int)>& visitor) const;
+
   /// Return the ID for the indicated result of a query or
   /// invalid_id if the index is not a valid leaf node index.
   int id(int result_index) const {
@@ -102,7 +138,10 @@ class DlRTree : public SkRefCnt {
 
   /// Returns the bytes used by the object and all of its node data.
   size_t bytes_used() const {
-    return sizeof(DlRTree) + sizeof(Node) * nodes_.size();
+    return sizeof(DlRTree) + sizeof(Node) * nodes_.size() +
+           sizeof(float) * (lefts_.size() + tops_.size() + rights_.size() +
+                            bottoms_.size()) +
+           sizeof(uint32_t) * leaf_order_.size();
   }
 
   /// Returns the number of leaf nodes corresponding to non-empty
@@ -139,11 +178,40 @@ class DlRTree : public SkRefCnt {
  private:
   static constexpr SkRect kEmpty = SkRect::MakeEmpty();
 
-  void search(const Node& parent,
-              const SkRect& query,
-              std::vector<int>* results) const;
+  template <typename Sink>
+  void search(const Node& parent, const SkRect& query, Sink& sink) const;
+
+  template <typename Sink>
+  void searchRoot(const SkRect& query, Sink& sink) const;
+
+  // Returns a bit mask of which of the 4 nodes, in tree layout order,
+  // starting at |index| intersect the query.
+  uint32_t intersectMask4(uint32_t index, const SkRect& query) const;
+
+  // Returns the index of the leaf node at the indicated position of the
+  // tree layout.
+  int leafAt(uint32_t tree_index) const {
+    return leaf_order_.empty() ? static_cast<int>(tree_index)
+                               : static_cast<int>(leaf_order_[tree_index]);
+  }
+
+  void computeSortTileRecursiveOrder();
 
   std::vector<Node> nodes_;
+
+  // The bounds of every node stored as a structure of arrays in tree
+  // layout order so that 4 sibling nodes can be tested against a query
+  // at once. Each array is padded so that 4 values can always be loaded.
+  std::vector<float> lefts_;
+  std::vector<float> tops_;
+  std::vector<float> rights_;
+  std::vector<float> bottoms_;
+
+  // The leaf node index of each leaf position of the tree layout if the
+  // tree was bulk loaded, or empty if the leaf nodes are laid out in
+  // insertion order.
+  std::vector<uint32_t> leaf_order_;
+
   int leaf_count_ = 0;
   int invalid_id_;
   mutable std::optional<DlRegion> region_;
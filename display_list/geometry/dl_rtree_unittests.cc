@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+
 #include "flutter/display_list/geometry/dl_rtree.h"
 #include "gtest/gtest.h"
 
@@ -319,5 +321,89 @@ TEST(DisplayListRTree, Region) {
   EXPECT_EQ(rects.size(), expected_rects.size());
 }
 
+TEST(DisplayListRTree, SortTileRecursiveMatchesInsertionOrder) {
+  // Scatter the rects so that the bulk loaded tree groups them very
+  // differently from the insertion order tree.
+  const int kCount = 5000;
+  std::vector<SkRect> rects;
+  std::vector<int> ids;
+  uint32_t seed = 12345u;
+  auto next = [&seed]() {
+    seed = seed * 1664525u + 1013904223u;
+    return static_cast<float>(seed >> 16) / 65536.0f;
+  };
+  for (int i = 0; i < kCount; i++) {
+    float x = next() * 2000.0f;
+    float y = next() * 2000.0f;
+    float w = 1.0f + next() * 40.0f;
+    float h = 1.0f + next() * 40.0f;
+    rects.push_back(SkRect::MakeXYWH(x, y, w, h));
+    // Every 7th id is filtered out by the predicate.
+    ids.push_back(i % 7 == 0 ? -1 : i);
+  }
+  auto predicate = [](int id) { return id >= 0; };
+  DlRTree ordered(rects.data(), kCount, ids.data(), predicate, -1,
+                  DlRTree::BuildStrategy::kInsertionOrder);
+  DlRTree bulk(rects.data(), kCount, ids.data(), predicate, -1,
+               DlRTree::BuildStrategy::kSortTileRecursive);
+  ASSERT_EQ(ordered.leaf_count(), bulk.leaf_count());
+  ASSERT_EQ(ordered.node_count(), bulk.node_count());
+  EXPECT_EQ(ordered.bounds(), bulk.bounds());
+
+  std::vector<int> ordered_results;
+  std::vector<int> bulk_results;
+  for (int i = 0; i < 200; i++) {
+    float x = next() * 2000.0f;
+    float y = next() * 2000.0f;
+    float size = 1.0f + next() * 300.0f;
+    auto query = SkRect::MakeXYWH(x, y, size, size);
+    ordered_results.clear();
+    bulk_results.clear();
+    ordered.search(query, &ordered_results);
+    bulk.search(query, &bulk_results);
+    ASSERT_EQ(ordered_results, bulk_results) << "query " << i;
+    for (int index : bulk_results) {
+      EXPECT_TRUE(bulk.bounds(index).intersects(query));
+      EXPECT_NE(bulk.id(index) % 7, 0);
+    }
+  }
+}
+
+TEST(DisplayListRTree, SearchAppendsToResults) {
+  SkRect rects[20];
+  for (int i = 0; i < 20; i++) {
+    rects[i] = SkRect::MakeXYWH(i * 10, 0, 5, 5);
+  }
+  DlRTree tree(rects, 20);
+  std::vector<int> results;
+  tree.search(SkRect::MakeLTRB(0, 0, 25, 5), &results);
+  tree.search(SkRect::MakeLTRB(180, 0, 200, 5), &results);
+  EXPECT_EQ(results, std::vector<int>({0, 1, 2, 18, 19}));
+}
+
+TEST(DisplayListRTree, SearchEachMatchesSearch) {
+  SkRect rects[100];
+  for (int i = 0; i < 100; i++) {
+    int x = (i % 10) * 10;
+    int y = (i / 10) * 10;
+    rects[i] = SkRect::MakeXYWH(x, y, 15, 15);
+  }
+  for (auto strategy : {DlRTree::BuildStrategy::kInsertionOrder,
+                        DlRTree::BuildStrategy::kSortTileRecursive}) {
+    DlRTree tree(rects, 100, nullptr, [](int) { return true; }, -1, strategy);
+    for (int i = 0; i < 10; i++) {
+      auto query = SkRect::MakeXYWH(i * 9, i * 7, 12, 23);
+      std::vector<int> results;
+      tree.search(query, &results);
+      std::vector<int> visited;
+      tree.searchEach(query, [&visited](int index) {  //
+        visited.push_back(index);
+      });
+      std::sort(visited.begin(), visited.end());
+      EXPECT_EQ(results, visited);
+    }
+  }
+}
+
 }  // namespace testing
 }  // namespace flutter
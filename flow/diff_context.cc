@@ -284,7 +284,8 @@ void DiffContext::Statistics::LogStatistics() {
                     deep_compare_pictures_, "SameInstancePictures",
                     same_instance_pictures_,
                     "DifferentInstanceButEqualPictures",
-                    different_instance_but_equal_pictures_);
+                    different_instance_but_equal_pictures_, "HashEqualPictures",
+                    hash_equal_pictures_);
 #endif  // !FLUTTER_RELEASE
 }
 
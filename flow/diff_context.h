@@ -192,6 +192,10 @@ class DiffContext {
       ++different_instance_but_equal_pictures_;
     };
 
+    // Picture that is a different instance and too large to compare, but
+    // was found to be equal by its content hash
+    void AddHashEqualPicture() { ++hash_equal_pictures_; }
+
     // Logs the statistics to trace counter
     void LogStatistics();
 
@@ -201,6 +205,7 @@ class DiffContext {
     int same_instance_pictures_ = 0;
     int deep_compare_pictures_ = 0;
     int different_instance_but_equal_pictures_ = 0;
+    int hash_equal_pictures_ = 0;
   };
 
   Statistics& statistics() { return statistics_; }
@@ -199,6 +199,16 @@ fml::Status FrameTimingsRecorder::RecordRasterStartImpl(
   return fml::Status();
 }
 
+void FrameTimingsRecorder::RecordPipelineStatistics(fml::TimeDelta age,
+                                                    size_t queued_frames,
+                                                    size_t dropped_frames) {
+  std::scoped_lock state_lock(state_mutex_);
+  FML_DCHECK(state_ < State::kRasterEnd);
+  pipeline_age_ = age;
+  pipeline_queued_frames_ = queued_frames;
+  pipeline_dropped_frames_ = dropped_frames;
+}
+
 FrameTiming FrameTimingsRecorder::RecordRasterEnd(const RasterCache* cache) {
   std::scoped_lock state_lock(state_mutex_);
   FML_DCHECK(state_ == State::kRasterStart);
@@ -227,6 +237,8 @@ FrameTiming FrameTimingsRecorder::RecordRasterEnd(const RasterCache* cache) {
   timing_.SetFrameNumber(GetFrameNumber());
   timing_.SetRasterCacheStatistics(layer_cache_count_, layer_cache_bytes_,
                                    picture_cache_count_, picture_cache_bytes_);
+  timing_.SetPipelineStatistics(pipeline_age_, pipeline_queued_frames_,
+                                pipeline_dropped_frames_);
   return timing_;
 }
 
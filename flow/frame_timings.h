@@ -99,6 +99,12 @@ class FrameTimingsRecorder {
   /// Records a raster start event.
   void RecordRasterStart(fml::TimePoint raster_start);
 
+  /// Records the statistics of the frame pipeline at the time the frame was
+  /// taken from it, to be reported in the `FrameTiming` of the frame.
+  void RecordPipelineStatistics(fml::TimeDelta age,
+                                size_t queued_frames,
+                                size_t dropped_frames);
+
   /// Clones the recorder until (and including) the specified state.
   std::unique_ptr<FrameTimingsRecorder> CloneUntil(State state);
 
@@ -158,6 +164,10 @@ class FrameTimingsRecorder {
   size_t picture_cache_count_;
   size_t picture_cache_bytes_;
 
+  fml::TimeDelta pipeline_age_;
+  size_t pipeline_queued_frames_ = 0;
+  size_t pipeline_dropped_frames_ = 0;
+
   // Set when `RecordRasterEnd` is called. Cannot be reset once set.
   FrameTiming timing_;
 
@@ -125,6 +125,25 @@ TEST(FrameTimingsRecorderTest, RecordRasterTimesWithCache) {
 #if !defined(OS_FUCHSIA) && !defined(FML_OS_WIN) && \
     (FLUTTER_RUNTIME_MODE == FLUTTER_RUNTIME_MODE_DEBUG)
 
+TEST(FrameTimingsRecorderTest, RecordPipelineStatistics) {
+  auto recorder = std::make_unique<FrameTimingsRecorder>();
+
+  const auto st = fml::TimePoint::Now();
+  const auto en = st + fml::TimeDelta::FromMillisecondsF(16);
+  recorder->RecordVsync(st, en);
+  recorder->RecordBuildStart(st);
+  recorder->RecordBuildEnd(st);
+
+  const auto age = fml::TimeDelta::FromMillisecondsF(5);
+  recorder->RecordPipelineStatistics(age, 1u, 2u);
+  recorder->RecordRasterStart(fml::TimePoint::Now());
+  const auto timing = recorder->RecordRasterEnd();
+
+  ASSERT_EQ(timing.GetPipelineAge(), age);
+  ASSERT_EQ(timing.GetPipelineQueuedFrames(), 1u);
+  ASSERT_EQ(timing.GetPipelineDroppedFrames(), 2u);
+}
+
 TEST(FrameTimingsRecorderTest, ThrowWhenRecordBuildBeforeVsync) {
   auto recorder = std::make_unique<FrameTimingsRecorder>();
 
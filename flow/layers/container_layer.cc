@@ -105,6 +105,76 @@ void ContainerLayer::DiffChildren(DiffContext* context,
 
 void ContainerLayer::Add(std::shared_ptr<Layer> layer) {
   layers_.emplace_back(std::move(layer));
+  retained_preroll_.valid = false;
+}
+
+void ContainerLayer::PrerollRetained(PrerollContext* context) {
+  if (!context->reuse_retained_subtrees) {
+    Preroll(context);
+    return;
+  }
+
+  const SkM44 transform = context->state_stack.transform_4x4();
+  const SkRect device_cull_rect = context->state_stack.device_cull_rect();
+  bool raster_cache_enabled = false;
+#if !SLIMPELLER
+  raster_cache_enabled = context->raster_cache != nullptr;
+#endif  //  !SLIMPELLER
+  if (retained_preroll_.valid) {
+    if (retained_preroll_.transform == transform &&
+        retained_preroll_.device_cull_rect == device_cull_rect &&
+        retained_preroll_.raster_cache_enabled == raster_cache_enabled) {
+      // The paint bounds and other results of the previous Preroll are
+      // still held by the layers of the subtree, only the outputs that
+      // were reported through the context need to be replayed.
+      context->has_texture_layer = retained_preroll_.has_texture_layer;
+      context->surface_needs_readback =
+          context->surface_needs_readback ||
+          retained_preroll_.surface_needs_readback;
+      context->renderable_state_flags =
+          retained_preroll_.renderable_state_flags;
+      context->retained_subtree_hits++;
+      return;
+    }
+    context->retained_subtree_misses++;
+  }
+
+  // Isolate the readback requirement of this subtree so that it can be
+  // replayed on its own in a later frame.
+  bool parent_needs_readback = context->surface_needs_readback;
+  context->surface_needs_readback = false;
+#if !SLIMPELLER
+  size_t cached_entries = context->raster_cached_entries
+                              ? context->raster_cached_entries->size()
+                              : 0u;
+#endif  //  !SLIMPELLER
+
+  Preroll(context);
+
+  // Subtrees containing platform views must be prerolled every frame so
+  // that the embedder sees them, and subtrees that registered raster cache
+  // entries must be prerolled so that those entries are marked as used.
+  bool reusable = !context->has_platform_view;
+#if !SLIMPELLER
+  if (raster_cache_enabled) {
+    reusable = reusable && context->raster_cached_entries &&
+               context->raster_cached_entries->size() == cached_entries;
+  }
+#endif  //  !SLIMPELLER
+  // |Preroll| invalidated |retained_preroll_| in |PrerollChildren|.
+  if (reusable) {
+    retained_preroll_ = {
+        .valid = true,
+        .transform = transform,
+        .device_cull_rect = device_cull_rect,
+        .raster_cache_enabled = raster_cache_enabled,
+        .has_texture_layer = context->has_texture_layer,
+        .surface_needs_readback = context->surface_needs_readback,
+        .renderable_state_flags = context->renderable_state_flags,
+    };
+  }
+  context->surface_needs_readback =
+      parent_needs_readback || context->surface_needs_readback;
 }
 
 void ContainerLayer::Preroll(PrerollContext* context) {
@@ -133,6 +203,9 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
   FML_DCHECK(!context->has_platform_view);
   FML_DCHECK(!context->has_texture_layer);
 
+  // The results of any previous Preroll are about to be replaced.
+  retained_preroll_.valid = false;
+
   bool child_has_platform_view = false;
   bool child_has_texture_layer = false;
   bool all_renderable_state_flags = LayerStateStack::kCallerCanApplyAnything;
@@ -148,7 +221,11 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
     // opt-in to applying state attributes during its |Preroll|
     context->renderable_state_flags = 0;
 
-    layer->Preroll(context);
+    if (layer->as_container_layer()) {
+      static_cast<ContainerLayer*>(layer.get())->PrerollRetained(context);
+    } else {
+      layer->Preroll(context);
+    }
 
     all_renderable_state_flags &= context->renderable_state_flags;
     if (safe_intersection_test(child_paint_bounds, layer->paint_bounds())) {
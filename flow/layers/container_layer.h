@@ -25,6 +25,16 @@ class ContainerLayer : public Layer {
 
   const std::vector<std::shared_ptr<Layer>>& layers() const { return layers_; }
 
+  // Prerolls this layer as a child of another container, reusing the
+  // results of its previous Preroll if it is being added again unchanged
+  // under the same transform and cull rect and the PrerollContext allows
+  // reusing retained subtrees.
+  //
+  // The reused results are only valid as long as the layers in this
+  // subtree are not prerolled in any other location in the meantime,
+  // which holds as a layer appears at most once in a layer tree.
+  void PrerollRetained(PrerollContext* context);
+
   virtual void DiffChildren(DiffContext* context,
                             const ContainerLayer* old_layer);
 
@@ -48,9 +58,22 @@ class ContainerLayer : public Layer {
   void PrerollChildren(PrerollContext* context, SkRect* child_paint_bounds);
 
  private:
+  // The state of the PrerollContext before and after the last Preroll of
+  // this layer that was performed by |PrerollRetained|.
+  struct RetainedPrerollState {
+    bool valid = false;
+    SkM44 transform;
+    SkRect device_cull_rect;
+    bool raster_cache_enabled = false;
+    bool has_texture_layer = false;
+    bool surface_needs_readback = false;
+    int renderable_state_flags = 0;
+  };
+
   std::vector<std::shared_ptr<Layer>> layers_;
   SkRect child_paint_bounds_;
   int children_renderable_state_flags_ = 0;
+  RetainedPrerollState retained_preroll_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ContainerLayer);
 };
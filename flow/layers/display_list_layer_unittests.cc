@@ -439,6 +439,39 @@ TEST_F(DisplayListLayerDiffTest, DisplayListCompare) {
   EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(20, 20, 70, 70));
 }
 
+TEST_F(DisplayListLayerDiffTest, LargeDisplayListCompareByContentHash) {
+  auto create_display_list = [](DlColor color) {
+    DisplayListBuilder builder;
+    for (int i = 0; i < 1000; i++) {
+      builder.DrawRect(SkRect::MakeLTRB(10, 10 + i * 0.01f, 60, 60),
+                       DlPaint(color));
+    }
+    return builder.Build();
+  };
+  auto display_list1 = create_display_list(DlColor::kGreen());
+  ASSERT_GT(display_list1->bytes(), DisplayListLayer::kMaxBytesToCompare);
+
+  MockLayerTree tree1;
+  tree1.root()->Add(CreateDisplayListLayer(display_list1));
+  auto damage = DiffLayerTree(tree1, MockLayerTree());
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(10, 10, 60, 60));
+
+  // An identical but separately recorded list is too large to compare op
+  // by op, so its matching content hash is trusted to mean that it did not
+  // change.
+  MockLayerTree tree2;
+  tree2.root()->Add(
+      CreateDisplayListLayer(create_display_list(DlColor::kGreen())));
+  damage = DiffLayerTree(tree2, tree1);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeEmpty());
+
+  MockLayerTree tree3;
+  tree3.root()->Add(
+      CreateDisplayListLayer(create_display_list(DlColor::kRed())));
+  damage = DiffLayerTree(tree3, tree2);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(10, 10, 60, 60));
+}
+
 TEST_F(DisplayListLayerTest, DisplayListAccessCountDependsOnVisibility) {
   const SkPoint layer_offset = SkPoint::Make(1.5f, -0.5f);
   const SkRect picture_bounds = SkRect::MakeLTRB(5.0f, 6.0f, 20.5f, 21.5f);
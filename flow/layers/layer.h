@@ -81,6 +81,17 @@ struct PrerollContext {
   int renderable_state_flags = 0;
 
   std::vector<RasterCacheItem*>* raster_cached_entries;
+
+  // Whether a |ContainerLayer| that is added to the tree again after being
+  // prerolled in a previous frame (a retained layer) may reuse the results
+  // of that Preroll instead of walking its subtree when it is prerolled
+  // under the same transform and cull rect.
+  bool reuse_retained_subtrees = false;
+
+  // The number of retained subtrees whose previous Preroll results were
+  // reused (hits) or had to be recomputed (misses) during this Preroll.
+  int retained_subtree_hits = 0;
+  int retained_subtree_misses = 0;
 };
 
 struct PaintContext {
@@ -56,10 +56,19 @@ bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
       .ui_time = frame.context().ui_time(),
       .texture_registry = frame.context().texture_registry(),
       .raster_cached_entries = &raster_cache_items_,
+      .reuse_retained_subtrees = true,
   };
 
   root_layer_->Preroll(&context);
 
+  retained_subtree_hits_ = context.retained_subtree_hits;
+  retained_subtree_misses_ = context.retained_subtree_misses;
+#if !FLUTTER_RELEASE
+  FML_TRACE_COUNTER("flutter", "RetainedSubtrees",
+                    reinterpret_cast<int64_t>(this), "Hits",
+                    retained_subtree_hits_, "Misses", retained_subtree_misses_);
+#endif  // !FLUTTER_RELEASE
+
   return context.surface_needs_readback;
 }
 
@@ -56,6 +56,11 @@ class LayerTree {
   const PaintRegionMap& paint_region_map() const { return paint_region_map_; }
   PaintRegionMap& paint_region_map() { return paint_region_map_; }
 
+  // The number of retained subtrees whose results from a previous frame
+  // were reused or had to be recomputed during the last |Preroll|.
+  int retained_subtree_hits() const { return retained_subtree_hits_; }
+  int retained_subtree_misses() const { return retained_subtree_misses_; }
+
  private:
   std::shared_ptr<Layer> root_layer_;
   SkISize frame_size_ = SkISize::MakeEmpty();  // Physical pixels.
@@ -64,6 +69,9 @@ class LayerTree {
 
   std::vector<RasterCacheItem*> raster_cache_items_;
 
+  int retained_subtree_hits_ = 0;
+  int retained_subtree_misses_ = 0;
+
   FML_DISALLOW_COPY_AND_ASSIGN(LayerTree);
 };
 
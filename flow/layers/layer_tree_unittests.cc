@@ -7,6 +7,7 @@
 
 #include "flutter/flow/compositor_context.h"
 #include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/flow/testing/mock_layer.h"
 #include "flutter/fml/macros.h"
@@ -210,6 +211,91 @@ TEST_F(LayerTreeTest, NeedsSystemComposite) {
   EXPECT_TRUE(DisplayListsEQ_Verbose(display_list(), expected_dl));
 }
 
+TEST_F(LayerTreeTest, RetainedSubtreeReusesPreroll) {
+  const SkPath child_path = SkPath().addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = std::make_shared<MockLayer>(child_path);
+  mock_layer->set_fake_reads_surface(true);
+  auto retained = std::make_shared<ContainerLayer>();
+  retained->Add(mock_layer);
+
+  auto root1 = std::make_shared<ContainerLayer>();
+  root1->Add(retained);
+  auto layer_tree1 = BuildLayerTree(root1);
+  EXPECT_TRUE(layer_tree1->Preroll(frame()));
+  EXPECT_EQ(layer_tree1->retained_subtree_hits(), 0);
+  EXPECT_EQ(layer_tree1->retained_subtree_misses(), 0);
+
+  // The framework adds the retained layer to a new tree unchanged.
+  auto root2 = std::make_shared<ContainerLayer>();
+  root2->Add(retained);
+  auto layer_tree2 = BuildLayerTree(root2);
+  EXPECT_TRUE(layer_tree2->Preroll(frame()));
+  EXPECT_EQ(layer_tree2->retained_subtree_hits(), 1);
+  EXPECT_EQ(layer_tree2->retained_subtree_misses(), 0);
+  EXPECT_EQ(root2->paint_bounds(), child_path.getBounds());
+
+  // Moving the retained layer under a new transform requires a new Preroll.
+  auto transform3 = std::make_shared<TransformLayer>(SkM44::Translate(5, 5));
+  transform3->Add(retained);
+  auto root3 = std::make_shared<ContainerLayer>();
+  root3->Add(transform3);
+  auto layer_tree3 = BuildLayerTree(root3);
+  EXPECT_TRUE(layer_tree3->Preroll(frame()));
+  EXPECT_EQ(layer_tree3->retained_subtree_hits(), 0);
+  EXPECT_EQ(layer_tree3->retained_subtree_misses(), 1);
+  EXPECT_EQ(mock_layer->parent_matrix(),
+            SkMatrix::Concat(root_transform(), SkMatrix::Translate(5, 5)));
+
+  // Both the new transform layer and the retained layer it contains are
+  // reused when the transform layer itself is retained.
+  auto root4 = std::make_shared<ContainerLayer>();
+  root4->Add(transform3);
+  auto layer_tree4 = BuildLayerTree(root4);
+  EXPECT_TRUE(layer_tree4->Preroll(frame()));
+  EXPECT_EQ(layer_tree4->retained_subtree_hits(), 1);
+  EXPECT_EQ(layer_tree4->retained_subtree_misses(), 0);
+}
+
+TEST_F(LayerTreeTest, RetainedSubtreeAddInvalidatesPreroll) {
+  const SkPath child_path1 = SkPath().addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  const SkPath child_path2 = SkPath().addRect(30.0f, 6.0f, 40.5f, 21.5f);
+  auto retained = std::make_shared<ContainerLayer>();
+  retained->Add(std::make_shared<MockLayer>(child_path1));
+
+  auto root1 = std::make_shared<ContainerLayer>();
+  root1->Add(retained);
+  auto layer_tree1 = BuildLayerTree(root1);
+  layer_tree1->Preroll(frame());
+  EXPECT_EQ(retained->paint_bounds(), child_path1.getBounds());
+
+  retained->Add(std::make_shared<MockLayer>(child_path2));
+  auto root2 = std::make_shared<ContainerLayer>();
+  root2->Add(retained);
+  auto layer_tree2 = BuildLayerTree(root2);
+  layer_tree2->Preroll(frame());
+  EXPECT_EQ(layer_tree2->retained_subtree_hits(), 0);
+  SkRect expected_bounds = child_path1.getBounds();
+  expected_bounds.join(child_path2.getBounds());
+  EXPECT_EQ(retained->paint_bounds(), expected_bounds);
+}
+
+TEST_F(LayerTreeTest, RetainedSubtreeWithPlatformViewIsNotReused) {
+  const SkPath child_path = SkPath().addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = std::make_shared<MockLayer>(child_path);
+  mock_layer->set_fake_has_platform_view(true);
+  auto retained = std::make_shared<ContainerLayer>();
+  retained->Add(mock_layer);
+
+  for (int i = 0; i < 2; i++) {
+    auto root = std::make_shared<ContainerLayer>();
+    root->Add(retained);
+    auto layer_tree = BuildLayerTree(root);
+    layer_tree->Preroll(frame());
+    EXPECT_EQ(layer_tree->retained_subtree_hits(), 0);
+    EXPECT_TRUE(root->subtree_has_platform_view());
+  }
+}
+
 TEST_F(LayerTreeTest, PrerollContextInitialization) {
   LayerStateStack state_stack;
   state_stack.set_preroll_delegate(kGiantRect, SkMatrix::I());
@@ -238,6 +324,10 @@ TEST_F(LayerTreeTest, PrerollContextInitialization) {
 
     EXPECT_EQ(context.renderable_state_flags, 0);
     EXPECT_EQ(context.raster_cached_entries, nullptr);
+
+    EXPECT_EQ(context.reuse_retained_subtrees, false);
+    EXPECT_EQ(context.retained_subtree_hits, 0);
+    EXPECT_EQ(context.retained_subtree_misses, 0);
   };
 
   // These 4 initializers are required because they are handled by reference
@@ -11,19 +11,27 @@
 
 namespace fml {
 
+namespace {
+
+// The loop and worker index of the current thread if it is a worker of a
+// |ConcurrentMessageLoop|.
+thread_local const void* tls_worker_loop = nullptr;
+thread_local size_t tls_worker_index = 0;
+
+}  // namespace
+
 ConcurrentMessageLoop::ConcurrentMessageLoop(size_t worker_count)
     : worker_count_(std::max<size_t>(worker_count, 1ul)) {
+  for (size_t i = 0; i < worker_count_; ++i) {
+    queues_.emplace_back(std::make_unique<WorkerQueue>());
+  }
   for (size_t i = 0; i < worker_count_; ++i) {
     workers_.emplace_back([i, this]() {
       fml::Thread::SetCurrentThreadName(fml::Thread::ThreadConfig(
           std::string{"io.worker." + std::to_string(i + 1)}));
-      WorkerMain();
+      WorkerMain(i);
     });
   }
-
-  for (const auto& worker : workers_) {
-    worker_thread_ids_.emplace_back(worker.get_id());
-  }
 }
 
 ConcurrentMessageLoop::~ConcurrentMessageLoop() {
@@ -47,69 +55,141 @@ void ConcurrentMessageLoop::PostTask(const fml::closure& task) {
     return;
   }
 
-  std::unique_lock lock(tasks_mutex_);
-
-  // Don't just drop tasks on the floor in case of shutdown.
-  if (shutdown_) {
-    FML_DLOG(WARNING)
-        << "Tried to post a task to shutdown concurrent message "
-           "loop. The task will be executed on the callers thread.";
-    lock.unlock();
-    ExecuteTask(task);
-    return;
+  // Tasks posted by a worker stay on that worker so that fan outs from a
+  // task don't contend with the other workers until they go idle.
+  size_t index = tls_worker_loop == this
+                     ? tls_worker_index
+                     : next_queue_.fetch_add(1, std::memory_order_relaxed) %
+                           worker_count_;
+  {
+    std::unique_lock lock(queues_[index]->mutex);
+    // Shutdown is checked under the queue lock so that the task is either
+    // queued before the workers see the shutdown, and is run by them, or is
+    // not queued at all.
+    if (shutdown_) {
+      lock.unlock();
+      // Don't just drop tasks on the floor in case of shutdown.
+      FML_DLOG(WARNING)
+          << "Tried to post a task to shutdown concurrent message "
+             "loop. The task will be executed on the callers thread.";
+      ExecuteTask(task);
+      return;
+    }
+    queues_[index]->tasks.push_back(task);
+    queued_tasks_.fetch_add(1);
   }
 
-  tasks_.push(task);
-
-  // Unlock the mutex before notifying the condition variable because that mutex
-  // has to be acquired on the other thread anyway. Waiting in this scope till
-  // it is acquired there is a pessimization.
-  lock.unlock();
-
-  tasks_condition_.notify_one();
+  WakeWorker();
 }
 
-void ConcurrentMessageLoop::WorkerMain() {
-  while (true) {
-    std::unique_lock lock(tasks_mutex_);
-    tasks_condition_.wait(lock, [&]() {
-      return !tasks_.empty() || shutdown_ || HasThreadTasksLocked();
-    });
+void ConcurrentMessageLoop::WorkerMain(size_t index) {
+  tls_worker_loop = this;
+  tls_worker_index = index;
 
-    // Shutdown cannot be read with the task mutex unlocked.
+  while (true) {
     bool shutdown_now = shutdown_;
-    fml::closure task;
-    std::vector<fml::closure> thread_tasks;
+    fml::closure task = TakeTask(index);
+    std::vector<fml::closure> thread_tasks = TakeThreadTasks(index);
 
-    if (!tasks_.empty()) {
-      task = tasks_.front();
-      tasks_.pop();
+    // Only one worker is woken at a time, so pass the wake on while there
+    // are tasks left for another worker.
+    if (task && queued_tasks_.load() > 0) {
+      WakeWorker();
     }
 
-    if (HasThreadTasksLocked()) {
-      thread_tasks = GetThreadTasksLocked();
-      FML_DCHECK(!HasThreadTasksLocked());
+    if (task || !thread_tasks.empty()) {
+      TRACE_EVENT0("flutter", "ConcurrentWorkerWake");
+      // Execute the primary task we woke up for.
+      if (task) {
+        ExecuteTask(task);
+      }
+
+      // Execute any thread tasks.
+      for (const auto& thread_task : thread_tasks) {
+        ExecuteTask(thread_task);
+      }
     }
 
-    // Don't hold onto the mutex while tasks are being executed as they could
-    // themselves try to post more tasks to the message loop.
-    lock.unlock();
-
-    TRACE_EVENT0("flutter", "ConcurrentWorkerWake");
-    // Execute the primary task we woke up for.
-    if (task) {
-      ExecuteTask(task);
+    // Keep running tasks until every task queued before the shutdown has
+    // been run.
+    if (shutdown_now && !task && thread_tasks.empty()) {
+      break;
     }
 
-    // Execute any thread tasks.
-    for (const auto& thread_task : thread_tasks) {
-      ExecuteTask(thread_task);
+    if (!task && thread_tasks.empty()) {
+      WaitForTasks(index);
     }
+  }
 
-    if (shutdown_now) {
-      break;
+  tls_worker_loop = nullptr;
+}
+
+fml::closure ConcurrentMessageLoop::TakeTask(size_t index) {
+  if (queued_tasks_.load() <= 0) {
+    return nullptr;
+  }
+
+  fml::closure task;
+  {
+    WorkerQueue& own = *queues_[index];
+    std::scoped_lock lock(own.mutex);
+    if (!own.tasks.empty()) {
+      task = std::move(own.tasks.front());
+      own.tasks.pop_front();
     }
   }
+  for (size_t i = 1; !task && i < worker_count_; ++i) {
+    WorkerQueue& victim = *queues_[(index + i) % worker_count_];
+    std::scoped_lock lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      task = std::move(victim.tasks.back());
+      victim.tasks.pop_back();
+    }
+  }
+  if (task) {
+    queued_tasks_.fetch_sub(1);
+  }
+  return task;
+}
+
+std::vector<fml::closure> ConcurrentMessageLoop::TakeThreadTasks(
+    size_t index) {
+  std::vector<fml::closure> thread_tasks;
+  std::scoped_lock lock(queues_[index]->mutex);
+  std::swap(thread_tasks, queues_[index]->thread_tasks);
+  return thread_tasks;
+}
+
+bool ConcurrentMessageLoop::HasThreadTasks(size_t index) {
+  std::scoped_lock lock(queues_[index]->mutex);
+  return !queues_[index]->thread_tasks.empty();
+}
+
+void ConcurrentMessageLoop::WaitForTasks(size_t index) {
+  std::unique_lock lock(sleep_mutex_);
+  // The count must be published before the predicate is checked. Posters
+  // queue their task before reading the count so either the predicate sees
+  // the task or the poster sees this worker and wakes it.
+  sleeping_workers_.fetch_add(1);
+  while (queued_tasks_.load() <= 0 && !shutdown_ && !HasThreadTasks(index)) {
+    sleep_condition_.wait(lock);
+    // Cleared before the checks so that a task queued by a poster that saw
+    // the flag still set is seen here.
+    waking_worker_ = false;
+  }
+  sleeping_workers_.fetch_sub(1);
+}
+
+void ConcurrentMessageLoop::WakeWorker() {
+  if (sleeping_workers_.load() == 0 || waking_worker_.exchange(true)) {
+    return;
+  }
+  std::scoped_lock lock(sleep_mutex_);
+  if (sleeping_workers_.load() == 0) {
+    waking_worker_ = false;
+    return;
+  }
+  sleep_condition_.notify_one();
 }
 
 void ConcurrentMessageLoop::ExecuteTask(const fml::closure& task) {
@@ -117,9 +197,16 @@ void ConcurrentMessageLoop::ExecuteTask(const fml::closure& task) {
 }
 
 void ConcurrentMessageLoop::Terminate() {
-  std::scoped_lock lock(tasks_mutex_);
-  shutdown_ = true;
-  tasks_condition_.notify_all();
+  {
+    std::vector<std::unique_lock<std::mutex>> queue_locks;
+    queue_locks.reserve(queues_.size());
+    for (const auto& queue : queues_) {
+      queue_locks.emplace_back(queue->mutex);
+    }
+    shutdown_ = true;
+  }
+  std::scoped_lock lock(sleep_mutex_);
+  sleep_condition_.notify_all();
 }
 
 void ConcurrentMessageLoop::PostTaskToAllWorkers(const fml::closure& task) {
@@ -127,24 +214,12 @@ void ConcurrentMessageLoop::PostTaskToAllWorkers(const fml::closure& task) {
     return;
   }
 
-  std::scoped_lock lock(tasks_mutex_);
-  for (const auto& worker_thread_id : worker_thread_ids_) {
-    thread_tasks_[worker_thread_id].emplace_back(task);
+  for (const auto& queue : queues_) {
+    std::scoped_lock lock(queue->mutex);
+    queue->thread_tasks.emplace_back(task);
   }
-  tasks_condition_.notify_all();
-}
-
-bool ConcurrentMessageLoop::HasThreadTasksLocked() const {
-  return thread_tasks_.count(std::this_thread::get_id()) > 0;
-}
-
-std::vector<fml::closure> ConcurrentMessageLoop::GetThreadTasksLocked() {
-  auto found = thread_tasks_.find(std::this_thread::get_id());
-  FML_DCHECK(found != thread_tasks_.end());
-  std::vector<fml::closure> pending_tasks;
-  std::swap(pending_tasks, found->second);
-  thread_tasks_.erase(found);
-  return pending_tasks;
+  std::scoped_lock lock(sleep_mutex_);
+  sleep_condition_.notify_all();
 }
 
 ConcurrentTaskRunner::ConcurrentTaskRunner(
@@ -170,13 +245,7 @@ void ConcurrentTaskRunner::PostTask(const fml::closure& task) {
 }
 
 bool ConcurrentMessageLoop::RunsTasksOnCurrentThread() {
-  std::scoped_lock lock(tasks_mutex_);
-  for (const auto& worker_thread_id : worker_thread_ids_) {
-    if (worker_thread_id == std::this_thread::get_id()) {
-      return true;
-    }
-  }
-  return false;
+  return tls_worker_loop == this;
 }
 
 }  // namespace fml
@@ -5,10 +5,13 @@
 #ifndef FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 #define FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 
+#include <atomic>
 #include <condition_variable>
-#include <map>
-#include <queue>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
@@ -18,6 +21,13 @@ namespace fml {
 
 class ConcurrentTaskRunner;
 
+/// A pool of worker threads that run the tasks posted to its task runners.
+///
+/// Each worker owns a queue of tasks. Tasks posted from a worker are queued
+/// on that worker and tasks posted from other threads are spread over the
+/// workers in turn. A worker that runs out of tasks steals the most recently
+/// queued tasks of the other workers before going to sleep, so no single lock
+/// is shared by all the workers and posters.
 class ConcurrentMessageLoop
     : public std::enable_shared_from_this<ConcurrentMessageLoop> {
  public:
@@ -30,6 +40,8 @@ class ConcurrentMessageLoop
 
   std::shared_ptr<ConcurrentTaskRunner> GetTaskRunner();
 
+  /// Stops the workers once they have run every task queued so far. Tasks
+  /// posted after this call are run on the posting thread.
   void Terminate();
 
   void PostTaskToAllWorkers(const fml::closure& task);
@@ -43,22 +55,50 @@ class ConcurrentMessageLoop
  private:
   friend ConcurrentTaskRunner;
 
+  struct WorkerQueue {
+    std::mutex mutex;
+    // Run from the front by the owning worker and stolen from the back by
+    // the other workers.
+    std::deque<fml::closure> tasks;
+    // Tasks posted via |PostTaskToAllWorkers|. These are never stolen.
+    std::vector<fml::closure> thread_tasks;
+  };
+
   size_t worker_count_ = 0;
   std::vector<std::thread> workers_;
-  std::mutex tasks_mutex_;
-  std::condition_variable tasks_condition_;
-  std::queue<fml::closure> tasks_;
-  std::vector<std::thread::id> worker_thread_ids_;
-  std::map<std::thread::id, std::vector<fml::closure>> thread_tasks_;
-  bool shutdown_ = false;
-
-  void WorkerMain();
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  // The queue that receives the next task posted from outside the workers.
+  std::atomic<size_t> next_queue_ = 0;
+  // The number of tasks in |queues_|, excluding thread tasks. This may be
+  // briefly off by one while a task is being queued or taken.
+  std::atomic<int64_t> queued_tasks_ = 0;
+  // The number of workers that are, or are about to be, waiting on
+  // |sleep_condition_|. Posters only take |sleep_mutex_| when this is
+  // non-zero.
+  std::atomic<size_t> sleeping_workers_ = 0;
+  // Set while a woken worker has yet to return from |WaitForTasks|. Waking
+  // one worker at a time, and having it pass the wake on once it has a
+  // task, avoids waking every sleeper for a burst of tasks that the awake
+  // workers would have taken anyway.
+  std::atomic<bool> waking_worker_ = false;
+  std::mutex sleep_mutex_;
+  std::condition_variable sleep_condition_;
+  // Only set while holding the mutex of every queue in |queues_|.
+  std::atomic<bool> shutdown_ = false;
+
+  void WorkerMain(size_t index);
 
   void PostTask(const fml::closure& task);
 
-  bool HasThreadTasksLocked() const;
+  fml::closure TakeTask(size_t index);
+
+  std::vector<fml::closure> TakeThreadTasks(size_t index);
+
+  bool HasThreadTasks(size_t index);
+
+  void WaitForTasks(size_t index);
 
-  std::vector<fml::closure> GetThreadTasksLocked();
+  void WakeWorker();
 
   FML_DISALLOW_COPY_AND_ASSIGN(ConcurrentMessageLoop);
 };
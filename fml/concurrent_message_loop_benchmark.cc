@@ -0,0 +1,96 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/concurrent_message_loop.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/task_group.h"
+
+namespace fml {
+namespace benchmarking {
+
+static constexpr size_t kWorkerCount = 4;
+static constexpr size_t kTaskCount = 10000;
+
+// Every task is posted from outside the loop.
+static void BM_ConcurrentPostSmallTasks(benchmark::State& state) {
+  auto loop = ConcurrentMessageLoop::Create(kWorkerCount);
+  auto task_runner = loop->GetTaskRunner();
+  const size_t producer_count = state.range(0);
+  for (auto _ : state) {
+    CountDownLatch latch(kTaskCount);
+    std::vector<std::thread> producers;
+    for (size_t i = 0; i < producer_count; i++) {
+      producers.emplace_back([&]() {
+        for (size_t j = 0; j < kTaskCount / producer_count; j++) {
+          task_runner->PostTask([&latch]() { latch.CountDown(); });
+        }
+      });
+    }
+    for (auto& producer : producers) {
+      producer.join();
+    }
+    latch.Wait();
+  }
+  state.SetItemsProcessed(state.iterations() * kTaskCount);
+}
+
+// Every task is posted by a task running on the loop, as happens when a
+// decode or compile job fans out into smaller jobs.
+static void BM_ConcurrentFanOutSmallTasks(benchmark::State& state) {
+  auto loop = ConcurrentMessageLoop::Create(kWorkerCount);
+  auto task_runner = loop->GetTaskRunner();
+  const size_t fan_out = state.range(0);
+  for (auto _ : state) {
+    // The outer tasks count down too so that none of them still holds a
+    // reference to the loop when the benchmark releases it.
+    CountDownLatch latch(kTaskCount + kTaskCount / fan_out);
+    for (size_t i = 0; i < kTaskCount / fan_out; i++) {
+      task_runner->PostTask([&]() {
+        for (size_t j = 0; j < fan_out; j++) {
+          task_runner->PostTask([&latch]() { latch.CountDown(); });
+        }
+        latch.CountDown();
+      });
+    }
+    latch.Wait();
+  }
+  state.SetItemsProcessed(state.iterations() * kTaskCount);
+}
+
+static void BM_ParallelForSmallTasks(benchmark::State& state) {
+  auto loop = ConcurrentMessageLoop::Create(kWorkerCount);
+  auto task_runner = loop->GetTaskRunner();
+  std::atomic<size_t> sum = 0;
+  for (auto _ : state) {
+    ParallelFor(task_runner, kTaskCount, [&](size_t index) {
+      sum.fetch_add(index, std::memory_order_relaxed);
+    });
+  }
+  benchmark::DoNotOptimize(sum.load());
+  state.SetItemsProcessed(state.iterations() * kTaskCount);
+}
+
+BENCHMARK(BM_ConcurrentPostSmallTasks)
+    ->Arg(1)
+    ->Arg(4)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ConcurrentFanOutSmallTasks)
+    ->Arg(10)
+    ->Arg(100)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ParallelForSmallTasks)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace benchmarking
+}  // namespace fml
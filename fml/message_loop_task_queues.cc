@@ -34,20 +34,41 @@ class TaskSourceGradeHolder {
 static thread_local std::unique_ptr<TaskSourceGradeHolder>
     tls_task_source_grade;
 
+struct TaskQueueEntry::PendingTask {
+  DelayedTask task;
+  PendingTask* next;
+};
+
+static int64_t ToTicks(fml::TimePoint time) {
+  return time.ToEpochDelta().ToNanoseconds();
+}
+
 TaskQueueEntry::TaskQueueEntry(TaskQueueId created_for_arg)
-    : subsumed_by(kUnmerged), created_for(created_for_arg) {
+    : subsumed_by(kUnmerged),
+      created_for(created_for_arg),
+      pending_tasks(nullptr),
+      scheduled_wake(ToTicks(fml::TimePoint::Max())) {
   wakeable = NULL;
   task_observers = TaskObservers();
   task_source = std::make_unique<TaskSource>(created_for);
 }
 
+TaskQueueEntry::~TaskQueueEntry() {
+  PendingTask* pending = pending_tasks.exchange(nullptr);
+  while (pending) {
+    PendingTask* next = pending->next;
+    delete pending;
+    pending = next;
+  }
+}
+
 MessageLoopTaskQueues* MessageLoopTaskQueues::GetInstance() {
   static MessageLoopTaskQueues* instance = new MessageLoopTaskQueues;
   return instance;
 }
 
 TaskQueueId MessageLoopTaskQueues::CreateTaskQueue() {
-  std::lock_guard guard(queue_mutex_);
+  std::unique_lock guard(queue_mutex_);
   TaskQueueId loop_id = TaskQueueId(task_queue_id_counter_);
   ++task_queue_id_counter_;
   queue_entries_[loop_id] = std::make_unique<TaskQueueEntry>(loop_id);
@@ -62,7 +83,7 @@ MessageLoopTaskQueues::MessageLoopTaskQueues() : order_(0) {
 MessageLoopTaskQueues::~MessageLoopTaskQueues() = default;
 
 void MessageLoopTaskQueues::Dispose(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
+  std::unique_lock guard(queue_mutex_);
   const auto& queue_entry = queue_entries_.at(queue_id);
   FML_DCHECK(queue_entry->subsumed_by == kUnmerged);
   auto& subsumed_set = queue_entry->owner_of;
@@ -74,10 +95,11 @@ void MessageLoopTaskQueues::Dispose(TaskQueueId queue_id) {
 }
 
 void MessageLoopTaskQueues::DisposeTasks(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
+  std::unique_lock guard(queue_mutex_);
   const auto& queue_entry = queue_entries_.at(queue_id);
   FML_DCHECK(queue_entry->subsumed_by == kUnmerged);
   auto& subsumed_set = queue_entry->owner_of;
+  MovePendingTasksUnlocked(queue_id);
   queue_entry->task_source->ShutDown();
   for (auto& subsumed : subsumed_set) {
     queue_entries_.at(subsumed)->task_source->ShutDown();
@@ -93,40 +115,50 @@ void MessageLoopTaskQueues::RegisterTask(
     const fml::closure& task,
     fml::TimePoint target_time,
     fml::TaskSourceGrade task_source_grade) {
-  std::lock_guard guard(queue_mutex_);
-  size_t order = order_++;
+  std::shared_lock guard(queue_mutex_);
   const auto& queue_entry = queue_entries_.at(queue_id);
-  queue_entry->task_source->RegisterTask(
-      {order, task, target_time, task_source_grade});
-  TaskQueueId loop_to_wake = queue_id;
-  if (queue_entry->subsumed_by != kUnmerged) {
-    loop_to_wake = queue_entry->subsumed_by;
+  auto* pending = new TaskQueueEntry::PendingTask{
+      {static_cast<size_t>(order_++), task, target_time, task_source_grade},
+      queue_entry->pending_tasks.load(std::memory_order_relaxed)};
+  while (!queue_entry->pending_tasks.compare_exchange_weak(pending->next,
+                                                           pending)) {
   }
 
-  // This can happen when the secondary tasks are paused.
-  if (HasPendingTasksUnlocked(loop_to_wake)) {
-    WakeUpUnlocked(loop_to_wake, GetNextWakeTimeUnlocked(loop_to_wake));
+  TaskQueueId loop_to_wake = GetOwnerUnlocked(queue_id);
+  const auto& wake_entry = queue_entries_.at(loop_to_wake);
+  // The owner moves this task into its task heaps when it wakes up for the
+  // wake up that is already scheduled. |UpdateWakeUpUnlocked| checks for
+  // pending tasks after publishing a later wake up so either it sees this
+  // task or this sees the later wake up.
+  if (ToTicks(target_time) >= wake_entry->scheduled_wake.load()) {
+    return;
   }
+  std::scoped_lock tasks_lock(wake_entry->tasks_mutex);
+  UpdateWakeUpUnlocked(loop_to_wake);
 }
 
 bool MessageLoopTaskQueues::HasPendingTasks(TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
+  std::shared_lock guard(queue_mutex_);
+  if (queue_entries_.at(queue_id)->subsumed_by != kUnmerged) {
+    return false;
+  }
+  std::scoped_lock tasks_lock(queue_entries_.at(queue_id)->tasks_mutex);
+  MovePendingTasksUnlocked(queue_id);
   return HasPendingTasksUnlocked(queue_id);
 }
 
 fml::closure MessageLoopTaskQueues::GetNextTaskToRun(TaskQueueId queue_id,
                                                      fml::TimePoint from_time) {
-  std::lock_guard guard(queue_mutex_);
-  if (!HasPendingTasksUnlocked(queue_id)) {
+  std::shared_lock guard(queue_mutex_);
+  if (queue_entries_.at(queue_id)->subsumed_by != kUnmerged) {
     return nullptr;
   }
-  TaskSource::TopTask top = PeekNextTaskUnlocked(queue_id);
-
+  std::scoped_lock tasks_lock(queue_entries_.at(queue_id)->tasks_mutex);
+  UpdateWakeUpUnlocked(queue_id);
   if (!HasPendingTasksUnlocked(queue_id)) {
-    WakeUpUnlocked(queue_id, fml::TimePoint::Max());
-  } else {
-    WakeUpUnlocked(queue_id, GetNextWakeTimeUnlocked(queue_id));
+    return nullptr;
   }
+  TaskSource::TopTask top = PeekNextTaskUnlocked(queue_id);
 
   if (top.task.GetTargetTime() > from_time) {
     return nullptr;
@@ -146,11 +178,13 @@ void MessageLoopTaskQueues::WakeUpUnlocked(TaskQueueId queue_id,
 }
 
 size_t MessageLoopTaskQueues::GetNumPendingTasks(TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
+  std::shared_lock guard(queue_mutex_);
   const auto& queue_entry = queue_entries_.at(queue_id);
   if (queue_entry->subsumed_by != kUnmerged) {
     return 0;
   }
+  std::scoped_lock tasks_lock(queue_entry->tasks_mutex);
+  MovePendingTasksUnlocked(queue_id);
 
   size_t total_tasks = 0;
   total_tasks += queue_entry->task_source->GetNumPendingTasks();
@@ -166,20 +200,20 @@ size_t MessageLoopTaskQueues::GetNumPendingTasks(TaskQueueId queue_id) const {
 void MessageLoopTaskQueues::AddTaskObserver(TaskQueueId queue_id,
                                             intptr_t key,
                                             const fml::closure& callback) {
-  std::lock_guard guard(queue_mutex_);
+  std::unique_lock guard(queue_mutex_);
   FML_DCHECK(callback != nullptr) << "Observer callback must be non-null.";
   queue_entries_.at(queue_id)->task_observers[key] = callback;
 }
 
 void MessageLoopTaskQueues::RemoveTaskObserver(TaskQueueId queue_id,
                                                intptr_t key) {
-  std::lock_guard guard(queue_mutex_);
+  std::unique_lock guard(queue_mutex_);
   queue_entries_.at(queue_id)->task_observers.erase(key);
 }
 
 std::vector<fml::closure> MessageLoopTaskQueues::GetObserversToNotify(
     TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
+  std::shared_lock guard(queue_mutex_);
   std::vector<fml::closure> observers;
 
   if (queue_entries_.at(queue_id)->subsumed_by != kUnmerged) {
@@ -202,7 +236,7 @@ std::vector<fml::closure> MessageLoopTaskQueues::GetObserversToNotify(
 
 void MessageLoopTaskQueues::SetWakeable(TaskQueueId queue_id,
                                         fml::Wakeable* wakeable) {
-  std::lock_guard guard(queue_mutex_);
+  std::unique_lock guard(queue_mutex_);
   FML_CHECK(!queue_entries_.at(queue_id)->wakeable)
       << "Wakeable can only be set once.";
   queue_entries_.at(queue_id)->wakeable = wakeable;
@@ -212,7 +246,7 @@ bool MessageLoopTaskQueues::Merge(TaskQueueId owner, TaskQueueId subsumed) {
   if (owner == subsumed) {
     return true;
   }
-  std::lock_guard guard(queue_mutex_);
+  std::unique_lock guard(queue_mutex_);
   auto& owner_entry = queue_entries_.at(owner);
   auto& subsumed_entry = queue_entries_.at(subsumed);
   auto& subsumed_set = owner_entry->owner_of;
@@ -252,15 +286,13 @@ bool MessageLoopTaskQueues::Merge(TaskQueueId owner, TaskQueueId subsumed) {
   owner_entry->owner_of.insert(subsumed);
   subsumed_entry->subsumed_by = owner;
 
-  if (HasPendingTasksUnlocked(owner)) {
-    WakeUpUnlocked(owner, GetNextWakeTimeUnlocked(owner));
-  }
+  UpdateWakeUpUnlocked(owner);
 
   return true;
 }
 
 bool MessageLoopTaskQueues::Unmerge(TaskQueueId owner, TaskQueueId subsumed) {
-  std::lock_guard guard(queue_mutex_);
+  std::unique_lock guard(queue_mutex_);
   const auto& owner_entry = queue_entries_.at(owner);
   if (owner_entry->owner_of.empty()) {
     FML_LOG(WARNING)
@@ -291,20 +323,16 @@ bool MessageLoopTaskQueues::Unmerge(TaskQueueId owner, TaskQueueId subsumed) {
   queue_entries_.at(subsumed)->subsumed_by = kUnmerged;
   owner_entry->owner_of.erase(subsumed);
 
-  if (HasPendingTasksUnlocked(owner)) {
-    WakeUpUnlocked(owner, GetNextWakeTimeUnlocked(owner));
-  }
-
-  if (HasPendingTasksUnlocked(subsumed)) {
-    WakeUpUnlocked(subsumed, GetNextWakeTimeUnlocked(subsumed));
-  }
+  UpdateWakeUpUnlocked(owner);
+  // Also forgets any wake up of the subsumed queue from before the merge.
+  UpdateWakeUpUnlocked(subsumed);
 
   return true;
 }
 
 bool MessageLoopTaskQueues::Owns(TaskQueueId owner,
                                  TaskQueueId subsumed) const {
-  std::lock_guard guard(queue_mutex_);
+  std::shared_lock guard(queue_mutex_);
   if (owner == kUnmerged || subsumed == kUnmerged) {
     return false;
   }
@@ -314,24 +342,81 @@ bool MessageLoopTaskQueues::Owns(TaskQueueId owner,
 
 std::set<TaskQueueId> MessageLoopTaskQueues::GetSubsumedTaskQueueId(
     TaskQueueId owner) const {
-  std::lock_guard guard(queue_mutex_);
+  std::shared_lock guard(queue_mutex_);
   return queue_entries_.at(owner)->owner_of;
 }
 
 void MessageLoopTaskQueues::PauseSecondarySource(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
+  std::shared_lock guard(queue_mutex_);
+  const auto& owner_entry = queue_entries_.at(GetOwnerUnlocked(queue_id));
+  std::scoped_lock tasks_lock(owner_entry->tasks_mutex);
   queue_entries_.at(queue_id)->task_source->PauseSecondary();
 }
 
 void MessageLoopTaskQueues::ResumeSecondarySource(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
+  std::shared_lock guard(queue_mutex_);
+  TaskQueueId owner = GetOwnerUnlocked(queue_id);
+  std::scoped_lock tasks_lock(queue_entries_.at(owner)->tasks_mutex);
   queue_entries_.at(queue_id)->task_source->ResumeSecondary();
   // Schedule a wake as needed.
-  if (HasPendingTasksUnlocked(queue_id)) {
-    WakeUpUnlocked(queue_id, GetNextWakeTimeUnlocked(queue_id));
+  if (owner == queue_id) {
+    UpdateWakeUpUnlocked(queue_id);
   }
 }
 
+TaskQueueId MessageLoopTaskQueues::GetOwnerUnlocked(
+    TaskQueueId queue_id) const {
+  const auto& entry = queue_entries_.at(queue_id);
+  return entry->subsumed_by == kUnmerged ? queue_id : entry->subsumed_by;
+}
+
+static void MovePendingTasks(TaskQueueEntry& entry) {
+  TaskQueueEntry::PendingTask* pending = entry.pending_tasks.exchange(nullptr);
+  while (pending) {
+    entry.task_source->RegisterTask(pending->task);
+    TaskQueueEntry::PendingTask* next = pending->next;
+    delete pending;
+    pending = next;
+  }
+}
+
+void MessageLoopTaskQueues::MovePendingTasksUnlocked(TaskQueueId owner) const {
+  const auto& entry = queue_entries_.at(owner);
+  MovePendingTasks(*entry);
+  for (TaskQueueId subsumed : entry->owner_of) {
+    MovePendingTasks(*queue_entries_.at(subsumed));
+  }
+}
+
+bool MessageLoopTaskQueues::HasUnmovedPendingTasksUnlocked(
+    TaskQueueId owner) const {
+  const auto& entry = queue_entries_.at(owner);
+  if (entry->pending_tasks.load()) {
+    return true;
+  }
+  return std::any_of(entry->owner_of.begin(), entry->owner_of.end(),
+                     [&](const auto& subsumed) {
+                       return queue_entries_.at(subsumed)->pending_tasks.load();
+                     });
+}
+
+void MessageLoopTaskQueues::UpdateWakeUpUnlocked(TaskQueueId owner) const {
+  const auto& entry = queue_entries_.at(owner);
+  do {
+    MovePendingTasksUnlocked(owner);
+    // This can happen when the secondary tasks are paused.
+    if (!HasPendingTasksUnlocked(owner)) {
+      entry->scheduled_wake = ToTicks(fml::TimePoint::Max());
+    } else {
+      fml::TimePoint wake_time = GetNextWakeTimeUnlocked(owner);
+      entry->scheduled_wake = ToTicks(wake_time);
+      WakeUpUnlocked(owner, wake_time);
+    }
+    // A task registered before the new wake up was published may have
+    // skipped waking up the owner, pick it up now.
+  } while (HasUnmovedPendingTasksUnlocked(owner));
+}
+
 // Subsumed queues will never have pending tasks.
 // Owning queues will consider both their and their subsumed tasks.
 bool MessageLoopTaskQueues::HasPendingTasksUnlocked(
@@ -5,10 +5,12 @@
 #ifndef FLUTTER_FML_MESSAGE_LOOP_TASK_QUEUES_H_
 #define FLUTTER_FML_MESSAGE_LOOP_TASK_QUEUES_H_
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <set>
+#include <shared_mutex>
 #include <vector>
 
 #include "flutter/fml/closure.h"
@@ -45,8 +47,27 @@ class TaskQueueEntry {
 
   TaskQueueId created_for;
 
+  /// A task that was registered for this TaskQueue but has not yet been
+  /// moved into |task_source|.
+  struct PendingTask;
+
+  /// Tasks registered for this TaskQueue that have not yet been moved into
+  /// |task_source|, kept as a lock-free stack so that producers never block
+  /// each other or the thread that runs the tasks.
+  std::atomic<PendingTask*> pending_tasks;
+
+  /// Guards the |task_source| of this TaskQueue and of the TaskQueues it owns
+  /// while this TaskQueue is not subsumed by another TaskQueue.
+  std::mutex tasks_mutex;
+
+  /// The ticks of the time most recently given to |wakeable|, or of
+  /// |fml::TimePoint::Max| if no wake up is known to be scheduled.
+  std::atomic<int64_t> scheduled_wake;
+
   explicit TaskQueueEntry(TaskQueueId created_for);
 
+  ~TaskQueueEntry();
+
  private:
   FML_DISALLOW_COPY_ASSIGN_AND_MOVE(TaskQueueEntry);
 };
@@ -60,6 +81,13 @@ enum class FlushType {
 /// fml::MessageLoops.
 ///
 /// This also wakes up the loop at the required times.
+///
+/// Registering a task does not serialize against other producers or the
+/// threads running tasks. The task is pushed onto a lock-free stack of the
+/// TaskQueue and the owner of the TaskQueue is only locked, in order to move
+/// the pending tasks into its task heaps and wake it up, when the new task is
+/// due before the wake up that is already scheduled for the owner. Otherwise
+/// the owner picks the task up the next time it looks for tasks to run.
 /// \see fml::MessageLoop
 /// \see fml::Wakeable
 class MessageLoopTaskQueues {
@@ -143,15 +171,29 @@ class MessageLoopTaskQueues {
 
   ~MessageLoopTaskQueues();
 
+  // Methods with the Unlocked suffix must be called while holding
+  // |queue_mutex_| and either holding it exclusively or holding the
+  // |tasks_mutex| of the owner of the TaskQueues being accessed.
+
   void WakeUpUnlocked(TaskQueueId queue_id, fml::TimePoint time) const;
 
+  TaskQueueId GetOwnerUnlocked(TaskQueueId queue_id) const;
+
+  void MovePendingTasksUnlocked(TaskQueueId owner) const;
+
+  bool HasUnmovedPendingTasksUnlocked(TaskQueueId owner) const;
+
+  void UpdateWakeUpUnlocked(TaskQueueId owner) const;
+
   bool HasPendingTasksUnlocked(TaskQueueId queue_id) const;
 
   TaskSource::TopTask PeekNextTaskUnlocked(TaskQueueId owner) const;
 
   fml::TimePoint GetNextWakeTimeUnlocked(TaskQueueId queue_id) const;
 
-  mutable std::mutex queue_mutex_;
+  // Guards |queue_entries_| and the merged state, observers and wakeables of
+  // the entries. Operations on tasks only hold it in shared mode.
+  mutable std::shared_mutex queue_mutex_;
   std::map<TaskQueueId, std::unique_ptr<TaskQueueEntry>> queue_entries_;
 
   size_t task_queue_id_counter_ = 0;
@@ -5,12 +5,15 @@
 #include "flutter/fml/message_loop_task_queues.h"
 
 #include <cassert>
+#include <memory>
 #include <string>
 #include <thread>
 #include <vector>
 
 #include "flutter/benchmarking/benchmarking.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/thread.h"
 
 namespace fml {
 namespace benchmarking {
@@ -66,5 +69,63 @@ static void BM_RegisterAndGetTasks(benchmark::State& state) {  // NOLINT
 
 BENCHMARK(BM_RegisterAndGetTasks);
 
+// Measures the throughput of several threads posting tasks to the task runners
+// of a few message loops, which is how the platform, UI, raster and IO threads
+// share the task queues when plugins post many platform channel messages.
+static void BM_PostTasksContended(benchmark::State& state) {  // NOLINT
+  const int num_producers = state.range(0);
+  const int num_loops = 4;
+  const int num_tasks_per_producer = 1000;
+
+  std::vector<std::unique_ptr<fml::Thread>> loops;
+  std::vector<int> num_tasks_per_loop(num_loops, 0);
+  for (int i = 0; i < num_loops; i++) {
+    loops.push_back(std::make_unique<fml::Thread>("loop" + std::to_string(i)));
+  }
+  for (int i = 0; i < num_producers; i++) {
+    for (int j = 0; j < num_tasks_per_producer; j++) {
+      num_tasks_per_loop[(i + j) % num_loops]++;
+    }
+  }
+
+  while (state.KeepRunning()) {
+    // Each count is only updated by the thread of its loop.
+    std::vector<int> num_tasks_left = num_tasks_per_loop;
+    CountDownLatch loops_done(num_loops);
+
+    std::vector<std::thread> producers;
+    producers.reserve(num_producers);
+    for (int i = 0; i < num_producers; i++) {
+      producers.emplace_back([producer = i, &loops, &num_tasks_left,
+                              &loops_done]() {
+        for (int j = 0; j < num_tasks_per_producer; j++) {
+          int loop = (producer + j) % num_loops;
+          loops[loop]->GetTaskRunner()->PostTask(
+              [&num_tasks_left, &loops_done, loop]() {
+                if (--num_tasks_left[loop] == 0) {
+                  loops_done.CountDown();
+                }
+              });
+        }
+      });
+    }
+
+    for (auto& producer : producers) {
+      producer.join();
+    }
+    loops_done.Wait();
+  }
+
+  state.SetItemsProcessed(state.iterations() * num_producers *
+                          num_tasks_per_producer);
+}
+
+BENCHMARK(BM_PostTasksContended)
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(16)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
 }  // namespace benchmarking
 }  // namespace fml
@@ -256,7 +256,7 @@ TEST(MessageLoopTaskQueue, AddRemoveNotifyObservers) {
   ASSERT_TRUE(test_val == 0);
 }
 
-TEST(MessageLoopTaskQueue, WakeUpIndependentOfTime) {
+TEST(MessageLoopTaskQueue, WakeUpOnlyForEarlierTasks) {
   auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
   auto queue_id = task_queue->CreateTaskQueue();
 
@@ -265,10 +265,95 @@ TEST(MessageLoopTaskQueue, WakeUpIndependentOfTime) {
       [&num_wakes](fml::TimePoint wake_time) { ++num_wakes; });
   task_queue->SetWakeable(queue_id, wakeable.get());
 
-  task_queue->RegisterTask(queue_id, []() {}, ChronoTicksSinceEpoch());
+  const auto now = ChronoTicksSinceEpoch();
+  task_queue->RegisterTask(queue_id, []() {}, now);
+  ASSERT_EQ(num_wakes, 1);
+
+  // The queue is already going to wake up before this task is due.
   task_queue->RegisterTask(queue_id, []() {}, fml::TimePoint::Max());
+  ASSERT_EQ(num_wakes, 1);
+
+  task_queue->RegisterTask(queue_id, []() {},
+                           now - fml::TimeDelta::FromMilliseconds(1));
+  ASSERT_EQ(num_wakes, 2);
+  ASSERT_EQ(task_queue->GetNumPendingTasks(queue_id), 3u);
+}
+
+TEST(MessageLoopTaskQueue, WakeUpAfterRunningAllTasks) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  auto queue_id = task_queue->CreateTaskQueue();
+
+  std::vector<fml::TimePoint> wakes;
+  auto wakeable = std::make_unique<TestWakeable>(
+      [&wakes](fml::TimePoint wake_time) { wakes.push_back(wake_time); });
+  task_queue->SetWakeable(queue_id, wakeable.get());
+
+  const auto time1 = ChronoTicksSinceEpoch();
+  task_queue->RegisterTask(queue_id, []() {}, time1);
+  ASSERT_TRUE(task_queue->GetNextTaskToRun(queue_id, time1));
+  ASSERT_FALSE(task_queue->GetNextTaskToRun(queue_id, time1));
+
+  // The wake up for the first task has been used up, so a later task must
+  // wake the queue up again.
+  const auto time2 = time1 + fml::TimeDelta::FromMilliseconds(1);
+  task_queue->RegisterTask(queue_id, []() {}, time2);
+  ASSERT_EQ(wakes.back(), time2);
+}
 
-  ASSERT_TRUE(num_wakes == 2);
+TEST(MessageLoopTaskQueue, ConcurrentRegisterAndRunTasks) {
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+  auto queue_id = task_queues->CreateTaskQueue();
+
+  constexpr int kThreadCount = 4;
+  constexpr int kThreadTaskCount = 1000;
+
+  // Wakes up the consumer whenever the queue asks to be woken up, as the
+  // tasks are all due immediately.
+  fml::AutoResetWaitableEvent wake_event;
+  auto wakeable = std::make_unique<TestWakeable>(
+      [&wake_event](fml::TimePoint wake_time) { wake_event.Signal(); });
+  task_queues->SetWakeable(queue_id, wakeable.get());
+
+  std::vector<int> last_task(kThreadCount, -1);
+  bool in_order = true;
+  int num_tasks_run = 0;
+
+  std::thread consumer([&]() {
+    while (num_tasks_run < kThreadCount * kThreadTaskCount) {
+      fml::closure task =
+          task_queues->GetNextTaskToRun(queue_id, fml::TimePoint::Max());
+      if (task) {
+        task();
+        num_tasks_run++;
+      } else {
+        wake_event.Wait();
+      }
+    }
+  });
+
+  std::vector<std::thread> producers;
+  for (int i = 0; i < kThreadCount; i++) {
+    producers.emplace_back([&, i]() {
+      for (int j = 0; j < kThreadTaskCount; j++) {
+        task_queues->RegisterTask(
+            queue_id,
+            [&, i, j]() {
+              in_order = in_order && last_task[i] == j - 1;
+              last_task[i] = j;
+            },
+            ChronoTicksSinceEpoch());
+      }
+    });
+  }
+
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  consumer.join();
+
+  ASSERT_EQ(num_tasks_run, kThreadCount * kThreadTaskCount);
+  ASSERT_TRUE(in_order);
+  ASSERT_FALSE(task_queues->HasPendingTasks(queue_id));
 }
 
 TEST(MessageLoopTaskQueue, WokenUpWithNewerTime) {
@@ -286,9 +371,10 @@ TEST(MessageLoopTaskQueue, WokenUpWithNewerTime) {
 
   task_queue->SetWakeable(queue_id, wakeable.get());
 
-  task_queue->RegisterTask(queue_id, []() {}, fml::TimePoint::Max());
-
   const auto now = ChronoTicksSinceEpoch();
+  expected = now + fml::TimeDelta::FromSeconds(1);
+  task_queue->RegisterTask(queue_id, []() {}, expected);
+
   expected = now;
   task_queue->RegisterTask(queue_id, []() {}, now);
 
@@ -421,8 +507,8 @@ TEST(MessageLoopTaskQueue, RegisterTaskWakesUpOwnerQueue) {
   task_queue->SetWakeable(platform_queue, wakeable1.get());
   task_queue->SetWakeable(raster_queue, wakeable2.get());
 
-  auto time1 = ChronoTicksSinceEpoch() + fml::TimeDelta::FromMilliseconds(1);
-  auto time2 = ChronoTicksSinceEpoch() + fml::TimeDelta::FromMilliseconds(2);
+  auto time1 = ChronoTicksSinceEpoch() + fml::TimeDelta::FromMilliseconds(2);
+  auto time2 = ChronoTicksSinceEpoch() + fml::TimeDelta::FromMilliseconds(1);
 
   ASSERT_EQ(0UL, wakes.size());
 
@@ -437,7 +523,11 @@ TEST(MessageLoopTaskQueue, RegisterTaskWakesUpOwnerQueue) {
 
   ASSERT_EQ(3UL, wakes.size());
   ASSERT_EQ(time1, wakes[1]);
-  ASSERT_EQ(time1, wakes[2]);
+  ASSERT_EQ(time2, wakes[2]);
+
+  // A task due after the scheduled wake up does not wake the owner again.
+  task_queue->RegisterTask(raster_queue, []() {}, time1);
+  ASSERT_EQ(3UL, wakes.size());
 }
 
 }  // namespace testing
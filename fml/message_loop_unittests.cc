@@ -6,7 +6,10 @@
 
 #include "flutter/fml/message_loop.h"
 
+#include <atomic>
 #include <iostream>
+#include <mutex>
+#include <set>
 #include <thread>
 
 #include "flutter/fml/build_config.h"
@@ -212,3 +215,119 @@ TEST(MessageLoop, CanCreateConcurrentMessageLoop) {
   latch.Wait();
   ASSERT_GE(thread_ids.size(), 1u);
 }
+
+TEST(MessageLoop, ConcurrentMessageLoopRunsTasksOnWorkers) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  auto task_runner = loop->GetTaskRunner();
+  ASSERT_FALSE(loop->RunsTasksOnCurrentThread());
+  const size_t kCount = 1000;
+  fml::CountDownLatch latch(kCount);
+  std::atomic<size_t> off_worker_count = 0;
+  for (size_t i = 0; i < kCount; ++i) {
+    task_runner->PostTask([&]() {
+      if (!loop->RunsTasksOnCurrentThread()) {
+        off_worker_count++;
+      }
+      latch.CountDown();
+    });
+  }
+  latch.Wait();
+  ASSERT_EQ(off_worker_count, 0u);
+}
+
+TEST(MessageLoop, ConcurrentMessageLoopStealsTasksPostedFromWorker) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  auto task_runner = loop->GetTaskRunner();
+  const size_t kCount = 16;
+  fml::CountDownLatch latch(kCount + 1);
+  std::mutex thread_ids_mutex;
+  std::set<std::thread::id> thread_ids;
+  // All the tasks are queued on the worker running the outer task, so the
+  // others only see them by stealing.
+  task_runner->PostTask([&]() {
+    for (size_t i = 0; i < kCount; ++i) {
+      task_runner->PostTask([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        {
+          std::scoped_lock lock(thread_ids_mutex);
+          thread_ids.insert(std::this_thread::get_id());
+        }
+        latch.CountDown();
+      });
+    }
+    latch.CountDown();
+  });
+  latch.Wait();
+  ASSERT_GT(thread_ids.size(), 1u);
+}
+
+TEST(MessageLoop, ConcurrentMessageLoopPostsTaskToAllWorkers) {
+  const size_t kWorkerCount = 4;
+  auto loop = fml::ConcurrentMessageLoop::Create(kWorkerCount);
+  fml::CountDownLatch latch(kWorkerCount);
+  std::mutex thread_ids_mutex;
+  std::set<std::thread::id> thread_ids;
+  loop->PostTaskToAllWorkers([&]() {
+    {
+      std::scoped_lock lock(thread_ids_mutex);
+      thread_ids.insert(std::this_thread::get_id());
+    }
+    latch.CountDown();
+  });
+  latch.Wait();
+  ASSERT_EQ(thread_ids.size(), kWorkerCount);
+}
+
+TEST(MessageLoop, ConcurrentMessageLoopRunsTaskInlineAfterTermination) {
+  auto loop = fml::ConcurrentMessageLoop::Create(2);
+  auto task_runner = loop->GetTaskRunner();
+  loop->Terminate();
+  std::thread::id task_thread_id;
+  task_runner->PostTask(
+      [&]() { task_thread_id = std::this_thread::get_id(); });
+  ASSERT_EQ(task_thread_id, std::this_thread::get_id());
+}
+
+TEST(MessageLoop, ConcurrentMessageLoopRunsTasksPostedDuringTermination) {
+  const size_t kWorkerCount = 4;
+  const size_t kPosterCount = 4;
+  const size_t kTasksPerPoster = 10000;
+  std::atomic<size_t> run_count = 0;
+  {
+    auto loop = fml::ConcurrentMessageLoop::Create(kWorkerCount);
+    auto task_runner = loop->GetTaskRunner();
+
+    // Keep every worker busy so that tasks are still queued at termination.
+    fml::CountDownLatch workers_blocked(kWorkerCount);
+    fml::ManualResetWaitableEvent unblock_workers;
+    for (size_t i = 0; i < kWorkerCount; i++) {
+      task_runner->PostTask([&]() {
+        workers_blocked.CountDown();
+        unblock_workers.Wait();
+      });
+    }
+    workers_blocked.Wait();
+
+    // Terminate once every poster is halfway through its tasks.
+    fml::CountDownLatch posters_halfway(kPosterCount);
+    std::vector<std::thread> posters;
+    for (size_t i = 0; i < kPosterCount; i++) {
+      posters.emplace_back([&]() {
+        for (size_t j = 0; j < kTasksPerPoster; j++) {
+          if (j == kTasksPerPoster / 2) {
+            posters_halfway.CountDown();
+          }
+          task_runner->PostTask([&]() { run_count++; });
+        }
+      });
+    }
+    posters_halfway.Wait();
+    loop->Terminate();
+    for (auto& poster : posters) {
+      poster.join();
+    }
+    unblock_workers.Signal();
+    // Destroying the loop joins the workers.
+  }
+  ASSERT_EQ(run_count.load(), kPosterCount * kTasksPerPoster);
+}
@@ -0,0 +1,142 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/task_group.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+#include "flutter/fml/synchronization/count_down_latch.h"
+
+namespace fml {
+
+struct TaskGroup::Task {
+  explicit Task(fml::closure p_closure) : closure(std::move(p_closure)) {}
+
+  fml::closure closure;
+  // Set by whichever of the task runner or |Wait| gets to the task first.
+  std::atomic<bool> claimed = false;
+};
+
+struct TaskGroup::State {
+  std::mutex mutex;
+  std::condition_variable condition;
+  size_t unfinished_tasks = 0;
+
+  void Run(Task& task) {
+    if (task.claimed.exchange(true)) {
+      return;
+    }
+    task.closure();
+    task.closure = nullptr;
+    std::scoped_lock lock(mutex);
+    if (--unfinished_tasks == 0) {
+      condition.notify_all();
+    }
+  }
+};
+
+TaskGroup::TaskGroup(std::shared_ptr<BasicTaskRunner> task_runner)
+    : task_runner_(std::move(task_runner)),
+      state_(std::make_shared<State>()) {}
+
+TaskGroup::~TaskGroup() {
+  Wait();
+}
+
+void TaskGroup::PostTask(const fml::closure& task) {
+  if (!task) {
+    return;
+  }
+  auto group_task = std::make_shared<Task>(task);
+  {
+    std::scoped_lock lock(state_->mutex);
+    state_->unfinished_tasks++;
+  }
+  tasks_.push_back(group_task);
+  if (task_runner_) {
+    task_runner_->PostTask(
+        [state = state_, group_task]() { state->Run(*group_task); });
+  }
+}
+
+void TaskGroup::Wait() {
+  // Run the tasks that the task runner hasn't started yet, oldest first.
+  for (const auto& task : tasks_) {
+    state_->Run(*task);
+  }
+  tasks_.clear();
+
+  std::unique_lock lock(state_->mutex);
+  state_->condition.wait(lock,
+                         [&]() { return state_->unfinished_tasks == 0; });
+}
+
+namespace {
+
+// The state of a |ParallelFor| loop shared with the helper tasks, which may
+// only get to run after the loop has returned.
+struct ParallelForState {
+  ParallelForState(size_t p_count,
+                   size_t p_batch_size,
+                   const std::function<void(size_t)>& p_task)
+      : count(p_count),
+        batch_size(p_batch_size),
+        task(p_task),
+        latch((p_count + p_batch_size - 1) / p_batch_size) {}
+
+  const size_t count;
+  const size_t batch_size;
+  // Only valid while there are unclaimed batches since the loop doesn't
+  // return until every batch has been processed.
+  const std::function<void(size_t)>& task;
+  std::atomic<size_t> next_index = 0;
+  CountDownLatch latch;
+
+  void RunBatches() {
+    while (true) {
+      size_t start = next_index.fetch_add(batch_size);
+      if (start >= count) {
+        return;
+      }
+      size_t end = std::min(count, start + batch_size);
+      for (size_t i = start; i < end; i++) {
+        task(i);
+      }
+      latch.CountDown();
+    }
+  }
+};
+
+// The number of batches each thread gets on average. More batches even out
+// the load at the cost of more contention on the next index.
+constexpr size_t kBatchesPerThread = 4u;
+
+}  // namespace
+
+void ParallelFor(const std::shared_ptr<BasicTaskRunner>& task_runner,
+                 size_t count,
+                 const std::function<void(size_t index)>& task,
+                 size_t max_concurrency) {
+  size_t threads = std::min(count, std::max<size_t>(max_concurrency, 1u));
+  if (!task_runner || threads <= 1u) {
+    for (size_t i = 0; i < count; i++) {
+      task(i);
+    }
+    return;
+  }
+
+  size_t batch_size =
+      std::max<size_t>(count / (threads * kBatchesPerThread), 1u);
+  auto state = std::make_shared<ParallelForState>(count, batch_size, task);
+  for (size_t i = 1; i < threads; i++) {
+    task_runner->PostTask([state]() { state->RunBatches(); });
+  }
+  state->RunBatches();
+  state->latch.Wait();
+}
+
+}  // namespace fml
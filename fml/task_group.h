@@ -0,0 +1,81 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TASK_GROUP_H_
+#define FLUTTER_FML_TASK_GROUP_H_
+
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "flutter/fml/closure.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// @brief      A join handle for a group of tasks posted to a task runner,
+///             usually a |ConcurrentTaskRunner|.
+///
+///             Tasks that have not started by the time the group is waited
+///             on are run by the waiting thread instead. This means that a
+///             group may be waited on from a task running on the same task
+///             runner without deadlocking, even when every worker is busy.
+///
+///             A task group is not thread safe and must be used from the
+///             thread that created it.
+///
+class TaskGroup {
+ public:
+  explicit TaskGroup(std::shared_ptr<BasicTaskRunner> task_runner);
+
+  /// Waits for all the tasks of the group.
+  ~TaskGroup();
+
+  void PostTask(const fml::closure& task);
+
+  /// Returns once every task posted to the group so far has run.
+  void Wait();
+
+ private:
+  struct Task;
+  struct State;
+
+  std::shared_ptr<BasicTaskRunner> task_runner_;
+  std::shared_ptr<State> state_;
+  std::vector<std::shared_ptr<Task>> tasks_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TaskGroup);
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Calls |task| once for every index in [0, count) and returns
+///             once all the calls have returned.
+///
+///             The indices are handed out in small batches to the calling
+///             thread and to up to |max_concurrency - 1| tasks posted to
+///             |task_runner|. The calling thread keeps taking batches until
+///             none are left, so the loop completes even if the posted tasks
+///             never get to run before that, which makes it safe to call
+///             from a task running on |task_runner|.
+///
+/// @param[in]  task_runner      The task runner, usually a
+///                              |ConcurrentTaskRunner|, that helps with the
+///                              loop. May be null.
+/// @param[in]  count            The number of indices.
+/// @param[in]  task             The function called with each index. It may
+///                              be called from several threads at once.
+/// @param[in]  max_concurrency  The maximum number of threads, including the
+///                              calling thread, running the loop.
+///
+void ParallelFor(const std::shared_ptr<BasicTaskRunner>& task_runner,
+                 size_t count,
+                 const std::function<void(size_t index)>& task,
+                 size_t max_concurrency = std::thread::hardware_concurrency());
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TASK_GROUP_H_
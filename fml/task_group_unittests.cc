@@ -0,0 +1,116 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/task_group.h"
+
+#include <atomic>
+#include <vector>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(TaskGroupTest, WaitRunsAllTasks) {
+  auto loop = ConcurrentMessageLoop::Create(4);
+  std::atomic<size_t> count = 0;
+  TaskGroup group(loop->GetTaskRunner());
+  for (size_t i = 0; i < 100; i++) {
+    group.PostTask([&]() { count++; });
+  }
+  group.Wait();
+  EXPECT_EQ(count, 100u);
+
+  group.PostTask([&]() { count++; });
+  group.Wait();
+  EXPECT_EQ(count, 101u);
+}
+
+TEST(TaskGroupTest, DestructorWaitsForTasks) {
+  auto loop = ConcurrentMessageLoop::Create(2);
+  std::atomic<size_t> count = 0;
+  {
+    TaskGroup group(loop->GetTaskRunner());
+    for (size_t i = 0; i < 10; i++) {
+      group.PostTask([&]() { count++; });
+    }
+  }
+  EXPECT_EQ(count, 10u);
+}
+
+TEST(TaskGroupTest, WaitRunsPendingTasksOnCallingThread) {
+  auto loop = ConcurrentMessageLoop::Create(1);
+  auto task_runner = loop->GetTaskRunner();
+  AutoResetWaitableEvent blocker_started;
+  ManualResetWaitableEvent release_blocker;
+  task_runner->PostTask([&]() {
+    blocker_started.Signal();
+    release_blocker.Wait();
+  });
+  blocker_started.Wait();
+
+  // The only worker is blocked so the group can only complete on this
+  // thread.
+  std::thread::id task_thread_id;
+  TaskGroup group(task_runner);
+  group.PostTask([&]() { task_thread_id = std::this_thread::get_id(); });
+  group.Wait();
+  EXPECT_EQ(task_thread_id, std::this_thread::get_id());
+  release_blocker.Signal();
+}
+
+TEST(TaskGroupTest, CanWaitFromWorker) {
+  auto loop = ConcurrentMessageLoop::Create(1);
+  auto task_runner = loop->GetTaskRunner();
+  std::atomic<size_t> count = 0;
+  AutoResetWaitableEvent done;
+  task_runner->PostTask([&]() {
+    TaskGroup group(task_runner);
+    for (size_t i = 0; i < 10; i++) {
+      group.PostTask([&]() { count++; });
+    }
+    group.Wait();
+    done.Signal();
+  });
+  done.Wait();
+  EXPECT_EQ(count, 10u);
+}
+
+TEST(ParallelForTest, VisitsEveryIndexOnce) {
+  auto loop = ConcurrentMessageLoop::Create(4);
+  for (size_t count : {0u, 1u, 7u, 1000u}) {
+    std::vector<std::atomic<int>> visits(count);
+    ParallelFor(loop->GetTaskRunner(), count,
+                [&](size_t index) { visits[index]++; });
+    for (size_t i = 0; i < count; i++) {
+      EXPECT_EQ(visits[i], 1) << "index " << i << " of " << count;
+    }
+  }
+}
+
+TEST(ParallelForTest, RunsOnCallingThreadWithoutTaskRunner) {
+  std::thread::id thread_id = std::this_thread::get_id();
+  size_t off_thread_count = 0;
+  ParallelFor(nullptr, 100, [&](size_t index) {
+    if (std::this_thread::get_id() != thread_id) {
+      off_thread_count++;
+    }
+  });
+  EXPECT_EQ(off_thread_count, 0u);
+}
+
+TEST(ParallelForTest, CanNestInsideWorkers) {
+  auto loop = ConcurrentMessageLoop::Create(2);
+  auto task_runner = loop->GetTaskRunner();
+  std::atomic<size_t> count = 0;
+  ParallelFor(task_runner, 8, [&](size_t outer) {
+    ParallelFor(task_runner, 8, [&](size_t inner) { count++; });
+  });
+  EXPECT_EQ(count, 64u);
+}
+
+}  // namespace testing
+}  // namespace fml
@@ -4,6 +4,7 @@
 
 #include "flutter/testing/testing.h"
 #include "impeller/base/mask.h"
+#include "impeller/base/persistence.h"
 #include "impeller/base/promise.h"
 #include "impeller/base/strings.h"
 #include "impeller/base/thread.h"
@@ -94,6 +95,74 @@ struct CVTest {
   uint32_t rando_ivar IPLR_GUARDED_BY(mutex) = 0;
 };
 
+TEST(PersistenceTest, PersistentHashMatchesFNV1a) {
+  EXPECT_EQ(PersistentHash("", 0u), 0xcbf29ce484222325u);
+  EXPECT_EQ(PersistentHash("a", 1u), 0xaf63dc4c8601ec8cu);
+  EXPECT_EQ(PersistentHash("foobar", 6u), 0x85944171f73967e8u);
+  EXPECT_EQ(PersistentHash("bar", 3u, PersistentHash("foo", 3u)),
+            PersistentHash("foobar", 6u));
+}
+
+namespace {
+
+class QueueTaskRunner : public fml::BasicTaskRunner {
+ public:
+  void PostTask(const fml::closure& task) override { tasks.push_back(task); }
+
+  void RunTasks() {
+    std::vector<fml::closure> pending;
+    std::swap(pending, tasks);
+    for (const fml::closure& task : pending) {
+      task();
+    }
+  }
+
+  std::vector<fml::closure> tasks;
+};
+
+struct Persistable {
+  void Persist() { persist_count++; }
+
+  int persist_count = 0;
+};
+
+}  // namespace
+
+TEST(PersistenceTest, PersistSchedulerCoalescesPendingWrites) {
+  auto task_runner = std::make_shared<QueueTaskRunner>();
+  auto persistable = std::make_shared<Persistable>();
+  PersistScheduler scheduler;
+
+  scheduler.Schedule(task_runner, std::weak_ptr<Persistable>(persistable));
+  scheduler.Schedule(task_runner, std::weak_ptr<Persistable>(persistable));
+  EXPECT_EQ(task_runner->tasks.size(), 1u);
+  task_runner->RunTasks();
+  EXPECT_EQ(persistable->persist_count, 1);
+
+  // Once the pending write has run, another one can be scheduled.
+  scheduler.Schedule(task_runner, std::weak_ptr<Persistable>(persistable));
+  EXPECT_EQ(task_runner->tasks.size(), 1u);
+  task_runner->RunTasks();
+  EXPECT_EQ(persistable->persist_count, 2);
+}
+
+TEST(PersistenceTest, PersistSchedulerSkipsCollectedOwners) {
+  auto task_runner = std::make_shared<QueueTaskRunner>();
+  auto persistable = std::make_shared<Persistable>();
+  std::weak_ptr<Persistable> weak_persistable = persistable;
+  PersistScheduler scheduler;
+
+  scheduler.Schedule(task_runner, weak_persistable);
+  persistable.reset();
+  task_runner->RunTasks();
+  EXPECT_TRUE(weak_persistable.expired());
+
+  // Nothing is scheduled without a task runner.
+  scheduler.Schedule(std::shared_ptr<fml::BasicTaskRunner>(),
+                     weak_persistable);
+  EXPECT_TRUE(task_runner->tasks.empty());
+}
+
 TEST(ConditionVariableTest, WaitUntil) {
   CVTest test;
   // test.rando_ivar = 12; // <--- Static analysis error
@@ -0,0 +1,20 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/base/persistence.h"
+
+namespace impeller {
+
+static constexpr uint64_t kFNVPrime = 0x100000001b3u;
+
+uint64_t PersistentHash(const void* data, size_t length, uint64_t hash) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < length; i++) {
+    hash ^= bytes[i];
+    hash *= kFNVPrime;
+  }
+  return hash;
+}
+
+}  // namespace impeller
@@ -0,0 +1,81 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_BASE_PERSISTENCE_H_
+#define FLUTTER_IMPELLER_BASE_PERSISTENCE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "flutter/fml/task_runner.h"
+
+namespace impeller {
+
+/// The initial value of a persistent hash.
+static constexpr uint64_t kPersistentHashSeed = 0xcbf29ce484222325u;
+
+//------------------------------------------------------------------------------
+/// @brief      Combine bytes into a 64-bit FNV-1a hash.
+///
+///             Unlike `std::hash`, the result only depends on the bytes, so
+///             it can identify data written to disk by a previous launch of
+///             the application.
+///
+/// @param[in]  data    The bytes to hash.
+/// @param[in]  length  The number of bytes to hash.
+/// @param[in]  hash    The hash to combine the bytes into.
+///
+/// @return     The combined hash.
+///
+uint64_t PersistentHash(const void* data,
+                        size_t length,
+                        uint64_t hash = kPersistentHashSeed);
+
+//------------------------------------------------------------------------------
+/// @brief      Coalesces requests to write an object to disk in the
+///             background, so that at most one write is pending at a time.
+///
+///             All methods are safe to call concurrently.
+///
+class PersistScheduler {
+ public:
+  PersistScheduler() = default;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Call `Persist()` on the owner on the task runner, unless a
+  ///             call is already pending. The call is skipped if the owner
+  ///             has been collected by the time the task runs.
+  ///
+  /// @param[in]  task_runner  The task runner to persist on. Nothing is
+  ///                          scheduled if this is null.
+  /// @param[in]  owner        The object to persist.
+  ///
+  template <typename T>
+  void Schedule(const std::shared_ptr<fml::BasicTaskRunner>& task_runner,
+                std::weak_ptr<T> owner) {
+    if (!task_runner || pending_->exchange(true)) {
+      return;
+    }
+    task_runner->PostTask([pending = pending_, owner = std::move(owner)]() {
+      pending->store(false);
+      if (auto strong_owner = owner.lock()) {
+        strong_owner->Persist();
+      }
+    });
+  }
+
+ private:
+  const std::shared_ptr<std::atomic_bool> pending_ =
+      std::make_shared<std::atomic_bool>(false);
+
+  PersistScheduler(const PersistScheduler&) = delete;
+
+  PersistScheduler& operator=(const PersistScheduler&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_BASE_PERSISTENCE_H_
@@ -4,6 +4,8 @@
 
 #include "impeller/core/buffer_view.h"
 
+#include "flutter/fml/logging.h"
+
 namespace impeller {
 
 BufferView::BufferView() : buffer_(nullptr), raw_buffer_(nullptr), range_({}) {}
@@ -18,6 +20,13 @@ const DeviceBuffer* BufferView::GetBuffer() const {
   return raw_buffer_ ? raw_buffer_ : buffer_.get();
 }
 
+BufferView BufferView::GetSubView(Range range) const {
+  FML_DCHECK(range.offset + range.length <= range_.length);
+  BufferView view = *this;
+  view.range_ = Range(range_.offset + range.offset, range.length);
+  return view;
+}
+
 std::shared_ptr<const DeviceBuffer> BufferView::TakeBuffer() {
   if (buffer_) {
     raw_buffer_ = buffer_.get();
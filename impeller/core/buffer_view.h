@@ -26,6 +26,10 @@ struct BufferView {
 
   Range GetRange() const { return range_; }
 
+  /// Returns a view of |range| within this view's buffer. The offset of
+  /// |range| is relative to the start of this view.
+  BufferView GetSubView(Range range) const;
+
   const DeviceBuffer* GetBuffer() const;
 
   std::shared_ptr<const DeviceBuffer> TakeBuffer();
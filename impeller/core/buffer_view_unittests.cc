@@ -22,5 +22,14 @@ TEST(BufferViewTest, TakeRaw) {
   EXPECT_EQ(buffer_view.GetBuffer(), buffer);
 }
 
+TEST(BufferViewTest, GetSubView) {
+  DeviceBuffer* buffer = reinterpret_cast<DeviceBuffer*>(0xcafebabe);
+  BufferView buffer_view(buffer, {16, 128});
+  BufferView sub_view = buffer_view.GetSubView({32, 64});
+  EXPECT_EQ(sub_view.GetBuffer(), buffer);
+  EXPECT_EQ(sub_view.GetRange(), Range(48, 64));
+  EXPECT_EQ(buffer_view.GetRange(), Range(16, 128));
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -4,6 +4,7 @@
 
 #include "impeller/core/host_buffer.h"
 
+#include <algorithm>
 #include <cstring>
 #include <tuple>
 
@@ -35,6 +36,8 @@ HostBuffer::HostBuffer(const std::shared_ptr<Allocator>& allocator,
     FML_CHECK(device_buffer) << "Failed to allocate device buffer.";
     device_buffers_[i].push_back(device_buffer);
   }
+  statistics_.blocks_allocated = kHostBufferArenaSize;
+  statistics_.blocks_retained = kHostBufferArenaSize;
 }
 
 HostBuffer::~HostBuffer() {
@@ -90,26 +93,41 @@ HostBuffer::TestStateQuery HostBuffer::GetStateForTest() {
       .current_frame = frame_index_,
       .current_buffer = current_buffer_,
       .total_buffer_count = device_buffers_[frame_index_].size(),
+      .pooled_buffer_count = pooled_buffers_.size(),
   };
 }
 
 bool HostBuffer::MaybeCreateNewBuffer() {
-  current_buffer_++;
-  if (current_buffer_ >= device_buffers_[frame_index_].size()) {
+  FML_DCHECK(current_buffer_ + 1 == device_buffers_[frame_index_].size());
+  std::shared_ptr<DeviceBuffer> buffer;
+  if (!pooled_buffers_.empty()) {
+    buffer = std::move(pooled_buffers_.back());
+    pooled_buffers_.pop_back();
+  } else {
     DeviceBufferDescriptor desc;
     desc.size = kAllocatorBlockSize;
     desc.storage_mode = StorageMode::kHostVisible;
-    std::shared_ptr<DeviceBuffer> buffer = allocator_->CreateBuffer(desc);
+    buffer = allocator_->CreateBuffer(desc);
     if (!buffer) {
       VALIDATION_LOG << "Failed to allocate host buffer of size " << desc.size;
       return false;
     }
-    device_buffers_[frame_index_].push_back(std::move(buffer));
+    statistics_.blocks_allocated++;
+    statistics_.blocks_retained++;
   }
+  device_buffers_[frame_index_].push_back(std::move(buffer));
+  current_buffer_++;
   offset_ = 0;
   return true;
 }
 
+void HostBuffer::RecordEmplace(size_t padding, size_t length) {
+  statistics_.wasted_alignment_bytes += padding;
+  frame_bytes_ += padding + length;
+  statistics_.peak_frame_bytes =
+      std::max(statistics_.peak_frame_bytes, frame_bytes_);
+}
+
 std::tuple<Range, std::shared_ptr<DeviceBuffer>, DeviceBuffer*>
 HostBuffer::EmplaceInternal(size_t length,
                             size_t align,
@@ -144,9 +162,11 @@ HostBuffer::EmplaceInternal(size_t length,
     if (!MaybeCreateNewBuffer()) {
       return {};
     }
+    padding = 0;
   } else {
     offset_ += padding;
   }
+  RecordEmplace(padding, length);
 
   const std::shared_ptr<DeviceBuffer>& current_buffer = GetCurrentBuffer();
   auto contents = current_buffer->OnGetContents();
@@ -187,6 +207,7 @@ HostBuffer::EmplaceInternal(const void* buffer, size_t length) {
     }
   }
   old_length = GetLength();
+  RecordEmplace(0u, length);
 
   const std::shared_ptr<DeviceBuffer>& current_buffer = GetCurrentBuffer();
   auto contents = current_buffer->OnGetContents();
@@ -209,6 +230,7 @@ HostBuffer::EmplaceInternal(const void* buffer, size_t length, size_t align) {
     auto padding = align - (GetLength() % align);
     if (offset_ + padding < kAllocatorBlockSize) {
       offset_ += padding;
+      RecordEmplace(padding, 0u);
     } else if (!MaybeCreateNewBuffer()) {
       return {};
     }
@@ -222,15 +244,41 @@ const std::shared_ptr<DeviceBuffer>& HostBuffer::GetCurrentBuffer() const {
 }
 
 void HostBuffer::Reset() {
-  // When resetting the host buffer state at the end of the frame, check if
-  // there are any unused buffers and remove them.
-  while (device_buffers_[frame_index_].size() > current_buffer_ + 1) {
-    device_buffers_[frame_index_].pop_back();
-  }
+  buffer_usage_history_[buffer_usage_index_] =
+      device_buffers_[frame_index_].size();
+  buffer_usage_index_ = (buffer_usage_index_ + 1) % kHostBufferTrimFrameCount;
 
   offset_ = 0u;
   current_buffer_ = 0u;
+  frame_bytes_ = 0u;
   frame_index_ = (frame_index_ + 1) % kHostBufferArenaSize;
+
+  // The frame that previously used this arena is no longer in flight. Keep
+  // its first block and return the others to the pool so that any frame
+  // can reuse them.
+  std::vector<std::shared_ptr<DeviceBuffer>>& arena =
+      device_buffers_[frame_index_];
+  for (size_t i = 1u; i < arena.size(); i++) {
+    pooled_buffers_.push_back(std::move(arena[i]));
+  }
+  arena.resize(1u);
+
+  TrimPooledBuffers();
+}
+
+void HostBuffer::TrimPooledBuffers() {
+  size_t peak_usage = 1u;
+  for (size_t usage : buffer_usage_history_) {
+    peak_usage = std::max(peak_usage, usage);
+  }
+  // Every frame in flight may need as many blocks as the busiest recent
+  // frame did.
+  const size_t wanted = peak_usage * kHostBufferArenaSize;
+  while (statistics_.blocks_retained > wanted && !pooled_buffers_.empty()) {
+    pooled_buffers_.pop_back();
+    statistics_.blocks_retained--;
+    statistics_.blocks_released++;
+  }
 }
 
 }  // namespace impeller
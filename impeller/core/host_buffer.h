@@ -21,12 +21,35 @@ namespace impeller {
 /// Approximately the same size as the max frames in flight.
 static const constexpr size_t kHostBufferArenaSize = 4u;
 
+/// The number of consecutive frames that must need fewer blocks than are
+/// retained before the excess blocks are returned to the allocator.
+static const constexpr size_t kHostBufferTrimFrameCount = 60u;
+
 /// The host buffer class manages one more 1024 Kb blocks of device buffer
 /// allocations.
 ///
-/// These are reset per-frame.
+/// Each of the |kHostBufferArenaSize| frames in flight owns one block. The
+/// additional blocks a busy frame needs are drawn from a pool shared by all
+/// frames and return to that pool once the frame is recycled. Blocks in the
+/// pool that have not been needed for |kHostBufferTrimFrameCount| frames are
+/// released.
 class HostBuffer {
  public:
+  /// Cumulative usage statistics of a host buffer.
+  struct Statistics {
+    /// The largest number of bytes, including alignment padding, emplaced
+    /// into blocks during a single frame.
+    size_t peak_frame_bytes = 0u;
+    /// The total number of bytes skipped to satisfy alignment requirements.
+    size_t wasted_alignment_bytes = 0u;
+    /// The number of blocks created since the host buffer was created.
+    size_t blocks_allocated = 0u;
+    /// The number of blocks returned to the allocator after calm frames.
+    size_t blocks_released = 0u;
+    /// The number of blocks currently held, both in use and pooled.
+    size_t blocks_retained = 0u;
+  };
+
   static std::shared_ptr<HostBuffer> Create(
       const std::shared_ptr<Allocator>& allocator,
       const std::shared_ptr<const IdleWaiter>& idle_waiter);
@@ -123,11 +146,16 @@ class HostBuffer {
   ///        reused.
   void Reset();
 
+  //----------------------------------------------------------------------------
+  /// @brief Retrieve the usage statistics accumulated since creation.
+  const Statistics& GetStatistics() const { return statistics_; }
+
   /// Test only internal state.
   struct TestStateQuery {
     size_t current_frame;
     size_t current_buffer;
     size_t total_buffer_count;
+    size_t pooled_buffer_count;
   };
 
   /// @brief Retrieve internal buffer state for test expectations.
@@ -151,6 +179,12 @@ class HostBuffer {
   /// A false return value indicates an unrecoverable allocation failure.
   [[nodiscard]] bool MaybeCreateNewBuffer();
 
+  /// Release pooled blocks that exceed what the busiest of the last
+  /// |kHostBufferTrimFrameCount| frames needed.
+  void TrimPooledBuffers();
+
+  void RecordEmplace(size_t padding, size_t length);
+
   const std::shared_ptr<DeviceBuffer>& GetCurrentBuffer() const;
 
   [[nodiscard]] BufferView Emplace(const void* buffer, size_t length);
@@ -166,9 +200,16 @@ class HostBuffer {
   std::shared_ptr<const IdleWaiter> idle_waiter_;
   std::array<std::vector<std::shared_ptr<DeviceBuffer>>, kHostBufferArenaSize>
       device_buffers_;
+  // Blocks not used by any frame in flight.
+  std::vector<std::shared_ptr<DeviceBuffer>> pooled_buffers_;
+  // The number of blocks used by each of the most recent frames.
+  std::array<size_t, kHostBufferTrimFrameCount> buffer_usage_history_ = {};
+  size_t buffer_usage_index_ = 0u;
   size_t current_buffer_ = 0u;
   size_t offset_ = 0u;
   size_t frame_index_ = 0u;
+  size_t frame_bytes_ = 0u;
+  Statistics statistics_;
 };
 
 }  // namespace impeller
@@ -29,10 +29,15 @@ class AiksContext {
   ///                             errors.
   /// @param render_target_allocator Injects a render target allocator or
   ///                                allocates its own if none is supplied.
+  /// @param variant_manifest     Records the pipeline variants used so that
+  ///                             they can be compiled ahead of the first frame
+  ///                             of the next launch. Optional.
   AiksContext(std::shared_ptr<Context> context,
               std::shared_ptr<TypographerContext> typographer_context,
               std::optional<std::shared_ptr<RenderTargetAllocator>>
-                  render_target_allocator = std::nullopt);
+                  render_target_allocator = std::nullopt,
+              std::shared_ptr<PipelineVariantManifest> variant_manifest =
+                  nullptr);
 
   ~AiksContext();
 
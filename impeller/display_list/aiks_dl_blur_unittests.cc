@@ -349,6 +349,37 @@ TEST_P(AiksTest,
   ASSERT_TRUE(OpenPlaygroundHere(builder.Build()));
 }
 
+// Alternating layers share the backdrop but apply one of two filters. Each
+// filter is applied to the backdrop once.
+TEST_P(AiksTest, CanRenderMultipleBackdropBlurWithSingleBackdropIdTwoFilters) {
+  auto image = DlImageImpeller::Make(CreateTextureForFixture("kalimba.jpg"));
+
+  DisplayListBuilder builder;
+
+  DlPaint paint;
+  builder.DrawImage(image, SkPoint::Make(50.0, 50.0),
+                    DlImageSampling::kNearestNeighbor, &paint);
+
+  for (int i = 0; i < 6; i++) {
+    SkRRect rrect = SkRRect::MakeRectXY(
+        SkRect::MakeXYWH(50 + (i * 100), 250, 100, 100), 20, 20);
+    builder.Save();
+    builder.ClipRRect(rrect);
+
+    DlPaint save_paint;
+    save_paint.setBlendMode(DlBlendMode::kSrc);
+    Scalar sigma = i % 2 == 0 ? 30 : 10;
+    auto backdrop_filter =
+        DlImageFilter::MakeBlur(sigma, sigma, DlTileMode::kClamp);
+    builder.SaveLayer(nullptr, &save_paint, backdrop_filter.get(),
+                      /*backdrop_id=*/1);
+    builder.Restore();
+    builder.Restore();
+  }
+
+  ASSERT_TRUE(OpenPlaygroundHere(builder.Build()));
+}
+
 TEST_P(AiksTest, CanRenderBackdropBlurHugeSigma) {
   DisplayListBuilder builder;
 
@@ -1092,6 +1123,34 @@ TEST_P(AiksTest, GaussianBlurOneDimension) {
   ASSERT_TRUE(OpenPlaygroundHere(builder.Build()));
 }
 
+// Large sigmas switch from the separable passes to the dual filter blur. The
+// blurs of each column should grow smoothly across the switch.
+TEST_P(AiksTest, GaussianBlurLargeSigmasAreContinuous) {
+  DisplayListBuilder builder;
+  builder.Scale(GetContentScale().x, GetContentScale().y);
+
+  std::shared_ptr<Texture> boston = CreateTextureForFixture("boston.jpg");
+  builder.DrawImageRect(
+      DlImageImpeller::Make(boston),
+      SkRect::MakeXYWH(0, 0, boston->GetSize().width, boston->GetSize().height),
+      SkRect::MakeXYWH(0, 0, 1000, 600), DlImageSampling::kLinear);
+
+  const Scalar sigmas[] = {15, 30, 60, 100, 200};
+  for (size_t i = 0; i < std::size(sigmas); i++) {
+    builder.Save();
+    builder.ClipRect(SkRect::MakeXYWH(i * 200, 0, 200, 600));
+    DlPaint paint;
+    paint.setBlendMode(DlBlendMode::kSrc);
+    auto backdrop_filter =
+        DlImageFilter::MakeBlur(sigmas[i], sigmas[i], DlTileMode::kClamp);
+    builder.SaveLayer(nullptr, &paint, backdrop_filter.get());
+    builder.Restore();
+    builder.Restore();
+  }
+
+  ASSERT_TRUE(OpenPlaygroundHere(builder.Build()));
+}
+
 // Smoketest to catch issues with the coverage hint.
 // Draws a rotated blurred image within a rectangle clip. The center of the clip
 // rectangle is the center of the rotated image. The entire area of the clip
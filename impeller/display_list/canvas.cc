@@ -160,6 +160,33 @@ static std::unique_ptr<EntityPassTarget> CreateRenderTarget(
 
 }  // namespace
 
+void BackdropData::RecordFilter(
+    const std::shared_ptr<flutter::DlImageFilter>& filter,
+    const Matrix& effect_transform) {
+  backdrop_count++;
+  BackdropFilterData* existing = FindFilter(*filter, effect_transform);
+  if (existing) {
+    existing->backdrop_count++;
+    return;
+  }
+  filters.push_back(BackdropFilterData{
+      .filter = filter,
+      .effect_transform = effect_transform,
+      .backdrop_count = 1,
+  });
+}
+
+BackdropFilterData* BackdropData::FindFilter(
+    const flutter::DlImageFilter& filter,
+    const Matrix& effect_transform) {
+  for (BackdropFilterData& data : filters) {
+    if (data.effect_transform == effect_transform && *data.filter == filter) {
+      return &data;
+    }
+  }
+  return nullptr;
+}
+
 Canvas::Canvas(ContentContext& renderer,
                const RenderTarget& render_target,
                bool requires_readback)
@@ -468,6 +495,11 @@ void Canvas::DrawRect(const Rect& rect, const Paint& paint) {
     return;
   }
 
+  if (AttemptBatchSolidColorFill(SolidColorBatch::Shape::MakeRect(rect),
+                                 paint)) {
+    return;
+  }
+
   Entity entity;
   entity.SetTransform(GetCurrentTransform());
   entity.SetBlendMode(paint.blend_mode);
@@ -515,6 +547,12 @@ void Canvas::DrawRoundRect(const RoundRect& round_rect, const Paint& paint) {
     }
 
     if (paint.style == Paint::Style::kFill) {
+      if (AttemptBatchSolidColorFill(
+              SolidColorBatch::Shape::MakeRoundRect(rect, radii.top_left),
+              paint)) {
+        return;
+      }
+
       Entity entity;
       entity.SetTransform(GetCurrentTransform());
       entity.SetBlendMode(paint.blend_mode);
@@ -543,6 +581,12 @@ void Canvas::DrawCircle(const Point& center,
     return;
   }
 
+  if (paint.style == Paint::Style::kFill &&
+      AttemptBatchSolidColorFill(
+          SolidColorBatch::Shape::MakeCircle(center, radius), paint)) {
+    return;
+  }
+
   Entity entity;
   entity.SetTransform(GetCurrentTransform());
   entity.SetBlendMode(paint.blend_mode);
@@ -562,6 +606,7 @@ void Canvas::ClipGeometry(const Geometry& geometry,
   if (IsSkipping()) {
     return;
   }
+  FlushSolidColorBatch();
 
   // Ideally the clip depth would be greater than the current rendering
   // depth because any rendering calls that follow this clip operation will
@@ -960,6 +1005,7 @@ void Canvas::SaveLayer(const Paint& paint,
                        bool can_distribute_opacity,
                        std::optional<int64_t> backdrop_id) {
   TRACE_EVENT0("flutter", "Canvas::saveLayer");
+  FlushSolidColorBatch();
   if (IsSkipping()) {
     return SkipUntilMatchingRestore(total_content_depth);
   }
@@ -1091,9 +1137,9 @@ void Canvas::SaveLayer(const Paint& paint,
       input_texture = backdrop_data->texture_slot;
     }
 
+    Matrix effect_transform = transform_stack_.back().transform.Basis();
     backdrop_filter_contents = backdrop_filter_proc(
-        FilterInput::Make(std::move(input_texture)),
-        transform_stack_.back().transform.Basis(),
+        FilterInput::Make(std::move(input_texture)), effect_transform,
         // When the subpass has a translation that means the math with
         // the snapshot has to be different.
         transform_stack_.back().transform.HasTranslation()
@@ -1102,17 +1148,21 @@ void Canvas::SaveLayer(const Paint& paint,
 
     if (will_cache_backdrop_texture) {
       FML_DCHECK(backdrop_data);
-      // If all filters on the shared backdrop layer are equal, process the
-      // layer once.
-      if (backdrop_data->all_filters_equal &&
-          !backdrop_data->shared_filter_snapshot.has_value()) {
-        // TODO(157110): compute minimum input hint.
-        backdrop_data->shared_filter_snapshot =
-            backdrop_filter_contents->RenderToSnapshot(renderer_, {});
+      // Process each filter that is applied to the shared backdrop by more
+      // than one layer under the same effect transform once, and reuse the
+      // result for the other layers.
+      BackdropFilterData* filter_data =
+          backdrop_data->FindFilter(*backdrop_filter, effect_transform);
+      std::optional<Snapshot> maybe_snapshot;
+      if (filter_data && filter_data->backdrop_count > 1) {
+        if (!filter_data->snapshot.has_value()) {
+          // TODO(157110): compute minimum input hint.
+          filter_data->snapshot =
+              backdrop_filter_contents->RenderToSnapshot(renderer_, {});
+          ++backdrop_filter_render_count_;
+        }
+        maybe_snapshot = filter_data->snapshot;
       }
-
-      std::optional<Snapshot> maybe_snapshot =
-          backdrop_data->shared_filter_snapshot;
       if (maybe_snapshot.has_value()) {
         Snapshot snapshot = maybe_snapshot.value();
         std::shared_ptr<TextureContents> contents = TextureContents::MakeRect(
@@ -1186,6 +1236,7 @@ bool Canvas::Restore() {
   if (transform_stack_.size() == 1) {
     return false;
   }
+  FlushSolidColorBatch();
 
   // This check is important to make sure we didn't exceed the depth
   // that the clips were rendered at while rendering any of the
@@ -1441,6 +1492,7 @@ void Canvas::AddRenderEntityToCurrentPass(Entity& entity, bool reuse_depth) {
   if (IsSkipping()) {
     return;
   }
+  FlushSolidColorBatch();
 
   entity.SetTransform(
       Matrix::MakeTranslation(Vector3(-GetGlobalPassPosition())) *
@@ -1528,9 +1580,79 @@ void Canvas::AddRenderEntityToCurrentPass(Entity& entity, bool reuse_depth) {
     return;
   }
 
+  ++rendered_entity_count_;
   entity.Render(renderer_, *result);
 }
 
+bool Canvas::AttemptBatchSolidColorFill(const SolidColorBatch::Shape& shape,
+                                        const Paint& paint) {
+  if (!solid_color_batching_enabled_ || paint.style != Paint::Style::kFill ||
+      paint.color_source || paint.color_filter || paint.invert_colors ||
+      paint.image_filter || paint.mask_blur_descriptor.has_value()) {
+    return false;
+  }
+  if (IsSkipping()) {
+    return true;
+  }
+  // Fills that could replace the clear color of the pass are left to
+  // AddRenderEntityToCurrentPass, which also starts the pass.
+  if (render_passes_.back().IsApplyingClearColor()) {
+    return false;
+  }
+
+  const Matrix transform =
+      Matrix::MakeTranslation(Vector3(-GetGlobalPassPosition())) *
+      GetCurrentTransform();
+  if (transform.HasPerspective()) {
+    return false;
+  }
+
+  Color color = paint.color;
+  color.alpha *= transform_stack_.back().distributed_opacity;
+  BlendMode blend_mode = paint.blend_mode;
+  if (blend_mode == BlendMode::kSourceOver && color.IsOpaque()) {
+    blend_mode = BlendMode::kSource;
+  }
+  if (blend_mode > Entity::kLastPipelineBlendMode) {
+    return false;
+  }
+
+  if (!solid_color_batch_.IsCompatible(blend_mode)) {
+    FlushSolidColorBatch();
+  }
+  const uint32_t clip_depth = current_depth_ + 1;
+  SolidColorBatch::AppendResult result =
+      solid_color_batch_.Append(renderer_.GetTessellator(), transform, shape,
+                                color, blend_mode, clip_depth);
+  if (result == SolidColorBatch::AppendResult::kBatchFull) {
+    FlushSolidColorBatch();
+    result = solid_color_batch_.Append(renderer_.GetTessellator(), transform,
+                                       shape, color, blend_mode, clip_depth);
+  }
+  if (result != SolidColorBatch::AppendResult::kAppended) {
+    return false;
+  }
+
+  ++current_depth_;
+  FML_DCHECK(current_depth_ <= transform_stack_.back().clip_depth)
+      << current_depth_ << " <=? " << transform_stack_.back().clip_depth;
+  return true;
+}
+
+void Canvas::FlushSolidColorBatch() {
+  if (solid_color_batch_.IsEmpty()) {
+    return;
+  }
+  const std::shared_ptr<RenderPass>& render_pass =
+      render_passes_.back().inline_pass_context->GetRenderPass();
+  if (!render_pass) {
+    solid_color_batch_.Reset();
+    return;
+  }
+  ++rendered_entity_count_;
+  solid_color_batch_.Render(renderer_, *render_pass);
+}
+
 RenderPass& Canvas::GetCurrentRenderPass() const {
   return *render_passes_.back().inline_pass_context->GetRenderPass();
 }
@@ -1545,6 +1667,7 @@ void Canvas::SetBackdropData(
 std::shared_ptr<Texture> Canvas::FlipBackdrop(Point global_pass_position,
                                               bool should_remove_texture,
                                               bool should_use_onscreen) {
+  FlushSolidColorBatch();
   LazyRenderingConfig rendering_config = std::move(render_passes_.back());
   render_passes_.pop_back();
 
@@ -1714,6 +1837,7 @@ bool Canvas::BlitToOnscreen() {
 
 void Canvas::EndReplay() {
   FML_DCHECK(render_passes_.size() == 1u);
+  FlushSolidColorBatch();
   render_passes_.back().inline_pass_context->GetRenderPass();
   render_passes_.back().inline_pass_context->EndPass();
   backdrop_data_.clear();
@@ -22,6 +22,7 @@
 #include "impeller/entity/geometry/geometry.h"
 #include "impeller/entity/geometry/vertices_geometry.h"
 #include "impeller/entity/inline_pass_context.h"
+#include "impeller/entity/solid_color_batch.h"
 #include "impeller/geometry/matrix.h"
 #include "impeller/geometry/path.h"
 #include "impeller/geometry/point.h"
@@ -32,14 +33,41 @@
 
 namespace impeller {
 
+/// A distinct filter applied to a shared backdrop under a distinct effect
+/// transform.
+struct BackdropFilterData {
+  std::shared_ptr<flutter::DlImageFilter> filter;
+  /// The basis of the transform the filter is applied under.
+  Matrix effect_transform;
+  /// The number of backdrop layers that apply an identical filter under the
+  /// same effect transform.
+  size_t backdrop_count = 0;
+  /// The result of the filter, computed by the first of those layers and
+  /// reused by the others.
+  std::optional<Snapshot> snapshot;
+};
+
+/// The backdrop shared by the backdrop layers with the same backdrop id.
+///
+/// This only lives for a single frame. Reusing the filtered backdrops across
+/// frames, when the DiffContext reports that neither the backdrop nor the
+/// filters changed, is not implemented yet.
 struct BackdropData {
   size_t backdrop_count = 0;
-  bool all_filters_equal = true;
   std::shared_ptr<Texture> texture_slot;
-  // A single snapshot of the backdrop filter that is used when there are
-  // multiple backdrops that share an identical filter.
-  std::optional<Snapshot> shared_filter_snapshot;
-  std::shared_ptr<flutter::DlImageFilter> last_backdrop;
+  /// The distinct filters applied to the backdrop, in the order they were
+  /// first recorded.
+  std::vector<BackdropFilterData> filters;
+
+  /// Records a backdrop layer that applies `filter` to the backdrop under
+  /// `effect_transform`.
+  void RecordFilter(const std::shared_ptr<flutter::DlImageFilter>& filter,
+                    const Matrix& effect_transform);
+
+  /// The data of the filter equal to `filter` applied under
+  /// `effect_transform`, or nullptr if no layer recorded one.
+  BackdropFilterData* FindFilter(const flutter::DlImageFilter& filter,
+                                 const Matrix& effect_transform);
 };
 
 struct CanvasStackEntry {
@@ -248,6 +276,23 @@ class Canvas {
   // Visible for testing.
   bool RequiresReadback() const { return requires_readback_; }
 
+  /// The number of entities and solid color batches rendered to the passes of
+  /// this canvas so far.
+  // Visible for testing.
+  size_t GetRenderedEntityCount() const { return rendered_entity_count_; }
+
+  // Visible for testing.
+  void SetSolidColorBatchingEnabled(bool enabled) {
+    solid_color_batching_enabled_ = enabled;
+  }
+
+  /// The number of times a backdrop filter shared by several layers was
+  /// rendered to a snapshot.
+  // Visible for testing.
+  size_t GetSharedBackdropFilterRenderCount() const {
+    return backdrop_filter_render_count_;
+  }
+
  private:
   ContentContext& renderer_;
   RenderTarget render_target_;
@@ -283,6 +328,12 @@ class Canvas {
 
   uint64_t current_depth_ = 0u;
 
+  /// Solid color fills that have not been rendered to the current pass yet.
+  SolidColorBatch solid_color_batch_;
+  bool solid_color_batching_enabled_ = true;
+  size_t rendered_entity_count_ = 0u;
+  size_t backdrop_filter_render_count_ = 0u;
+
   Point GetGlobalPassPosition() const;
 
   // clip depth of the previous save or 0.
@@ -337,6 +388,20 @@ class Canvas {
                                Size corner_radii,
                                const Paint& paint);
 
+  /// @brief  Append a solid color fill to the pending batch instead of
+  ///         rendering it as its own entity.
+  ///
+  /// Returns false if the paint or the current state requires the fill to be
+  /// drawn as an entity.
+  bool AttemptBatchSolidColorFill(const SolidColorBatch::Shape& shape,
+                                  const Paint& paint);
+
+  /// @brief  Render the pending solid color fills to the current pass.
+  ///
+  /// This must be called before anything else is rendered to the current pass
+  /// or the pass, its scissor or its clips are changed.
+  void FlushSolidColorBatch();
+
   RenderPass& GetCurrentRenderPass() const;
 
   Canvas(const Canvas&) = delete;
@@ -2,27 +2,31 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <cstring>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "flutter/display_list/dl_tile_mode.h"
 #include "flutter/display_list/effects/dl_image_filter.h"
 #include "flutter/display_list/geometry/dl_geometry_types.h"
+#include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/testing/testing.h"
 #include "gtest/gtest.h"
+#include "impeller/core/device_buffer_descriptor.h"
 #include "impeller/core/formats.h"
 #include "impeller/core/texture_descriptor.h"
 #include "impeller/display_list/aiks_unittests.h"
 #include "impeller/display_list/canvas.h"
 #include "impeller/geometry/geometry_asserts.h"
+#include "impeller/renderer/blit_pass.h"
+#include "impeller/renderer/command_buffer.h"
 #include "impeller/renderer/render_target.h"
 
 namespace impeller {
 namespace testing {
 
-std::unique_ptr<Canvas> CreateTestCanvas(
-    ContentContext& context,
-    std::optional<Rect> cull_rect = std::nullopt,
-    bool requires_readback = false) {
+RenderTarget CreateTestRenderTarget(ContentContext& context) {
   TextureDescriptor onscreen_desc;
   onscreen_desc.size = {100, 100};
   onscreen_desc.format =
@@ -54,7 +58,14 @@ std::unique_ptr<Canvas> CreateTestCanvas(
 
   RenderTarget render_target;
   render_target.SetColorAttachment(color0, 0);
+  return render_target;
+}
 
+std::unique_ptr<Canvas> CreateTestCanvas(
+    ContentContext& context,
+    std::optional<Rect> cull_rect = std::nullopt,
+    bool requires_readback = false) {
+  RenderTarget render_target = CreateTestRenderTarget(context);
   if (cull_rect.has_value()) {
     return std::make_unique<Canvas>(context, render_target, requires_readback,
                                     cull_rect.value());
@@ -62,6 +73,47 @@ std::unique_ptr<Canvas> CreateTestCanvas(
   return std::make_unique<Canvas>(context, render_target, requires_readback);
 }
 
+// Reads back the pixels of |texture|, or returns an empty vector on failure.
+std::vector<uint8_t> ReadPixels(const std::shared_ptr<Context>& context,
+                                const std::shared_ptr<Texture>& texture) {
+  DeviceBufferDescriptor buffer_desc;
+  buffer_desc.storage_mode = StorageMode::kHostVisible;
+  buffer_desc.size =
+      texture->GetTextureDescriptor().GetByteSizeOfBaseMipLevel();
+  std::shared_ptr<DeviceBuffer> buffer =
+      context->GetResourceAllocator()->CreateBuffer(buffer_desc);
+  std::shared_ptr<CommandBuffer> command_buffer =
+      context->CreateCommandBuffer();
+  if (!buffer || !command_buffer) {
+    return {};
+  }
+  std::shared_ptr<BlitPass> blit_pass = command_buffer->CreateBlitPass();
+  if (!blit_pass->AddCopy(texture, buffer) ||
+      !blit_pass->EncodeCommands(context->GetResourceAllocator())) {
+    return {};
+  }
+
+  fml::AutoResetWaitableEvent latch;
+  bool completed = false;
+  if (!context->GetCommandQueue()
+           ->Submit({command_buffer},
+                    [&latch, &completed](CommandBuffer::Status status) {
+                      completed = status == CommandBuffer::Status::kCompleted;
+                      latch.Signal();
+                    })
+           .ok()) {
+    return {};
+  }
+  latch.Wait();
+  if (!completed) {
+    return {};
+  }
+
+  std::vector<uint8_t> pixels(buffer_desc.size);
+  std::memcpy(pixels.data(), buffer->OnGetContents(), pixels.size());
+  return pixels;
+}
+
 TEST_P(AiksTest, TransformMultipliesCorrectly) {
   ContentContext context(GetContext(), nullptr);
   auto canvas = CreateTestCanvas(context);
@@ -276,5 +328,123 @@ TEST_P(AiksTest, BackdropCountDownWithNestedSaveLayers) {
   EXPECT_TRUE(canvas->RequiresReadback());
 }
 
+TEST_P(AiksTest, ConsecutiveSolidColorRectsAreBatched) {
+  constexpr size_t kRectCount = 16u;
+
+  // Draws overlapping translucent rects of different colors, so that their
+  // order matters, and returns the number of entities rendered with the
+  // resulting pixels.
+  auto draw_rects = [&](bool batching_enabled) {
+    ContentContext context(GetContext(), nullptr);
+    RenderTarget render_target = CreateTestRenderTarget(context);
+    Canvas canvas(context, render_target, /*requires_readback=*/false);
+    canvas.SetSolidColorBatchingEnabled(batching_enabled);
+    for (size_t i = 0; i < kRectCount; i++) {
+      Paint paint;
+      paint.color =
+          Color(i / static_cast<Scalar>(kRectCount), 0.5, 1.0, 0.75);
+      canvas.DrawRect(Rect::MakeXYWH(i * 5, i * 4, 20, 20), paint);
+    }
+    canvas.EndReplay();
+    return std::make_pair(
+        canvas.GetRenderedEntityCount(),
+        ReadPixels(GetContext(), render_target.GetRenderTargetTexture()));
+  };
+
+  auto [unbatched_count, unbatched_pixels] = draw_rects(false);
+  auto [batched_count, batched_pixels] = draw_rects(true);
+
+  EXPECT_EQ(unbatched_count, kRectCount);
+  // The first rect starts the pass and is rendered as an entity, the rest
+  // share a batch.
+  EXPECT_EQ(batched_count, 2u);
+
+  ASSERT_FALSE(unbatched_pixels.empty());
+  ASSERT_EQ(batched_pixels.size(), unbatched_pixels.size());
+  for (size_t i = 0; i < batched_pixels.size(); i++) {
+    ASSERT_NEAR(batched_pixels[i], unbatched_pixels[i], 1) << "at byte " << i;
+  }
+}
+
+TEST_P(AiksTest, BackdropDataGroupsEqualFilters) {
+  auto blur =
+      flutter::DlImageFilter::MakeBlur(4, 4, flutter::DlTileMode::kClamp);
+  auto equal_blur =
+      flutter::DlImageFilter::MakeBlur(4, 4, flutter::DlTileMode::kClamp);
+  auto other_blur =
+      flutter::DlImageFilter::MakeBlur(8, 8, flutter::DlTileMode::kClamp);
+
+  const Matrix scale = Matrix::MakeScale({2, 2, 1});
+
+  BackdropData data;
+  data.RecordFilter(blur, Matrix());
+  data.RecordFilter(other_blur, Matrix());
+  data.RecordFilter(equal_blur, Matrix());
+  data.RecordFilter(equal_blur, scale);
+
+  EXPECT_EQ(data.backdrop_count, 4u);
+  ASSERT_EQ(data.filters.size(), 3u);
+  BackdropFilterData* blur_data = data.FindFilter(*equal_blur, Matrix());
+  ASSERT_NE(blur_data, nullptr);
+  EXPECT_EQ(blur_data->backdrop_count, 2u);
+  BackdropFilterData* scaled_blur_data = data.FindFilter(*blur, scale);
+  ASSERT_NE(scaled_blur_data, nullptr);
+  EXPECT_EQ(scaled_blur_data->backdrop_count, 1u);
+  BackdropFilterData* other_blur_data =
+      data.FindFilter(*other_blur, Matrix());
+  ASSERT_NE(other_blur_data, nullptr);
+  EXPECT_EQ(other_blur_data->backdrop_count, 1u);
+
+  auto unused_blur =
+      flutter::DlImageFilter::MakeBlur(2, 2, flutter::DlTileMode::kClamp);
+  EXPECT_EQ(data.FindFilter(*unused_blur, Matrix()), nullptr);
+  EXPECT_EQ(data.FindFilter(*other_blur, scale), nullptr);
+}
+
+TEST_P(AiksTest, SharedBackdropFilterIsRenderedOnce) {
+  ContentContext context(GetContext(), nullptr);
+  auto canvas = CreateTestCanvas(context, Rect::MakeLTRB(0, 0, 100, 100),
+                                 /*requires_readback=*/true);
+  auto blur =
+      flutter::DlImageFilter::MakeBlur(4, 4, flutter::DlTileMode::kClamp);
+  auto other_blur =
+      flutter::DlImageFilter::MakeBlur(8, 8, flutter::DlTileMode::kClamp);
+  const Matrix scale = Matrix::MakeScale({2, 2, 1});
+
+  // Three layers apply the same filter under the same transform, one under a
+  // different transform and one applies a different filter.
+  std::unordered_map<int64_t, BackdropData> data;
+  data[1].RecordFilter(blur, Matrix());
+  data[1].RecordFilter(blur, Matrix());
+  data[1].RecordFilter(blur, Matrix());
+  data[1].RecordFilter(blur, scale);
+  data[1].RecordFilter(other_blur, Matrix());
+  canvas->SetBackdropData(data, 5);
+
+  canvas->DrawRect(flutter::DlRect::MakeLTRB(0, 0, 50, 50),
+                   {.color = Color::Azure()});
+  auto save_backdrop_layer = [&](const flutter::DlImageFilter* filter,
+                                 const Matrix& transform) {
+    canvas->Save(/*total_content_depth=*/2);
+    canvas->Concat(transform);
+    canvas->SaveLayer({}, std::nullopt, filter,
+                      ContentBoundsPromise::kContainsContents,
+                      /*total_content_depth=*/1,
+                      /*can_distribute_opacity=*/false, /*backdrop_id=*/1);
+    canvas->Restore();
+    canvas->Restore();
+  };
+  save_backdrop_layer(blur.get(), Matrix());
+  save_backdrop_layer(blur.get(), scale);
+  save_backdrop_layer(blur.get(), Matrix());
+  save_backdrop_layer(other_blur.get(), Matrix());
+  save_backdrop_layer(blur.get(), Matrix());
+
+  // Only the filter shared by several layers is rendered to a snapshot, and
+  // only once.
+  EXPECT_EQ(canvas->GetSharedBackdropFilterRenderCount(), 1u);
+  canvas->EndReplay();
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -1002,21 +1002,9 @@ void FirstPassDispatcher::saveLayer(const DlRect& bounds,
 
   backdrop_count_ += (backdrop == nullptr ? 0 : 1);
   if (backdrop != nullptr && backdrop_id.has_value()) {
-    std::shared_ptr<flutter::DlImageFilter> shared_backdrop =
-        backdrop->shared();
-    std::unordered_map<int64_t, BackdropData>::iterator existing =
-        backdrop_data_.find(backdrop_id.value());
-    if (existing == backdrop_data_.end()) {
-      backdrop_data_[backdrop_id.value()] =
-          BackdropData{.backdrop_count = 1, .last_backdrop = shared_backdrop};
-    } else {
-      BackdropData& data = existing->second;
-      data.backdrop_count++;
-      if (data.all_filters_equal) {
-        data.all_filters_equal = (*data.last_backdrop == *shared_backdrop);
-        data.last_backdrop = shared_backdrop;
-      }
-    }
+    // The canvas applies the filter under the basis of the layer transform.
+    backdrop_data_[backdrop_id.value()].RecordFilter(backdrop->shared(),
+                                                     matrix_.Basis());
   }
 
   // This dispatcher does not track enough state to accurately compute
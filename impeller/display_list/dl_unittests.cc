@@ -1556,5 +1556,47 @@ TEST_P(DisplayListTest, DrawMaskBlursThatMightUseSaveLayers) {
   ASSERT_TRUE(OpenPlaygroundHere(builder.Build()));
 }
 
+TEST_P(DisplayListTest, FirstPassRecordsDistinctBackdropFilters) {
+  flutter::DisplayListBuilder builder;
+  auto blur =
+      flutter::DlImageFilter::MakeBlur(4, 4, flutter::DlTileMode::kClamp);
+  auto other_blur =
+      flutter::DlImageFilter::MakeBlur(8, 8, flutter::DlTileMode::kClamp);
+  // Layers that only differ in translation share a filter, while a scaled
+  // layer filters the backdrop under a different effect transform.
+  for (int i = 0; i < 4; i++) {
+    builder.Save();
+    builder.Translate(i * 10, 0);
+    builder.SaveLayer(std::nullopt, nullptr, blur.get(), /*backdrop_id=*/1);
+    builder.Restore();
+    builder.Restore();
+  }
+  builder.Save();
+  builder.Scale(2, 2);
+  builder.SaveLayer(std::nullopt, nullptr, blur.get(), /*backdrop_id=*/1);
+  builder.Restore();
+  builder.Restore();
+  builder.SaveLayer(std::nullopt, nullptr, other_blur.get(),
+                    /*backdrop_id=*/1);
+  builder.Restore();
+  auto display_list = builder.Build();
+
+  ContentContext context(GetContext(), nullptr);
+  FirstPassDispatcher collector(context, Matrix(), Rect::MakeWH(1000, 1000));
+  display_list->Dispatch(collector, SkIRect::MakeWH(1000, 1000));
+  const auto& [backdrop_data, backdrop_count] = collector.TakeBackdropData();
+
+  EXPECT_EQ(backdrop_count, 6u);
+  ASSERT_EQ(backdrop_data.size(), 1u);
+  const BackdropData& data = backdrop_data.at(1);
+  EXPECT_EQ(data.backdrop_count, 6u);
+  ASSERT_EQ(data.filters.size(), 3u);
+  EXPECT_EQ(data.filters[0].backdrop_count, 4u);
+  EXPECT_EQ(data.filters[0].effect_transform, Matrix());
+  EXPECT_EQ(data.filters[1].backdrop_count, 1u);
+  EXPECT_EQ(data.filters[1].effect_transform, Matrix::MakeScale({2, 2, 1}));
+  EXPECT_EQ(data.filters[2].backdrop_count, 1u);
+}
+
 }  // namespace testing
 }  // namespace impeller
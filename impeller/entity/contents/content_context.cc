@@ -13,6 +13,10 @@
 #include "impeller/core/texture_descriptor.h"
 #include "impeller/entity/contents/framebuffer_blend_contents.h"
 #include "impeller/entity/entity.h"
+#include "impeller/entity/geometry/tessellation_cache.h"
+#ifdef IMPELLER_ENABLE_COMPUTE
+#include "impeller/entity/geometry/compute_path_rasterizer.h"
+#endif  // IMPELLER_ENABLE_COMPUTE
 #include "impeller/entity/render_target_cache.h"
 #include "impeller/renderer/command_buffer.h"
 #include "impeller/renderer/pipeline_descriptor.h"
@@ -220,6 +224,37 @@ void ContentContextOptions::ApplyToPipelineDescriptor(
   desc.SetPolygonMode(wireframe ? PolygonMode::kLine : PolygonMode::kFill);
 }
 
+std::optional<ContentContextOptions> ContentContextOptions::FromKey(
+    uint64_t key) {
+  const auto field = [key](int shift) -> uint8_t {
+    return static_cast<uint8_t>(key >> shift);
+  };
+  ContentContextOptions options{
+      .sample_count = static_cast<SampleCount>(field(48)),
+      .blend_mode = static_cast<BlendMode>(field(40)),
+      .depth_compare = static_cast<CompareFunction>(field(32)),
+      .stencil_mode = static_cast<StencilMode>(field(24)),
+      .primitive_type = static_cast<PrimitiveType>(field(16)),
+      .color_attachment_pixel_format = static_cast<PixelFormat>(field(8)),
+      .has_depth_stencil_attachments = (key & (1llu << 2)) != 0,
+      .depth_write_enabled = (key & (1llu << 3)) != 0,
+      .wireframe = (key & (1llu << 1)) != 0,
+      .is_for_rrect_blur_clear = (key & (1llu << 0)) != 0,
+  };
+  // Reject unused bits and enum values that are out of range.
+  if (options.ToKey() != key ||
+      (options.sample_count != SampleCount::kCount1 &&
+       options.sample_count != SampleCount::kCount4) ||
+      options.blend_mode > Entity::kLastPipelineBlendMode ||
+      options.depth_compare > CompareFunction::kGreaterEqual ||
+      options.stencil_mode > StencilMode::kOverdrawPreventionRestore ||
+      options.primitive_type > PrimitiveType::kTriangleFan ||
+      options.color_attachment_pixel_format > PixelFormat::kB10G10R10A10XR) {
+    return std::nullopt;
+  }
+  return options;
+}
+
 template <typename PipelineT>
 static std::unique_ptr<PipelineT> CreateDefaultPipeline(
     const Context& context) {
@@ -240,17 +275,20 @@ static std::unique_ptr<PipelineT> CreateDefaultPipeline(
 ContentContext::ContentContext(
     std::shared_ptr<Context> context,
     std::shared_ptr<TypographerContext> typographer_context,
-    std::shared_ptr<RenderTargetAllocator> render_target_allocator)
+    std::shared_ptr<RenderTargetAllocator> render_target_allocator,
+    std::shared_ptr<PipelineVariantManifest> variant_manifest)
     : context_(std::move(context)),
       lazy_glyph_atlas_(
           std::make_shared<LazyGlyphAtlas>(std::move(typographer_context))),
       tessellator_(std::make_shared<Tessellator>()),
+      tessellation_cache_(std::make_shared<TessellationCache>()),
       render_target_cache_(render_target_allocator == nullptr
                                ? std::make_shared<RenderTargetCache>(
                                      context_->GetResourceAllocator())
                                : std::move(render_target_allocator)),
       host_buffer_(HostBuffer::Create(context_->GetResourceAllocator(),
-                                      context_->GetIdleWaiter())) {
+                                      context_->GetIdleWaiter())),
+      variant_manifest_(std::move(variant_manifest)) {
   if (!context_ || !context_->IsValid()) {
     return;
   }
@@ -350,6 +388,9 @@ ContentContext::ContentContext(
                                            {supports_decal});
     gaussian_blur_pipelines_.CreateDefault(*context_, options_trianglestrip,
                                            {supports_decal});
+    kawase_downsample_pipelines_.CreateDefault(*context_,
+                                               options_trianglestrip);
+    kawase_upsample_pipelines_.CreateDefault(*context_, options_trianglestrip);
     border_mask_blur_pipelines_.CreateDefault(*context_, options_trianglestrip);
     color_matrix_color_filter_pipelines_.CreateDefault(*context_,
                                                        options_trianglestrip);
@@ -472,10 +513,15 @@ ContentContext::ContentContext(
 #endif  // IMPELLER_ENABLE_OPENGLES
 
   is_valid_ = true;
+  PrewarmPipelineVariants();
   InitializeCommonlyUsedShadersIfNeeded();
 }
 
-ContentContext::~ContentContext() = default;
+ContentContext::~ContentContext() {
+  if (variant_manifest_ && variant_manifest_->GetPendingEntryCount() > 0u) {
+    variant_manifest_->Persist();
+  }
+}
 
 bool ContentContext::IsValid() const {
   return is_valid_;
@@ -557,6 +603,21 @@ Tessellator& ContentContext::GetTessellator() const {
   return *tessellator_;
 }
 
+TessellationCache& ContentContext::GetTessellationCache() const {
+  return *tessellation_cache_;
+}
+
+const ComputePathRasterizer* ContentContext::GetComputePathRasterizer() const {
+#ifdef IMPELLER_ENABLE_COMPUTE
+  if (!compute_path_rasterization_enabled_) {
+    return nullptr;
+  }
+  return compute_path_rasterizer_.get();
+#else
+  return nullptr;
+#endif  // IMPELLER_ENABLE_COMPUTE
+}
+
 std::shared_ptr<Context> ContentContext::GetContext() const {
   return context_;
 }
@@ -569,6 +630,26 @@ void ContentContext::SetWireframe(bool wireframe) {
   wireframe_ = wireframe;
 }
 
+void ContentContext::SetComputePathRasterizationEnabled(bool enabled) {
+  compute_path_rasterization_enabled_ = enabled;
+#ifdef IMPELLER_ENABLE_COMPUTE
+  if (!enabled || !is_valid_ || compute_path_rasterizer_ ||
+      !ComputePathRasterizer::IsSupported(*context_->GetCapabilities())) {
+    return;
+  }
+  auto rasterizer = std::make_unique<ComputePathRasterizer>(*context_);
+  if (!rasterizer->IsValid()) {
+    return;
+  }
+  compute_path_rasterizer_ = std::move(rasterizer);
+  path_coverage_fill_pipelines_.CreateDefault(
+      *context_, ContentContextOptions{
+                     .sample_count = SampleCount::kCount4,
+                     .color_attachment_pixel_format =
+                         context_->GetCapabilities()->GetDefaultColorFormat()});
+#endif  // IMPELLER_ENABLE_COMPUTE
+}
+
 PipelineRef ContentContext::GetCachedRuntimeEffectPipeline(
     const std::string& unique_entrypoint_name,
     const ContentContextOptions& options,
@@ -594,6 +675,40 @@ void ContentContext::ClearCachedRuntimeEffectPipeline(
   }
 }
 
+void ContentContext::PrewarmPipelineVariants() {
+  if (!variant_manifest_) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "PrewarmPipelineVariants");
+#define IMPELLER_VARIANTS_ADDRESS(pipeline_handle, member) &member,
+  GenericVariants* const all_variants[] = {
+      IMPELLER_FOR_EACH_ALL_CONTENT_CONTEXT_VARIANTS(
+          IMPELLER_VARIANTS_ADDRESS)};
+#undef IMPELLER_VARIANTS_ADDRESS
+  std::unordered_map<uint64_t, GenericVariants*> families;
+  for (GenericVariants* variants : all_variants) {
+    if (variants->GetFamily() != 0u) {
+      families[variants->GetFamily()] = variants;
+    }
+  }
+
+  // The variants are compiled asynchronously by the pipeline library in the
+  // order they were first used in previous launches.
+  for (const PipelineVariantManifest::Entry& entry :
+       variant_manifest_->GetEntries()) {
+    auto family = families.find(entry.family);
+    if (family == families.end()) {
+      continue;
+    }
+    std::optional<ContentContextOptions> options =
+        ContentContextOptions::FromKey(entry.options_key);
+    if (!options.has_value()) {
+      continue;
+    }
+    family->second->Prewarm(*context_, options.value());
+  }
+}
+
 void ContentContext::InitializeCommonlyUsedShadersIfNeeded() const {
   TRACE_EVENT0("flutter", "InitializeCommonlyUsedShadersIfNeeded");
   GetContext()->InitializeCommonlyUsedShadersIfNeeded();
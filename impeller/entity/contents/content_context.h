@@ -15,6 +15,7 @@
 #include "impeller/base/validation.h"
 #include "impeller/core/formats.h"
 #include "impeller/core/host_buffer.h"
+#include "impeller/entity/contents/pipeline_variant_manifest.h"
 #include "impeller/renderer/capabilities.h"
 #include "impeller/renderer/command_buffer.h"
 #include "impeller/renderer/pipeline.h"
@@ -36,6 +37,8 @@
 #include "impeller/entity/glyph_atlas.frag.h"
 #include "impeller/entity/glyph_atlas.vert.h"
 #include "impeller/entity/gradient_fill.vert.h"
+#include "impeller/entity/kawase_downsample.frag.h"
+#include "impeller/entity/kawase_upsample.frag.h"
 #include "impeller/entity/linear_gradient_fill.frag.h"
 #include "impeller/entity/linear_to_srgb_filter.frag.h"
 #include "impeller/entity/morphology_filter.frag.h"
@@ -79,6 +82,10 @@
 #include "impeller/entity/tiled_texture_fill_external.frag.h"
 #endif  // IMPELLER_ENABLE_OPENGLES
 
+#ifdef IMPELLER_ENABLE_COMPUTE
+#include "impeller/entity/path_coverage_fill.frag.h"
+#endif  // IMPELLER_ENABLE_COMPUTE
+
 namespace impeller {
 
 using FastGradientPipeline =
@@ -136,6 +143,12 @@ using TiledTexturePipeline =
                          TiledTextureFillFragmentShader>;
 using GaussianBlurPipeline =
     RenderPipelineHandle<FilterPositionUvVertexShader, GaussianFragmentShader>;
+using KawaseDownsamplePipeline =
+    RenderPipelineHandle<FilterPositionUvVertexShader,
+                         KawaseDownsampleFragmentShader>;
+using KawaseUpsamplePipeline =
+    RenderPipelineHandle<FilterPositionUvVertexShader,
+                         KawaseUpsampleFragmentShader>;
 using BorderMaskBlurPipeline =
     RenderPipelineHandle<FilterPositionUvVertexShader,
                          BorderMaskBlurFragmentShader>;
@@ -262,6 +275,107 @@ using TextureDownsampleGlesPipeline =
                          TextureDownsampleGlesFragmentShader>;
 #endif  // IMPELLER_ENABLE_OPENGLES
 
+#ifdef IMPELLER_ENABLE_COMPUTE
+using PathCoverageFillPipeline =
+    RenderPipelineHandle<SolidFillVertexShader, PathCoverageFillFragmentShader>;
+#endif  // IMPELLER_ENABLE_COMPUTE
+
+/// The pipeline variant families held by a ContentContext, as pairs of the
+/// pipeline handle type and the name of the member that holds its variants.
+///
+/// Every family is declared from this list, so it is also the list of the
+/// families whose variants are replayed from the pipeline variant manifest.
+#define IMPELLER_FOR_EACH_CONTENT_CONTEXT_VARIANTS(V)                          \
+  V(SolidFillPipeline, solid_fill_pipelines_)                                  \
+  V(FastGradientPipeline, fast_gradient_pipelines_)                            \
+  V(LinearGradientFillPipeline, linear_gradient_fill_pipelines_)               \
+  V(RadialGradientFillPipeline, radial_gradient_fill_pipelines_)               \
+  V(ConicalGradientFillPipeline, conical_gradient_fill_pipelines_)             \
+  V(SweepGradientFillPipeline, sweep_gradient_fill_pipelines_)                 \
+  V(LinearGradientUniformFillPipeline,                                         \
+    linear_gradient_uniform_fill_pipelines_)                                   \
+  V(RadialGradientUniformFillPipeline,                                         \
+    radial_gradient_uniform_fill_pipelines_)                                   \
+  V(ConicalGradientUniformFillPipeline,                                        \
+    conical_gradient_uniform_fill_pipelines_)                                  \
+  V(SweepGradientUniformFillPipeline, sweep_gradient_uniform_fill_pipelines_)  \
+  V(LinearGradientSSBOFillPipeline, linear_gradient_ssbo_fill_pipelines_)      \
+  V(RadialGradientSSBOFillPipeline, radial_gradient_ssbo_fill_pipelines_)      \
+  V(ConicalGradientSSBOFillPipeline, conical_gradient_ssbo_fill_pipelines_)    \
+  V(SweepGradientSSBOFillPipeline, sweep_gradient_ssbo_fill_pipelines_)        \
+  V(RRectBlurPipeline, rrect_blur_pipelines_)                                  \
+  V(TexturePipeline, texture_pipelines_)                                       \
+  V(TextureDownsamplePipeline, texture_downsample_pipelines_)                  \
+  V(TextureStrictSrcPipeline, texture_strict_src_pipelines_)                   \
+  V(TiledTexturePipeline, tiled_texture_pipelines_)                            \
+  V(GaussianBlurPipeline, gaussian_blur_pipelines_)                            \
+  V(KawaseDownsamplePipeline, kawase_downsample_pipelines_)                    \
+  V(KawaseUpsamplePipeline, kawase_upsample_pipelines_)                        \
+  V(BorderMaskBlurPipeline, border_mask_blur_pipelines_)                       \
+  V(MorphologyFilterPipeline, morphology_filter_pipelines_)                    \
+  V(ColorMatrixColorFilterPipeline, color_matrix_color_filter_pipelines_)      \
+  V(LinearToSrgbFilterPipeline, linear_to_srgb_filter_pipelines_)              \
+  V(SrgbToLinearFilterPipeline, srgb_to_linear_filter_pipelines_)              \
+  V(ClipPipeline, clip_pipelines_)                                             \
+  V(GlyphAtlasPipeline, glyph_atlas_pipelines_)                                \
+  V(YUVToRGBFilterPipeline, yuv_to_rgb_filter_pipelines_)                      \
+  V(PorterDuffBlendPipeline, porter_duff_blend_pipelines_)                     \
+  V(BlendColorPipeline, blend_color_pipelines_)                                \
+  V(BlendColorBurnPipeline, blend_colorburn_pipelines_)                        \
+  V(BlendColorDodgePipeline, blend_colordodge_pipelines_)                      \
+  V(BlendDarkenPipeline, blend_darken_pipelines_)                              \
+  V(BlendDifferencePipeline, blend_difference_pipelines_)                      \
+  V(BlendExclusionPipeline, blend_exclusion_pipelines_)                        \
+  V(BlendHardLightPipeline, blend_hardlight_pipelines_)                        \
+  V(BlendHuePipeline, blend_hue_pipelines_)                                    \
+  V(BlendLightenPipeline, blend_lighten_pipelines_)                            \
+  V(BlendLuminosityPipeline, blend_luminosity_pipelines_)                      \
+  V(BlendMultiplyPipeline, blend_multiply_pipelines_)                          \
+  V(BlendOverlayPipeline, blend_overlay_pipelines_)                            \
+  V(BlendSaturationPipeline, blend_saturation_pipelines_)                      \
+  V(BlendScreenPipeline, blend_screen_pipelines_)                              \
+  V(BlendSoftLightPipeline, blend_softlight_pipelines_)                        \
+  V(FramebufferBlendColorPipeline, framebuffer_blend_color_pipelines_)         \
+  V(FramebufferBlendColorBurnPipeline, framebuffer_blend_colorburn_pipelines_) \
+  V(FramebufferBlendColorDodgePipeline,                                        \
+    framebuffer_blend_colordodge_pipelines_)                                   \
+  V(FramebufferBlendDarkenPipeline, framebuffer_blend_darken_pipelines_)       \
+  V(FramebufferBlendDifferencePipeline,                                        \
+    framebuffer_blend_difference_pipelines_)                                   \
+  V(FramebufferBlendExclusionPipeline, framebuffer_blend_exclusion_pipelines_) \
+  V(FramebufferBlendHardLightPipeline, framebuffer_blend_hardlight_pipelines_) \
+  V(FramebufferBlendHuePipeline, framebuffer_blend_hue_pipelines_)             \
+  V(FramebufferBlendLightenPipeline, framebuffer_blend_lighten_pipelines_)     \
+  V(FramebufferBlendLuminosityPipeline,                                        \
+    framebuffer_blend_luminosity_pipelines_)                                   \
+  V(FramebufferBlendMultiplyPipeline, framebuffer_blend_multiply_pipelines_)   \
+  V(FramebufferBlendOverlayPipeline, framebuffer_blend_overlay_pipelines_)     \
+  V(FramebufferBlendSaturationPipeline,                                        \
+    framebuffer_blend_saturation_pipelines_)                                   \
+  V(FramebufferBlendScreenPipeline, framebuffer_blend_screen_pipelines_)       \
+  V(FramebufferBlendSoftLightPipeline, framebuffer_blend_softlight_pipelines_) \
+  V(VerticesUberShader, vertices_uber_shader_)
+
+#ifdef IMPELLER_ENABLE_OPENGLES
+#define IMPELLER_FOR_EACH_CONTENT_CONTEXT_GLES_VARIANTS(V)             \
+  V(TiledTextureExternalPipeline, tiled_texture_external_pipelines_)   \
+  V(TextureDownsampleGlesPipeline, texture_downsample_gles_pipelines_)
+#else
+#define IMPELLER_FOR_EACH_CONTENT_CONTEXT_GLES_VARIANTS(V)
+#endif  // IMPELLER_ENABLE_OPENGLES
+
+#ifdef IMPELLER_ENABLE_COMPUTE
+#define IMPELLER_FOR_EACH_CONTENT_CONTEXT_COMPUTE_VARIANTS(V) \
+  V(PathCoverageFillPipeline, path_coverage_fill_pipelines_)
+#else
+#define IMPELLER_FOR_EACH_CONTENT_CONTEXT_COMPUTE_VARIANTS(V)
+#endif  // IMPELLER_ENABLE_COMPUTE
+
+#define IMPELLER_FOR_EACH_ALL_CONTENT_CONTEXT_VARIANTS(V) \
+  IMPELLER_FOR_EACH_CONTENT_CONTEXT_VARIANTS(V)           \
+  IMPELLER_FOR_EACH_CONTENT_CONTEXT_GLES_VARIANTS(V)      \
+  IMPELLER_FOR_EACH_CONTENT_CONTEXT_COMPUTE_VARIANTS(V)
+
 /// Pipeline state configuration.
 ///
 /// Each unique combination of these options requires a different pipeline state
@@ -358,10 +472,18 @@ struct ContentContextOptions {
            static_cast<uint64_t>(sample_count) << 48;
   }
 
+  /// @brief Reconstruct the options from a key returned by |ToKey|.
+  ///
+  /// @return The options, or std::nullopt if the key does not describe a valid
+  ///         set of options. Used to validate keys read from disk.
+  static std::optional<ContentContextOptions> FromKey(uint64_t key);
+
   void ApplyToPipelineDescriptor(PipelineDescriptor& desc) const;
 };
 
 class Tessellator;
+class TessellationCache;
+class ComputePathRasterizer;
 class RenderTargetCache;
 
 class ContentContext {
@@ -369,7 +491,8 @@ class ContentContext {
   explicit ContentContext(
       std::shared_ptr<Context> context,
       std::shared_ptr<TypographerContext> typographer_context,
-      std::shared_ptr<RenderTargetAllocator> render_target_allocator = nullptr);
+      std::shared_ptr<RenderTargetAllocator> render_target_allocator = nullptr,
+      std::shared_ptr<PipelineVariantManifest> variant_manifest = nullptr);
 
   ~ContentContext();
 
@@ -377,6 +500,14 @@ class ContentContext {
 
   Tessellator& GetTessellator() const;
 
+  /// @brief The cache of path tessellations that are reused across frames.
+  TessellationCache& GetTessellationCache() const;
+
+  /// @brief The rasterizer of complex path fills, or nullptr if compute path
+  ///        rasterization is disabled or the device cannot rasterize paths
+  ///        in compute passes.
+  const ComputePathRasterizer* GetComputePathRasterizer() const;
+
   PipelineRef GetFastGradientPipeline(ContentContextOptions opts) const {
     return GetPipeline(fast_gradient_pipelines_, opts);
   }
@@ -471,6 +602,13 @@ class ContentContext {
   }
 #endif  // IMPELLER_ENABLE_OPENGLES
 
+#ifdef IMPELLER_ENABLE_COMPUTE
+  PipelineRef GetPathCoverageFillPipeline(ContentContextOptions opts) const {
+    FML_DCHECK(GetComputePathRasterizer() != nullptr);
+    return GetPipeline(path_coverage_fill_pipelines_, opts);
+  }
+#endif  // IMPELLER_ENABLE_COMPUTE
+
   PipelineRef GetTiledTexturePipeline(ContentContextOptions opts) const {
     return GetPipeline(tiled_texture_pipelines_, opts);
   }
@@ -479,6 +617,14 @@ class ContentContext {
     return GetPipeline(gaussian_blur_pipelines_, opts);
   }
 
+  PipelineRef GetKawaseDownsamplePipeline(ContentContextOptions opts) const {
+    return GetPipeline(kawase_downsample_pipelines_, opts);
+  }
+
+  PipelineRef GetKawaseUpsamplePipeline(ContentContextOptions opts) const {
+    return GetPipeline(kawase_upsample_pipelines_, opts);
+  }
+
   PipelineRef GetBorderMaskBlurPipeline(ContentContextOptions opts) const {
     return GetPipeline(border_mask_blur_pipelines_, opts);
   }
@@ -686,6 +832,14 @@ class ContentContext {
 
   void SetWireframe(bool wireframe);
 
+  /// @brief Whether complex solid color path fills get their coverage from
+  ///        compute passes instead of stencil-then-cover. Disabled by
+  ///        default.
+  ///
+  /// The rasterizer and its pipelines are created the first time this is
+  /// enabled, so this must not be called while rendering.
+  void SetComputePathRasterizationEnabled(bool enabled);
+
   using SubpassCallback =
       std::function<bool(const ContentContext&, RenderPass&)>;
 
@@ -779,6 +933,27 @@ class ContentContext {
                              RuntimeEffectPipelineKey::Equal>
       runtime_effect_pipelines_;
 
+  /// The type erased interface of |Variants| used to replay the pipeline
+  /// variant manifest.
+  class GenericVariants {
+   public:
+    virtual ~GenericVariants() = default;
+
+    /// The identifier of this family of pipelines in the pipeline variant
+    /// manifest, or zero if there is no default pipeline.
+    uint64_t GetFamily() const { return family_; }
+
+    /// Start compiling the variant for the given options in the background
+    /// unless it already exists.
+    ///
+    /// @return True if the compilation of a new variant was started.
+    virtual bool Prewarm(const Context& context,
+                         const ContentContextOptions& options) = 0;
+
+   protected:
+    uint64_t family_ = 0u;
+  };
+
   /// Holds multiple Pipelines associated with the same PipelineHandle types.
   ///
   /// For example, it may have multiple
@@ -793,24 +968,21 @@ class ContentContext {
   ///  - impeller::RenderPipelineHandle<> - The type of objects this typically
   ///    contains.
   template <class PipelineHandleT>
-  class Variants {
+  class Variants : public GenericVariants {
    public:
     Variants() = default;
 
     void Set(const ContentContextOptions& options,
              std::unique_ptr<PipelineHandleT> pipeline) {
-      uint64_t p_key = options.ToKey();
-      for (const auto& [key, pipeline] : pipelines_) {
-        if (key == p_key) {
-          return;
-        }
-      }
-      pipelines_.push_back(std::make_pair(p_key, std::move(pipeline)));
+      pipelines_.try_emplace(options.ToKey(), std::move(pipeline));
     }
 
     void SetDefault(const ContentContextOptions& options,
                     std::unique_ptr<PipelineHandleT> pipeline) {
       default_options_ = options;
+      std::optional<PipelineDescriptor> desc = pipeline->GetDescriptor();
+      family_ =
+          desc.has_value() ? PipelineVariantManifest::HashFamily(*desc) : 0u;
       Set(options, std::move(pipeline));
     }
 
@@ -828,13 +1000,8 @@ class ContentContext {
     }
 
     PipelineHandleT* Get(const ContentContextOptions& options) const {
-      uint64_t p_key = options.ToKey();
-      for (const auto& [key, pipeline] : pipelines_) {
-        if (key == p_key) {
-          return pipeline.get();
-        }
-      }
-      return nullptr;
+      auto found = pipelines_.find(options.ToKey());
+      return found == pipelines_.end() ? nullptr : found->second.get();
     }
 
     PipelineHandleT* GetDefault() const {
@@ -846,10 +1013,33 @@ class ContentContext {
 
     size_t GetPipelineCount() const { return pipelines_.size(); }
 
+    // |GenericVariants|
+    bool Prewarm(const Context& context,
+                 const ContentContextOptions& options) override {
+      if (Get(options)) {
+        return false;
+      }
+      PipelineHandleT* default_handle = GetDefault();
+      if (!default_handle) {
+        return false;
+      }
+      // Derive the variant from the descriptor of the default rather than
+      // its pipeline so that prewarming does not wait for the default to
+      // finish compiling.
+      std::optional<PipelineDescriptor> desc = default_handle->GetDescriptor();
+      if (!desc.has_value()) {
+        return false;
+      }
+      options.ApplyToPipelineDescriptor(*desc);
+      desc->SetLabel(
+          SPrintF("%s V#%zu", desc->GetLabel().data(), GetPipelineCount()));
+      Set(options, std::make_unique<PipelineHandleT>(context, desc));
+      return true;
+    }
+
    private:
     std::optional<ContentContextOptions> default_options_;
-    std::vector<std::pair<uint64_t, std::unique_ptr<PipelineHandleT>>>
-        pipelines_;
+    std::unordered_map<uint64_t, std::unique_ptr<PipelineHandleT>> pipelines_;
 
     Variants(const Variants&) = delete;
 
@@ -859,100 +1049,10 @@ class ContentContext {
   // These are mutable because while the prototypes are created eagerly, any
   // variants requested from that are lazily created and cached in the variants
   // map.
-
-  mutable Variants<SolidFillPipeline> solid_fill_pipelines_;
-  mutable Variants<FastGradientPipeline> fast_gradient_pipelines_;
-  mutable Variants<LinearGradientFillPipeline> linear_gradient_fill_pipelines_;
-  mutable Variants<RadialGradientFillPipeline> radial_gradient_fill_pipelines_;
-  mutable Variants<ConicalGradientFillPipeline>
-      conical_gradient_fill_pipelines_;
-  mutable Variants<SweepGradientFillPipeline> sweep_gradient_fill_pipelines_;
-  mutable Variants<LinearGradientUniformFillPipeline>
-      linear_gradient_uniform_fill_pipelines_;
-  mutable Variants<RadialGradientUniformFillPipeline>
-      radial_gradient_uniform_fill_pipelines_;
-  mutable Variants<ConicalGradientUniformFillPipeline>
-      conical_gradient_uniform_fill_pipelines_;
-  mutable Variants<SweepGradientUniformFillPipeline>
-      sweep_gradient_uniform_fill_pipelines_;
-  mutable Variants<LinearGradientSSBOFillPipeline>
-      linear_gradient_ssbo_fill_pipelines_;
-  mutable Variants<RadialGradientSSBOFillPipeline>
-      radial_gradient_ssbo_fill_pipelines_;
-  mutable Variants<ConicalGradientSSBOFillPipeline>
-      conical_gradient_ssbo_fill_pipelines_;
-  mutable Variants<SweepGradientSSBOFillPipeline>
-      sweep_gradient_ssbo_fill_pipelines_;
-  mutable Variants<RRectBlurPipeline> rrect_blur_pipelines_;
-  mutable Variants<TexturePipeline> texture_pipelines_;
-  mutable Variants<TextureDownsamplePipeline> texture_downsample_pipelines_;
-  mutable Variants<TextureStrictSrcPipeline> texture_strict_src_pipelines_;
-#ifdef IMPELLER_ENABLE_OPENGLES
-  mutable Variants<TiledTextureExternalPipeline>
-      tiled_texture_external_pipelines_;
-  mutable Variants<TextureDownsampleGlesPipeline>
-      texture_downsample_gles_pipelines_;
-#endif  // IMPELLER_ENABLE_OPENGLES
-  mutable Variants<TiledTexturePipeline> tiled_texture_pipelines_;
-  mutable Variants<GaussianBlurPipeline> gaussian_blur_pipelines_;
-  mutable Variants<BorderMaskBlurPipeline> border_mask_blur_pipelines_;
-  mutable Variants<MorphologyFilterPipeline> morphology_filter_pipelines_;
-  mutable Variants<ColorMatrixColorFilterPipeline>
-      color_matrix_color_filter_pipelines_;
-  mutable Variants<LinearToSrgbFilterPipeline> linear_to_srgb_filter_pipelines_;
-  mutable Variants<SrgbToLinearFilterPipeline> srgb_to_linear_filter_pipelines_;
-  mutable Variants<ClipPipeline> clip_pipelines_;
-  mutable Variants<GlyphAtlasPipeline> glyph_atlas_pipelines_;
-  mutable Variants<YUVToRGBFilterPipeline> yuv_to_rgb_filter_pipelines_;
-  mutable Variants<PorterDuffBlendPipeline> porter_duff_blend_pipelines_;
-  // Advanced blends.
-  mutable Variants<BlendColorPipeline> blend_color_pipelines_;
-  mutable Variants<BlendColorBurnPipeline> blend_colorburn_pipelines_;
-  mutable Variants<BlendColorDodgePipeline> blend_colordodge_pipelines_;
-  mutable Variants<BlendDarkenPipeline> blend_darken_pipelines_;
-  mutable Variants<BlendDifferencePipeline> blend_difference_pipelines_;
-  mutable Variants<BlendExclusionPipeline> blend_exclusion_pipelines_;
-  mutable Variants<BlendHardLightPipeline> blend_hardlight_pipelines_;
-  mutable Variants<BlendHuePipeline> blend_hue_pipelines_;
-  mutable Variants<BlendLightenPipeline> blend_lighten_pipelines_;
-  mutable Variants<BlendLuminosityPipeline> blend_luminosity_pipelines_;
-  mutable Variants<BlendMultiplyPipeline> blend_multiply_pipelines_;
-  mutable Variants<BlendOverlayPipeline> blend_overlay_pipelines_;
-  mutable Variants<BlendSaturationPipeline> blend_saturation_pipelines_;
-  mutable Variants<BlendScreenPipeline> blend_screen_pipelines_;
-  mutable Variants<BlendSoftLightPipeline> blend_softlight_pipelines_;
-  // Framebuffer Advanced blends.
-  mutable Variants<FramebufferBlendColorPipeline>
-      framebuffer_blend_color_pipelines_;
-  mutable Variants<FramebufferBlendColorBurnPipeline>
-      framebuffer_blend_colorburn_pipelines_;
-  mutable Variants<FramebufferBlendColorDodgePipeline>
-      framebuffer_blend_colordodge_pipelines_;
-  mutable Variants<FramebufferBlendDarkenPipeline>
-      framebuffer_blend_darken_pipelines_;
-  mutable Variants<FramebufferBlendDifferencePipeline>
-      framebuffer_blend_difference_pipelines_;
-  mutable Variants<FramebufferBlendExclusionPipeline>
-      framebuffer_blend_exclusion_pipelines_;
-  mutable Variants<FramebufferBlendHardLightPipeline>
-      framebuffer_blend_hardlight_pipelines_;
-  mutable Variants<FramebufferBlendHuePipeline>
-      framebuffer_blend_hue_pipelines_;
-  mutable Variants<FramebufferBlendLightenPipeline>
-      framebuffer_blend_lighten_pipelines_;
-  mutable Variants<FramebufferBlendLuminosityPipeline>
-      framebuffer_blend_luminosity_pipelines_;
-  mutable Variants<FramebufferBlendMultiplyPipeline>
-      framebuffer_blend_multiply_pipelines_;
-  mutable Variants<FramebufferBlendOverlayPipeline>
-      framebuffer_blend_overlay_pipelines_;
-  mutable Variants<FramebufferBlendSaturationPipeline>
-      framebuffer_blend_saturation_pipelines_;
-  mutable Variants<FramebufferBlendScreenPipeline>
-      framebuffer_blend_screen_pipelines_;
-  mutable Variants<FramebufferBlendSoftLightPipeline>
-      framebuffer_blend_softlight_pipelines_;
-  mutable Variants<VerticesUberShader> vertices_uber_shader_;
+#define IMPELLER_DECLARE_VARIANTS(pipeline_handle, member) \
+  mutable Variants<pipeline_handle> member;
+  IMPELLER_FOR_EACH_ALL_CONTENT_CONTEXT_VARIANTS(IMPELLER_DECLARE_VARIANTS)
+#undef IMPELLER_DECLARE_VARIANTS
 
   template <class TypedPipeline>
   PipelineRef GetPipeline(Variants<TypedPipeline>& container,
@@ -1001,15 +1101,28 @@ class ContentContext {
     std::unique_ptr<RenderPipelineHandleT> variant =
         std::make_unique<RenderPipelineHandleT>(std::move(variant_future));
     container.Set(opts, std::move(variant));
+    if (variant_manifest_ && !opts.wireframe) {
+      variant_manifest_->Record(container.GetFamily(), opts.ToKey());
+    }
     return container.Get(opts);
   }
 
+  /// Start compiling the pipeline variants recorded in the variant manifest
+  /// by previous launches.
+  void PrewarmPipelineVariants();
+
   bool is_valid_ = false;
   std::shared_ptr<Tessellator> tessellator_;
+  std::shared_ptr<TessellationCache> tessellation_cache_;
+#ifdef IMPELLER_ENABLE_COMPUTE
+  std::unique_ptr<ComputePathRasterizer> compute_path_rasterizer_;
+#endif  // IMPELLER_ENABLE_COMPUTE
   std::shared_ptr<RenderTargetAllocator> render_target_cache_;
   std::shared_ptr<HostBuffer> host_buffer_;
   std::shared_ptr<Texture> empty_texture_;
   bool wireframe_ = false;
+  bool compute_path_rasterization_enabled_ = false;
+  std::shared_ptr<PipelineVariantManifest> variant_manifest_;
 
   ContentContext(const ContentContext&) = delete;
 
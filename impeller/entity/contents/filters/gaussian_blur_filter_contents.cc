@@ -21,11 +21,28 @@ namespace impeller {
 
 using GaussianBlurVertexShader = GaussianBlurPipeline::VertexShader;
 using GaussianBlurFragmentShader = GaussianBlurPipeline::FragmentShader;
+using KawaseVertexShader = KawaseDownsamplePipeline::VertexShader;
 
 namespace {
 
 constexpr Scalar kMaxSigma = 500.0f;
 
+// A dual filter blur with `n` levels and a sample offset of `h` texels has a
+// variance of about (4^n - 1) / 3 * (kKawaseBaseVariance +
+// kKawaseOffsetVariance * h^2) pixels squared. The constants were fit to
+// simulated blurs with 1 to 4 levels and offsets of 0.5 to 1.5 texels.
+constexpr Scalar kKawaseBaseVariance = 0.93f;
+constexpr Scalar kKawaseOffsetVariance = 5.67f;
+// Up to this sigma, in pixels of the source, the downsample pass keeps the
+// kernels of the separable passes at a radius of about 10 texels. Larger
+// sigmas are downsampled by at most 1/8th, so the separable kernels grow with
+// the sigma while the dual filter only gains levels of ever smaller size.
+constexpr Scalar kKawaseMinSourceSigma = 40.0f;
+// Smaller offsets waste levels. Larger offsets skip over texels and alias.
+constexpr Scalar kKawaseMinSampleOffset = 0.5f;
+constexpr Scalar kKawaseMaxSampleOffset = 1.5f;
+constexpr int kKawaseMaxLevels = 8;
+
 SamplerDescriptor MakeSamplerDescriptor(MinMagFilter filter,
                                         SamplerAddressMode address_mode) {
   SamplerDescriptor sampler_desc;
@@ -516,6 +533,124 @@ fml::StatusOr<RenderTarget> MakeBlurSubpass(
   }
 }
 
+/// Makes a subpass that draws one pass of the dual filter blur.
+///
+/// The output samples the input between the UVs (0, 0) and `max_uv`.
+/// `sample_offset` is in texels of the input.
+template <typename FragmentShader>
+fml::StatusOr<RenderTarget> MakeKawaseSubpass(
+    const ContentContext& renderer,
+    const std::shared_ptr<CommandBuffer>& command_buffer,
+    const std::shared_ptr<Texture>& input_texture,
+    const SamplerDescriptor& sampler_descriptor,
+    Entity::TileMode tile_mode,
+    PipelineRef (ContentContext::*get_pipeline)(ContentContextOptions) const,
+    Vector2 max_uv,
+    Vector2 sample_offset,
+    ISize subpass_size,
+    std::optional<RenderTarget> destination_target) {
+  ContentContext::SubpassCallback subpass_callback =
+      [&](const ContentContext& renderer, RenderPass& pass) {
+        HostBuffer& host_buffer = renderer.GetTransientsBuffer();
+
+        ContentContextOptions options = OptionsFromPass(pass);
+        options.primitive_type = PrimitiveType::kTriangleStrip;
+        pass.SetPipeline((renderer.*get_pipeline)(options));
+
+        std::array<KawaseVertexShader::PerVertexData, 4> vertices = {
+            KawaseVertexShader::PerVertexData{Point(0, 0), Point(0, 0)},
+            KawaseVertexShader::PerVertexData{Point(1, 0), Point(max_uv.x, 0)},
+            KawaseVertexShader::PerVertexData{Point(0, 1), Point(0, max_uv.y)},
+            KawaseVertexShader::PerVertexData{Point(1, 1), max_uv},
+        };
+        pass.SetVertexBuffer(CreateVertexBuffer(vertices, host_buffer));
+
+        KawaseVertexShader::FrameInfo frame_info;
+        frame_info.mvp = Matrix::MakeOrthographic(ISize(1, 1));
+        frame_info.texture_sampler_y_coord_scale =
+            input_texture->GetYCoordScale();
+        KawaseVertexShader::BindFrameInfo(
+            pass, host_buffer.EmplaceUniform(frame_info));
+
+        typename FragmentShader::FragInfo frag_info;
+        frag_info.sample_offset =
+            sample_offset / Vector2(input_texture->GetSize());
+        FragmentShader::BindFragInfo(pass,
+                                     host_buffer.EmplaceUniform(frag_info));
+
+        SamplerDescriptor linear_sampler_descriptor = sampler_descriptor;
+        SetTileMode(&linear_sampler_descriptor, renderer, tile_mode);
+        linear_sampler_descriptor.mag_filter = MinMagFilter::kLinear;
+        linear_sampler_descriptor.min_filter = MinMagFilter::kLinear;
+        FragmentShader::BindTextureSampler(
+            pass, input_texture,
+            renderer.GetContext()->GetSamplerLibrary()->GetSampler(
+                linear_sampler_descriptor));
+        return pass.Draw().ok();
+      };
+  if (destination_target.has_value()) {
+    return renderer.MakeSubpass("Kawase Blur Filter",
+                                destination_target.value(), command_buffer,
+                                subpass_callback);
+  } else {
+    return renderer.MakeSubpass("Kawase Blur Filter", subpass_size,
+                                command_buffer, subpass_callback);
+  }
+}
+
+/// Blurs `input_pass` with a dual filter blur and renders the result back into
+/// it.
+///
+/// Every downsample pass halves its input, rounding up, so that each output
+/// texel covers exactly 2x2 input texels. Every upsample pass then renders
+/// into the target of the level it was downsampled from, which has already
+/// been read.
+fml::StatusOr<RenderTarget> MakeKawaseBlurSubpasses(
+    const ContentContext& renderer,
+    const std::shared_ptr<CommandBuffer>& downsample_command_buffer,
+    const std::shared_ptr<CommandBuffer>& upsample_command_buffer,
+    const RenderTarget& input_pass,
+    const SamplerDescriptor& sampler_descriptor,
+    Entity::TileMode tile_mode,
+    const KawaseBlurParameters& parameters) {
+  std::vector<RenderTarget> levels = {input_pass};
+  levels.reserve(parameters.levels + 1);
+  for (int i = 0; i < parameters.levels; i++) {
+    ISize input_size = levels.back().GetRenderTargetSize();
+    ISize subpass_size((input_size.width + 1) / 2,
+                       (input_size.height + 1) / 2);
+    fml::StatusOr<RenderTarget> level = MakeKawaseSubpass<
+        KawaseDownsampleFragmentShader>(
+        renderer, downsample_command_buffer,
+        levels.back().GetRenderTargetTexture(), sampler_descriptor, tile_mode,
+        &ContentContext::GetKawaseDownsamplePipeline,
+        Vector2(subpass_size * 2) / Vector2(input_size),
+        parameters.sample_offset, subpass_size,
+        /*destination_target=*/std::nullopt);
+    if (!level.ok()) {
+      return level;
+    }
+    levels.push_back(level.value());
+  }
+
+  for (size_t i = levels.size() - 1; i > 0; i--) {
+    ISize input_size = levels[i].GetRenderTargetSize();
+    ISize subpass_size = levels[i - 1].GetRenderTargetSize();
+    fml::StatusOr<RenderTarget> level =
+        MakeKawaseSubpass<KawaseUpsampleFragmentShader>(
+            renderer, upsample_command_buffer,
+            levels[i].GetRenderTargetTexture(), sampler_descriptor, tile_mode,
+            &ContentContext::GetKawaseUpsamplePipeline,
+            Vector2(subpass_size) / Vector2(input_size * 2),
+            parameters.sample_offset, subpass_size, levels[i - 1]);
+    if (!level.ok()) {
+      return level;
+    }
+    levels[i - 1] = level.value();
+  }
+  return levels.front();
+}
+
 int ScaleBlurRadius(Scalar radius, Scalar scalar) {
   return static_cast<int>(std::round(radius * scalar));
 }
@@ -699,8 +834,10 @@ std::optional<Rect> GaussianBlurFilterContents::GetFilterCoverage(
 // 1) Snapshot the filter input.
 // 2) Perform downsample pass. This also inserts the gutter around the input
 //    snapshot since the blur can render outside the bounds of the snapshot.
-// 3) Perform 1D horizontal blur pass.
-// 4) Perform 1D vertical blur pass.
+// 3) Perform 1D vertical blur pass.
+// 4) Perform 1D horizontal blur pass.
+//    Large blurs instead repeatedly halve the downsampled input and upsample
+//    it back with a dual filter blur, which takes fewer samples per pixel.
 // 5) Apply the blur style to the blur result. This may just mask the output or
 //    draw the original snapshot over the result.
 std::optional<Entity> GaussianBlurFilterContents::RenderFilter(
@@ -785,56 +922,94 @@ std::optional<Entity> GaussianBlurFilterContents::RenderFilter(
 
   Quad blur_uvs = {Point(0, 0), Point(1, 0), Point(0, 1), Point(1, 1)};
 
+  BlurParameters blur_y_parameters = {
+      .blur_uv_offset = Point(0.0, pass1_pixel_size.y),
+      .blur_sigma =
+          blur_info.scaled_sigma.y * downsample_pass_args.effective_scalar.y,
+      .blur_radius = ScaleBlurRadius(blur_info.blur_radius.y,
+                                     downsample_pass_args.effective_scalar.y),
+      .step_size = 1,
+  };
+  BlurParameters blur_x_parameters = {
+      .blur_uv_offset = Point(pass1_pixel_size.x, 0.0),
+      .blur_sigma =
+          blur_info.scaled_sigma.x * downsample_pass_args.effective_scalar.x,
+      .blur_radius = ScaleBlurRadius(blur_info.blur_radius.x,
+                                     downsample_pass_args.effective_scalar.x),
+      .step_size = 1,
+  };
+
   std::shared_ptr<CommandBuffer> command_buffer_2 =
       renderer.GetContext()->CreateCommandBuffer();
   if (!command_buffer_2) {
     return std::nullopt;
   }
 
-  fml::StatusOr<RenderTarget> pass2_out = MakeBlurSubpass(
-      renderer, command_buffer_2, /*input_pass=*/pass1_out.value(),
-      input_snapshot->sampler_descriptor, tile_mode_,
-      BlurParameters{
-          .blur_uv_offset = Point(0.0, pass1_pixel_size.y),
-          .blur_sigma = blur_info.scaled_sigma.y *
-                        downsample_pass_args.effective_scalar.y,
-          .blur_radius = ScaleBlurRadius(
-              blur_info.blur_radius.y, downsample_pass_args.effective_scalar.y),
-          .step_size = 1,
-      },
-      /*destination_target=*/std::nullopt, blur_uvs);
-
-  if (!pass2_out.ok()) {
-    return std::nullopt;
-  }
-
   std::shared_ptr<CommandBuffer> command_buffer_3 =
       renderer.GetContext()->CreateCommandBuffer();
   if (!command_buffer_3) {
     return std::nullopt;
   }
 
-  // Only ping pong if the first pass actually created a render target.
-  auto pass3_destination = pass2_out.value().GetRenderTargetTexture() !=
-                                   pass1_out.value().GetRenderTargetTexture()
-                               ? std::optional<RenderTarget>(pass1_out.value())
-                               : std::optional<RenderTarget>(std::nullopt);
-
-  fml::StatusOr<RenderTarget> pass3_out = MakeBlurSubpass(
-      renderer, command_buffer_3, /*input_pass=*/pass2_out.value(),
-      input_snapshot->sampler_descriptor, tile_mode_,
-      BlurParameters{
-          .blur_uv_offset = Point(pass1_pixel_size.x, 0.0),
-          .blur_sigma = blur_info.scaled_sigma.x *
-                        downsample_pass_args.effective_scalar.x,
-          .blur_radius = ScaleBlurRadius(
-              blur_info.blur_radius.x, downsample_pass_args.effective_scalar.x),
-          .step_size = 1,
-      },
-      pass3_destination, blur_uvs);
-
-  if (!pass3_out.ok()) {
-    return std::nullopt;
+  // Large blurs are approximated with a dual filter blur, which matches the
+  // spread of the truncated kernel the separable passes would have applied.
+  // The dual filter passes rely on the sampler for the decal tile mode, so
+  // backends without decal samplers use the separable passes instead.
+  std::optional<KawaseBlurParameters> kawase_parameters;
+  if (blur_mode_ != BlurMode::kSeparable &&
+      (tile_mode_ != Entity::TileMode::kDecal ||
+       renderer.GetDeviceCapabilities().SupportsDecalSamplerAddressMode())) {
+    Vector2 source_sigma = blur_mode_ == BlurMode::kKawase
+                               ? Vector2(kMaxSigma, kMaxSigma)
+                               : blur_info.scaled_sigma;
+    kawase_parameters = CalculateKawaseBlurParameters(
+        source_sigma, Vector2(CalculateKernelSigma(blur_x_parameters),
+                              CalculateKernelSigma(blur_y_parameters)));
+  }
+
+  std::optional<RenderTarget> blur_out;
+  if (kawase_parameters.has_value()) {
+    fml::StatusOr<RenderTarget> kawase_out = MakeKawaseBlurSubpasses(
+        renderer, command_buffer_2, command_buffer_3,
+        /*input_pass=*/pass1_out.value(), input_snapshot->sampler_descriptor,
+        tile_mode_, kawase_parameters.value());
+    if (!kawase_out.ok()) {
+      return std::nullopt;
+    }
+    blur_out = kawase_out.value();
+  } else {
+    fml::StatusOr<RenderTarget> pass2_out = MakeBlurSubpass(
+        renderer, command_buffer_2, /*input_pass=*/pass1_out.value(),
+        input_snapshot->sampler_descriptor, tile_mode_, blur_y_parameters,
+        /*destination_target=*/std::nullopt, blur_uvs);
+
+    if (!pass2_out.ok()) {
+      return std::nullopt;
+    }
+
+    // Only ping pong if the first pass actually created a render target.
+    auto pass3_destination =
+        pass2_out.value().GetRenderTargetTexture() !=
+                pass1_out.value().GetRenderTargetTexture()
+            ? std::optional<RenderTarget>(pass1_out.value())
+            : std::optional<RenderTarget>(std::nullopt);
+
+    fml::StatusOr<RenderTarget> pass3_out = MakeBlurSubpass(
+        renderer, command_buffer_3, /*input_pass=*/pass2_out.value(),
+        input_snapshot->sampler_descriptor, tile_mode_, blur_x_parameters,
+        pass3_destination, blur_uvs);
+
+    if (!pass3_out.ok()) {
+      return std::nullopt;
+    }
+
+    // The ping-pong approach requires that each render pass output has the
+    // same size.
+    FML_DCHECK((pass1_out.value().GetRenderTargetSize() ==
+                pass2_out.value().GetRenderTargetSize()) &&
+               (pass2_out.value().GetRenderTargetSize() ==
+                pass3_out.value().GetRenderTargetSize()));
+    blur_out = pass3_out.value();
   }
 
   if (!(renderer.GetContext()->EnqueueCommandBuffer(
@@ -846,18 +1021,11 @@ std::optional<Entity> GaussianBlurFilterContents::RenderFilter(
     return std::nullopt;
   }
 
-  // The ping-pong approach requires that each render pass output has the same
-  // size.
-  FML_DCHECK((pass1_out.value().GetRenderTargetSize() ==
-              pass2_out.value().GetRenderTargetSize()) &&
-             (pass2_out.value().GetRenderTargetSize() ==
-              pass3_out.value().GetRenderTargetSize()));
-
   SamplerDescriptor sampler_desc = MakeSamplerDescriptor(
       MinMagFilter::kLinear, SamplerAddressMode::kClampToEdge);
 
   Entity blur_output_entity = Entity::FromSnapshot(
-      Snapshot{.texture = pass3_out.value().GetRenderTargetTexture(),
+      Snapshot{.texture = blur_out->GetRenderTargetTexture(),
                .transform =
                    entity.GetTransform() *                                   //
                    Matrix::MakeScale(1.f / blur_info.source_space_scalar) *  //
@@ -985,4 +1153,55 @@ GaussianBlurPipeline::FragmentShader::KernelSamples LerpHackKernelSamples(
   return result;
 }
 
+Scalar CalculateKernelSigma(BlurParameters parameters) {
+  if (parameters.blur_sigma < kEhCloseEnough) {
+    return 0.0f;
+  }
+  parameters.blur_uv_offset = Point(1, 0);
+  KernelSamples samples = GenerateBlurInfo(parameters);
+  Scalar variance = 0.0f;
+  for (int i = 0; i < samples.sample_count; i++) {
+    Scalar x = samples.samples[i].uv_offset.x;
+    variance += samples.samples[i].coefficient * x * x;
+  }
+  return std::sqrt(variance);
+}
+
+std::optional<KawaseBlurParameters> CalculateKawaseBlurParameters(
+    Vector2 source_sigma,
+    Vector2 sigma) {
+  // The choice depends on the sigma in the source rather than in the
+  // downsampled input, which rises and falls with every change of the
+  // downsample scale.
+  if (std::min(source_sigma.x, source_sigma.y) < kKawaseMinSourceSigma) {
+    return std::nullopt;
+  }
+  Scalar min_sigma = std::min(sigma.x, sigma.y);
+
+  // Use as many levels as the smaller sigma allows with the smallest offset.
+  Scalar min_offset_variance =
+      kKawaseBaseVariance +
+      kKawaseOffsetVariance * kKawaseMinSampleOffset * kKawaseMinSampleOffset;
+  int levels = 1;
+  while (levels < kKawaseMaxLevels &&
+         (std::pow(4.0f, levels + 1) - 1.0f) / 3.0f * min_offset_variance <=
+             min_sigma * min_sigma) {
+    levels++;
+  }
+
+  // Then solve for the offset that gives each axis its sigma.
+  Scalar variance_scale = (std::pow(4.0f, levels) - 1.0f) / 3.0f;
+  auto solve_offset = [&](Scalar axis_sigma) {
+    Scalar offset_variance =
+        axis_sigma * axis_sigma / variance_scale - kKawaseBaseVariance;
+    return std::sqrt(std::max(offset_variance, 0.0f) / kKawaseOffsetVariance);
+  };
+  Vector2 sample_offset(solve_offset(sigma.x), solve_offset(sigma.y));
+  if (sample_offset.x > kKawaseMaxSampleOffset ||
+      sample_offset.y > kKawaseMaxSampleOffset) {
+    return std::nullopt;
+  }
+  return KawaseBlurParameters{.levels = levels, .sample_offset = sample_offset};
+}
+
 }  // namespace impeller
@@ -49,12 +49,49 @@ KernelSamples GenerateBlurInfo(BlurParameters parameters);
 GaussianBlurPipeline::FragmentShader::KernelSamples LerpHackKernelSamples(
     KernelSamples samples);
 
+/// The standard deviation, in multiples of `blur_uv_offset`, of the kernel
+/// that GenerateBlurInfo makes for the parameters. This is smaller than
+/// `blur_sigma` since the kernel is truncated at the blur radius.
+Scalar CalculateKernelSigma(BlurParameters parameters);
+
+/// The shape of a dual filter (Kawase) blur, which repeatedly halves its input
+/// and then upsamples it back to its original size.
+struct KawaseBlurParameters {
+  /// The number of times the input is halved.
+  int levels;
+  /// The distance of the diagonal samples of each pass from the center of the
+  /// output texel, in texels of the pass input.
+  Vector2 sample_offset;
+};
+
+/// Calculates the dual filter blur that approximates a blur with the standard
+/// deviation `sigma` in pixels of its (downsampled) input.
+///
+/// `source_sigma` is the standard deviation of the same blur in pixels of the
+/// source. Returns std::nullopt if the separable Gaussian passes are cheaper
+/// for `source_sigma`, or if `sigma` differs too much between the axes for the
+/// dual filter to approximate.
+std::optional<KawaseBlurParameters> CalculateKawaseBlurParameters(
+    Vector2 source_sigma,
+    Vector2 sigma);
+
 /// Performs a bidirectional Gaussian blur.
 ///
 /// This is accomplished by rendering multiple passes in multiple directions.
 /// Note: This will replace `DirectionalGaussianBlurFilterContents`.
 class GaussianBlurFilterContents final : public FilterContents {
  public:
+  /// The passes that render the blur.
+  enum class BlurMode {
+    /// Dual filter passes for large sigmas, separable passes otherwise.
+    kAutomatic,
+    /// Always the separable Gaussian passes.
+    kSeparable,
+    /// Dual filter passes whenever they can approximate the sigma and the
+    /// backend can sample with the tile mode.
+    kKawase,
+  };
+
   explicit GaussianBlurFilterContents(Scalar sigma_x,
                                       Scalar sigma_y,
                                       Entity::TileMode tile_mode,
@@ -64,6 +101,11 @@ class GaussianBlurFilterContents final : public FilterContents {
   Scalar GetSigmaX() const { return sigma_.x; }
   Scalar GetSigmaY() const { return sigma_.y; }
 
+  /// Overrides the choice of passes that render the blur.
+  ///
+  /// Visible for testing.
+  void SetBlurMode(BlurMode blur_mode) { blur_mode_ = blur_mode; }
+
   // |FilterContents|
   std::optional<Rect> GetFilterSourceCoverage(
       const Matrix& effect_transform,
@@ -117,6 +159,7 @@ class GaussianBlurFilterContents final : public FilterContents {
   const Entity::TileMode tile_mode_;
   const BlurStyle mask_blur_style_;
   const Geometry* mask_geometry_ = nullptr;
+  BlurMode blur_mode_ = BlurMode::kAutomatic;
 };
 
 }  // namespace impeller
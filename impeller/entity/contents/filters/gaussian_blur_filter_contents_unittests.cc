@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/testing/testing.h"
 #include "fml/status_or.h"
 #include "gmock/gmock.h"
@@ -11,6 +12,7 @@
 #include "impeller/entity/entity_playground.h"
 #include "impeller/geometry/color.h"
 #include "impeller/geometry/geometry_asserts.h"
+#include "impeller/renderer/blit_pass.h"
 #include "impeller/renderer/testing/mocks.h"
 
 #if FML_OS_MACOSX
@@ -78,6 +80,67 @@ fml::StatusOr<Scalar> CalculateSigmaForBlurRadius(
   return LowerBoundNewtonianMethod(f, radius, 2.f, 0.001f);
 }
 
+// Linearly samples a row of texels at `x` texels, clamping to the edge.
+Scalar SampleLinear(const std::vector<Scalar>& texels, Scalar x) {
+  Scalar left = std::floor(x - 0.5f);
+  Scalar fraction = x - 0.5f - left;
+  int max_index = static_cast<int>(texels.size()) - 1;
+  int i = std::clamp(static_cast<int>(left), 0, max_index);
+  int j = std::clamp(static_cast<int>(left) + 1, 0, max_index);
+  return texels[i] * (1.0f - fraction) + texels[j] * fraction;
+}
+
+// Simulates the dual filter blur of a row of texels, weighting the samples of
+// kawase_downsample.frag and kawase_upsample.frag by their share of the row.
+std::vector<Scalar> SimulateKawaseBlur(const std::vector<Scalar>& texels,
+                                       int levels,
+                                       Scalar offset) {
+  std::vector<std::vector<Scalar>> pyramid = {texels};
+  for (int i = 0; i < levels; i++) {
+    const std::vector<Scalar>& input = pyramid.back();
+    std::vector<Scalar> output((input.size() + 1) / 2);
+    for (size_t j = 0; j < output.size(); j++) {
+      Scalar x = 2.0f * (j + 0.5f);
+      output[j] = 0.5f * SampleLinear(input, x) +
+                  0.25f * (SampleLinear(input, x - offset) +
+                           SampleLinear(input, x + offset));
+    }
+    pyramid.push_back(std::move(output));
+  }
+  for (int i = levels; i > 0; i--) {
+    const std::vector<Scalar>& input = pyramid[i];
+    std::vector<Scalar>& output = pyramid[i - 1];
+    for (size_t j = 0; j < output.size(); j++) {
+      Scalar x = (j + 0.5f) / 2.0f;
+      output[j] = (2.0f * SampleLinear(input, x) +
+                   SampleLinear(input, x - 2.0f * offset) +
+                   SampleLinear(input, x + 2.0f * offset) +
+                   4.0f * (SampleLinear(input, x - offset) +
+                           SampleLinear(input, x + offset))) /
+                  12.0f;
+    }
+  }
+  return pyramid.front();
+}
+
+Scalar CalculateStandardDeviation(const std::vector<Scalar>& texels) {
+  Scalar tally = 0.0f;
+  Scalar mean = 0.0f;
+  for (size_t i = 0; i < texels.size(); i++) {
+    tally += texels[i];
+    mean += texels[i] * i;
+  }
+  mean /= tally;
+  Scalar variance = 0.0f;
+  for (size_t i = 0; i < texels.size(); i++) {
+    variance += texels[i] * (i - mean) * (i - mean);
+  }
+  return std::sqrt(variance / tally);
+}
+
+// A sigma, in pixels of the source, that always selects the dual filter blur.
+constexpr Vector2 kLargeSourceSigma = Vector2(100, 100);
+
 }  // namespace
 
 class GaussianBlurFilterContentsTest : public EntityPlayground {
@@ -107,6 +170,140 @@ class GaussianBlurFilterContentsTest : public EntityPlayground {
     }
     return nullptr;
   }
+
+  /// Create a texture that is filled with opaque white.
+  std::shared_ptr<Texture> MakeOpaqueTexture(ISize size) {
+    std::shared_ptr<Context> context = GetContentContext()->GetContext();
+    TextureDescriptor texture_descriptor;
+    texture_descriptor.storage_mode = StorageMode::kHostVisible;
+    texture_descriptor.format = PixelFormat::kR8G8B8A8UNormInt;
+    texture_descriptor.size = size;
+    std::shared_ptr<Texture> texture =
+        context->GetResourceAllocator()->CreateTexture(texture_descriptor);
+    std::vector<uint8_t> pixels(
+        texture_descriptor.GetByteSizeOfBaseMipLevel(), 0xFF);
+    std::shared_ptr<DeviceBuffer> buffer =
+        context->GetResourceAllocator()->CreateBufferWithCopy(pixels.data(),
+                                                              pixels.size());
+    std::shared_ptr<CommandBuffer> command_buffer =
+        context->CreateCommandBuffer();
+    if (!texture || !buffer || !command_buffer) {
+      return nullptr;
+    }
+    std::shared_ptr<BlitPass> blit_pass = command_buffer->CreateBlitPass();
+    if (!blit_pass->AddCopy(DeviceBuffer::AsBufferView(buffer), texture) ||
+        !blit_pass->EncodeCommands(context->GetResourceAllocator()) ||
+        !context->GetCommandQueue()->Submit({command_buffer}).ok()) {
+      return nullptr;
+    }
+    return texture;
+  }
+
+  /// Read back the alpha of every texel of a texture with 4 bytes per
+  /// texel, row by row. Returns an empty vector on failure.
+  std::vector<uint8_t> ReadAlpha(const std::shared_ptr<Texture>& texture) {
+    std::shared_ptr<Context> context = GetContentContext()->GetContext();
+    const TextureDescriptor& texture_descriptor =
+        texture->GetTextureDescriptor();
+    if (BytesPerPixelForPixelFormat(texture_descriptor.format) != 4u) {
+      return {};
+    }
+    DeviceBufferDescriptor buffer_descriptor;
+    buffer_descriptor.storage_mode = StorageMode::kHostVisible;
+    buffer_descriptor.size = texture_descriptor.GetByteSizeOfBaseMipLevel();
+    std::shared_ptr<DeviceBuffer> buffer =
+        context->GetResourceAllocator()->CreateBuffer(buffer_descriptor);
+    std::shared_ptr<CommandBuffer> command_buffer =
+        context->CreateCommandBuffer();
+    if (!buffer || !command_buffer) {
+      return {};
+    }
+    std::shared_ptr<BlitPass> blit_pass = command_buffer->CreateBlitPass();
+    if (!blit_pass->AddCopy(texture, buffer) ||
+        !blit_pass->EncodeCommands(context->GetResourceAllocator())) {
+      return {};
+    }
+
+    fml::AutoResetWaitableEvent latch;
+    bool completed = false;
+    if (!context->GetCommandQueue()
+             ->Submit({command_buffer},
+                      [&latch, &completed](CommandBuffer::Status status) {
+                        completed = status == CommandBuffer::Status::kCompleted;
+                        latch.Signal();
+                      })
+             .ok()) {
+      return {};
+    }
+    latch.Wait();
+    if (!completed) {
+      return {};
+    }
+
+    std::vector<uint8_t> alpha(buffer_descriptor.size / 4u);
+    for (size_t i = 0; i < alpha.size(); i++) {
+      alpha[i] = buffer->OnGetContents()[i * 4u + 3u];
+    }
+    return alpha;
+  }
+
+  struct BlurAlpha {
+    uint8_t corner = 0u;
+    uint8_t center = 0u;
+  };
+
+  /// Blurs an opaque square with the given tile mode and passes, and
+  /// returns the alpha of the top left corner and the center of the result.
+  std::optional<BlurAlpha> BlurOpaqueSquare(
+      Entity::TileMode tile_mode,
+      GaussianBlurFilterContents::BlurMode blur_mode) {
+    std::shared_ptr<Texture> texture = MakeOpaqueTexture(ISize(100, 100));
+    if (!texture) {
+      return std::nullopt;
+    }
+    auto contents = std::make_unique<GaussianBlurFilterContents>(
+        /*sigma_x=*/20.0f, /*sigma_y=*/20.0f, tile_mode,
+        FilterContents::BlurStyle::kNormal, /*mask_geometry=*/nullptr);
+    contents->SetBlurMode(blur_mode);
+    contents->SetInputs({FilterInput::Make(texture)});
+
+    std::optional<Snapshot> snapshot =
+        contents->RenderToSnapshot(*GetContentContext(), Entity());
+    if (!snapshot.has_value() || !snapshot->texture) {
+      return std::nullopt;
+    }
+    std::vector<uint8_t> alpha = ReadAlpha(snapshot->texture);
+    if (alpha.empty()) {
+      return std::nullopt;
+    }
+    ISize size = snapshot->texture->GetSize();
+    return BlurAlpha{
+        .corner = alpha[0],
+        .center = alpha[(size.height / 2) * size.width + size.width / 2],
+    };
+  }
+
+  /// Checks that the dual filter passes give an opaque square the same
+  /// edges as the separable passes for the tile mode. Edges that sample
+  /// outside the square fade out for decal and stay opaque otherwise.
+  void ExpectKawaseEdgesMatchSeparable(Entity::TileMode tile_mode) {
+    std::optional<BlurAlpha> separable = BlurOpaqueSquare(
+        tile_mode, GaussianBlurFilterContents::BlurMode::kSeparable);
+    std::optional<BlurAlpha> kawase = BlurOpaqueSquare(
+        tile_mode, GaussianBlurFilterContents::BlurMode::kKawase);
+    ASSERT_TRUE(separable.has_value());
+    ASSERT_TRUE(kawase.has_value());
+
+    EXPECT_GE(separable->center, 250u);
+    EXPECT_GE(kawase->center, 250u);
+    if (tile_mode == Entity::TileMode::kDecal) {
+      EXPECT_LT(separable->corner, 64u);
+      EXPECT_LT(kawase->corner, 64u);
+    } else {
+      EXPECT_GE(separable->corner, 250u);
+      EXPECT_GE(kawase->corner, 250u);
+    }
+  }
 };
 INSTANTIATE_PLAYGROUND_SUITE(GaussianBlurFilterContentsTest);
 
@@ -632,5 +829,153 @@ TEST(GaussianBlurFilterContentsTest, ChopHugeBlurs) {
   EXPECT_TRUE(frag_kernel_samples.sample_count <= kGaussianBlurMaxKernelSize);
 }
 
+TEST_P(GaussianBlurFilterContentsTest, SeparableAndKawaseBlursMatch) {
+  // The top row is blurred with the separable passes and the bottom row with
+  // the dual filter, at the same sigmas.
+  std::shared_ptr<Texture> boston = CreateTextureForFixture("boston.jpg");
+  ASSERT_TRUE(boston);
+  auto callback = [&](ContentContext& context, RenderPass& pass) -> bool {
+    const Scalar sigmas[] = {5.0f, 15.0f, 30.0f, 60.0f, 120.0f};
+    for (size_t i = 0; i < std::size(sigmas); i++) {
+      for (auto blur_mode : {GaussianBlurFilterContents::BlurMode::kSeparable,
+                             GaussianBlurFilterContents::BlurMode::kKawase}) {
+        auto texture = std::make_shared<TextureContents>();
+        texture->SetSourceRect(Rect::MakeSize(boston->GetSize()));
+        texture->SetDestinationRect(Rect::MakeXYWH(0, 0, 150, 150));
+        texture->SetTexture(boston);
+
+        auto blur = std::make_shared<GaussianBlurFilterContents>(
+            sigmas[i], sigmas[i], Entity::TileMode::kDecal,
+            FilterContents::BlurStyle::kNormal, /*mask_geometry=*/nullptr);
+        blur->SetBlurMode(blur_mode);
+        blur->SetInputs({FilterInput::Make(texture)});
+
+        Scalar row =
+            blur_mode == GaussianBlurFilterContents::BlurMode::kKawase ? 1 : 0;
+        Entity entity;
+        entity.SetContents(blur);
+        entity.SetTransform(
+            Matrix::MakeScale(GetContentScale()) *
+            Matrix::MakeTranslation(
+                Vector3(50.0f + i * 200.0f, 50.0f + row * 250.0f)));
+        if (!entity.Render(context, pass)) {
+          return false;
+        }
+      }
+    }
+    return true;
+  };
+  ASSERT_TRUE(OpenPlaygroundHere(callback));
+}
+
+TEST_P(GaussianBlurFilterContentsTest, KawaseBlurHonorsDecalTileMode) {
+  ExpectKawaseEdgesMatchSeparable(Entity::TileMode::kDecal);
+}
+
+TEST_P(GaussianBlurFilterContentsTest, KawaseBlurHonorsClampTileMode) {
+  ExpectKawaseEdgesMatchSeparable(Entity::TileMode::kClamp);
+}
+
+TEST_P(GaussianBlurFilterContentsTest, KawaseBlurHonorsMirrorTileMode) {
+  ExpectKawaseEdgesMatchSeparable(Entity::TileMode::kMirror);
+}
+
+TEST_P(GaussianBlurFilterContentsTest, KawaseBlurHonorsRepeatTileMode) {
+  ExpectKawaseEdgesMatchSeparable(Entity::TileMode::kRepeat);
+}
+
+TEST(GaussianBlurFilterContentsTest, KernelSigmaAccountsForTruncation) {
+  BlurParameters parameters = {.blur_uv_offset = Point(0, 0.1),
+                               .blur_sigma = 4,
+                               .blur_radius = 7,
+                               .step_size = 1};
+  Scalar kernel_sigma = CalculateKernelSigma(parameters);
+  EXPECT_GT(kernel_sigma, 2.0f);
+  EXPECT_LT(kernel_sigma, 4.0f);
+
+  parameters.blur_radius = 30;
+  EXPECT_NEAR(CalculateKernelSigma(parameters), 4.0f, 0.01f);
+
+  parameters.blur_sigma = 0;
+  EXPECT_EQ(CalculateKernelSigma(parameters), 0.0f);
+}
+
+TEST(GaussianBlurFilterContentsTest, KawaseBlurSkipsSmallSigmas) {
+  EXPECT_FALSE(CalculateKawaseBlurParameters(Vector2(10, 10), Vector2(5, 5))
+                   .has_value());
+  EXPECT_FALSE(CalculateKawaseBlurParameters(Vector2(20, 200), Vector2(5, 5))
+                   .has_value());
+  EXPECT_TRUE(CalculateKawaseBlurParameters(Vector2(40, 40), Vector2(5, 5))
+                  .has_value());
+}
+
+TEST(GaussianBlurFilterContentsTest, KawaseBlurSelectionIsMonotonic) {
+  // Follows the sigma of a blur through to the kernel of the separable pass
+  // the way RenderFilter does.
+  bool use_kawase = false;
+  for (Scalar sigma = 1.0f; sigma <= 500.0f; sigma += 0.5f) {
+    Scalar scaled_sigma = GaussianBlurFilterContents::ScaleSigma(sigma);
+    Scalar scale = GaussianBlurFilterContents::CalculateScale(scaled_sigma);
+    BlurParameters parameters = {
+        .blur_uv_offset = Point(1, 0),
+        .blur_sigma = scaled_sigma * scale,
+        .blur_radius = static_cast<int>(std::round(
+            GaussianBlurFilterContents::CalculateBlurRadius(scaled_sigma) *
+            scale)),
+        .step_size = 1,
+    };
+    Scalar kernel_sigma = CalculateKernelSigma(parameters);
+    bool selected =
+        CalculateKawaseBlurParameters(Vector2(scaled_sigma, scaled_sigma),
+                                      Vector2(kernel_sigma, kernel_sigma))
+            .has_value();
+    EXPECT_TRUE(selected || !use_kawase) << "sigma: " << sigma;
+    use_kawase = selected;
+  }
+  EXPECT_TRUE(use_kawase);
+}
+
+TEST(GaussianBlurFilterContentsTest, KawaseBlurLevelsGrowWithSigma) {
+  int previous_levels = 0;
+  for (Scalar sigma : {3.0f, 5.0f, 10.0f, 20.0f, 40.0f}) {
+    std::optional<KawaseBlurParameters> parameters =
+        CalculateKawaseBlurParameters(kLargeSourceSigma,  //
+                                      Vector2(sigma, sigma));
+    ASSERT_TRUE(parameters.has_value());
+    EXPECT_GE(parameters->levels, previous_levels);
+    EXPECT_GE(parameters->sample_offset.x, 0.5f);
+    EXPECT_LE(parameters->sample_offset.x, 1.5f);
+    EXPECT_EQ(parameters->sample_offset.x, parameters->sample_offset.y);
+    previous_levels = parameters->levels;
+  }
+  EXPECT_GT(previous_levels, 1);
+}
+
+TEST(GaussianBlurFilterContentsTest, KawaseBlurOffsetsAreAnisotropic) {
+  std::optional<KawaseBlurParameters> parameters =
+      CalculateKawaseBlurParameters(kLargeSourceSigma, Vector2(4, 6));
+  ASSERT_TRUE(parameters.has_value());
+  EXPECT_LT(parameters->sample_offset.x, parameters->sample_offset.y);
+
+  // Too different to share the levels.
+  EXPECT_FALSE(CalculateKawaseBlurParameters(kLargeSourceSigma, Vector2(3, 30))
+                   .has_value());
+}
+
+TEST(GaussianBlurFilterContentsTest, KawaseBlurMatchesSigma) {
+  std::vector<Scalar> impulse(512, 0.0f);
+  impulse[256] = 1.0f;
+  for (Scalar sigma : {3.0f, 4.0f, 7.0f, 10.0f, 16.0f, 25.0f, 40.0f}) {
+    std::optional<KawaseBlurParameters> parameters =
+        CalculateKawaseBlurParameters(kLargeSourceSigma,  //
+                                      Vector2(sigma, sigma));
+    ASSERT_TRUE(parameters.has_value());
+    std::vector<Scalar> blurred = SimulateKawaseBlur(
+        impulse, parameters->levels, parameters->sample_offset.x);
+    EXPECT_NEAR(CalculateStandardDeviation(blurred), sigma, sigma * 0.05f)
+        << "sigma: " << sigma;
+  }
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -145,7 +145,7 @@ TEST_P(HostBufferTest, EmplacingLargerThanBlockSizeCreatesOneOffBuffer) {
   EXPECT_EQ(buffer->GetStateForTest().total_buffer_count, 1u);
 }
 
-TEST_P(HostBufferTest, UnusedBuffersAreDiscardedWhenResetting) {
+TEST_P(HostBufferTest, UnusedBuffersAreDiscardedAfterCalmFrames) {
   auto buffer = HostBuffer::Create(GetContext()->GetResourceAllocator(),
                                    GetContext()->GetIdleWaiter());
 
@@ -162,19 +162,64 @@ TEST_P(HostBufferTest, UnusedBuffersAreDiscardedWhenResetting) {
     buffer->Reset();
   }
 
+  // The extra buffer is pooled rather than kept by the frame.
   EXPECT_EQ(buffer->GetStateForTest().current_buffer, 0u);
-  EXPECT_EQ(buffer->GetStateForTest().total_buffer_count, 2u);
+  EXPECT_EQ(buffer->GetStateForTest().total_buffer_count, 1u);
+  EXPECT_EQ(buffer->GetStateForTest().pooled_buffer_count, 1u);
   EXPECT_EQ(buffer->GetStateForTest().current_frame, 0u);
 
-  // Now when we reset, the buffer should get dropped.
-  // Reset until we get back to this frame.
-  for (auto i = 0; i < 4; i++) {
+  // Once the large frame is older than the trim window the pooled buffer
+  // gets dropped.
+  for (auto i = 4u; i < kHostBufferTrimFrameCount; i++) {
     buffer->Reset();
+    EXPECT_EQ(buffer->GetStateForTest().pooled_buffer_count, 1u);
   }
+  buffer->Reset();
 
-  EXPECT_EQ(buffer->GetStateForTest().current_buffer, 0u);
-  EXPECT_EQ(buffer->GetStateForTest().total_buffer_count, 1u);
-  EXPECT_EQ(buffer->GetStateForTest().current_frame, 0u);
+  EXPECT_EQ(buffer->GetStateForTest().pooled_buffer_count, 0u);
+  EXPECT_EQ(buffer->GetStatistics().blocks_allocated, 5u);
+  EXPECT_EQ(buffer->GetStatistics().blocks_released, 1u);
+  EXPECT_EQ(buffer->GetStatistics().blocks_retained, 4u);
+}
+
+TEST_P(HostBufferTest, PooledBuffersAreSharedBetweenFrames) {
+  auto buffer = HostBuffer::Create(GetContext()->GetResourceAllocator(),
+                                   GetContext()->GetIdleWaiter());
+
+  auto buffer_view_a = buffer->Emplace(1020000, 0, [](uint8_t* data) {});
+  auto buffer_view_b = buffer->Emplace(1020000, 0, [](uint8_t* data) {});
+  EXPECT_EQ(buffer->GetStatistics().blocks_allocated, 5u);
+
+  // Every following frame is as busy, but only the frames that overlap
+  // with a busy frame still in flight need a new block.
+  for (auto i = 0u; i < 2 * kHostBufferArenaSize; i++) {
+    buffer->Reset();
+    auto buffer_view_c = buffer->Emplace(1020000, 0, [](uint8_t* data) {});
+    auto buffer_view_d = buffer->Emplace(1020000, 0, [](uint8_t* data) {});
+    EXPECT_EQ(buffer->GetStateForTest().total_buffer_count, 2u);
+  }
+
+  EXPECT_EQ(buffer->GetStatistics().blocks_allocated,
+            2 * kHostBufferArenaSize);
+  EXPECT_EQ(buffer->GetStatistics().blocks_released, 0u);
+}
+
+TEST_P(HostBufferTest, StatisticsTrackPeakBytesAndAlignmentWaste) {
+  auto buffer = HostBuffer::Create(GetContext()->GetResourceAllocator(),
+                                   GetContext()->GetIdleWaiter());
+
+  auto view = buffer->Emplace(std::array<char, 21>());
+  view = buffer->Emplace(64, 16, [](uint8_t*) {});
+  EXPECT_EQ(view.GetRange(), Range(32, 64));
+
+  EXPECT_EQ(buffer->GetStatistics().wasted_alignment_bytes, 11u);
+  EXPECT_EQ(buffer->GetStatistics().peak_frame_bytes, 96u);
+
+  buffer->Reset();
+  view = buffer->Emplace(std::array<char, 8>());
+
+  EXPECT_EQ(buffer->GetStatistics().peak_frame_bytes, 96u);
+  EXPECT_EQ(buffer->GetStatistics().wasted_alignment_bytes, 11u);
 }
 
 TEST_P(HostBufferTest, EmplaceWithProcIsAligned) {
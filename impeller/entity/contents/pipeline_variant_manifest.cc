@@ -0,0 +1,163 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/contents/pipeline_variant_manifest.h"
+
+#include <cstring>
+#include <utility>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/trace_event.h"
+
+namespace impeller {
+
+static constexpr const char* kPipelineVariantManifestFileName =
+    "flutter.impeller.pipelinevariants";
+
+namespace {
+
+struct PipelineVariantManifestHeader {
+  uint32_t magic = 0x50564D46;
+  // Bump this to invalidate manifests when the layout of the content context
+  // options key changes.
+  uint32_t version = 1u;
+  uint64_t entry_count = 0u;
+
+  bool IsCompatibleWith(const PipelineVariantManifestHeader& o) const {
+    return magic == o.magic && version == o.version;
+  }
+};
+
+}  // namespace
+
+std::size_t PipelineVariantManifest::Entry::Hash::operator()(
+    const Entry& entry) const {
+  return PersistentHash(&entry, sizeof(Entry));
+}
+
+std::shared_ptr<PipelineVariantManifest> PipelineVariantManifest::Create(
+    fml::UniqueFD cache_directory,
+    std::shared_ptr<fml::BasicTaskRunner> persist_task_runner) {
+  if (!cache_directory.is_valid()) {
+    return nullptr;
+  }
+  auto manifest = std::shared_ptr<PipelineVariantManifest>(
+      new PipelineVariantManifest(std::move(cache_directory),
+                                  std::move(persist_task_runner)));
+  manifest->Load();
+  return manifest;
+}
+
+uint64_t PipelineVariantManifest::HashFamily(const PipelineDescriptor& desc) {
+  const std::string_view label = desc.GetLabel();
+  const std::vector<Scalar>& constants = desc.GetSpecializationConstants();
+  uint64_t hash = PersistentHash(label.data(), label.size());
+  return PersistentHash(constants.data(), constants.size() * sizeof(Scalar),
+                        hash);
+}
+
+PipelineVariantManifest::PipelineVariantManifest(
+    fml::UniqueFD cache_directory,
+    std::shared_ptr<fml::BasicTaskRunner> persist_task_runner)
+    : cache_directory_(std::move(cache_directory)),
+      persist_task_runner_(std::move(persist_task_runner)) {}
+
+PipelineVariantManifest::~PipelineVariantManifest() = default;
+
+void PipelineVariantManifest::Load() {
+  TRACE_EVENT0("impeller", "PipelineVariantManifest::Load");
+  std::unique_ptr<fml::FileMapping> mapping = fml::FileMapping::CreateReadOnly(
+      cache_directory_, kPipelineVariantManifestFileName);
+  if (!mapping || mapping->GetSize() < sizeof(PipelineVariantManifestHeader)) {
+    return;
+  }
+  PipelineVariantManifestHeader header;
+  std::memcpy(&header, mapping->GetMapping(), sizeof(header));
+  if (!header.IsCompatibleWith(PipelineVariantManifestHeader{})) {
+    FML_LOG(WARNING)
+        << "Persisted pipeline variant manifest is not compatible. Ignoring.";
+    return;
+  }
+  if (header.entry_count > kMaxEntryCount ||
+      mapping->GetSize() - sizeof(header) <
+          header.entry_count * sizeof(Entry)) {
+    FML_LOG(WARNING)
+        << "Persisted pipeline variant manifest is truncated. Ignoring.";
+    return;
+  }
+
+  const uint8_t* entries = mapping->GetMapping() + sizeof(header);
+  std::scoped_lock lock(mutex_);
+  for (uint64_t i = 0; i < header.entry_count; i++) {
+    Entry entry;
+    std::memcpy(&entry, entries + i * sizeof(Entry), sizeof(Entry));
+    if (entry_set_.insert(entry).second) {
+      entries_.push_back(entry);
+    }
+  }
+}
+
+std::vector<PipelineVariantManifest::Entry>
+PipelineVariantManifest::GetEntries() const {
+  std::scoped_lock lock(mutex_);
+  return entries_;
+}
+
+bool PipelineVariantManifest::Record(uint64_t family, uint64_t options_key) {
+  {
+    std::scoped_lock lock(mutex_);
+    if (entries_.size() >= kMaxEntryCount) {
+      return false;
+    }
+    const Entry entry{.family = family, .options_key = options_key};
+    if (!entry_set_.insert(entry).second) {
+      return false;
+    }
+    entries_.push_back(entry);
+    pending_entry_count_++;
+  }
+  PersistLater();
+  return true;
+}
+
+size_t PipelineVariantManifest::GetEntryCount() const {
+  std::scoped_lock lock(mutex_);
+  return entries_.size();
+}
+
+size_t PipelineVariantManifest::GetPendingEntryCount() const {
+  std::scoped_lock lock(mutex_);
+  return pending_entry_count_;
+}
+
+bool PipelineVariantManifest::Persist() {
+  TRACE_EVENT0("impeller", "PipelineVariantManifest::Persist");
+  std::vector<uint8_t> contents;
+  {
+    std::scoped_lock lock(mutex_);
+    PipelineVariantManifestHeader header;
+    header.entry_count = entries_.size();
+    contents.resize(sizeof(header) + entries_.size() * sizeof(Entry));
+    std::memcpy(contents.data(), &header, sizeof(header));
+    std::memcpy(contents.data() + sizeof(header), entries_.data(),
+                entries_.size() * sizeof(Entry));
+    pending_entry_count_ = 0u;
+  }
+
+  fml::DataMapping mapping(std::move(contents));
+  if (!fml::WriteAtomically(cache_directory_, kPipelineVariantManifestFileName,
+                            mapping)) {
+    FML_LOG(ERROR) << "Could not write pipeline variant manifest to disk.";
+    return false;
+  }
+  return true;
+}
+
+void PipelineVariantManifest::PersistLater() {
+  persist_scheduler_.Schedule(persist_task_runner_, weak_from_this());
+}
+
+}  // namespace impeller
@@ -0,0 +1,131 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_ENTITY_CONTENTS_PIPELINE_VARIANT_MANIFEST_H_
+#define FLUTTER_IMPELLER_ENTITY_CONTENTS_PIPELINE_VARIANT_MANIFEST_H_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/unique_fd.h"
+#include "impeller/base/persistence.h"
+#include "impeller/renderer/pipeline_descriptor.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A record of the pipeline variants created by a content context,
+///             persisted to disk so that the next launch of the application
+///             can compile them in the background before the first frame
+///             instead of on the raster thread when they are first used.
+///
+///             A variant is identified by the family of pipelines it belongs
+///             to and the key of the content context options it was created
+///             with. Families are identified by a hash of the label and
+///             specialization constants of their default pipeline.
+///
+///             All methods are safe to call concurrently.
+///
+class PipelineVariantManifest
+    : public std::enable_shared_from_this<PipelineVariantManifest> {
+ public:
+  /// The maximum number of variants recorded in the manifest.
+  static constexpr size_t kMaxEntryCount = 1024u;
+
+  struct Entry {
+    uint64_t family = 0u;
+    uint64_t options_key = 0u;
+
+    struct Hash {
+      std::size_t operator()(const Entry& entry) const;
+    };
+
+    struct Equal {
+      constexpr bool operator()(const Entry& lhs, const Entry& rhs) const {
+        return lhs.family == rhs.family && lhs.options_key == rhs.options_key;
+      }
+    };
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Create a manifest backed by a file in the given directory,
+  ///             loading the variants recorded there by a previous launch.
+  ///
+  /// @param[in]  cache_directory      The cache directory.
+  /// @param[in]  persist_task_runner  If set, the manifest is written to disk
+  ///                                  on this task runner whenever new
+  ///                                  variants are recorded.
+  ///
+  static std::shared_ptr<PipelineVariantManifest> Create(
+      fml::UniqueFD cache_directory,
+      std::shared_ptr<fml::BasicTaskRunner> persist_task_runner = nullptr);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Compute the identifier of the family of pipelines created
+  ///             from the given default descriptor. This is stable across
+  ///             launches of the same application.
+  ///
+  static uint64_t HashFamily(const PipelineDescriptor& desc);
+
+  ~PipelineVariantManifest();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The recorded variants in the order they were first used.
+  ///
+  std::vector<Entry> GetEntries() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Record the creation of a pipeline variant.
+  ///
+  /// @return     True if the variant was not already in the manifest.
+  ///
+  bool Record(uint64_t family, uint64_t options_key);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of variants in the manifest.
+  ///
+  size_t GetEntryCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of variants recorded since the manifest was last
+  ///             persisted.
+  ///
+  size_t GetPendingEntryCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Write the manifest to disk.
+  ///
+  /// @return     If the manifest could be persisted.
+  ///
+  bool Persist();
+
+ private:
+  const fml::UniqueFD cache_directory_;
+  const std::shared_ptr<fml::BasicTaskRunner> persist_task_runner_;
+  mutable std::mutex mutex_;
+  std::vector<Entry> entries_;
+  std::unordered_set<Entry, Entry::Hash, Entry::Equal> entry_set_;
+  size_t pending_entry_count_ = 0u;
+  PersistScheduler persist_scheduler_;
+
+  PipelineVariantManifest(
+      fml::UniqueFD cache_directory,
+      std::shared_ptr<fml::BasicTaskRunner> persist_task_runner);
+
+  void Load();
+
+  void PersistLater();
+
+  PipelineVariantManifest(const PipelineVariantManifest&) = delete;
+
+  PipelineVariantManifest& operator=(const PipelineVariantManifest&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_ENTITY_CONTENTS_PIPELINE_VARIANT_MANIFEST_H_
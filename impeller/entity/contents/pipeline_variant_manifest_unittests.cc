@@ -0,0 +1,134 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/testing/testing.h"
+#include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/contents/pipeline_variant_manifest.h"
+#include "impeller/entity/entity_playground.h"
+#include "impeller/typographer/backends/skia/typographer_context_skia.h"
+
+namespace impeller {
+namespace testing {
+
+using PipelineVariantManifestTest = EntityPlayground;
+INSTANTIATE_PLAYGROUND_SUITE(PipelineVariantManifestTest);
+
+namespace {
+std::shared_ptr<PipelineVariantManifest> OpenManifest(
+    const fml::ScopedTemporaryDirectory& temp_dir) {
+  return PipelineVariantManifest::Create(fml::OpenDirectory(
+      temp_dir.path().c_str(), false, fml::FilePermission::kReadWrite));
+}
+}  // namespace
+
+TEST_P(PipelineVariantManifestTest, RecordsArePersistedInOrder) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  auto manifest = OpenManifest(temp_dir);
+  ASSERT_TRUE(manifest);
+  EXPECT_EQ(manifest->GetEntryCount(), 0u);
+
+  EXPECT_TRUE(manifest->Record(2u, 20u));
+  EXPECT_TRUE(manifest->Record(1u, 10u));
+  EXPECT_FALSE(manifest->Record(2u, 20u));
+  EXPECT_TRUE(manifest->Record(2u, 10u));
+  EXPECT_EQ(manifest->GetEntryCount(), 3u);
+  EXPECT_EQ(manifest->GetPendingEntryCount(), 3u);
+
+  ASSERT_TRUE(manifest->Persist());
+  EXPECT_EQ(manifest->GetPendingEntryCount(), 0u);
+
+  auto reopened = OpenManifest(temp_dir);
+  ASSERT_TRUE(reopened);
+  auto entries = reopened->GetEntries();
+  ASSERT_EQ(entries.size(), 3u);
+  EXPECT_EQ(entries[0].family, 2u);
+  EXPECT_EQ(entries[0].options_key, 20u);
+  EXPECT_EQ(entries[1].family, 1u);
+  EXPECT_EQ(entries[1].options_key, 10u);
+  EXPECT_EQ(entries[2].family, 2u);
+  EXPECT_EQ(entries[2].options_key, 10u);
+  EXPECT_EQ(reopened->GetPendingEntryCount(), 0u);
+}
+
+TEST_P(PipelineVariantManifestTest, IgnoresIncompatibleFiles) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  auto directory = fml::OpenDirectory(temp_dir.path().c_str(), false,
+                                      fml::FilePermission::kReadWrite);
+  fml::DataMapping garbage(std::string(64, 'x'));
+  ASSERT_TRUE(fml::WriteAtomically(
+      directory, "flutter.impeller.pipelinevariants", garbage));
+
+  auto manifest = OpenManifest(temp_dir);
+  ASSERT_TRUE(manifest);
+  EXPECT_EQ(manifest->GetEntryCount(), 0u);
+}
+
+TEST_P(PipelineVariantManifestTest, ContentContextOptionsRoundTripThroughKey) {
+  ContentContextOptions options{
+      .sample_count = SampleCount::kCount4,
+      .blend_mode = BlendMode::kModulate,
+      .depth_compare = CompareFunction::kGreaterEqual,
+      .stencil_mode =
+          ContentContextOptions::StencilMode::kOverdrawPreventionRestore,
+      .primitive_type = PrimitiveType::kTriangleStrip,
+      .color_attachment_pixel_format = PixelFormat::kB8G8R8A8UNormInt,
+      .has_depth_stencil_attachments = false,
+      .depth_write_enabled = true,
+      .is_for_rrect_blur_clear = true,
+  };
+  auto decoded = ContentContextOptions::FromKey(options.ToKey());
+  ASSERT_TRUE(decoded.has_value());
+  EXPECT_EQ(decoded->ToKey(), options.ToKey());
+  EXPECT_EQ(decoded->blend_mode, BlendMode::kModulate);
+  EXPECT_EQ(decoded->stencil_mode,
+            ContentContextOptions::StencilMode::kOverdrawPreventionRestore);
+
+  // Unused bits and out of range enums are rejected.
+  EXPECT_FALSE(ContentContextOptions::FromKey(options.ToKey() | 1llu << 5));
+  EXPECT_FALSE(ContentContextOptions::FromKey(options.ToKey() | 1llu << 60));
+  ContentContextOptions advanced_blend = options;
+  advanced_blend.blend_mode = BlendMode::kLuminosity;
+  EXPECT_FALSE(ContentContextOptions::FromKey(advanced_blend.ToKey()));
+}
+
+TEST_P(PipelineVariantManifestTest, ContentContextPrewarmsRecordedVariants) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  ContentContextOptions options{
+      .sample_count = SampleCount::kCount4,
+      .blend_mode = BlendMode::kSource,
+      .color_attachment_pixel_format =
+          GetContext()->GetCapabilities()->GetDefaultColorFormat(),
+  };
+
+  auto manifest = OpenManifest(temp_dir);
+  ASSERT_TRUE(manifest);
+  {
+    ContentContext content_context(GetContext(), TypographerContextSkia::Make(),
+                                   nullptr, manifest);
+    ASSERT_TRUE(content_context.IsValid());
+    EXPECT_TRUE(content_context.GetSolidFillPipeline(options));
+    EXPECT_EQ(manifest->GetEntryCount(), 1u);
+    EXPECT_TRUE(content_context.GetSolidFillPipeline(options));
+    EXPECT_EQ(manifest->GetEntryCount(), 1u);
+    // Destroying the context persists the pending variants.
+  }
+  EXPECT_EQ(manifest->GetPendingEntryCount(), 0u);
+
+  auto reopened = OpenManifest(temp_dir);
+  ASSERT_TRUE(reopened);
+  ASSERT_EQ(reopened->GetEntryCount(), 1u);
+  ContentContext content_context(GetContext(), TypographerContextSkia::Make(),
+                                 nullptr, reopened);
+  ASSERT_TRUE(content_context.IsValid());
+  // The variant was created by the replay, so using it records nothing new.
+  EXPECT_TRUE(content_context.GetSolidFillPipeline(options));
+  EXPECT_EQ(reopened->GetPendingEntryCount(), 0u);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -9,6 +9,10 @@
 #include "impeller/entity/geometry/geometry.h"
 #include "impeller/renderer/render_pass.h"
 
+#ifdef IMPELLER_ENABLE_COMPUTE
+#include "impeller/entity/geometry/compute_path_rasterizer.h"
+#endif  // IMPELLER_ENABLE_COMPUTE
+
 namespace impeller {
 
 SolidColorContents::SolidColorContents() = default;
@@ -49,6 +53,13 @@ bool SolidColorContents::Render(const ContentContext& renderer,
                                 RenderPass& pass) const {
   using VS = SolidFillPipeline::VertexShader;
   using FS = SolidFillPipeline::FragmentShader;
+
+  if (std::optional<bool> result =
+          RenderComputedCoverage(renderer, entity, pass);
+      result.has_value()) {
+    return result.value();
+  }
+
   auto& host_buffer = renderer.GetTransientsBuffer();
 
   VS::FrameInfo frame_info;
@@ -69,6 +80,69 @@ bool SolidColorContents::Render(const ContentContext& renderer,
       });
 }
 
+std::optional<bool> SolidColorContents::RenderComputedCoverage(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) const {
+#ifdef IMPELLER_ENABLE_COMPUTE
+  using VS = PathCoverageFillPipeline::VertexShader;
+  using FS = PathCoverageFillPipeline::FragmentShader;
+
+  const ComputePathRasterizer* rasterizer = renderer.GetComputePathRasterizer();
+  const Path* path = GetGeometry()->GetFillPath();
+  if (rasterizer == nullptr || path == nullptr ||
+      !ComputePathRasterizer::ShouldRasterize(*path, entity.GetTransform())) {
+    return std::nullopt;
+  }
+
+  auto& host_buffer = renderer.GetTransientsBuffer();
+  std::optional<ComputePathRasterizer::Coverage> coverage =
+      rasterizer->Rasterize(*renderer.GetContext(), host_buffer, *path,
+                            entity.GetTransform(),
+                            IRect::MakeSize(pass.GetRenderTargetSize()));
+  if (!coverage.has_value()) {
+    return std::nullopt;
+  }
+
+  // The cover quad is specified in render target pixels.
+  Rect bounds = Rect::Make(coverage->bounds);
+  pass.SetCommandLabel("Solid Fill (Computed Coverage)");
+  pass.SetVertexBuffer(VertexBuffer{
+      .vertex_buffer = host_buffer.Emplace(bounds.GetPoints().data(),
+                                           8 * sizeof(float), alignof(float)),
+      .vertex_count = 4,
+      .index_type = IndexType::kNone,
+  });
+
+  ContentContextOptions options = OptionsFromPassAndEntity(pass, entity);
+  options.primitive_type = PrimitiveType::kTriangleStrip;
+  // Opaque fills are still blended at their anti-aliased edges, so they
+  // cannot be drawn with source blending and depth writes.
+  if (options.blend_mode == BlendMode::kSource) {
+    options.blend_mode = BlendMode::kSourceOver;
+  }
+  pass.SetPipeline(renderer.GetPathCoverageFillPipeline(options));
+
+  VS::FrameInfo frame_info;
+  frame_info.mvp =
+      Entity::GetShaderTransform(entity.GetShaderClipDepth(), pass, Matrix());
+  VS::BindFrameInfo(pass, host_buffer.EmplaceUniform(frame_info));
+
+  FS::FragInfo frag_info;
+  frag_info.color = GetColor().Premultiply() *
+                    GetGeometry()->ComputeAlphaCoverage(entity.GetTransform());
+  frag_info.origin = bounds.GetOrigin();
+  frag_info.size = Point(bounds.GetSize());
+  frag_info.stride = static_cast<Scalar>(coverage->stride);
+  FS::BindFragInfo(pass, host_buffer.EmplaceUniform(frag_info));
+  FS::BindCoverage(pass, coverage->buffer);
+
+  return pass.Draw().ok();
+#else
+  return std::nullopt;
+#endif  // IMPELLER_ENABLE_COMPUTE
+}
+
 std::optional<Color> SolidColorContents::AsBackgroundColor(
     const Entity& entity,
     ISize target_size) const {
@@ -5,6 +5,8 @@
 #ifndef FLUTTER_IMPELLER_ENTITY_CONTENTS_SOLID_COLOR_CONTENTS_H_
 #define FLUTTER_IMPELLER_ENTITY_CONTENTS_SOLID_COLOR_CONTENTS_H_
 
+#include <optional>
+
 #include "impeller/entity/contents/color_source_contents.h"
 #include "impeller/entity/contents/contents.h"
 #include "impeller/geometry/color.h"
@@ -45,6 +47,21 @@ class SolidColorContents final : public ColorSourceContents {
  private:
   Color color_;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Draws complex path fills with coverage rasterized in compute
+  ///             passes instead of stencil-then-cover, if enabled with
+  ///             |ContentContext::SetComputePathRasterizationEnabled|.
+  ///
+  ///             Each such fill enqueues its own command buffer, see
+  ///             |ComputePathRasterizer::Rasterize|.
+  ///
+  /// @return     Whether the draw succeeded, or |std::nullopt| if the fill
+  ///             should be drawn with |DrawGeometry| instead.
+  ///
+  std::optional<bool> RenderComputedCoverage(const ContentContext& renderer,
+                                             const Entity& entity,
+                                             RenderPass& pass) const;
+
   SolidColorContents(const SolidColorContents&) = delete;
 
   SolidColorContents& operator=(const SolidColorContents&) = delete;
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include <algorithm>
+#include <cstdlib>
 #include <cstring>
 #include <memory>
 #include <optional>
@@ -10,9 +11,11 @@
 #include <vector>
 
 #include "flutter/display_list/testing/dl_test_snippets.h"
+#include "flutter/fml/synchronization/waitable_event.h"
 #include "fml/logging.h"
 #include "gtest/gtest.h"
 #include "impeller/core/device_buffer.h"
+#include "impeller/core/device_buffer_descriptor.h"
 #include "impeller/core/formats.h"
 #include "impeller/core/host_buffer.h"
 #include "impeller/core/raw_ptr.h"
@@ -36,11 +39,15 @@
 #include "impeller/entity/contents/tiled_texture_contents.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/entity_playground.h"
+#ifdef IMPELLER_ENABLE_COMPUTE
+#include "impeller/entity/geometry/compute_path_rasterizer.h"
+#endif  // IMPELLER_ENABLE_COMPUTE
 #include "impeller/entity/geometry/geometry.h"
 #include "impeller/entity/geometry/point_field_geometry.h"
 #include "impeller/entity/geometry/round_superellipse_geometry.h"
 #include "impeller/entity/geometry/stroke_path_geometry.h"
 #include "impeller/entity/geometry/superellipse_geometry.h"
+#include "impeller/entity/geometry/tessellation_cache.h"
 #include "impeller/geometry/color.h"
 #include "impeller/geometry/geometry_asserts.h"
 #include "impeller/geometry/path_builder.h"
@@ -49,7 +56,9 @@
 #include "impeller/geometry/vector.h"
 #include "impeller/playground/playground.h"
 #include "impeller/playground/widgets.h"
+#include "impeller/renderer/blit_pass.h"
 #include "impeller/renderer/command.h"
+#include "impeller/renderer/command_buffer.h"
 #include "impeller/renderer/pipeline_descriptor.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/renderer/render_target.h"
@@ -128,6 +137,161 @@ TEST_P(EntityTest, ThreeStrokesInOnePath) {
   ASSERT_TRUE(OpenPlaygroundHere(std::move(entity)));
 }
 
+#ifdef IMPELLER_ENABLE_COMPUTE
+namespace {
+
+// A self-intersecting star with enough components to be rasterized in
+// compute passes.
+Path MakeComplexStar(Point center, Scalar radius, FillType fill_type) {
+  PathBuilder builder;
+  constexpr size_t kPointCount = 101;
+  for (size_t i = 0; i < kPointCount; i++) {
+    Scalar angle = kPi * 2 * (i * 37 % kPointCount) / kPointCount;
+    Point point = center + Point(std::cos(angle), std::sin(angle)) * radius;
+    if (i == 0) {
+      builder.MoveTo(point);
+    } else {
+      builder.LineTo(point);
+    }
+  }
+  builder.Close();
+  return builder.TakePath(fill_type);
+}
+
+}  // namespace
+
+TEST_P(EntityTest, ComplexFillsUseComputedCoverage) {
+  if (!ComputePathRasterizer::IsSupported(*GetContext()->GetCapabilities())) {
+    GTEST_SKIP() << "Compute path rasterization is not supported.";
+  }
+
+  // One star for each fill rule.
+  Path non_zero = MakeComplexStar({250, 250}, 200, FillType::kNonZero);
+  Path even_odd = MakeComplexStar({700, 250}, 200, FillType::kOdd);
+  ASSERT_TRUE(ComputePathRasterizer::ShouldRasterize(non_zero, Matrix()));
+
+  auto callback = [&](ContentContext& context, RenderPass& pass) -> bool {
+    context.SetComputePathRasterizationEnabled(true);
+    for (const Path* path : {&non_zero, &even_odd}) {
+      Entity entity;
+      entity.SetTransform(Matrix::MakeScale(GetContentScale()));
+      auto contents = std::make_unique<SolidColorContents>();
+      std::unique_ptr<Geometry> geom = Geometry::MakeFillPath(*path);
+      contents->SetGeometry(geom.get());
+      contents->SetColor(Color::Red().WithAlpha(0.75));
+      entity.SetContents(std::move(contents));
+      if (!entity.Render(context, pass)) {
+        return false;
+      }
+    }
+    return true;
+  };
+  ASSERT_TRUE(OpenPlaygroundHere(callback));
+}
+
+TEST_P(EntityTest, ComputedCoverageMatchesStencilThenCover) {
+  if (!ComputePathRasterizer::IsSupported(*GetContext()->GetCapabilities())) {
+    GTEST_SKIP() << "Compute path rasterization is not supported.";
+  }
+  constexpr ISize kSize = {256, 256};
+
+  // Renders an opaque fill of |path| and reads back the resolved pixels, or
+  // returns an empty vector on failure.
+  auto render = [&](const Path& path,
+                    bool use_computed_coverage) -> std::vector<uint8_t> {
+    std::shared_ptr<ContentContext> content_context = GetContentContext();
+    content_context->SetComputePathRasterizationEnabled(
+        use_computed_coverage);
+    if (use_computed_coverage &&
+        content_context->GetComputePathRasterizer() == nullptr) {
+      return {};
+    }
+    std::shared_ptr<Context> context = GetContext();
+    std::shared_ptr<CommandBuffer> command_buffer =
+        context->CreateCommandBuffer();
+    fml::StatusOr<RenderTarget> target = content_context->MakeSubpass(
+        "Path Coverage Comparison", kSize, command_buffer,
+        [&path](const ContentContext& renderer, RenderPass& pass) {
+          Entity entity;
+          auto contents = std::make_unique<SolidColorContents>();
+          std::unique_ptr<Geometry> geom = Geometry::MakeFillPath(path);
+          contents->SetGeometry(geom.get());
+          contents->SetColor(Color::Red());
+          entity.SetContents(std::move(contents));
+          return entity.Render(renderer, pass);
+        },
+        /*msaa_enabled=*/true, /*depth_stencil_enabled=*/true);
+    if (!target.ok()) {
+      return {};
+    }
+
+    std::shared_ptr<Texture> texture = target->GetRenderTargetTexture();
+    DeviceBufferDescriptor buffer_desc;
+    buffer_desc.storage_mode = StorageMode::kHostVisible;
+    buffer_desc.size =
+        texture->GetTextureDescriptor().GetByteSizeOfBaseMipLevel();
+    std::shared_ptr<DeviceBuffer> readback =
+        context->GetResourceAllocator()->CreateBuffer(buffer_desc);
+    std::shared_ptr<BlitPass> blit_pass = command_buffer->CreateBlitPass();
+    if (!readback || !blit_pass->AddCopy(texture, readback) ||
+        !blit_pass->EncodeCommands(context->GetResourceAllocator())) {
+      return {};
+    }
+
+    // The coverage command buffers may still be pending in the context, and
+    // must be submitted before the pass that reads the coverage.
+    if (!context->FlushCommandBuffers()) {
+      return {};
+    }
+    fml::AutoResetWaitableEvent latch;
+    bool completed = false;
+    if (!context->GetCommandQueue()
+             ->Submit({command_buffer},
+                      [&latch, &completed](CommandBuffer::Status status) {
+                        completed = status == CommandBuffer::Status::kCompleted;
+                        latch.Signal();
+                      })
+             .ok()) {
+      return {};
+    }
+    latch.Wait();
+    if (!completed) {
+      return {};
+    }
+
+    std::vector<uint8_t> pixels(buffer_desc.size);
+    std::memcpy(pixels.data(), readback->OnGetContents(), pixels.size());
+    return pixels;
+  };
+
+  for (FillType fill_type : {FillType::kNonZero, FillType::kOdd}) {
+    Path path = MakeComplexStar({128, 128}, 120, fill_type);
+    ASSERT_TRUE(ComputePathRasterizer::ShouldRasterize(path, Matrix()));
+
+    std::vector<uint8_t> stencil_then_cover = render(path, false);
+    std::vector<uint8_t> computed_coverage = render(path, true);
+    ASSERT_FALSE(stencil_then_cover.empty());
+    ASSERT_EQ(computed_coverage.size(), stencil_then_cover.size());
+
+    // The interiors match exactly. The anti-aliased edges differ since
+    // stencil-then-cover resolves 4 samples per pixel and the compute passes
+    // take 16, and the star has many thin spikes.
+    size_t differing_bytes = 0u;
+    int max_difference = 0;
+    for (size_t i = 0; i < computed_coverage.size(); i++) {
+      int difference = std::abs(static_cast<int>(computed_coverage[i]) -
+                                static_cast<int>(stencil_then_cover[i]));
+      max_difference = std::max(max_difference, difference);
+      if (difference > 2) {
+        differing_bytes++;
+      }
+    }
+    EXPECT_LE(max_difference, 128);
+    EXPECT_LT(differing_bytes, computed_coverage.size() / 20u);
+  }
+}
+#endif  // IMPELLER_ENABLE_COMPUTE
+
 TEST_P(EntityTest, StrokeWithTextureContents) {
   auto bridge = CreateTextureForFixture("bay_bridge.jpg");
   Path path = PathBuilder{}
@@ -2500,6 +2664,96 @@ TEST_P(EntityTest, GiantLineStripPathAllocation) {
   EXPECT_NEAR(point.y, expected[4].y, 0.1);
 }
 
+static VertexBuffer EmplaceTriangle(HostBuffer& host_buffer) {
+  std::vector<Point> points = {{0, 0}, {10, 0}, {0, 10}};
+  return VertexBuffer{
+      .vertex_buffer = host_buffer.Emplace(
+          points.data(), points.size() * sizeof(Point), alignof(Point)),
+      .vertex_count = points.size(),
+      .index_type = IndexType::kNone,
+  };
+}
+
+TEST_P(EntityTest, TessellationCacheStoresRepeatedTessellations) {
+  TessellationCache cache;
+  auto& host_buffer = GetContentContext()->GetTransientsBuffer();
+  auto& allocator = *GetContext()->GetResourceAllocator();
+  Path path = PathBuilder{}.AddCircle({10, 10}, 5).TakePath();
+  TessellationCache::Key key = {.path_hash = path.GetContentHash()};
+
+  EXPECT_FALSE(cache.Get(key, path).has_value());
+
+  // The first tessellation is only remembered, not copied.
+  VertexBuffer first = EmplaceTriangle(host_buffer);
+  const DeviceBuffer* first_buffer = first.vertex_buffer.GetBuffer();
+  VertexBuffer stored = cache.Store(key, path, std::move(first), allocator);
+  EXPECT_EQ(stored.vertex_buffer.GetBuffer(), first_buffer);
+  EXPECT_EQ(cache.GetEntryCount(), 0u);
+
+  stored = cache.Store(key, path, EmplaceTriangle(host_buffer), allocator);
+  EXPECT_EQ(cache.GetEntryCount(), 1u);
+  EXPECT_EQ(cache.GetByteSize(), 3 * sizeof(Point));
+
+  std::optional<VertexBuffer> cached = cache.Get(key, path);
+  ASSERT_TRUE(cached.has_value());
+  EXPECT_EQ(cached->vertex_buffer.GetBuffer(),
+            stored.vertex_buffer.GetBuffer());
+  EXPECT_EQ(cached->vertex_count, 3u);
+
+  // A different path with a colliding key is not served from the cache.
+  Path other_path = PathBuilder{}.AddCircle({10, 10}, 6).TakePath();
+  EXPECT_FALSE(cache.Get(key, other_path).has_value());
+}
+
+TEST_P(EntityTest, TessellationCacheEvictsLeastRecentlyUsed) {
+  TessellationCache cache(/*max_bytes=*/2 * 3 * sizeof(Point));
+  auto& host_buffer = GetContentContext()->GetTransientsBuffer();
+  auto& allocator = *GetContext()->GetResourceAllocator();
+  Path path = PathBuilder{}.AddCircle({10, 10}, 5).TakePath();
+
+  for (int32_t bucket = 0; bucket < 3; bucket++) {
+    TessellationCache::Key key = {.path_hash = path.GetContentHash(),
+                                  .scale_bucket = bucket};
+    cache.Store(key, path, EmplaceTriangle(host_buffer), allocator);
+    cache.Store(key, path, EmplaceTriangle(host_buffer), allocator);
+  }
+
+  EXPECT_EQ(cache.GetEntryCount(), 2u);
+  EXPECT_FALSE(
+      cache.Get({.path_hash = path.GetContentHash(), .scale_bucket = 0}, path)
+          .has_value());
+  EXPECT_TRUE(
+      cache.Get({.path_hash = path.GetContentHash(), .scale_bucket = 2}, path)
+          .has_value());
+}
+
+TEST_P(EntityTest, FillPathGeometryReusesTessellationAcrossTranslations) {
+  auto content_context = GetContentContext();
+  TessellationCache& cache = content_context->GetTessellationCache();
+  cache.Clear();
+  auto geometry = Geometry::MakeFillPath(
+      PathBuilder{}.AddCircle({100, 100}, 50).TakePath());
+
+  auto target = content_context->GetRenderTargetCache()->CreateOffscreen(
+      *GetContext(), {100, 100}, /*mip_count=*/1);
+  auto buffer = GetContext()->CreateCommandBuffer();
+  auto render_pass = buffer->CreateRenderPass(target);
+
+  Entity entity;
+  entity.SetTransform(Matrix::MakeTranslation({10, 10}));
+  geometry->GetPositionBuffer(*content_context, entity, *render_pass);
+  GeometryResult result =
+      geometry->GetPositionBuffer(*content_context, entity, *render_pass);
+  EXPECT_EQ(cache.GetEntryCount(), 1u);
+
+  entity.SetTransform(Matrix::MakeTranslation({20, 30}));
+  GeometryResult translated =
+      geometry->GetPositionBuffer(*content_context, entity, *render_pass);
+  EXPECT_EQ(cache.GetEntryCount(), 1u);
+  EXPECT_EQ(translated.vertex_buffer.vertex_buffer.GetBuffer(),
+            result.vertex_buffer.vertex_buffer.GetBuffer());
+}
+
 }  // namespace testing
 }  // namespace impeller
 
@@ -0,0 +1,278 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/geometry/compute_path_rasterizer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "impeller/base/validation.h"
+#include "impeller/core/platform.h"
+#include "impeller/entity/path_bin_count.comp.h"
+#include "impeller/entity/path_bin_offsets.comp.h"
+#include "impeller/entity/path_bin_scatter.comp.h"
+#include "impeller/entity/path_coverage.comp.h"
+#include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/compute_pass.h"
+#include "impeller/renderer/compute_pipeline_builder.h"
+#include "impeller/renderer/pipeline_library.h"
+
+namespace impeller {
+
+namespace {
+
+template <class ComputeShader>
+PipelineFuture<ComputePipelineDescriptor> CreatePipeline(
+    const Context& context) {
+  return context.GetPipelineLibrary()->GetPipeline(
+      ComputePipelineBuilder<ComputeShader>::MakeDefaultPipelineDescriptor(
+          context));
+}
+
+uint32_t GetBand(Scalar y, const IRect& bounds) {
+  Scalar row = std::clamp(std::floor(y), 0.0f,
+                          static_cast<Scalar>(bounds.GetHeight() - 1));
+  return static_cast<uint32_t>(row) / ComputePathRasterizer::kBandHeight;
+}
+
+}  // namespace
+
+// static
+bool ComputePathRasterizer::IsSupported(const Capabilities& capabilities) {
+  return capabilities.SupportsCompute() && capabilities.SupportsSSBO();
+}
+
+// static
+bool ComputePathRasterizer::ShouldRasterize(const Path& path,
+                                            const Matrix& transform) {
+  return !path.IsConvex() && !transform.HasPerspective() &&
+         path.GetComponentCount() >= kMinComponentCount;
+}
+
+// static
+std::optional<ComputePathRasterizer::Segments>
+ComputePathRasterizer::ComputeSegments(const Path& path,
+                                       const Matrix& transform,
+                                       const IRect& clip_bounds) {
+  std::optional<Rect> path_bounds = path.GetTransformedBoundingBox(transform);
+  if (!path_bounds.has_value()) {
+    return std::nullopt;
+  }
+  std::optional<IRect> bounds =
+      IRect::RoundOut(path_bounds.value()).Intersection(clip_bounds);
+  if (!bounds.has_value() || bounds->IsEmpty() ||
+      bounds->GetWidth() * bounds->GetHeight() >
+          static_cast<int64_t>(kMaxCoveragePixels)) {
+    return std::nullopt;
+  }
+
+  Segments segments;
+  segments.bounds = bounds.value();
+  segments.band_count = static_cast<uint32_t>(
+      (bounds->GetHeight() + kBandHeight - 1) / kBandHeight);
+
+  const Point origin = Point(bounds->GetLeftTop());
+  const Scalar height = static_cast<Scalar>(bounds->GetHeight());
+  auto add_segment = [&segments, &origin, height](Point p0, Point p1) {
+    p0 -= origin;
+    p1 -= origin;
+    Scalar min_y = std::min(p0.y, p1.y);
+    Scalar max_y = std::max(p0.y, p1.y);
+    // Horizontal segments never cross a sample row. Segments entirely above,
+    // below or to the left of the coverage area never cross a sample row to
+    // the right of a sample in it.
+    if (min_y == max_y || max_y <= 0 || min_y >= height ||
+        std::max(p0.x, p1.x) <= 0) {
+      return;
+    }
+    uint32_t first_band = GetBand(min_y, segments.bounds);
+    uint32_t last_band = GetBand(std::ceil(max_y) - 1, segments.bounds);
+    segments.points.emplace_back(p0.x, p0.y, p1.x, p1.y);
+    segments.bands.push_back(first_band);
+    segments.bands.push_back(last_band);
+    segments.bin_count += last_band - first_band + 1;
+  };
+
+  Path::Polyline polyline =
+      path.CreatePolyline(transform.GetMaxBasisLengthXY());
+  for (size_t i = 0; i < polyline.contours.size(); i++) {
+    auto [start, end] = polyline.GetContourPointBounds(i);
+    if (end - start < 2) {
+      continue;
+    }
+    Point first = transform * polyline.GetPoint(start);
+    Point previous = first;
+    for (size_t j = start + 1; j < end; j++) {
+      Point point = transform * polyline.GetPoint(j);
+      add_segment(previous, point);
+      previous = point;
+    }
+    // Fills implicitly close every contour.
+    add_segment(previous, first);
+  }
+  return segments;
+}
+
+ComputePathRasterizer::ComputePathRasterizer(const Context& context)
+    : bin_count_pipeline_(CreatePipeline<PathBinCountComputeShader>(context)),
+      bin_offsets_pipeline_(
+          CreatePipeline<PathBinOffsetsComputeShader>(context)),
+      bin_scatter_pipeline_(
+          CreatePipeline<PathBinScatterComputeShader>(context)),
+      coverage_pipeline_(CreatePipeline<PathCoverageComputeShader>(context)) {}
+
+ComputePathRasterizer::~ComputePathRasterizer() = default;
+
+bool ComputePathRasterizer::IsValid() const {
+  return bin_count_pipeline_.IsValid() && bin_offsets_pipeline_.IsValid() &&
+         bin_scatter_pipeline_.IsValid() && coverage_pipeline_.IsValid();
+}
+
+std::optional<ComputePathRasterizer::Coverage>
+ComputePathRasterizer::Rasterize(Context& context,
+                                 HostBuffer& host_buffer,
+                                 const Path& path,
+                                 const Matrix& transform,
+                                 const IRect& clip_bounds) const {
+  using BinCountCS = PathBinCountComputeShader;
+  using BinOffsetsCS = PathBinOffsetsComputeShader;
+  using BinScatterCS = PathBinScatterComputeShader;
+  using CoverageCS = PathCoverageComputeShader;
+
+  if (!IsValid()) {
+    return std::nullopt;
+  }
+  std::optional<Segments> segments =
+      ComputeSegments(path, transform, clip_bounds);
+  if (!segments.has_value() || segments->points.empty()) {
+    return std::nullopt;
+  }
+
+  auto bin_count_pipeline = bin_count_pipeline_.Get();
+  auto bin_offsets_pipeline = bin_offsets_pipeline_.Get();
+  auto bin_scatter_pipeline = bin_scatter_pipeline_.Get();
+  auto coverage_pipeline = coverage_pipeline_.Get();
+  if (!bin_count_pipeline || !bin_offsets_pipeline || !bin_scatter_pipeline ||
+      !coverage_pipeline) {
+    return std::nullopt;
+  }
+
+  const uint32_t segment_count =
+      static_cast<uint32_t>(segments->points.size());
+  const uint32_t band_count = segments->band_count;
+  const ISize size = segments->bounds.GetSize();
+  const uint32_t stride = static_cast<uint32_t>((size.width + 3) / 4);
+  const size_t coverage_word_count = static_cast<size_t>(stride) * size.height;
+
+  const size_t alignment = DefaultUniformAlignment();
+  BufferView points_view = host_buffer.Emplace(
+      segments->points.data(), segments->points.size() * sizeof(Vector4),
+      alignment);
+  BufferView segment_bands_view = host_buffer.Emplace(
+      segments->bands.data(), segments->bands.size() * sizeof(uint32_t),
+      alignment);
+  // The counts, offsets and write cursors of the bands. The counts must start
+  // at zero.
+  std::vector<uint32_t> bands(band_count * 3u, 0u);
+  BufferView bands_view = host_buffer.Emplace(
+      bands.data(), bands.size() * sizeof(uint32_t), alignment);
+  BufferView bins_view = host_buffer.Emplace(
+      nullptr, segments->bin_count * sizeof(uint32_t), alignment);
+  BufferView coverage_view = host_buffer.Emplace(
+      nullptr, coverage_word_count * sizeof(uint32_t), alignment);
+  if (!points_view || !segment_bands_view || !bands_view || !bins_view ||
+      !coverage_view) {
+    return std::nullopt;
+  }
+
+  std::shared_ptr<CommandBuffer> command_buffer =
+      context.CreateCommandBuffer();
+  if (!command_buffer) {
+    return std::nullopt;
+  }
+  command_buffer->SetLabel("Path Coverage");
+  std::shared_ptr<ComputePass> pass = command_buffer->CreateComputePass();
+  if (!pass || !pass->IsValid()) {
+    return std::nullopt;
+  }
+
+  {
+    pass->SetCommandLabel("Path Bin Count");
+    pass->SetPipeline(bin_count_pipeline);
+    BinCountCS::Config config;
+    config.segment_count = segment_count;
+    BinCountCS::BindConfig(*pass, host_buffer.EmplaceUniform(config));
+    BinCountCS::BindSegmentBands(*pass, segment_bands_view);
+    BinCountCS::BindBands(*pass, bands_view);
+    if (!pass->Compute(ISize(segment_count, 1)).ok()) {
+      return std::nullopt;
+    }
+    pass->AddBufferMemoryBarrier();
+  }
+
+  {
+    pass->SetCommandLabel("Path Bin Offsets");
+    pass->SetPipeline(bin_offsets_pipeline);
+    BinOffsetsCS::Config config;
+    config.band_count = band_count;
+    BinOffsetsCS::BindConfig(*pass, host_buffer.EmplaceUniform(config));
+    BinOffsetsCS::BindBands(*pass, bands_view);
+    if (!pass->Compute(ISize(1, 1)).ok()) {
+      return std::nullopt;
+    }
+    pass->AddBufferMemoryBarrier();
+  }
+
+  {
+    pass->SetCommandLabel("Path Bin Scatter");
+    pass->SetPipeline(bin_scatter_pipeline);
+    BinScatterCS::Config config;
+    config.segment_count = segment_count;
+    config.band_count = band_count;
+    BinScatterCS::BindConfig(*pass, host_buffer.EmplaceUniform(config));
+    BinScatterCS::BindSegmentBands(*pass, segment_bands_view);
+    BinScatterCS::BindBands(*pass, bands_view);
+    BinScatterCS::BindBins(*pass, bins_view);
+    if (!pass->Compute(ISize(segment_count, 1)).ok()) {
+      return std::nullopt;
+    }
+    pass->AddBufferMemoryBarrier();
+  }
+
+  {
+    pass->SetCommandLabel("Path Coverage");
+    pass->SetPipeline(coverage_pipeline);
+    CoverageCS::Config config;
+    config.band_count = band_count;
+    config.band_height = kBandHeight;
+    config.width = static_cast<uint32_t>(size.width);
+    config.height = static_cast<uint32_t>(size.height);
+    config.stride = stride;
+    config.even_odd = path.GetFillType() == FillType::kOdd ? 1u : 0u;
+    CoverageCS::BindConfig(*pass, host_buffer.EmplaceUniform(config));
+    CoverageCS::BindSegments(*pass, points_view);
+    CoverageCS::BindBands(*pass, bands_view);
+    CoverageCS::BindBins(*pass, bins_view);
+    CoverageCS::BindCoverage(*pass, coverage_view);
+    if (!pass->Compute(ISize(coverage_word_count, 1)).ok()) {
+      return std::nullopt;
+    }
+  }
+
+  if (!pass->EncodeCommands()) {
+    return std::nullopt;
+  }
+  if (!context.EnqueueCommandBuffer(std::move(command_buffer))) {
+    VALIDATION_LOG << "Failed to enqueue the path coverage command buffer.";
+    return std::nullopt;
+  }
+
+  return Coverage{
+      .bounds = segments->bounds,
+      .buffer = std::move(coverage_view),
+      .stride = stride,
+  };
+}
+
+}  // namespace impeller
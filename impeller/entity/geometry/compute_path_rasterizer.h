@@ -0,0 +1,138 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_ENTITY_GEOMETRY_COMPUTE_PATH_RASTERIZER_H_
+#define FLUTTER_IMPELLER_ENTITY_GEOMETRY_COMPUTE_PATH_RASTERIZER_H_
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "impeller/core/buffer_view.h"
+#include "impeller/core/host_buffer.h"
+#include "impeller/geometry/matrix.h"
+#include "impeller/geometry/path.h"
+#include "impeller/geometry/rect.h"
+#include "impeller/geometry/vector.h"
+#include "impeller/renderer/capabilities.h"
+#include "impeller/renderer/compute_pipeline_descriptor.h"
+#include "impeller/renderer/context.h"
+#include "impeller/renderer/pipeline.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Rasterizes the coverage of filled paths in compute passes, as
+///             an alternative to stencil-then-cover for complex paths.
+///
+///             The path is flattened into line segments in render target
+///             space on the CPU. The GPU then bins the segments into
+///             horizontal bands of the coverage area and computes the
+///             coverage of every pixel from the winding numbers of a 4x4 grid
+///             of samples, using only the segments in the band of the pixel.
+///             The anti-aliased coverage is read by the cover draw of the
+///             fill, which needs storage buffers in fragment shaders.
+///
+class ComputePathRasterizer {
+ public:
+  /// The number of pixel rows in each band of the coverage area.
+  static constexpr uint32_t kBandHeight = 16u;
+
+  /// Paths with fewer components are cheap to stencil and are left to
+  /// stencil-then-cover.
+  static constexpr size_t kMinComponentCount = 64u;
+
+  /// Larger coverage areas fall back to stencil-then-cover.
+  static constexpr size_t kMaxCoveragePixels = 2048u * 2048u;
+
+  /// The segments of a path and the bands of the coverage area they cross.
+  struct Segments {
+    /// The pixels of the render target covered by the coverage area.
+    IRect bounds;
+    /// The end points of each segment relative to the origin of |bounds|.
+    std::vector<Vector4> points;
+    /// The first and last band crossed by each segment.
+    std::vector<uint32_t> bands;
+    uint32_t band_count = 0u;
+    /// The number of segment references across all bands.
+    size_t bin_count = 0u;
+  };
+
+  /// The coverage of a path computed by |Rasterize|.
+  struct Coverage {
+    /// The pixels of the render target covered by |buffer|.
+    IRect bounds;
+    /// The coverage of the pixels in |bounds|, packed as 8 bit unsigned
+    /// normalized values in words of four horizontally adjacent pixels.
+    BufferView buffer;
+    /// The number of words per row of pixels.
+    uint32_t stride = 0u;
+  };
+
+  static bool IsSupported(const Capabilities& capabilities);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether a fill of |path| drawn with |transform| is complex
+  ///             enough to be rasterized in compute passes.
+  ///
+  static bool ShouldRasterize(const Path& path, const Matrix& transform);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Flattens |path| into segments in render target space and
+  ///             assigns them to the bands of the coverage area.
+  ///
+  ///             Segments that cannot affect the winding number of a sample
+  ///             in |clip_bounds| are dropped.
+  ///
+  /// @return     The segments, or |std::nullopt| if the coverage area is
+  ///             empty or too large.
+  ///
+  static std::optional<Segments> ComputeSegments(const Path& path,
+                                                 const Matrix& transform,
+                                                 const IRect& clip_bounds);
+
+  explicit ComputePathRasterizer(const Context& context);
+
+  ~ComputePathRasterizer();
+
+  bool IsValid() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Encodes the compute passes that rasterize the coverage of
+  ///             |path| into a new command buffer and enqueues it, so that
+  ///             the coverage is ready before the pass that reads it.
+  ///
+  ///             Every call costs a command buffer. The coverage must be
+  ///             computed before the render pass that reads it is submitted,
+  ///             and there is no point between the draws of a pass at which
+  ///             the work of several fills could be submitted together. On
+  ///             Vulkan, contexts that batch command buffers submit these
+  ///             with the rest of the frame. Elsewhere each one is a separate
+  ///             submission. This is one reason only paths that are
+  ///             expensive to stencil are rasterized this way.
+  ///
+  /// @return     The coverage, or |std::nullopt| if the path should be drawn
+  ///             another way.
+  ///
+  std::optional<Coverage> Rasterize(Context& context,
+                                    HostBuffer& host_buffer,
+                                    const Path& path,
+                                    const Matrix& transform,
+                                    const IRect& clip_bounds) const;
+
+ private:
+  PipelineFuture<ComputePipelineDescriptor> bin_count_pipeline_;
+  PipelineFuture<ComputePipelineDescriptor> bin_offsets_pipeline_;
+  PipelineFuture<ComputePipelineDescriptor> bin_scatter_pipeline_;
+  PipelineFuture<ComputePipelineDescriptor> coverage_pipeline_;
+
+  ComputePathRasterizer(const ComputePathRasterizer&) = delete;
+
+  ComputePathRasterizer& operator=(const ComputePathRasterizer&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_ENTITY_GEOMETRY_COMPUTE_PATH_RASTERIZER_H_
@@ -9,6 +9,7 @@
 #include "impeller/core/vertex_buffer.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/geometry/geometry.h"
+#include "impeller/entity/geometry/tessellation_cache.h"
 
 namespace impeller {
 
@@ -43,10 +44,39 @@ GeometryResult FillPathGeometry::GetPositionBuffer(
   bool supports_triangle_fan =
       renderer.GetDeviceCapabilities().SupportsTriangleFan() &&
       supports_primitive_restart;
-  VertexBuffer vertex_buffer = renderer.GetTessellator().TessellateConvex(
-      path_, host_buffer, entity.GetTransform().GetMaxBasisLengthXY(),
-      /*supports_primitive_restart=*/supports_primitive_restart,
-      /*supports_triangle_fan=*/supports_triangle_fan);
+
+  // The vertices only depend on the transform through the scale, so paths
+  // drawn again at a scale in the same bucket reuse the cached tessellation.
+  Scalar scale = entity.GetTransform().GetMaxBasisLengthXY();
+  std::optional<int32_t> scale_bucket =
+      TessellationCache::GetScaleBucket(scale);
+  TessellationCache::Key cache_key;
+  std::optional<VertexBuffer> cached;
+  if (scale_bucket.has_value()) {
+    scale = TessellationCache::GetBucketScale(scale_bucket.value());
+    cache_key = {
+        .path_hash = path_.GetContentHash(),
+        .scale_bucket = scale_bucket.value(),
+        .flags = (supports_primitive_restart ? 1u : 0u) |
+                 (supports_triangle_fan ? 2u : 0u),
+    };
+    cached = renderer.GetTessellationCache().Get(cache_key, path_);
+  }
+
+  VertexBuffer vertex_buffer;
+  if (cached.has_value()) {
+    vertex_buffer = std::move(cached.value());
+  } else {
+    vertex_buffer = renderer.GetTessellator().TessellateConvex(
+        path_, host_buffer, scale,
+        /*supports_primitive_restart=*/supports_primitive_restart,
+        /*supports_triangle_fan=*/supports_triangle_fan);
+    if (scale_bucket.has_value()) {
+      vertex_buffer = renderer.GetTessellationCache().Store(
+          cache_key, path_, std::move(vertex_buffer),
+          *renderer.GetContext()->GetResourceAllocator());
+    }
+  }
 
   return GeometryResult{
       .type = supports_triangle_fan ? PrimitiveType::kTriangleFan
@@ -91,4 +121,8 @@ bool FillPathGeometry::CoversArea(const Matrix& transform,
   return coverage.Contains(rect);
 }
 
+const Path* FillPathGeometry::GetFillPath() const {
+  return &path_;
+}
+
 }  // namespace impeller
@@ -122,6 +122,10 @@ bool Geometry::CanApplyMaskFilter() const {
   return true;
 }
 
+const Path* Geometry::GetFillPath() const {
+  return nullptr;
+}
+
 // static
 Scalar Geometry::ComputeStrokeAlphaCoverage(const Matrix& transform,
                                             Scalar stroke_width) {
@@ -112,6 +112,9 @@ class Geometry {
 
   virtual bool CanApplyMaskFilter() const;
 
+  /// @brief    The path filled by this geometry, if it is a path fill.
+  virtual const Path* GetFillPath() const;
+
   virtual Scalar ComputeAlphaCoverage(const Matrix& transform) const {
     return 1.0;
   }
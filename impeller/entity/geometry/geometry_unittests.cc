@@ -2,12 +2,17 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <limits>
 #include <memory>
 #include "flutter/testing/testing.h"
 #include "gtest/gtest.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/geometry/geometry.h"
 #include "impeller/entity/geometry/stroke_path_geometry.h"
+#include "impeller/entity/geometry/tessellation_cache.h"
+#ifdef IMPELLER_ENABLE_COMPUTE
+#include "impeller/entity/geometry/compute_path_rasterizer.h"
+#endif  // IMPELLER_ENABLE_COMPUTE
 #include "impeller/geometry/constants.h"
 #include "impeller/geometry/geometry_asserts.h"
 #include "impeller/geometry/path_builder.h"
@@ -129,6 +134,97 @@ TEST(EntityGeometryTest, RoundRectGeometryCoversArea) {
   EXPECT_TRUE(geometry->CoversArea({}, Rect::MakeLTRB(1, 30, 99, 70)));
 }
 
+TEST(EntityGeometryTest, TessellationCacheScaleBuckets) {
+  EXPECT_EQ(TessellationCache::GetScaleBucket(1.0f), 0);
+  EXPECT_FALSE(TessellationCache::GetScaleBucket(0.0f).has_value());
+  EXPECT_FALSE(TessellationCache::GetScaleBucket(-1.0f).has_value());
+  EXPECT_FALSE(
+      TessellationCache::GetScaleBucket(std::numeric_limits<Scalar>::infinity())
+          .has_value());
+
+  for (Scalar scale : {0.3f, 1.0f, 1.1f, 2.5f, 17.0f}) {
+    std::optional<int32_t> bucket = TessellationCache::GetScaleBucket(scale);
+    ASSERT_TRUE(bucket.has_value());
+    // Curves are never subdivided less than the actual scale requires.
+    EXPECT_GE(TessellationCache::GetBucketScale(bucket.value()), scale);
+    EXPECT_LT(TessellationCache::GetBucketScale(bucket.value()), scale * 1.2f);
+  }
+  EXPECT_EQ(TessellationCache::GetScaleBucket(1.05f),
+            TessellationCache::GetScaleBucket(1.1f));
+}
+
+TEST(EntityGeometryTest, OnlyFillPathGeometryHasFillPath) {
+  Path path = PathBuilder{}.AddRect(Rect::MakeLTRB(0, 0, 10, 10)).TakePath();
+  auto fill = Geometry::MakeFillPath(path);
+  ASSERT_NE(fill->GetFillPath(), nullptr);
+  EXPECT_TRUE(fill->GetFillPath()->IsContentEqual(path));
+  EXPECT_EQ(Geometry::MakeStrokePath(path, 2)->GetFillPath(), nullptr);
+  EXPECT_EQ(Geometry::MakeRect(Rect::MakeLTRB(0, 0, 10, 10))->GetFillPath(),
+            nullptr);
+}
+
+#ifdef IMPELLER_ENABLE_COMPUTE
+TEST(EntityGeometryTest, ComputePathRasterizerDropsSegmentsWithoutCrossings) {
+  Path path = PathBuilder{}
+                  .MoveTo({0, 0})
+                  .LineTo({40, 0})
+                  .LineTo({40, 40})
+                  .LineTo({0, 40})
+                  .Close()
+                  .TakePath();
+  auto segments = ComputePathRasterizer::ComputeSegments(
+      path, Matrix::MakeTranslation({10, 10}), IRect::MakeLTRB(0, 0, 100, 100));
+  ASSERT_TRUE(segments.has_value());
+  EXPECT_EQ(segments->bounds, IRect::MakeLTRB(10, 10, 50, 50));
+  EXPECT_EQ(segments->band_count, 3u);
+
+  // The horizontal edges never cross a sample row, and the left edge lies on
+  // the left edge of the coverage area, where no sample is to its left.
+  ASSERT_EQ(segments->points.size(), 1u);
+  EXPECT_EQ(segments->points[0], Vector4(40, 0, 40, 40));
+  ASSERT_EQ(segments->bands.size(), 2u);
+  EXPECT_EQ(segments->bands[0], 0u);
+  EXPECT_EQ(segments->bands[1], 2u);
+  EXPECT_EQ(segments->bin_count, 3u);
+}
+
+TEST(EntityGeometryTest, ComputePathRasterizerClosesContours) {
+  Path path =
+      PathBuilder{}.MoveTo({0, 0}).LineTo({40, 20}).LineTo({20, 40}).TakePath();
+  auto segments = ComputePathRasterizer::ComputeSegments(
+      path, Matrix(), IRect::MakeLTRB(0, 0, 100, 100));
+  ASSERT_TRUE(segments.has_value());
+  ASSERT_EQ(segments->points.size(), 3u);
+  EXPECT_EQ(segments->points[2], Vector4(20, 40, 0, 0));
+  EXPECT_EQ(segments->bin_count, 2u + 2u + 3u);
+}
+
+TEST(EntityGeometryTest, ComputePathRasterizerClipsCoverageArea) {
+  Path path = PathBuilder{}
+                  .MoveTo({0, 0})
+                  .LineTo({40, 0})
+                  .LineTo({40, 40})
+                  .LineTo({0, 40})
+                  .Close()
+                  .TakePath();
+  auto segments = ComputePathRasterizer::ComputeSegments(
+      path, Matrix(), IRect::MakeLTRB(0, 0, 100, 20));
+  ASSERT_TRUE(segments.has_value());
+  EXPECT_EQ(segments->bounds, IRect::MakeLTRB(0, 0, 40, 20));
+  EXPECT_EQ(segments->band_count, 2u);
+  ASSERT_EQ(segments->bands.size(), 2u);
+  EXPECT_EQ(segments->bands[1], 1u);
+
+  EXPECT_FALSE(ComputePathRasterizer::ComputeSegments(
+                   path, Matrix(), IRect::MakeLTRB(50, 50, 100, 100))
+                   .has_value());
+  EXPECT_FALSE(ComputePathRasterizer::ComputeSegments(
+                   path, Matrix::MakeScale({100, 100, 1}),
+                   IRect::MakeLTRB(0, 0, 4096, 4096))
+                   .has_value());
+}
+#endif  // IMPELLER_ENABLE_COMPUTE
+
 TEST(EntityGeometryTest, GeometryResultHasReasonableDefaults) {
   GeometryResult result;
   EXPECT_EQ(result.type, PrimitiveType::kTriangleStrip);
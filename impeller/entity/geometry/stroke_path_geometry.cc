@@ -8,6 +8,7 @@
 #include "impeller/core/formats.h"
 #include "impeller/core/host_buffer.h"
 #include "impeller/entity/geometry/geometry.h"
+#include "impeller/entity/geometry/tessellation_cache.h"
 #include "impeller/geometry/constants.h"
 #include "impeller/geometry/path_builder.h"
 #include "impeller/geometry/path_component.h"
@@ -573,33 +574,23 @@ Scalar StrokePathGeometry::ComputeAlphaCoverage(const Matrix& transform) const {
   return Geometry::ComputeStrokeAlphaCoverage(transform, stroke_width_);
 }
 
-GeometryResult StrokePathGeometry::GetPositionBuffer(
-    const ContentContext& renderer,
-    const Entity& entity,
-    RenderPass& pass) const {
-  if (stroke_width_ < 0.0) {
-    return {};
-  }
-  Scalar max_basis = entity.GetTransform().GetMaxBasisLengthXY();
-  if (max_basis == 0) {
-    return {};
-  }
-
-  Scalar min_size = kMinStrokeSize / max_basis;
-  Scalar stroke_width = std::max(stroke_width_, min_size);
-
+static VertexBuffer CreateStrokeVertexBuffer(const ContentContext& renderer,
+                                             const Path& path,
+                                             Scalar stroke_width,
+                                             Scalar miter_limit,
+                                             Join stroke_join,
+                                             Cap stroke_cap,
+                                             Scalar scale) {
   auto& host_buffer = renderer.GetTransientsBuffer();
-  auto scale = entity.GetTransform().GetMaxBasisLengthXY();
 
   PositionWriter position_writer(
       renderer.GetTessellator().GetStrokePointCache());
   Path::Polyline polyline =
-      renderer.GetTessellator().CreateTempPolyline(path_, scale);
+      renderer.GetTessellator().CreateTempPolyline(path, scale);
 
   CreateSolidStrokeVertices(position_writer, polyline, stroke_width,
-                            miter_limit_ * stroke_width_ * 0.5f,
-                            GetJoinProc(stroke_join_), GetCapProc(stroke_cap_),
-                            scale);
+                            miter_limit, GetJoinProc(stroke_join),
+                            GetCapProc(stroke_cap), scale);
 
   const auto [arena_length, oversized_length] = position_writer.GetUsedSize();
   if (!position_writer.HasOversizedBuffer()) {
@@ -607,15 +598,11 @@ GeometryResult StrokePathGeometry::GetPositionBuffer(
         renderer.GetTessellator().GetStrokePointCache().data(),
         arena_length * sizeof(Point), alignof(Point));
 
-    return GeometryResult{.type = PrimitiveType::kTriangleStrip,
-                          .vertex_buffer =
-                              {
-                                  .vertex_buffer = buffer_view,
-                                  .vertex_count = arena_length,
-                                  .index_type = IndexType::kNone,
-                              },
-                          .transform = entity.GetShaderTransform(pass),
-                          .mode = GeometryResult::Mode::kPreventOverdraw};
+    return VertexBuffer{
+        .vertex_buffer = buffer_view,
+        .vertex_count = arena_length,
+        .index_type = IndexType::kNone,
+    };
   }
   const std::vector<Point>& oversized_data =
       position_writer.GetOversizedBuffer();
@@ -636,13 +623,68 @@ GeometryResult StrokePathGeometry::GetPositionBuffer(
   );
   buffer_view.GetBuffer()->Flush(buffer_view.GetRange());
 
+  return VertexBuffer{
+      .vertex_buffer = buffer_view,
+      .vertex_count = arena_length + oversized_length,
+      .index_type = IndexType::kNone,
+  };
+}
+
+GeometryResult StrokePathGeometry::GetPositionBuffer(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) const {
+  if (stroke_width_ < 0.0) {
+    return {};
+  }
+  Scalar max_basis = entity.GetTransform().GetMaxBasisLengthXY();
+  if (max_basis == 0) {
+    return {};
+  }
+
+  Scalar min_size = kMinStrokeSize / max_basis;
+  Scalar stroke_width = std::max(stroke_width_, min_size);
+  Scalar scale = max_basis;
+
+  // Strokes that are not widened to the minimum size only depend on the
+  // transform through the curve subdivision scale, so they are cached per
+  // scale bucket. Tessellating at the bucket scale never widens them either
+  // since it is at least as large as the actual scale.
+  std::optional<int32_t> scale_bucket;
+  if (stroke_width_ >= min_size) {
+    scale_bucket = TessellationCache::GetScaleBucket(max_basis);
+  }
+  TessellationCache::Key cache_key;
+  std::optional<VertexBuffer> cached;
+  if (scale_bucket.has_value()) {
+    scale = TessellationCache::GetBucketScale(scale_bucket.value());
+    cache_key = {
+        .path_hash = path_.GetContentHash(),
+        .scale_bucket = scale_bucket.value(),
+        .stroke_width = stroke_width_,
+        .miter_limit = miter_limit_,
+        .stroke_cap = stroke_cap_,
+        .stroke_join = stroke_join_,
+    };
+    cached = renderer.GetTessellationCache().Get(cache_key, path_);
+  }
+
+  VertexBuffer vertex_buffer;
+  if (cached.has_value()) {
+    vertex_buffer = std::move(cached.value());
+  } else {
+    vertex_buffer = CreateStrokeVertexBuffer(
+        renderer, path_, stroke_width, miter_limit_ * stroke_width_ * 0.5f,
+        stroke_join_, stroke_cap_, scale);
+    if (scale_bucket.has_value()) {
+      vertex_buffer = renderer.GetTessellationCache().Store(
+          cache_key, path_, std::move(vertex_buffer),
+          *renderer.GetContext()->GetResourceAllocator());
+    }
+  }
+
   return GeometryResult{.type = PrimitiveType::kTriangleStrip,
-                        .vertex_buffer =
-                            {
-                                .vertex_buffer = buffer_view,
-                                .vertex_count = arena_length + oversized_length,
-                                .index_type = IndexType::kNone,
-                            },
+                        .vertex_buffer = std::move(vertex_buffer),
                         .transform = entity.GetShaderTransform(pass),
                         .mode = GeometryResult::Mode::kPreventOverdraw};
 }
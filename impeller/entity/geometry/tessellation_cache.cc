@@ -0,0 +1,164 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/geometry/tessellation_cache.h"
+
+#include <cmath>
+#include <cstring>
+
+#include "flutter/fml/hash_combine.h"
+#include "impeller/core/device_buffer.h"
+#include "impeller/core/device_buffer_descriptor.h"
+
+namespace impeller {
+
+// The offset of the index data within a cached buffer is aligned to this so
+// that it is valid for every backend and index type.
+static constexpr size_t kIndexDataAlignment = 16u;
+
+size_t TessellationCache::Key::Hash::operator()(const Key& key) const {
+  return fml::HashCombine(key.path_hash, key.scale_bucket, key.stroke_width,
+                          key.miter_limit, key.stroke_cap, key.stroke_join,
+                          key.flags);
+}
+
+TessellationCache::TessellationCache(size_t max_bytes)
+    : max_bytes_(max_bytes) {}
+
+TessellationCache::~TessellationCache() = default;
+
+// static
+std::optional<int32_t> TessellationCache::GetScaleBucket(Scalar scale) {
+  if (!(scale > 0.0f) || !std::isfinite(scale)) {
+    return std::nullopt;
+  }
+  return static_cast<int32_t>(std::ceil(std::log2(scale) * kBucketsPerOctave));
+}
+
+// static
+Scalar TessellationCache::GetBucketScale(int32_t bucket) {
+  return std::exp2(bucket / kBucketsPerOctave);
+}
+
+std::optional<VertexBuffer> TessellationCache::Get(const Key& key,
+                                                   const Path& path) {
+  auto found = index_.find(key);
+  if (found == index_.end()) {
+    return std::nullopt;
+  }
+  // Guard against hash collisions between paths with different contents.
+  if (!found->second->path.IsContentEqual(path)) {
+    return std::nullopt;
+  }
+  entries_.splice(entries_.begin(), entries_, found->second);
+  return found->second->vertex_buffer;
+}
+
+VertexBuffer TessellationCache::Store(const Key& key,
+                                      const Path& path,
+                                      VertexBuffer vertex_buffer,
+                                      Allocator& allocator) {
+  if (!vertex_buffer || !TakeCandidate(key)) {
+    return vertex_buffer;
+  }
+
+  const BufferView& vertices = vertex_buffer.vertex_buffer;
+  const bool has_indices = vertex_buffer.index_type != IndexType::kNone;
+  const size_t vertex_length = vertices.GetRange().length;
+  const size_t index_offset =
+      (vertex_length + kIndexDataAlignment - 1) & ~(kIndexDataAlignment - 1);
+  const size_t index_length =
+      has_indices ? vertex_buffer.index_buffer.GetRange().length : 0u;
+  const size_t byte_size =
+      has_indices ? index_offset + index_length : vertex_length;
+  if (byte_size == 0u || byte_size > kMaxEntryBytes ||
+      byte_size > max_bytes_) {
+    return vertex_buffer;
+  }
+
+  DeviceBufferDescriptor desc;
+  desc.storage_mode = StorageMode::kHostVisible;
+  desc.size = byte_size;
+  std::shared_ptr<DeviceBuffer> buffer = allocator.CreateBuffer(desc);
+  if (!buffer || !buffer->OnGetContents()) {
+    return vertex_buffer;
+  }
+  uint8_t* contents = buffer->OnGetContents();
+  ::memcpy(contents,
+           vertices.GetBuffer()->OnGetContents() + vertices.GetRange().offset,
+           vertex_length);
+  if (has_indices) {
+    const BufferView& indices = vertex_buffer.index_buffer;
+    ::memcpy(contents + index_offset,
+             indices.GetBuffer()->OnGetContents() + indices.GetRange().offset,
+             index_length);
+  }
+  buffer->Flush(Range{0, byte_size});
+
+  VertexBuffer cached{
+      .vertex_buffer = BufferView(buffer, Range{0, vertex_length}),
+      .vertex_count = vertex_buffer.vertex_count,
+      .index_type = vertex_buffer.index_type,
+  };
+  if (has_indices) {
+    cached.index_buffer = BufferView(buffer, Range{index_offset, index_length});
+  }
+
+  // A colliding entry for a different path is replaced.
+  if (auto found = index_.find(key); found != index_.end()) {
+    Erase(found->second);
+  }
+  entries_.push_front(Entry{
+      .key = key,
+      .path = path,
+      .vertex_buffer = cached,
+      .byte_size = byte_size,
+  });
+  index_[key] = entries_.begin();
+  byte_size_ += byte_size;
+
+  while (byte_size_ > max_bytes_) {
+    Erase(std::prev(entries_.end()));
+  }
+  return cached;
+}
+
+bool TessellationCache::TakeCandidate(const Key& key) {
+  if (candidates_.erase(key) > 0u) {
+    // The key stays in the order queue until it ages out, a stale entry there
+    // only shortens how long other keys are remembered.
+    return true;
+  }
+  if (candidate_order_.size() >= kMaxCandidates) {
+    candidates_.erase(candidate_order_.front());
+    candidate_order_.pop_front();
+  }
+  candidate_order_.push_back(key);
+  candidates_.insert(key);
+  return false;
+}
+
+void TessellationCache::Erase(EntryList::iterator entry) {
+  byte_size_ -= entry->byte_size;
+  index_.erase(entry->key);
+  entries_.erase(entry);
+}
+
+size_t TessellationCache::GetEntryCount() const {
+  return entries_.size();
+}
+
+size_t TessellationCache::GetByteSize() const {
+  return byte_size_;
+}
+
+void TessellationCache::Clear() {
+  entries_.clear();
+  index_.clear();
+  candidate_order_.clear();
+  candidates_.clear();
+  byte_size_ = 0u;
+}
+
+}  // namespace impeller
@@ -0,0 +1,160 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_ENTITY_GEOMETRY_TESSELLATION_CACHE_H_
+#define FLUTTER_IMPELLER_ENTITY_GEOMETRY_TESSELLATION_CACHE_H_
+
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "impeller/core/allocator.h"
+#include "impeller/core/vertex_buffer.h"
+#include "impeller/geometry/path.h"
+#include "impeller/geometry/scalar.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A cache of path tessellations that are kept in device buffers
+///             across frames.
+///
+///             Fill and stroke vertices are generated in the local coordinate
+///             space of the path. They only depend on the transform through
+///             its scale, which determines how finely curves are subdivided.
+///             Scales are rounded up to a small number of buckets per octave
+///             so that a path drawn again at a different translation, or at a
+///             nearby scale, reuses the vertices of a previous frame.
+///
+///             A tessellation is only copied into its own device buffer the
+///             second time it is stored, so paths that change every frame
+///             only pay for hashing. Entries are evicted in least recently
+///             used order once the byte budget is exceeded.
+///
+///             The cache is not thread safe and should only be used from the
+///             raster thread, like the |Tessellator|.
+///
+class TessellationCache {
+ public:
+  struct Key {
+    size_t path_hash = 0u;
+    int32_t scale_bucket = 0;
+    /// Zero for fills.
+    Scalar stroke_width = 0.0f;
+    Scalar miter_limit = 0.0f;
+    Cap stroke_cap = Cap::kButt;
+    Join stroke_join = Join::kMiter;
+    /// Any other option that changes the generated vertices, such as the
+    /// primitive type used by the geometry.
+    uint32_t flags = 0u;
+
+    constexpr bool operator==(const Key& other) const {
+      return path_hash == other.path_hash &&
+             scale_bucket == other.scale_bucket &&
+             stroke_width == other.stroke_width &&
+             miter_limit == other.miter_limit &&
+             stroke_cap == other.stroke_cap &&
+             stroke_join == other.stroke_join && flags == other.flags;
+    }
+
+    struct Hash {
+      size_t operator()(const Key& key) const;
+    };
+  };
+
+  /// The default limit for the total size of the cached vertex data.
+  static constexpr size_t kDefaultMaxBytes = 16u * 1024u * 1024u;
+
+  /// Tessellations larger than this are never cached.
+  static constexpr size_t kMaxEntryBytes = 1024u * 1024u;
+
+  /// The number of recently stored keys that are remembered in order to
+  /// decide whether a tessellation is worth caching.
+  static constexpr size_t kMaxCandidates = 512u;
+
+  /// The number of scale buckets per doubling of the scale.
+  static constexpr Scalar kBucketsPerOctave = 4.0f;
+
+  explicit TessellationCache(size_t max_bytes = kDefaultMaxBytes);
+
+  ~TessellationCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Computes the bucket the given transform scale falls in.
+  ///
+  /// @return     The bucket or |std::nullopt| if the scale is not positive
+  ///             and finite, in which case nothing should be cached.
+  ///
+  static std::optional<int32_t> GetScaleBucket(Scalar scale);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The scale to tessellate at for every scale in the bucket.
+  ///             This is the largest scale in the bucket so that curves are
+  ///             never subdivided less than they would be without the cache.
+  ///
+  static Scalar GetBucketScale(int32_t bucket);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Looks up a cached tessellation of |path|.
+  ///
+  /// @return     The cached vertex buffer or |std::nullopt| on a miss.
+  ///
+  std::optional<VertexBuffer> Get(const Key& key, const Path& path);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Offers a freshly generated tessellation of |path| to the
+  ///             cache.
+  ///
+  ///             If the same key was offered recently, the vertex and index
+  ///             data are copied into a new device buffer that is retained by
+  ///             the cache.
+  ///
+  /// @return     Either the cached copy of the vertex buffer, or the vertex
+  ///             buffer that was passed in.
+  ///
+  VertexBuffer Store(const Key& key,
+                     const Path& path,
+                     VertexBuffer vertex_buffer,
+                     Allocator& allocator);
+
+  size_t GetEntryCount() const;
+
+  size_t GetByteSize() const;
+
+  void Clear();
+
+ private:
+  struct Entry {
+    Key key;
+    Path path;
+    VertexBuffer vertex_buffer;
+    size_t byte_size = 0u;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  const size_t max_bytes_;
+  size_t byte_size_ = 0u;
+  // Most recently used entries first.
+  EntryList entries_;
+  std::unordered_map<Key, EntryList::iterator, Key::Hash> index_;
+  std::deque<Key> candidate_order_;
+  std::unordered_set<Key, Key::Hash> candidates_;
+
+  bool TakeCandidate(const Key& key);
+
+  void Erase(EntryList::iterator entry);
+
+  TessellationCache(const TessellationCache&) = delete;
+
+  TessellationCache& operator=(const TessellationCache&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_ENTITY_GEOMETRY_TESSELLATION_CACHE_H_
@@ -0,0 +1,34 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <impeller/types.glsl>
+
+// The downsample pass of the dual filter (Kawase) blur. Every output texel
+// averages the input texel under it with four bilinear samples placed
+// diagonally around it.
+
+uniform f16sampler2D texture_sampler;
+
+uniform FragInfo {
+  // The offset of the diagonal samples in UV space.
+  vec2 sample_offset;
+}
+frag_info;
+
+in vec2 v_texture_coords;
+
+out f16vec4 frag_color;
+
+void main() {
+  vec2 offset = frag_info.sample_offset;
+  vec2 flipped_offset = vec2(offset.x, -offset.y);
+
+  f16vec4 total = texture(texture_sampler, v_texture_coords) * 4.0hf;
+  total += texture(texture_sampler, v_texture_coords - offset);
+  total += texture(texture_sampler, v_texture_coords + offset);
+  total += texture(texture_sampler, v_texture_coords - flipped_offset);
+  total += texture(texture_sampler, v_texture_coords + flipped_offset);
+
+  frag_color = total * 0.125hf;
+}
@@ -0,0 +1,40 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <impeller/types.glsl>
+
+// The upsample pass of the dual filter (Kawase) blur. Every output texel is a
+// weighted average of eight bilinear samples on a diamond around it.
+
+uniform f16sampler2D texture_sampler;
+
+uniform FragInfo {
+  // The offset of the diagonal samples in UV space. The samples on the axes
+  // are twice as far away.
+  vec2 sample_offset;
+}
+frag_info;
+
+in vec2 v_texture_coords;
+
+out f16vec4 frag_color;
+
+void main() {
+  vec2 offset = frag_info.sample_offset;
+  vec2 flipped_offset = vec2(offset.x, -offset.y);
+  vec2 x_offset = vec2(2.0 * offset.x, 0.0);
+  vec2 y_offset = vec2(0.0, 2.0 * offset.y);
+
+  f16vec4 total = texture(texture_sampler, v_texture_coords - x_offset);
+  total += texture(texture_sampler, v_texture_coords + x_offset);
+  total += texture(texture_sampler, v_texture_coords - y_offset);
+  total += texture(texture_sampler, v_texture_coords + y_offset);
+
+  f16vec4 diagonal = texture(texture_sampler, v_texture_coords - offset);
+  diagonal += texture(texture_sampler, v_texture_coords + offset);
+  diagonal += texture(texture_sampler, v_texture_coords - flipped_offset);
+  diagonal += texture(texture_sampler, v_texture_coords + flipped_offset);
+
+  frag_color = (total + diagonal * 2.0hf) / 12.0hf;
+}
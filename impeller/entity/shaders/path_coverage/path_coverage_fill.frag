@@ -0,0 +1,36 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+precision highp float;
+
+#include <impeller/types.glsl>
+
+uniform FragInfo {
+  vec4 color;
+  // The top left corner of the coverage area in render target pixels.
+  vec2 origin;
+  vec2 size;
+  // The number of coverage words per row of pixels.
+  float stride;
+}
+frag_info;
+
+// The coverage of the pixels, packed as 8 bit unsigned normalized values.
+layout(std430) readonly buffer Coverage {
+  uint data[];
+}
+coverage;
+
+out vec4 frag_color;
+
+void main() {
+  ivec2 pixel = ivec2(floor(gl_FragCoord.xy - frag_info.origin));
+  if (pixel.x < 0 || pixel.y < 0 || pixel.x >= int(frag_info.size.x) ||
+      pixel.y >= int(frag_info.size.y)) {
+    frag_color = vec4(0.0);
+    return;
+  }
+  uint word = coverage.data[pixel.y * int(frag_info.stride) + pixel.x / 4];
+  frag_color = frag_info.color * unpackUnorm4x8(word)[pixel.x % 4];
+}
@@ -0,0 +1,153 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/solid_color_batch.h"
+
+#include "impeller/base/strings.h"
+#include "impeller/core/formats.h"
+#include "impeller/core/sampler_descriptor.h"
+#include "impeller/entity/contents/contents.h"
+#include "impeller/entity/contents/filters/blend_filter_contents.h"
+#include "impeller/entity/entity.h"
+#include "impeller/renderer/sampler_library.h"
+
+namespace impeller {
+
+SolidColorBatch::SolidColorBatch() = default;
+
+SolidColorBatch::~SolidColorBatch() = default;
+
+SolidColorBatch::AppendResult SolidColorBatch::Append(Tessellator& tessellator,
+                                                      const Matrix& transform,
+                                                      const Shape& shape,
+                                                      Color color,
+                                                      BlendMode blend_mode,
+                                                      uint32_t clip_depth) {
+  FML_DCHECK(IsCompatible(blend_mode));
+  FML_DCHECK(!transform.HasPerspective());
+
+  const size_t first_vertex = vertices_.size();
+  const Color premultiplied = color.Premultiply();
+  auto add_vertex = [this, &transform, &premultiplied](const Point& point) {
+    vertices_.push_back(VS::PerVertexData{
+        .vertices = transform * point,
+        .texture_coords = Point(),
+        .color = premultiplied,
+    });
+  };
+
+  switch (shape.type) {
+    case Shape::Type::kRect:
+      for (const Point& point : shape.bounds.GetPoints()) {
+        add_vertex(point);
+      }
+      break;
+    case Shape::Type::kRoundRect:
+      tessellator
+          .FilledRoundRect(transform, shape.bounds, shape.radii)
+          .GenerateVertices(add_vertex);
+      break;
+    case Shape::Type::kCircle:
+      tessellator
+          .FilledCircle(transform, shape.bounds.GetCenter(), shape.radii.width)
+          .GenerateVertices(add_vertex);
+      break;
+  }
+
+  // The maximum vertex count also keeps the 0xFFFF primitive restart index
+  // out of the index buffer.
+  if (vertices_.size() > kMaxVertexCount) {
+    vertices_.resize(first_vertex);
+    return first_vertex == 0u ? AppendResult::kTooLarge
+                              : AppendResult::kBatchFull;
+  }
+
+  AppendTriangleStrip(first_vertex, vertices_.size() - first_vertex);
+  blend_mode_ = blend_mode;
+  clip_depth_ = clip_depth;
+  draw_count_++;
+  return AppendResult::kAppended;
+}
+
+void SolidColorBatch::AppendTriangleStrip(size_t first_vertex,
+                                          size_t vertex_count) {
+  for (size_t i = 2; i < vertex_count; i++) {
+    indices_.push_back(static_cast<uint16_t>(first_vertex + i - 2));
+    indices_.push_back(static_cast<uint16_t>(first_vertex + i - 1));
+    indices_.push_back(static_cast<uint16_t>(first_vertex + i));
+  }
+}
+
+bool SolidColorBatch::Render(const ContentContext& renderer, RenderPass& pass) {
+  if (IsEmpty()) {
+    return true;
+  }
+  if (indices_.empty()) {
+    Reset();
+    return true;
+  }
+
+  auto& host_buffer = renderer.GetTransientsBuffer();
+
+#ifdef IMPELLER_DEBUG
+  pass.SetCommandLabel(SPrintF("Solid Fill Batch (%zu)", draw_count_));
+#endif  // IMPELLER_DEBUG
+  pass.SetVertexBuffer(VertexBuffer{
+      .vertex_buffer = host_buffer.Emplace(
+          vertices_.data(), vertices_.size() * sizeof(VS::PerVertexData),
+          alignof(VS::PerVertexData)),
+      .index_buffer = host_buffer.Emplace(
+          indices_.data(), indices_.size() * sizeof(uint16_t),
+          alignof(uint16_t)),
+      .vertex_count = indices_.size(),
+      .index_type = IndexType::k16bit,
+  });
+
+  auto options = OptionsFromPass(pass);
+  options.blend_mode = blend_mode_;
+  options.primitive_type = PrimitiveType::kTriangle;
+  options.depth_write_enabled = blend_mode_ == BlendMode::kSource;
+  pass.SetPipeline(renderer.GetPorterDuffBlendPipeline(options));
+  pass.SetStencilReference(0);
+
+  // The vertex colors are written as is by blending them with an empty
+  // destination texture using the source coefficients.
+  std::shared_ptr<Texture> texture = renderer.GetEmptyTexture();
+  const std::unique_ptr<const Sampler>& sampler =
+      renderer.GetContext()->GetSamplerLibrary()->GetSampler({});
+  FS::BindTextureSamplerDst(pass, texture, sampler);
+
+  VS::FrameInfo frame_info;
+  frame_info.mvp = Entity::GetShaderTransform(
+      Entity::GetShaderClipDepth(clip_depth_), pass, Matrix());
+  frame_info.texture_sampler_y_coord_scale = texture->GetYCoordScale();
+
+  FS::FragInfo frag_info;
+  frag_info.input_alpha = 1.0;
+  frag_info.output_alpha = 1.0;
+  const auto& blend_coefficients =
+      kPorterDuffCoefficients[static_cast<int>(BlendMode::kSource)];
+  frag_info.src_coeff = blend_coefficients[0];
+  frag_info.src_coeff_dst_alpha = blend_coefficients[1];
+  frag_info.dst_coeff = blend_coefficients[2];
+  frag_info.dst_coeff_src_alpha = blend_coefficients[3];
+  frag_info.dst_coeff_src_color = blend_coefficients[4];
+  frag_info.tmx = static_cast<int>(Entity::TileMode::kDecal);
+  frag_info.tmy = static_cast<int>(Entity::TileMode::kDecal);
+
+  FS::BindFragInfo(pass, host_buffer.EmplaceUniform(frag_info));
+  VS::BindFrameInfo(pass, host_buffer.EmplaceUniform(frame_info));
+
+  const bool result = pass.Draw().ok();
+  Reset();
+  return result;
+}
+
+void SolidColorBatch::Reset() {
+  vertices_.clear();
+  indices_.clear();
+  draw_count_ = 0u;
+}
+
+}  // namespace impeller
@@ -0,0 +1,139 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_ENTITY_SOLID_COLOR_BATCH_H_
+#define FLUTTER_IMPELLER_ENTITY_SOLID_COLOR_BATCH_H_
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "impeller/entity/contents/content_context.h"
+#include "impeller/geometry/color.h"
+#include "impeller/geometry/matrix.h"
+#include "impeller/geometry/rect.h"
+#include "impeller/renderer/render_pass.h"
+#include "impeller/tessellator/tessellator.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Accumulates consecutive solid color fills that share a blend
+///             mode and renders them with a single draw call.
+///
+///             The vertices of each fill are transformed on the CPU and tagged
+///             with the premultiplied color of the fill, so fills with
+///             different transforms and colors can share a draw. The batch
+///             is rendered at the depth of the last fill appended to it. This
+///             matches the clipping of the individual fills as long as no clip
+///             is applied between them, and fills within the batch are drawn
+///             in the order they were appended.
+///
+class SolidColorBatch {
+ public:
+  /// Batches are drawn with 16 bit indices.
+  static constexpr size_t kMaxVertexCount =
+      std::numeric_limits<uint16_t>::max();
+
+  /// A filled shape that can be appended to a batch.
+  struct Shape {
+    enum class Type {
+      kRect,
+      kRoundRect,
+      kCircle,
+    };
+
+    Type type = Type::kRect;
+    Rect bounds;
+    Size radii;
+
+    static Shape MakeRect(const Rect& rect) {
+      return {.type = Type::kRect, .bounds = rect};
+    }
+
+    static Shape MakeRoundRect(const Rect& rect, const Size& radii) {
+      return {.type = Type::kRoundRect, .bounds = rect, .radii = radii};
+    }
+
+    static Shape MakeCircle(const Point& center, Scalar radius) {
+      return {.type = Type::kCircle,
+              .bounds = Rect::MakeLTRB(center.x - radius, center.y - radius,
+                                       center.x + radius, center.y + radius),
+              .radii = Size(radius, radius)};
+    }
+  };
+
+  enum class AppendResult {
+    /// The shape was appended to the batch.
+    kAppended,
+    /// The batch must be rendered before the shape can be appended.
+    kBatchFull,
+    /// The shape has too many vertices to be batched.
+    kTooLarge,
+  };
+
+  SolidColorBatch();
+
+  ~SolidColorBatch();
+
+  bool IsEmpty() const { return draw_count_ == 0u; }
+
+  /// The number of fills in the batch.
+  size_t GetDrawCount() const { return draw_count_; }
+
+  /// Whether a fill with the given blend mode may be appended to the batch
+  /// without rendering it first.
+  bool IsCompatible(BlendMode blend_mode) const {
+    return IsEmpty() || blend_mode == blend_mode_;
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Append a filled shape to the batch.
+  ///
+  /// @param[in]  tessellator  The tessellator used for curved shapes.
+  /// @param[in]  transform    The pass relative transform of the shape, which
+  ///                          must not have perspective.
+  /// @param[in]  shape        The shape.
+  /// @param[in]  color        The unpremultiplied color of the fill.
+  /// @param[in]  blend_mode   The blend mode, which must be compatible with
+  ///                          the batch.
+  /// @param[in]  clip_depth   The clip depth of the fill.
+  ///
+  AppendResult Append(Tessellator& tessellator,
+                      const Matrix& transform,
+                      const Shape& shape,
+                      Color color,
+                      BlendMode blend_mode,
+                      uint32_t clip_depth);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Record a draw for the fills in the batch and reset it.
+  ///
+  bool Render(const ContentContext& renderer, RenderPass& pass);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Discard the fills in the batch without rendering them.
+  ///
+  void Reset();
+
+ private:
+  using VS = PorterDuffBlendPipeline::VertexShader;
+  using FS = PorterDuffBlendPipeline::FragmentShader;
+
+  std::vector<VS::PerVertexData> vertices_;
+  std::vector<uint16_t> indices_;
+  BlendMode blend_mode_ = BlendMode::kSourceOver;
+  uint32_t clip_depth_ = 0u;
+  size_t draw_count_ = 0u;
+
+  void AppendTriangleStrip(size_t first_vertex, size_t vertex_count);
+
+  SolidColorBatch(const SolidColorBatch&) = delete;
+
+  SolidColorBatch& operator=(const SolidColorBatch&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_ENTITY_SOLID_COLOR_BATCH_H_
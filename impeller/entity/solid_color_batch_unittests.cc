@@ -0,0 +1,109 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+
+#include "impeller/core/formats.h"
+#include "impeller/entity/contents/test/recording_render_pass.h"
+#include "impeller/entity/entity_playground.h"
+#include "impeller/entity/solid_color_batch.h"
+#include "impeller/playground/playground_test.h"
+#include "third_party/googletest/googletest/include/gtest/gtest.h"
+
+namespace impeller {
+namespace testing {
+
+using EntityTest = EntityPlayground;
+
+TEST_P(EntityTest, SolidColorBatchRendersFillsWithOneDraw) {
+  auto content_context = GetContentContext();
+  Tessellator& tessellator = content_context->GetTessellator();
+  SolidColorBatch batch;
+  EXPECT_TRUE(batch.IsEmpty());
+
+  const Matrix transform = Matrix::MakeScale({2, 2, 1});
+  EXPECT_EQ(batch.Append(tessellator, transform,
+                         SolidColorBatch::Shape::MakeRect(
+                             Rect::MakeXYWH(10, 10, 20, 20)),
+                         Color::Red(), BlendMode::kSource, 1u),
+            SolidColorBatch::AppendResult::kAppended);
+  EXPECT_EQ(batch.Append(tessellator, Matrix::MakeTranslation({5, 5}),
+                         SolidColorBatch::Shape::MakeRect(
+                             Rect::MakeXYWH(40, 40, 20, 20)),
+                         Color::Blue(), BlendMode::kSource, 2u),
+            SolidColorBatch::AppendResult::kAppended);
+  EXPECT_EQ(batch.Append(tessellator, transform,
+                         SolidColorBatch::Shape::MakeCircle({50, 50}, 10),
+                         Color::Green(), BlendMode::kSource, 3u),
+            SolidColorBatch::AppendResult::kAppended);
+  EXPECT_EQ(batch.GetDrawCount(), 3u);
+
+  EXPECT_TRUE(batch.IsCompatible(BlendMode::kSource));
+  EXPECT_FALSE(batch.IsCompatible(BlendMode::kSourceOver));
+
+  size_t circle_vertex_count =
+      tessellator.FilledCircle(transform, {50, 50}, 10).GetVertexCount();
+  size_t expected_index_count = 6u + 6u + (circle_vertex_count - 2u) * 3u;
+
+  auto buffer = content_context->GetContext()->CreateCommandBuffer();
+  auto render_target =
+      content_context->GetRenderTargetCache()->CreateOffscreenMSAA(
+          *content_context->GetContext(), {100, 100},
+          /*mip_count=*/1);
+  auto render_pass = buffer->CreateRenderPass(render_target);
+  auto recording_pass = std::make_shared<RecordingRenderPass>(
+      render_pass, GetContext(), render_target);
+
+  ASSERT_TRUE(batch.Render(*content_context, *recording_pass));
+  EXPECT_TRUE(batch.IsEmpty());
+
+  const std::vector<Command>& commands = recording_pass->GetCommands();
+  ASSERT_EQ(commands.size(), 1u);
+  EXPECT_EQ(commands[0].element_count, expected_index_count);
+  EXPECT_EQ(commands[0].index_type, IndexType::k16bit);
+
+  auto options = OptionsFromPass(*recording_pass);
+  options.blend_mode = BlendMode::kSource;
+  options.primitive_type = PrimitiveType::kTriangle;
+  options.depth_write_enabled = true;
+  EXPECT_EQ(commands[0].pipeline,
+            content_context->GetPorterDuffBlendPipeline(options));
+
+  if (GetParam() == PlaygroundBackend::kMetal) {
+    recording_pass->EncodeCommands();
+  }
+}
+
+TEST_P(EntityTest, SolidColorBatchReportsFullBatches) {
+  Tessellator& tessellator = GetContentContext()->GetTessellator();
+  SolidColorBatch batch;
+
+  // Large circles use many vertices, so the batch fills up quickly.
+  const Matrix transform = Matrix::MakeScale({100, 100, 1});
+  const auto circle = SolidColorBatch::Shape::MakeCircle({50, 50}, 50);
+  SolidColorBatch::AppendResult result =
+      SolidColorBatch::AppendResult::kAppended;
+  size_t draw_count = 0u;
+  while (draw_count < SolidColorBatch::kMaxVertexCount) {
+    result = batch.Append(tessellator, transform, circle, Color::Red(),
+                          BlendMode::kSourceOver, 1u);
+    if (result != SolidColorBatch::AppendResult::kAppended) {
+      break;
+    }
+    draw_count++;
+  }
+
+  EXPECT_EQ(result, SolidColorBatch::AppendResult::kBatchFull);
+  EXPECT_GT(draw_count, 0u);
+  EXPECT_EQ(batch.GetDrawCount(), draw_count);
+
+  batch.Reset();
+  EXPECT_TRUE(batch.IsEmpty());
+  EXPECT_EQ(batch.Append(tessellator, transform, circle, Color::Red(),
+                         BlendMode::kSourceOver, 1u),
+            SolidColorBatch::AppendResult::kAppended);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -33,6 +33,9 @@ Path CreateCubic(bool closed);
 Path CreateQuadratic(bool closed);
 /// Create a rounded rect.
 Path CreateRRect();
+/// A deterministic path resembling a detailed SVG icon set, made of many
+/// small contours of mixed cubics and quadratics.
+Path CreateDenseCurves();
 }  // namespace
 
 static TessellatorLibtess tess;
@@ -114,6 +117,28 @@ static void BM_Convex(benchmark::State& state, Args&&... args) {
   state.counters["TotalPointCount"] = point_count;
 }
 
+template <class... Args>
+static void BM_CountAndWritePolyline(benchmark::State& state, Args&&... args) {
+  auto args_tuple = std::make_tuple(std::move(args)...);
+  auto path = std::get<Path>(args_tuple);
+  auto scale = std::get<Scalar>(args_tuple);
+
+  std::vector<Point> points;
+  std::vector<uint16_t> indices;
+  size_t single_point_count = 0u;
+  while (state.KeepRunning()) {
+    auto [point_count, contour_count] = path.CountStorage(scale);
+    points.resize(point_count);
+    indices.resize(point_count + contour_count);
+    StripVertexWriter writer(points.data(), indices.data());
+    path.WritePolyline(scale, writer);
+    single_point_count = writer.GetIndexCount();
+    benchmark::DoNotOptimize(points.data());
+  }
+  state.SetItemsProcessed(state.iterations() * single_point_count);
+  state.counters["SinglePointCount"] = single_point_count;
+}
+
 #define MAKE_STROKE_BENCHMARK_CAPTURE(path, cap, join, closed)         \
   BENCHMARK_CAPTURE(BM_StrokePolyline, stroke_##path##_##cap##_##join, \
                     Create##path(closed), Cap::k##cap, Join::k##join)
@@ -141,6 +166,17 @@ MAKE_STROKE_BENCHMARK_CAPTURE(RRect, Butt, Bevel, );
 MAKE_STROKE_BENCHMARK_CAPTURE(RRect, Butt, Miter, );
 MAKE_STROKE_BENCHMARK_CAPTURE(RRect, Butt, Round, );
 
+BENCHMARK_CAPTURE(BM_Polyline, dense_curves_polyline, CreateDenseCurves());
+BENCHMARK_CAPTURE(BM_Convex, dense_curves_convex, CreateDenseCurves(), true);
+BENCHMARK_CAPTURE(BM_CountAndWritePolyline,
+                  dense_curves_write_polyline,
+                  CreateDenseCurves(),
+                  1.0f);
+BENCHMARK_CAPTURE(BM_CountAndWritePolyline,
+                  dense_curves_write_polyline_4x,
+                  CreateDenseCurves(),
+                  4.0f);
+
 namespace {
 
 Path CreateRRect() {
@@ -449,5 +485,35 @@ Path CreateQuadratic(bool closed) {
   return builder.TakePath();
 }
 
+Path CreateDenseCurves() {
+  // A fixed linear congruential generator keeps the path identical between
+  // runs without depending on the standard library's distributions.
+  uint32_t seed = 0x2545F491u;
+  auto next = [&seed](Scalar range) {
+    seed = seed * 1664525u + 1013904223u;
+    return static_cast<Scalar>(seed >> 8) / static_cast<Scalar>(1u << 24) *
+           range;
+  };
+
+  PathBuilder builder;
+  for (int row = 0; row < 12; row++) {
+    for (int column = 0; column < 12; column++) {
+      Point origin(column * 32.0f, row * 32.0f);
+      builder.MoveTo(origin + Point(next(8), next(8)));
+      for (int i = 0; i < 12; i++) {
+        Point end = origin + Point(next(32), next(32));
+        if (i % 3 == 0) {
+          builder.QuadraticCurveTo(origin + Point(next(32), next(32)), end);
+        } else {
+          builder.CubicCurveTo(origin + Point(next(32), next(32)),
+                               origin + Point(next(32), next(32)), end);
+        }
+      }
+      builder.Close();
+    }
+  }
+  return builder.TakePath();
+}
+
 }  // namespace
 }  // namespace impeller
@@ -4,12 +4,17 @@
 
 #include "impeller/geometry/path.h"
 
+#include <array>
+#include <cmath>
 #include <optional>
+#include <string_view>
 #include <utility>
 
+#include "flutter/fml/hash_combine.h"
 #include "flutter/fml/logging.h"
 #include "impeller/geometry/path_component.h"
 #include "impeller/geometry/point.h"
+#include "impeller/geometry/wangs_formula.h"
 
 namespace impeller {
 
@@ -64,6 +69,56 @@ bool Path::IsSingleContour() const {
 }
 
 /// Determine required storage for points and indices.
+namespace {
+
+// Accumulates the storage needed for curves in small batches so that their
+// subdivision counts are computed four at a time.
+template <class Component>
+class CurveStorageCounter {
+ public:
+  explicit CurveStorageCounter(Scalar scale) : scale_(scale) {}
+
+  void Add(const Component* component, size_t& points) {
+    components_[count_++] = component;
+    if (count_ == kBatchSize) {
+      Flush(points);
+    }
+  }
+
+  void Flush(size_t& points) {
+    ComputeSubdivisions(scale_, components_.data(), count_,
+                        subdivisions_.data());
+    for (size_t i = 0; i < count_; i++) {
+      points += static_cast<size_t>(std::ceilf(subdivisions_[i])) + 2;
+    }
+    count_ = 0u;
+  }
+
+ private:
+  static constexpr size_t kBatchSize = 16u;
+
+  static void ComputeSubdivisions(Scalar scale,
+                                  const QuadraticPathComponent* const quads[],
+                                  size_t count,
+                                  Scalar subdivisions[]) {
+    ComputeQuadradicSubdivisions(scale, quads, count, subdivisions);
+  }
+
+  static void ComputeSubdivisions(Scalar scale,
+                                  const CubicPathComponent* const cubics[],
+                                  size_t count,
+                                  Scalar subdivisions[]) {
+    ComputeCubicSubdivisions(scale, cubics, count, subdivisions);
+  }
+
+  const Scalar scale_;
+  std::array<const Component*, kBatchSize> components_;
+  std::array<Scalar, kBatchSize> subdivisions_;
+  size_t count_ = 0u;
+};
+
+}  // namespace
+
 std::pair<size_t, size_t> Path::CountStorage(Scalar scale) const {
   size_t points = 0;
   size_t contours = 0;
@@ -71,6 +126,9 @@ std::pair<size_t, size_t> Path::CountStorage(Scalar scale) const {
   auto& path_components = data_->components;
   auto& path_points = data_->points;
 
+  CurveStorageCounter<QuadraticPathComponent> quads(scale);
+  CurveStorageCounter<CubicPathComponent> cubics(scale);
+
   size_t storage_offset = 0u;
   for (size_t component_i = 0; component_i < path_components.size();
        component_i++) {
@@ -84,14 +142,14 @@ std::pair<size_t, size_t> Path::CountStorage(Scalar scale) const {
         const QuadraticPathComponent* quad =
             reinterpret_cast<const QuadraticPathComponent*>(
                 &path_points[storage_offset]);
-        points += quad->CountLinearPathComponents(scale);
+        quads.Add(quad, points);
         break;
       }
       case ComponentType::kCubic: {
         const CubicPathComponent* cubic =
             reinterpret_cast<const CubicPathComponent*>(
                 &path_points[storage_offset]);
-        points += cubic->CountLinearPathComponents(scale);
+        cubics.Add(cubic, points);
         break;
       }
       case Path::ComponentType::kContour:
@@ -99,6 +157,8 @@ std::pair<size_t, size_t> Path::CountStorage(Scalar scale) const {
     }
     storage_offset += VerbToOffset(path_component);
   }
+  quads.Flush(points);
+  cubics.Flush(points);
   return std::make_pair(points, contours);
 }
 
@@ -428,6 +488,24 @@ Path::Polyline Path::CreatePolyline(
   return polyline;
 }
 
+size_t Path::GetContentHash() const {
+  std::string_view points(reinterpret_cast<const char*>(data_->points.data()),
+                          data_->points.size() * sizeof(Point));
+  std::string_view components(
+      reinterpret_cast<const char*>(data_->components.data()),
+      data_->components.size() * sizeof(ComponentType));
+  return fml::HashCombine(points, components, data_->fill);
+}
+
+bool Path::IsContentEqual(const Path& other) const {
+  if (data_ == other.data_) {
+    return true;
+  }
+  return data_->fill == other.data_->fill &&
+         data_->components == other.data_->components &&
+         data_->points == other.data_->points;
+}
+
 std::optional<Rect> Path::GetBoundingBox() const {
   return data_->bounds;
 }
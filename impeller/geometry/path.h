@@ -200,6 +200,15 @@ class Path {
   /// Determine required storage for points and number of contours.
   std::pair<size_t, size_t> CountStorage(Scalar scale) const;
 
+  /// @brief Computes a hash of the points, components and fill type of this
+  ///        path. Paths with equal contents have equal hashes regardless of
+  ///        whether they share storage.
+  size_t GetContentHash() const;
+
+  /// @brief Whether the points, components and fill type of this path are
+  ///        the same as those of |other|.
+  bool IsContentEqual(const Path& other) const;
+
  private:
   friend class PathBuilder;
 
@@ -4,10 +4,12 @@
 
 #include "path_component.h"
 
+#include <algorithm>
 #include <cmath>
 #include <utility>
 
 #include "impeller/geometry/scalar.h"
+#include "impeller/geometry/simd_float4.h"
 #include "impeller/geometry/wangs_formula.h"
 
 namespace impeller {
@@ -205,6 +207,64 @@ static inline Scalar CubicSolveDerivative(Scalar t,
          3 * p3 * t * t;
 }
 
+// Writes the points of a curve at t = i / line_count for 0 < i < line_count,
+// four at a time, followed by the end point of the curve. |solve| evaluates
+// the x and y coordinates of the curve at four values of t at once using the
+// same operations as the scalar solvers above.
+template <class Solve, class Sink>
+static void WriteCurvePoints(Scalar line_count,
+                             Point end,
+                             const Solve& solve,
+                             const Sink& sink) {
+  size_t interior_count = 0u;
+  if (line_count > 1 && std::isfinite(line_count)) {
+    interior_count = static_cast<size_t>(line_count) - 1u;
+  }
+  const SimdFloat4 divisor = SimdFloat4::Splat(line_count);
+  const SimdFloat4 lane_offsets = SimdFloat4::Make(1, 2, 3, 4);
+  Scalar xs[SimdFloat4::kLaneCount];
+  Scalar ys[SimdFloat4::kLaneCount];
+  for (size_t i = 0; i < interior_count; i += SimdFloat4::kLaneCount) {
+    SimdFloat4 t =
+        (SimdFloat4::Splat(static_cast<Scalar>(i)) + lane_offsets) / divisor;
+    auto [x, y] = solve(t);
+    x.Store(xs);
+    y.Store(ys);
+    const size_t count =
+        std::min(interior_count - i, SimdFloat4::kLaneCount);
+    for (size_t j = 0; j < count; j++) {
+      sink(Point(xs[j], ys[j]));
+    }
+  }
+  sink(end);
+}
+
+static inline SimdFloat4 QuadraticSolve(const SimdFloat4& t,
+                                        Scalar p0,
+                                        Scalar p1,
+                                        Scalar p2) {
+  const SimdFloat4 one = SimdFloat4::Splat(1);
+  const SimdFloat4 two = SimdFloat4::Splat(2);
+  const SimdFloat4 mt = one - t;
+  return mt * mt * SimdFloat4::Splat(p0) +  //
+         two * mt * t * SimdFloat4::Splat(p1) +  //
+         t * t * SimdFloat4::Splat(p2);
+}
+
+static inline SimdFloat4 CubicSolve(const SimdFloat4& t,
+                                    Scalar p0,
+                                    Scalar p1,
+                                    Scalar p2,
+                                    Scalar p3) {
+  const SimdFloat4 one = SimdFloat4::Splat(1);
+  const SimdFloat4 three = SimdFloat4::Splat(3);
+  const SimdFloat4 mt = one - t;
+  return mt * mt * mt * SimdFloat4::Splat(p0) +      //
+         three * mt * mt * t * SimdFloat4::Splat(p1) +  //
+         three * mt * t * t * SimdFloat4::Splat(p2) +   //
+         t * t * t * SimdFloat4::Splat(p3);
+}
+
 Point LinearPathComponent::Solve(Scalar time) const {
   return {
       LinearSolve(time, p1.x, p2.x),  // x
@@ -255,10 +315,13 @@ void QuadraticPathComponent::ToLinearPathComponents(
     Scalar scale,
     VertexWriter& writer) const {
   Scalar line_count = std::ceilf(ComputeQuadradicSubdivisions(scale, *this));
-  for (size_t i = 1; i < line_count; i += 1) {
-    writer.Write(Solve(i / line_count));
-  }
-  writer.Write(p2);
+  WriteCurvePoints(
+      line_count, p2,
+      [this](const SimdFloat4& t) {
+        return std::make_pair(QuadraticSolve(t, p1.x, cp.x, p2.x),
+                              QuadraticSolve(t, p1.y, cp.y, p2.y));
+      },
+      [&writer](Point point) { writer.Write(point); });
 }
 
 void QuadraticPathComponent::AppendPolylinePoints(
@@ -274,10 +337,13 @@ void QuadraticPathComponent::ToLinearPathComponents(
     const PointProc& proc) const {
   Scalar line_count =
       std::ceilf(ComputeQuadradicSubdivisions(scale_factor, *this));
-  for (size_t i = 1; i < line_count; i += 1) {
-    proc(Solve(i / line_count));
-  }
-  proc(p2);
+  WriteCurvePoints(
+      line_count, p2,
+      [this](const SimdFloat4& t) {
+        return std::make_pair(QuadraticSolve(t, p1.x, cp.x, p2.x),
+                              QuadraticSolve(t, p1.y, cp.y, p2.y));
+      },
+      proc);
 }
 
 size_t QuadraticPathComponent::CountLinearPathComponents(Scalar scale) const {
@@ -333,10 +399,13 @@ void CubicPathComponent::AppendPolylinePoints(
 void CubicPathComponent::ToLinearPathComponents(Scalar scale,
                                                 VertexWriter& writer) const {
   Scalar line_count = std::ceilf(ComputeCubicSubdivisions(scale, *this));
-  for (size_t i = 1; i < line_count; i++) {
-    writer.Write(Solve(i / line_count));
-  }
-  writer.Write(p2);
+  WriteCurvePoints(
+      line_count, p2,
+      [this](const SimdFloat4& t) {
+        return std::make_pair(CubicSolve(t, p1.x, cp1.x, cp2.x, p2.x),
+                              CubicSolve(t, p1.y, cp1.y, cp2.y, p2.y));
+      },
+      [&writer](Point point) { writer.Write(point); });
 }
 
 size_t CubicPathComponent::CountLinearPathComponents(Scalar scale) const {
@@ -361,10 +430,13 @@ CubicPathComponent CubicPathComponent::Subsegment(Scalar t0, Scalar t1) const {
 void CubicPathComponent::ToLinearPathComponents(Scalar scale,
                                                 const PointProc& proc) const {
   Scalar line_count = std::ceilf(ComputeCubicSubdivisions(scale, *this));
-  for (size_t i = 1; i < line_count; i++) {
-    proc(Solve(i / line_count));
-  }
-  proc(p2);
+  WriteCurvePoints(
+      line_count, p2,
+      [this](const SimdFloat4& t) {
+        return std::make_pair(CubicSolve(t, p1.x, cp1.x, cp2.x, p2.x),
+                              CubicSolve(t, p1.y, cp1.y, cp2.y, p2.y));
+      },
+      proc);
 }
 
 static inline bool NearEqual(Scalar a, Scalar b, Scalar epsilon) {
@@ -10,6 +10,7 @@
 #include "impeller/geometry/path_builder.h"
 #include "impeller/geometry/path_component.h"
 #include "impeller/geometry/round_rect.h"
+#include "impeller/geometry/wangs_formula.h"
 
 namespace impeller {
 namespace testing {
@@ -1017,5 +1018,112 @@ TEST(PathTest, PathBuilderDoesNotMutateCopiedPaths) {
       false, {23, 42}, "Shift");
 }
 
+TEST(PathTest, ContentHashIgnoresStorageIdentity) {
+  Path path = PathBuilder{}.AddCircle({100, 100}, 50).TakePath();
+  Path same_path = PathBuilder{}.AddCircle({100, 100}, 50).TakePath();
+  Path other_path = PathBuilder{}.AddCircle({100, 100}, 51).TakePath();
+
+  EXPECT_EQ(path.GetContentHash(), same_path.GetContentHash());
+  EXPECT_TRUE(path.IsContentEqual(same_path));
+  EXPECT_NE(path.GetContentHash(), other_path.GetContentHash());
+  EXPECT_FALSE(path.IsContentEqual(other_path));
+
+  Path even_odd_path = PathBuilder{}
+                           .AddCircle({100, 100}, 50)
+                           .SetFillType(FillType::kOdd)
+                           .TakePath();
+  EXPECT_FALSE(path.IsContentEqual(even_odd_path));
+}
+
+TEST(PathTest, BatchedSubdivisionsMatchSingleCurves) {
+  std::vector<QuadraticPathComponent> quads;
+  std::vector<CubicPathComponent> cubics;
+  for (int i = 0; i < 7; i++) {
+    Scalar d = i * 13.5f;
+    quads.emplace_back(Point(d, 0), Point(50 + d, 100 - d), Point(100, d));
+    cubics.emplace_back(Point(d, 0), Point(50, 100 + d), Point(100 - d, -50),
+                        Point(150, d));
+  }
+  std::vector<const QuadraticPathComponent*> quad_ptrs;
+  std::vector<const CubicPathComponent*> cubic_ptrs;
+  for (size_t i = 0; i < quads.size(); i++) {
+    quad_ptrs.push_back(&quads[i]);
+    cubic_ptrs.push_back(&cubics[i]);
+  }
+
+  for (Scalar scale : {0.5f, 1.0f, 3.0f}) {
+    // An odd count exercises the partially filled final batch.
+    std::vector<Scalar> quad_subdivisions(quads.size());
+    std::vector<Scalar> cubic_subdivisions(cubics.size());
+    ComputeQuadradicSubdivisions(scale, quad_ptrs.data(), quad_ptrs.size(),
+                                 quad_subdivisions.data());
+    ComputeCubicSubdivisions(scale, cubic_ptrs.data(), cubic_ptrs.size(),
+                             cubic_subdivisions.data());
+    for (size_t i = 0; i < quads.size(); i++) {
+      EXPECT_EQ(quad_subdivisions[i],
+                ComputeQuadradicSubdivisions(scale, quads[i]));
+      EXPECT_EQ(cubic_subdivisions[i],
+                ComputeCubicSubdivisions(scale, cubics[i]));
+    }
+  }
+}
+
+TEST(PathTest, CurveFlatteningMatchesSolve) {
+  CubicPathComponent cubic({0, 0}, {30, 200}, {170, -100}, {200, 100});
+  QuadraticPathComponent quad({0, 0}, {100, 200}, {200, 0});
+
+  std::vector<Point> cubic_points;
+  cubic.ToLinearPathComponents(
+      1.0f, [&cubic_points](const Point& p) { cubic_points.push_back(p); });
+  Scalar cubic_count = std::ceilf(ComputeCubicSubdivisions(1.0f, cubic));
+  ASSERT_EQ(cubic_points.size(), static_cast<size_t>(cubic_count));
+  for (size_t i = 1; i < cubic_points.size(); i++) {
+    EXPECT_POINT_NEAR(cubic_points[i - 1], cubic.Solve(i / cubic_count));
+  }
+  EXPECT_EQ(cubic_points.back(), cubic.p2);
+
+  std::vector<Point> quad_points;
+  quad.ToLinearPathComponents(
+      1.0f, [&quad_points](const Point& p) { quad_points.push_back(p); });
+  Scalar quad_count = std::ceilf(ComputeQuadradicSubdivisions(1.0f, quad));
+  ASSERT_EQ(quad_points.size(), static_cast<size_t>(quad_count));
+  for (size_t i = 1; i < quad_points.size(); i++) {
+    EXPECT_POINT_NEAR(quad_points[i - 1], quad.Solve(i / quad_count));
+  }
+  EXPECT_EQ(quad_points.back(), quad.p2);
+}
+
+TEST(PathTest, CountStorageMatchesCurveCountsAcrossBatches) {
+  PathBuilder builder;
+  size_t expected_points = 0u;
+  builder.MoveTo({0, 0});
+  Point current(0, 0);
+  for (int i = 0; i < 41; i++) {
+    Point end(i * 7.0f, (i % 5) * 11.0f);
+    if (i % 3 == 0) {
+      QuadraticPathComponent quad(current, {end.x, end.y + 40}, end);
+      expected_points += quad.CountLinearPathComponents(2.0f);
+      builder.QuadraticCurveTo(quad.cp, end);
+    } else {
+      CubicPathComponent cubic(current, {current.x + 20, end.y - 30},
+                               {end.x - 20, end.y + 30}, end);
+      expected_points += cubic.CountLinearPathComponents(2.0f);
+      builder.CubicCurveTo(cubic.cp1, cubic.cp2, end);
+    }
+    current = end;
+  }
+  Path path = builder.TakePath();
+
+  auto [points, contours] = path.CountStorage(2.0f);
+  EXPECT_EQ(points, expected_points);
+
+  std::vector<Point> point_storage(points);
+  std::vector<uint16_t> index_storage(points + contours);
+  StripVertexWriter writer(point_storage.data(), index_storage.data());
+  path.WritePolyline(2.0f, writer);
+
+  EXPECT_LE(writer.GetIndexCount(), index_storage.size());
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -0,0 +1,174 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_GEOMETRY_SIMD_FLOAT4_H_
+#define FLUTTER_IMPELLER_GEOMETRY_SIMD_FLOAT4_H_
+
+#include <cmath>
+#include <cstddef>
+
+#include "impeller/geometry/scalar.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define IMPELLER_SIMD_FLOAT4_USE_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define IMPELLER_SIMD_FLOAT4_USE_NEON 1
+#endif
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Four floats that are operated on together, using SSE2 on x86,
+///             NEON on arm64 and plain loops elsewhere.
+///
+///             Every operation is a single correctly rounded IEEE operation
+///             per lane, so the results are identical across implementations
+///             and identical to the same sequence of scalar operations
+///             without fused multiply-adds.
+///
+class SimdFloat4 {
+ public:
+  static constexpr size_t kLaneCount = 4u;
+
+  static SimdFloat4 Splat(Scalar value) {
+#if IMPELLER_SIMD_FLOAT4_USE_SSE2
+    return SimdFloat4(_mm_set1_ps(value));
+#elif IMPELLER_SIMD_FLOAT4_USE_NEON
+    return SimdFloat4(vdupq_n_f32(value));
+#else
+    return SimdFloat4(value, value, value, value);
+#endif
+  }
+
+  static SimdFloat4 Load(const Scalar* values) {
+#if IMPELLER_SIMD_FLOAT4_USE_SSE2
+    return SimdFloat4(_mm_loadu_ps(values));
+#elif IMPELLER_SIMD_FLOAT4_USE_NEON
+    return SimdFloat4(vld1q_f32(values));
+#else
+    return SimdFloat4(values[0], values[1], values[2], values[3]);
+#endif
+  }
+
+  static SimdFloat4 Make(Scalar a, Scalar b, Scalar c, Scalar d) {
+#if IMPELLER_SIMD_FLOAT4_USE_SSE2
+    return SimdFloat4(_mm_setr_ps(a, b, c, d));
+#elif IMPELLER_SIMD_FLOAT4_USE_NEON
+    const float lanes[kLaneCount] = {a, b, c, d};
+    return SimdFloat4(vld1q_f32(lanes));
+#else
+    return SimdFloat4(a, b, c, d);
+#endif
+  }
+
+  void Store(Scalar* out) const {
+#if IMPELLER_SIMD_FLOAT4_USE_SSE2
+    _mm_storeu_ps(out, value_);
+#elif IMPELLER_SIMD_FLOAT4_USE_NEON
+    vst1q_f32(out, value_);
+#else
+    for (size_t i = 0; i < kLaneCount; i++) {
+      out[i] = value_[i];
+    }
+#endif
+  }
+
+  SimdFloat4 operator+(const SimdFloat4& o) const {
+#if IMPELLER_SIMD_FLOAT4_USE_SSE2
+    return SimdFloat4(_mm_add_ps(value_, o.value_));
+#elif IMPELLER_SIMD_FLOAT4_USE_NEON
+    return SimdFloat4(vaddq_f32(value_, o.value_));
+#else
+    return Map(o, [](Scalar a, Scalar b) { return a + b; });
+#endif
+  }
+
+  SimdFloat4 operator-(const SimdFloat4& o) const {
+#if IMPELLER_SIMD_FLOAT4_USE_SSE2
+    return SimdFloat4(_mm_sub_ps(value_, o.value_));
+#elif IMPELLER_SIMD_FLOAT4_USE_NEON
+    return SimdFloat4(vsubq_f32(value_, o.value_));
+#else
+    return Map(o, [](Scalar a, Scalar b) { return a - b; });
+#endif
+  }
+
+  SimdFloat4 operator*(const SimdFloat4& o) const {
+#if IMPELLER_SIMD_FLOAT4_USE_SSE2
+    return SimdFloat4(_mm_mul_ps(value_, o.value_));
+#elif IMPELLER_SIMD_FLOAT4_USE_NEON
+    return SimdFloat4(vmulq_f32(value_, o.value_));
+#else
+    return Map(o, [](Scalar a, Scalar b) { return a * b; });
+#endif
+  }
+
+  SimdFloat4 operator/(const SimdFloat4& o) const {
+#if IMPELLER_SIMD_FLOAT4_USE_SSE2
+    return SimdFloat4(_mm_div_ps(value_, o.value_));
+#elif IMPELLER_SIMD_FLOAT4_USE_NEON
+    return SimdFloat4(vdivq_f32(value_, o.value_));
+#else
+    return Map(o, [](Scalar a, Scalar b) { return a / b; });
+#endif
+  }
+
+  SimdFloat4 Max(const SimdFloat4& o) const {
+#if IMPELLER_SIMD_FLOAT4_USE_SSE2
+    return SimdFloat4(_mm_max_ps(value_, o.value_));
+#elif IMPELLER_SIMD_FLOAT4_USE_NEON
+    return SimdFloat4(vmaxq_f32(value_, o.value_));
+#else
+    return Map(o, [](Scalar a, Scalar b) { return a > b ? a : b; });
+#endif
+  }
+
+  SimdFloat4 Abs() const {
+#if IMPELLER_SIMD_FLOAT4_USE_SSE2
+    return SimdFloat4(_mm_andnot_ps(_mm_set1_ps(-0.0f), value_));
+#elif IMPELLER_SIMD_FLOAT4_USE_NEON
+    return SimdFloat4(vabsq_f32(value_));
+#else
+    return Map(*this, [](Scalar a, Scalar) { return std::fabs(a); });
+#endif
+  }
+
+  SimdFloat4 Sqrt() const {
+#if IMPELLER_SIMD_FLOAT4_USE_SSE2
+    return SimdFloat4(_mm_sqrt_ps(value_));
+#elif IMPELLER_SIMD_FLOAT4_USE_NEON
+    return SimdFloat4(vsqrtq_f32(value_));
+#else
+    return Map(*this, [](Scalar a, Scalar) { return std::sqrt(a); });
+#endif
+  }
+
+ private:
+#if IMPELLER_SIMD_FLOAT4_USE_SSE2
+  explicit SimdFloat4(__m128 value) : value_(value) {}
+
+  __m128 value_;
+#elif IMPELLER_SIMD_FLOAT4_USE_NEON
+  explicit SimdFloat4(float32x4_t value) : value_(value) {}
+
+  float32x4_t value_;
+#else
+  SimdFloat4(Scalar a, Scalar b, Scalar c, Scalar d) : value_{a, b, c, d} {}
+
+  template <class Op>
+  SimdFloat4 Map(const SimdFloat4& o, Op op) const {
+    return SimdFloat4(op(value_[0], o.value_[0]), op(value_[1], o.value_[1]),
+                      op(value_[2], o.value_[2]), op(value_[3], o.value_[3]));
+  }
+
+  Scalar value_[kLaneCount];
+#endif
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_GEOMETRY_SIMD_FLOAT4_H_
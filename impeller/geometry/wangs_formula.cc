@@ -4,6 +4,10 @@
 
 #include "impeller/geometry/wangs_formula.h"
 
+#include <algorithm>
+
+#include "impeller/geometry/simd_float4.h"
+
 namespace impeller {
 
 namespace {
@@ -13,41 +17,119 @@ namespace {
 // X and Y directions.
 constexpr static Scalar kPrecision = 4;
 
-constexpr Scalar length(Point n) {
-  Point nn = n * n;
-  return std::sqrt(nn.x + nn.y);
+// Loads one coordinate of up to four curves into the lanes of a vector. Lanes
+// past |count| repeat the last curve.
+template <class Curve, class Accessor>
+SimdFloat4 LoadLanes(const Curve* const curves[],
+                     size_t count,
+                     const Accessor& accessor) {
+  Scalar lanes[SimdFloat4::kLaneCount];
+  for (size_t i = 0; i < SimdFloat4::kLaneCount; i++) {
+    lanes[i] = accessor(*curves[std::min(i, count - 1)]);
+  }
+  return SimdFloat4::Load(lanes);
+}
+
+// The length of the vectors (x, y) in each lane.
+SimdFloat4 Length(const SimdFloat4& x, const SimdFloat4& y) {
+  return (x * x + y * y).Sqrt();
 }
 
 }  // namespace
 
+void ComputeQuadradicSubdivisions(Scalar scale_factor,
+                                  const QuadraticPathComponent* const quads[],
+                                  size_t count,
+                                  Scalar subdivisions[]) {
+  const SimdFloat4 k = SimdFloat4::Splat(scale_factor * .25f * kPrecision);
+  const SimdFloat4 two = SimdFloat4::Splat(2);
+  for (size_t i = 0; i < count; i += SimdFloat4::kLaneCount) {
+    const QuadraticPathComponent* const* batch = quads + i;
+    const size_t batch_count = std::min(count - i, SimdFloat4::kLaneCount);
+    auto load = [&](auto accessor) {
+      return LoadLanes(batch, batch_count, accessor);
+    };
+    SimdFloat4 p0x = load([](const auto& q) { return q.p1.x; });
+    SimdFloat4 p0y = load([](const auto& q) { return q.p1.y; });
+    SimdFloat4 p1x = load([](const auto& q) { return q.cp.x; });
+    SimdFloat4 p1y = load([](const auto& q) { return q.cp.y; });
+    SimdFloat4 p2x = load([](const auto& q) { return q.p2.x; });
+    SimdFloat4 p2y = load([](const auto& q) { return q.p2.y; });
+
+    SimdFloat4 result = (k * Length(p0x - p1x * two + p2x,  //
+                                    p0y - p1y * two + p2y))
+                            .Sqrt();
+
+    Scalar lanes[SimdFloat4::kLaneCount];
+    result.Store(lanes);
+    std::copy_n(lanes, batch_count, subdivisions + i);
+  }
+}
+
+void ComputeCubicSubdivisions(Scalar scale_factor,
+                              const CubicPathComponent* const cubics[],
+                              size_t count,
+                              Scalar subdivisions[]) {
+  const SimdFloat4 k = SimdFloat4::Splat(scale_factor * .75f * kPrecision);
+  const SimdFloat4 two = SimdFloat4::Splat(2);
+  for (size_t i = 0; i < count; i += SimdFloat4::kLaneCount) {
+    const CubicPathComponent* const* batch = cubics + i;
+    const size_t batch_count = std::min(count - i, SimdFloat4::kLaneCount);
+    auto load = [&](auto accessor) {
+      return LoadLanes(batch, batch_count, accessor);
+    };
+    SimdFloat4 p0x = load([](const auto& c) { return c.p1.x; });
+    SimdFloat4 p0y = load([](const auto& c) { return c.p1.y; });
+    SimdFloat4 p1x = load([](const auto& c) { return c.cp1.x; });
+    SimdFloat4 p1y = load([](const auto& c) { return c.cp1.y; });
+    SimdFloat4 p2x = load([](const auto& c) { return c.cp2.x; });
+    SimdFloat4 p2y = load([](const auto& c) { return c.cp2.y; });
+    SimdFloat4 p3x = load([](const auto& c) { return c.p2.x; });
+    SimdFloat4 p3y = load([](const auto& c) { return c.p2.y; });
+
+    SimdFloat4 ax = (p0x - p1x * two + p2x).Abs();
+    SimdFloat4 ay = (p0y - p1y * two + p2y).Abs();
+    SimdFloat4 bx = (p1x - p2x * two + p3x).Abs();
+    SimdFloat4 by = (p1y - p2y * two + p3y).Abs();
+    SimdFloat4 result = (k * Length(ax.Max(bx), ay.Max(by))).Sqrt();
+
+    Scalar lanes[SimdFloat4::kLaneCount];
+    result.Store(lanes);
+    std::copy_n(lanes, batch_count, subdivisions + i);
+  }
+}
+
 Scalar ComputeCubicSubdivisions(Scalar scale_factor,
                                 Point p0,
                                 Point p1,
                                 Point p2,
                                 Point p3) {
-  Scalar k = scale_factor * .75f * kPrecision;
-  Point a = (p0 - p1 * 2 + p2).Abs();
-  Point b = (p1 - p2 * 2 + p3).Abs();
-  return std::sqrt(k * length(a.Max(b)));
+  CubicPathComponent cubic(p0, p1, p2, p3);
+  return ComputeCubicSubdivisions(scale_factor, cubic);
 }
 
 Scalar ComputeQuadradicSubdivisions(Scalar scale_factor,
                                     Point p0,
                                     Point p1,
                                     Point p2) {
-  Scalar k = scale_factor * .25f * kPrecision;
-  return std::sqrt(k * length(p0 - p1 * 2 + p2));
+  QuadraticPathComponent quad(p0, p1, p2);
+  return ComputeQuadradicSubdivisions(scale_factor, quad);
 }
 
 Scalar ComputeQuadradicSubdivisions(Scalar scale_factor,
                                     const QuadraticPathComponent& quad) {
-  return ComputeQuadradicSubdivisions(scale_factor, quad.p1, quad.cp, quad.p2);
+  const QuadraticPathComponent* quads[] = {&quad};
+  Scalar subdivisions;
+  ComputeQuadradicSubdivisions(scale_factor, quads, 1u, &subdivisions);
+  return subdivisions;
 }
 
 Scalar ComputeCubicSubdivisions(float scale_factor,
                                 const CubicPathComponent& cub) {
-  return ComputeCubicSubdivisions(scale_factor, cub.p1, cub.cp1, cub.cp2,
-                                  cub.p2);
+  const CubicPathComponent* cubics[] = {&cub};
+  Scalar subdivisions;
+  ComputeCubicSubdivisions(scale_factor, cubics, 1u, &subdivisions);
+  return subdivisions;
 }
 
 }  // namespace impeller
@@ -5,6 +5,8 @@
 #ifndef FLUTTER_IMPELLER_GEOMETRY_WANGS_FORMULA_H_
 #define FLUTTER_IMPELLER_GEOMETRY_WANGS_FORMULA_H_
 
+#include <cstddef>
+
 #include "impeller/geometry/path_component.h"
 #include "impeller/geometry/point.h"
 #include "impeller/geometry/scalar.h"
@@ -60,6 +62,22 @@ Scalar ComputeQuadradicSubdivisions(Scalar scale_factor,
 /// The scale_factor should be the max basis XY of the current transform.
 Scalar ComputeCubicSubdivisions(float scale_factor,
                                 const CubicPathComponent& cub);
+
+/// Computes the subdivisions of |count| quadratics, four at a time. The
+/// results are identical to those of the single curve variants, which are
+/// implemented in terms of this.
+void ComputeQuadradicSubdivisions(Scalar scale_factor,
+                                  const QuadraticPathComponent* const quads[],
+                                  size_t count,
+                                  Scalar subdivisions[]);
+
+/// Computes the subdivisions of |count| cubics, four at a time. The results
+/// are identical to those of the single curve variants, which are implemented
+/// in terms of this.
+void ComputeCubicSubdivisions(Scalar scale_factor,
+                              const CubicPathComponent* const cubics[],
+                              size_t count,
+                              Scalar subdivisions[]);
 }  // namespace impeller
 
 #endif  // FLUTTER_IMPELLER_GEOMETRY_WANGS_FORMULA_H_
@@ -14,6 +14,7 @@
 #include <QuartzCore/QuartzCore.h>
 
 #include "flutter/fml/mapping.h"
+#include "impeller/entity/mtl/compute_entity_shaders.h"
 #include "impeller/entity/mtl/entity_shaders.h"
 #include "impeller/entity/mtl/framebuffer_blend_shaders.h"
 #include "impeller/entity/mtl/modern_shaders.h"
@@ -38,6 +39,9 @@ ShaderLibraryMappingsForPlayground() {
               impeller_entity_shaders_data, impeller_entity_shaders_length),
           std::make_shared<fml::NonOwnedMapping>(
               impeller_modern_shaders_data, impeller_modern_shaders_length),
+          std::make_shared<fml::NonOwnedMapping>(
+              impeller_compute_entity_shaders_data,
+              impeller_compute_entity_shaders_length),
           std::make_shared<fml::NonOwnedMapping>(
               impeller_framebuffer_blend_shaders_data,
               impeller_framebuffer_blend_shaders_length),
@@ -12,6 +12,7 @@
 
 #include "flutter/fml/logging.h"
 #include "flutter/fml/mapping.h"
+#include "impeller/entity/vk/compute_entity_shaders_vk.h"
 #include "impeller/entity/vk/entity_shaders_vk.h"
 #include "impeller/entity/vk/framebuffer_blend_shaders_vk.h"
 #include "impeller/entity/vk/modern_shaders_vk.h"
@@ -34,6 +35,9 @@ ShaderLibraryMappingsForPlayground() {
                                              impeller_entity_shaders_vk_length),
       std::make_shared<fml::NonOwnedMapping>(impeller_modern_shaders_vk_data,
                                              impeller_modern_shaders_vk_length),
+      std::make_shared<fml::NonOwnedMapping>(
+          impeller_compute_entity_shaders_vk_data,
+          impeller_compute_entity_shaders_vk_length),
       std::make_shared<fml::NonOwnedMapping>(
           impeller_framebuffer_blend_shaders_vk_data,
           impeller_framebuffer_blend_shaders_vk_length),
@@ -91,6 +95,8 @@ PlaygroundImplVK::PlaygroundImplVK(PlaygroundSwitches switches)
   context_settings.enable_validation = switches_.enable_vulkan_validation;
   context_settings.fatal_missing_validations =
       switches_.enable_vulkan_validation;
+  context_settings.enable_parallel_render_pass_encoding =
+      switches_.enable_parallel_render_pass_encoding;
   ;
 
   auto context_vk = ContextVK::Create(std::move(context_settings));
@@ -58,6 +58,11 @@ void PlaygroundTest::SetUp() {
   PlaygroundSwitches switches = switches_;
   switches.enable_wide_gamut =
       test_name.find("WideGamut/") != std::string::npos;
+  // Test names that end with "ParallelEncoding" will split their render
+  // passes across threads on backends that support it.
+  switches.enable_parallel_render_pass_encoding =
+      switches.enable_parallel_render_pass_encoding ||
+      test_name.find("ParallelEncoding/") != std::string::npos;
 
   if (switches.enable_wide_gamut && (GetParam() != PlaygroundBackend::kMetal ||
                                      !DoesSupportWideGamutTests())) {
@@ -23,6 +23,8 @@ PlaygroundSwitches::PlaygroundSwitches(const fml::CommandLine& args) {
   enable_vulkan_validation = args.HasOption("enable_vulkan_validation");
   use_swiftshader = args.HasOption("use_swiftshader");
   use_angle = args.HasOption("use_angle");
+  enable_parallel_render_pass_encoding =
+      args.HasOption("enable_parallel_render_pass_encoding");
 #if FML_OS_MACOSX
   // OpenGL on macOS is busted and deprecated. Use Angle there by default.
   use_angle = true;
@@ -34,6 +34,12 @@ struct PlaygroundSwitches {
 
   bool enable_wide_gamut = false;
 
+  //----------------------------------------------------------------------------
+  /// Split render passes with many draws into secondary command buffers that
+  /// are encoded on worker threads. Only the Vulkan backend supports this.
+  ///
+  bool enable_parallel_render_pass_encoding = false;
+
   PlaygroundSwitches();
 
   explicit PlaygroundSwitches(const fml::CommandLine& args);
@@ -101,9 +101,10 @@ bool BlitCopyTextureToTextureCommandGLES::Encode(
     draw_fbo = draw.value();
   }
 
-  gl.Disable(GL_SCISSOR_TEST);
-  gl.Disable(GL_DEPTH_TEST);
-  gl.Disable(GL_STENCIL_TEST);
+  StateCacheGLES& state = reactor.GetStateCache();
+  state.Disable(gl, GL_SCISSOR_TEST);
+  state.Disable(gl, GL_DEPTH_TEST);
+  state.Disable(gl, GL_STENCIL_TEST);
 
   gl.BlitFramebuffer(source_region.GetX(),       // srcX0
                      source_region.GetY(),       // srcY0
@@ -397,9 +398,10 @@ bool BlitResizeTextureCommandGLES::Encode(const ReactorGLES& reactor) const {
     draw_fbo = draw.value();
   }
 
-  gl.Disable(GL_SCISSOR_TEST);
-  gl.Disable(GL_DEPTH_TEST);
-  gl.Disable(GL_STENCIL_TEST);
+  StateCacheGLES& state = reactor.GetStateCache();
+  state.Disable(gl, GL_SCISSOR_TEST);
+  state.Disable(gl, GL_DEPTH_TEST);
+  state.Disable(gl, GL_STENCIL_TEST);
 
   const IRect source_region = IRect::MakeSize(source->GetSize());
   const IRect destination_region = IRect::MakeSize(destination->GetSize());
@@ -4,6 +4,7 @@
 
 #include "impeller/renderer/backend/gles/buffer_bindings_gles.h"
 
+#include <algorithm>
 #include <cstring>
 #include <vector>
 
@@ -115,6 +116,12 @@ bool BufferBindingsGLES::ReadUniformsBindingsV3(const ProcTableGLES& gl,
   program_handle_ = program;
   GLint uniform_blocks = 0;
   gl.GetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCKS, &uniform_blocks);
+  if (static_cast<size_t>(std::max(uniform_blocks, 0)) >
+      gl.GetCapabilities()->max_uniform_buffer_bindings) {
+    VALIDATION_LOG << "Program has more uniform blocks than there are uniform "
+                      "buffer binding points.";
+    return false;
+  }
   for (GLint i = 0; i < uniform_blocks; i++) {
     GLint name_length = 0;
     gl.GetActiveUniformBlockiv(program, i, GL_UNIFORM_BLOCK_NAME_LENGTH,
@@ -125,9 +132,19 @@ bool BufferBindingsGLES::ReadUniformsBindingsV3(const ProcTableGLES& gl,
     GLint length = 0;
     gl.GetActiveUniformBlockName(program, i, name_length, &length, name.data());
 
-    GLuint block_index = gl.GetUniformBlockIndex(program, name.data());
-    ubo_locations_[std::string{name.data(), static_cast<size_t>(length)}] =
-        std::make_pair(block_index, i);
+    GLint data_size = 0;
+    gl.GetActiveUniformBlockiv(program, i, GL_UNIFORM_BLOCK_DATA_SIZE,
+                               &data_size);
+
+    // The block to binding point mapping is program state. Give every block
+    // its own binding point once here so that binding a block for a draw only
+    // needs to bind the buffer range.
+    gl.UniformBlockBinding(program, i, i);
+    uniform_blocks_[std::string{name.data(), static_cast<size_t>(length)}] =
+        UniformBlock{
+            .binding_point = static_cast<GLuint>(i),
+            .data_size = static_cast<size_t>(std::max(data_size, 0)),
+        };
   }
   use_ubo_ = true;
   return ReadUniformsBindingsV2(gl, program);
@@ -330,13 +347,32 @@ bool BufferBindingsGLES::BindUniformBufferV3(
     const BufferView& buffer,
     const ShaderMetadata* metadata,
     const DeviceBufferGLES& device_buffer_gles) {
-  absl::flat_hash_map<std::string, std::pair<GLint, GLuint>>::iterator it =
-      ubo_locations_.find(metadata->name);
-  if (it == ubo_locations_.end()) {
+  absl::flat_hash_map<std::string, UniformBlock>::iterator it =
+      uniform_blocks_.find(metadata->name);
+  if (it == uniform_blocks_.end()) {
     return BindUniformBufferV2(gl, buffer, metadata, device_buffer_gles);
   }
-  const auto& [block_index, binding_point] = it->second;
-  gl.UniformBlockBinding(program_handle_, block_index, binding_point);
+  const UniformBlock& block = it->second;
+
+  const Range range = buffer.GetRange();
+  const size_t alignment =
+      gl.GetCapabilities()->uniform_buffer_offset_alignment;
+  if (range.offset % alignment != 0u) {
+    VALIDATION_LOG << "Uniform buffer range for " << metadata->name
+                   << " is not aligned to the uniform buffer offset alignment.";
+    return false;
+  }
+
+  // The reflected struct may omit the padding std140 adds to the end of the
+  // block. The driver requires the whole block to be backed, so bind the
+  // block size and let the trailing bytes be the padding.
+  const size_t length = std::max(range.length, block.data_size);
+  if (range.offset + length >
+      device_buffer_gles.GetDeviceBufferDescriptor().size) {
+    VALIDATION_LOG << "Uniform buffer range for " << metadata->name
+                   << " does not cover the whole uniform block.";
+    return false;
+  }
 
   if (!device_buffer_gles.BindAndUploadDataIfNecessary(
           DeviceBufferGLES::BindingType::kUniformBuffer)) {
@@ -346,8 +382,8 @@ bool BufferBindingsGLES::BindUniformBufferV3(
   if (!handle.has_value()) {
     return false;
   }
-  gl.BindBufferRange(GL_UNIFORM_BUFFER, binding_point, handle.value(),
-                     buffer.GetRange().offset, buffer.GetRange().length);
+  gl.BindBufferRange(GL_UNIFORM_BUFFER, block.binding_point, handle.value(),
+                     range.offset, length);
   return true;
 }
 
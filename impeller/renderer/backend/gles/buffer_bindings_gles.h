@@ -19,6 +19,8 @@ namespace impeller {
 
 namespace testing {
 FML_TEST_CLASS(BufferBindingsGLESTest, BindUniformData);
+FML_TEST_CLASS(BufferBindingsGLESTest, ReadsUniformBlocks);
+FML_TEST_CLASS(BufferBindingsGLESTest, BindsUniformBlocksWithOneCall);
 }  // namespace testing
 
 //------------------------------------------------------------------------------
@@ -52,6 +54,9 @@ class BufferBindingsGLES {
 
  private:
   FML_FRIEND_TEST(testing::BufferBindingsGLESTest, BindUniformData);
+  FML_FRIEND_TEST(testing::BufferBindingsGLESTest, ReadsUniformBlocks);
+  FML_FRIEND_TEST(testing::BufferBindingsGLESTest,
+                  BindsUniformBlocksWithOneCall);
   //----------------------------------------------------------------------------
   /// @brief      The arguments to glVertexAttribPointer.
   ///
@@ -65,8 +70,19 @@ class BufferBindingsGLES {
   };
   std::vector<std::vector<VertexAttribPointer>> vertex_attrib_arrays_;
 
+  //----------------------------------------------------------------------------
+  /// @brief      An active uniform block of the program and the binding point
+  ///             it was assigned when the program was read.
+  ///
+  struct UniformBlock {
+    GLuint binding_point = 0u;
+    /// The std140 size of the block. The bound range must be at least this
+    /// large.
+    size_t data_size = 0u;
+  };
+
   absl::flat_hash_map<std::string, GLint> uniform_locations_;
-  absl::flat_hash_map<std::string, std::pair<GLint, GLuint>> ubo_locations_;
+  absl::flat_hash_map<std::string, UniformBlock> uniform_blocks_;
 
   using BindingMap = absl::flat_hash_map<std::string, std::vector<GLint>>;
   BindingMap binding_map_ = {};
@@ -2,10 +2,13 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <cstring>
+
 #include "flutter/testing/testing.h"  // IWYU pragma: keep
 #include "gtest/gtest.h"
 #include "impeller/renderer/backend/gles/buffer_bindings_gles.h"
 #include "impeller/renderer/backend/gles/device_buffer_gles.h"
+#include "impeller/renderer/backend/gles/reactor_gles.h"
 #include "impeller/renderer/backend/gles/test/mock_gles.h"
 #include "impeller/renderer/command.h"
 
@@ -13,6 +16,18 @@ namespace impeller {
 namespace testing {
 
 using ::testing::_;
+using ::testing::AnyNumber;
+using ::testing::SetArgPointee;
+
+namespace {
+class TestWorker : public ReactorGLES::Worker {
+ public:
+  bool CanReactorReactOnCurrentThreadNow(
+      const ReactorGLES& reactor) const override {
+    return true;
+  }
+};
+}  // namespace
 
 TEST(BufferBindingsGLESTest, BindUniformData) {
   BufferBindingsGLES bindings;
@@ -47,5 +62,80 @@ TEST(BufferBindingsGLESTest, BindUniformData) {
                                        Range{0, 1}));
 }
 
+TEST(BufferBindingsGLESTest, ReadsUniformBlocks) {
+  constexpr GLuint kProgram = 3u;
+  static constexpr char kBlockName[] = "FragInfo";
+  auto mock_gles_impl = std::make_unique<MockGLESImpl>();
+  EXPECT_CALL(*mock_gles_impl, GetProgramiv(_, _, _)).Times(AnyNumber());
+  EXPECT_CALL(*mock_gles_impl,
+              GetProgramiv(kProgram, GL_ACTIVE_UNIFORM_BLOCKS, _))
+      .WillOnce(SetArgPointee<2>(1));
+  EXPECT_CALL(*mock_gles_impl,
+              GetActiveUniformBlockiv(kProgram, 0u,
+                                      GL_UNIFORM_BLOCK_NAME_LENGTH, _))
+      .WillOnce(SetArgPointee<3>(sizeof(kBlockName)));
+  EXPECT_CALL(*mock_gles_impl,
+              GetActiveUniformBlockiv(kProgram, 0u, GL_UNIFORM_BLOCK_DATA_SIZE,
+                                      _))
+      .WillOnce(SetArgPointee<3>(48));
+  EXPECT_CALL(*mock_gles_impl,
+              GetActiveUniformBlockName(kProgram, 0u, sizeof(kBlockName), _, _))
+      .WillOnce([](GLuint, GLuint, GLsizei, GLsizei* length, GLchar* name) {
+        std::memcpy(name, kBlockName, sizeof(kBlockName));
+        *length = sizeof(kBlockName) - 1;
+      });
+  // The binding point is assigned once per program rather than per draw.
+  EXPECT_CALL(*mock_gles_impl, UniformBlockBinding(kProgram, 0u, 0u)).Times(1);
+  auto mock_gles = MockGLES::Init(std::move(mock_gles_impl));
+
+  BufferBindingsGLES bindings;
+  ASSERT_TRUE(
+      bindings.ReadUniformsBindingsV3(mock_gles->GetProcTable(), kProgram));
+  ASSERT_EQ(bindings.uniform_blocks_.count(kBlockName), 1u);
+  EXPECT_EQ(bindings.uniform_blocks_[kBlockName].binding_point, 0u);
+  EXPECT_EQ(bindings.uniform_blocks_[kBlockName].data_size, 48u);
+}
+
+TEST(BufferBindingsGLESTest, BindsUniformBlocksWithOneCall) {
+  auto mock_gles_impl = std::make_unique<MockGLESImpl>();
+  EXPECT_CALL(*mock_gles_impl, GenBuffers(1, _))
+      .WillOnce([](GLsizei, GLuint* buffers) { buffers[0] = 7u; });
+  EXPECT_CALL(*mock_gles_impl, Uniform1fv(_, _, _)).Times(0);
+  EXPECT_CALL(*mock_gles_impl, UniformBlockBinding(_, _, _)).Times(0);
+  // The range is extended to the std140 size of the block.
+  EXPECT_CALL(*mock_gles_impl,
+              BindBufferRange(GL_UNIFORM_BUFFER, 2u, 7u, 256, 48))
+      .Times(1);
+  auto mock_gles = MockGLES::Init(std::move(mock_gles_impl));
+  auto reactor = std::make_shared<ReactorGLES>(
+      std::make_unique<ProcTableGLES>(kMockResolverGLES));
+  auto worker = std::make_shared<TestWorker>();
+  reactor->AddWorker(worker);
+
+  BufferBindingsGLES bindings;
+  bindings.use_ubo_ = true;
+  bindings.uniform_blocks_["FragInfo"] = {.binding_point = 2u,
+                                          .data_size = 48u};
+
+  ShaderMetadata shader_metadata = {
+      .name = "FragInfo",
+      .members = {ShaderStructMemberMetadata{.type = ShaderType::kFloat,
+                                             .name = "alpha",
+                                             .offset = 0,
+                                             .size = sizeof(float),
+                                             .byte_length = sizeof(float)}}};
+  std::shared_ptr<Allocation> backing_store = std::make_shared<Allocation>();
+  ASSERT_TRUE(backing_store->Truncate(Bytes{512u}));
+  DeviceBufferGLES device_buffer(DeviceBufferDescriptor{.size = 512u}, reactor,
+                                 backing_store);
+  std::vector<BufferResource> bound_buffers;
+  bound_buffers.push_back(BufferResource(
+      &shader_metadata, BufferView(&device_buffer, Range(256u, 32u))));
+
+  EXPECT_TRUE(bindings.BindUniformData(mock_gles->GetProcTable(), {},
+                                       bound_buffers, Range{0, 0},
+                                       Range{0, 1}));
+}
+
 }  // namespace testing
 }  // namespace impeller
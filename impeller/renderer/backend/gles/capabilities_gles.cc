@@ -107,6 +107,20 @@ CapabilitiesGLES::CapabilitiesGLES(const ProcTableGLES& gl) {
     num_shader_binary_formats = value;
   }
 
+  if (desc->GetGlVersion().major_version >= 3) {
+    GLint value = 0;
+    gl.GetIntegerv(GL_MAX_UNIFORM_BUFFER_BINDINGS, &value);
+    max_uniform_buffer_bindings = value;
+  }
+
+  if (desc->GetGlVersion().major_version >= 3) {
+    GLint value = 0;
+    gl.GetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &value);
+    if (value > 0) {
+      uniform_buffer_offset_alignment = value;
+    }
+  }
+
   if (desc->IsES()) {
     default_glyph_atlas_format_ = PixelFormat::kA8UNormInt;
   } else {
@@ -73,6 +73,13 @@ class CapabilitiesGLES final
   // May be 0.
   size_t num_shader_binary_formats = 0;
 
+  // Must be at least 24 in OpenGL ES 3.0. Zero if uniform buffers are not
+  // supported.
+  size_t max_uniform_buffer_bindings = 0;
+
+  // May be at most 256.
+  size_t uniform_buffer_offset_alignment = 256;
+
   size_t GetMaxTextureUnits(ShaderStage stage) const;
 
   bool IsANGLE() const;
@@ -21,15 +21,17 @@ namespace impeller {
 std::shared_ptr<ContextGLES> ContextGLES::Create(
     std::unique_ptr<ProcTableGLES> gl,
     const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries,
-    bool enable_gpu_tracing) {
-  return std::shared_ptr<ContextGLES>(
-      new ContextGLES(std::move(gl), shader_libraries, enable_gpu_tracing));
+    bool enable_gpu_tracing,
+    const fml::UniqueFD& cache_directory) {
+  return std::shared_ptr<ContextGLES>(new ContextGLES(
+      std::move(gl), shader_libraries, enable_gpu_tracing, cache_directory));
 }
 
 ContextGLES::ContextGLES(
     std::unique_ptr<ProcTableGLES> gl,
     const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries_mappings,
-    bool enable_gpu_tracing) {
+    bool enable_gpu_tracing,
+    const fml::UniqueFD& cache_directory) {
   reactor_ = std::make_shared<ReactorGLES>(std::move(gl));
   if (!reactor_->IsValid()) {
     VALIDATION_LOG << "Could not create valid reactor.";
@@ -49,8 +51,8 @@ ContextGLES::ContextGLES(
 
   // Create the pipeline library.
   {
-    pipeline_library_ =
-        std::shared_ptr<PipelineLibraryGLES>(new PipelineLibraryGLES(reactor_));
+    pipeline_library_ = std::shared_ptr<PipelineLibraryGLES>(
+        new PipelineLibraryGLES(reactor_, cache_directory));
   }
 
   // Create allocators.
@@ -157,7 +159,8 @@ void ContextGLES::ResetThreadLocalState() const {
   }
   [[maybe_unused]] auto result =
       reactor_->AddOperation([](const ReactorGLES& reactor) {
-        RenderPassGLES::ResetGLState(reactor.GetProcTable());
+        RenderPassGLES::ResetGLState(reactor.GetProcTable(),
+                                     reactor.GetStateCache());
       });
 }
 
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_CONTEXT_GLES_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_CONTEXT_GLES_H_
 
+#include "flutter/fml/unique_fd.h"
 #include "impeller/base/backend_cast.h"
 #include "impeller/core/runtime_types.h"
 #include "impeller/renderer/backend/gles/allocator_gles.h"
@@ -24,10 +25,18 @@ class ContextGLES final : public Context,
                           public BackendCast<ContextGLES, Context>,
                           public std::enable_shared_from_this<ContextGLES> {
  public:
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a context for the OpenGL context of the proc table.
+  ///
+  /// @param[in]  cache_directory  If valid, linked programs are persisted in
+  ///                              this directory and reused by later
+  ///                              contexts on the same driver.
+  ///
   static std::shared_ptr<ContextGLES> Create(
       std::unique_ptr<ProcTableGLES> gl,
       const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries,
-      bool enable_gpu_tracing);
+      bool enable_gpu_tracing,
+      const fml::UniqueFD& cache_directory = fml::UniqueFD());
 
   // |Context|
   ~ContextGLES() override;
@@ -62,7 +71,8 @@ class ContextGLES final : public Context,
   ContextGLES(
       std::unique_ptr<ProcTableGLES> gl,
       const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries,
-      bool enable_gpu_tracing);
+      bool enable_gpu_tracing,
+      const fml::UniqueFD& cache_directory);
 
   // |Context|
   std::string DescribeGpuModel() const override;
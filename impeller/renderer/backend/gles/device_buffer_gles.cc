@@ -109,7 +109,7 @@ bool DeviceBufferGLES::BindAndUploadDataIfNecessary(BindingType type) const {
   const auto target_type = ToTarget(type);
   const auto& gl = reactor_->GetProcTable();
 
-  gl.BindBuffer(target_type, buffer.value());
+  reactor_->GetStateCache().BindBuffer(gl, target_type, buffer.value());
   if (!initialized_) {
     gl.BufferData(target_type, backing_store_->GetLength().GetByteSize(),
                   nullptr, GL_DYNAMIC_DRAW);
@@ -57,7 +57,7 @@ bool PipelineGLES::BuildVertexDescriptor(const ProcTableGLES& gl,
   return true;
 }
 
-[[nodiscard]] bool PipelineGLES::BindProgram() const {
+[[nodiscard]] bool PipelineGLES::BindProgram(StateCacheGLES& state) const {
   if (!handle_->IsValid()) {
     return false;
   }
@@ -65,13 +65,13 @@ bool PipelineGLES::BuildVertexDescriptor(const ProcTableGLES& gl,
   if (!handle.has_value()) {
     return false;
   }
-  reactor_->GetProcTable().UseProgram(handle.value());
+  state.UseProgram(reactor_->GetProcTable(), handle.value());
   return true;
 }
 
-[[nodiscard]] bool PipelineGLES::UnbindProgram() const {
+[[nodiscard]] bool PipelineGLES::UnbindProgram(StateCacheGLES& state) const {
   if (reactor_) {
-    reactor_->GetProcTable().UseProgram(0u);
+    state.UseProgram(reactor_->GetProcTable(), 0u);
   }
   return true;
 }
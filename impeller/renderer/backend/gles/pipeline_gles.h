@@ -8,6 +8,7 @@
 #include "impeller/base/backend_cast.h"
 #include "impeller/renderer/backend/gles/buffer_bindings_gles.h"
 #include "impeller/renderer/backend/gles/reactor_gles.h"
+#include "impeller/renderer/backend/gles/state_cache_gles.h"
 #include "impeller/renderer/backend/gles/unique_handle_gles.h"
 #include "impeller/renderer/pipeline.h"
 
@@ -26,9 +27,9 @@ class PipelineGLES final
 
   const std::shared_ptr<UniqueHandleGLES> GetSharedHandle() const;
 
-  [[nodiscard]] bool BindProgram() const;
+  [[nodiscard]] bool BindProgram(StateCacheGLES& state) const;
 
-  [[nodiscard]] bool UnbindProgram() const;
+  [[nodiscard]] bool UnbindProgram(StateCacheGLES& state) const;
 
   BufferBindingsGLES* GetBufferBindings() const;
 
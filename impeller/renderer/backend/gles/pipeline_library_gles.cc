@@ -16,8 +16,14 @@
 
 namespace impeller {
 
-PipelineLibraryGLES::PipelineLibraryGLES(std::shared_ptr<ReactorGLES> reactor)
-    : reactor_(std::move(reactor)) {}
+PipelineLibraryGLES::PipelineLibraryGLES(std::shared_ptr<ReactorGLES> reactor,
+                                         const fml::UniqueFD& cache_directory)
+    : reactor_(std::move(reactor)) {
+  if (reactor_ && cache_directory.is_valid()) {
+    program_binary_cache_ = std::make_shared<ProgramBinaryCacheGLES>(
+        reactor_->GetProcTable(), cache_directory);
+  }
+}
 
 static std::string GetShaderInfoLog(const ProcTableGLES& gl, GLuint shader) {
   GLint log_length = 0;
@@ -78,7 +84,8 @@ static bool LinkProgram(
     const ReactorGLES& reactor,
     const std::shared_ptr<PipelineGLES>& pipeline,
     const std::shared_ptr<const ShaderFunction>& vert_function,
-    const std::shared_ptr<const ShaderFunction>& frag_function) {
+    const std::shared_ptr<const ShaderFunction>& frag_function,
+    const ProgramBinaryCacheGLES* binary_cache) {
   TRACE_EVENT0("impeller", __FUNCTION__);
 
   const auto& descriptor = pipeline->GetDescriptor();
@@ -90,6 +97,23 @@ static bool LinkProgram(
 
   const auto& gl = reactor.GetProcTable();
 
+  auto program = reactor.GetGLHandle(pipeline->GetProgramHandle());
+  if (!program.has_value()) {
+    VALIDATION_LOG << "Could not get program handle from reactor.";
+    return false;
+  }
+
+  const bool use_binary_cache = binary_cache && binary_cache->IsValid();
+  const uint64_t program_hash =
+      use_binary_cache ? ProgramBinaryCacheGLES::ComputeProgramHash(
+                             *vert_mapping, *frag_mapping,
+                             descriptor.GetSpecializationConstants())
+                       : 0u;
+  if (use_binary_cache &&
+      binary_cache->LoadProgram(gl, *program, program_hash)) {
+    return true;
+  }
+
   auto vert_shader = gl.CreateShader(GL_VERTEX_SHADER);
   auto frag_shader = gl.CreateShader(GL_FRAGMENT_SHADER);
 
@@ -134,12 +158,6 @@ static bool LinkProgram(
     return false;
   }
 
-  auto program = reactor.GetGLHandle(pipeline->GetProgramHandle());
-  if (!program.has_value()) {
-    VALIDATION_LOG << "Could not get program handle from reactor.";
-    return false;
-  }
-
   gl.AttachShader(*program, vert_shader);
   gl.AttachShader(*program, frag_shader);
 
@@ -160,6 +178,10 @@ static bool LinkProgram(
     );
   }
 
+  if (use_binary_cache) {
+    gl.ProgramParameteri(*program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  }
+
   gl.LinkProgram(*program);
 
   GLint link_status = GL_FALSE;
@@ -170,6 +192,10 @@ static bool LinkProgram(
                    << gl.GetProgramInfoLogString(*program);
     return false;
   }
+
+  if (use_binary_cache) {
+    binary_cache->StoreProgram(gl, *program, program_hash);
+  }
   return true;
 }
 
@@ -222,12 +248,15 @@ std::shared_ptr<PipelineGLES> PipelineLibraryGLES::CreatePipeline(
     return nullptr;
   }
 
-  const auto link_result = !has_cached_program ? LinkProgram(*reactor,       //
-                                                             pipeline,       //
-                                                             vert_function,  //
-                                                             frag_function   //
-                                                             )
-                                               : true;
+  const auto link_result =
+      !has_cached_program
+          ? LinkProgram(*reactor,                               //
+                        pipeline,                               //
+                        vert_function,                          //
+                        frag_function,                          //
+                        library.GetProgramBinaryCache().get()  //
+                        )
+          : true;
 
   if (!link_result) {
     VALIDATION_LOG << "Could not link pipeline program.";
@@ -328,6 +357,11 @@ const std::shared_ptr<ReactorGLES>& PipelineLibraryGLES::GetReactor() const {
   return reactor_;
 }
 
+const std::shared_ptr<ProgramBinaryCacheGLES>&
+PipelineLibraryGLES::GetProgramBinaryCache() const {
+  return program_binary_cache_;
+}
+
 std::shared_ptr<UniqueHandleGLES> PipelineLibraryGLES::GetProgramForKey(
     const ProgramKey& key) {
   Lock lock(programs_mutex_);
@@ -9,7 +9,9 @@
 #include <vector>
 
 #include "flutter/fml/hash_combine.h"
+#include "flutter/fml/unique_fd.h"
 #include "impeller/base/thread.h"
+#include "impeller/renderer/backend/gles/program_binary_cache_gles.h"
 #include "impeller/renderer/backend/gles/reactor_gles.h"
 #include "impeller/renderer/backend/gles/unique_handle_gles.h"
 #include "impeller/renderer/pipeline_library.h"
@@ -91,8 +93,10 @@ class PipelineLibraryGLES final
   PipelineMap pipelines_;
   Mutex programs_mutex_;
   ProgramMap programs_ IPLR_GUARDED_BY(programs_mutex_);
+  std::shared_ptr<ProgramBinaryCacheGLES> program_binary_cache_;
 
-  explicit PipelineLibraryGLES(std::shared_ptr<ReactorGLES> reactor);
+  PipelineLibraryGLES(std::shared_ptr<ReactorGLES> reactor,
+                      const fml::UniqueFD& cache_directory);
 
   // |PipelineLibrary|
   bool IsValid() const override;
@@ -115,6 +119,12 @@ class PipelineLibraryGLES final
 
   const std::shared_ptr<ReactorGLES>& GetReactor() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The on-disk cache of linked programs, or null if the context
+  ///             was created without a cache directory.
+  ///
+  const std::shared_ptr<ProgramBinaryCacheGLES>& GetProgramBinaryCache() const;
+
   static std::shared_ptr<PipelineGLES> CreatePipeline(
       const std::weak_ptr<PipelineLibrary>& weak_library,
       const PipelineDescriptor& desc,
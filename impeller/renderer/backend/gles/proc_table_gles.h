@@ -247,7 +247,10 @@ void(glDepthRange)(GLdouble n, GLdouble f);
   PROC(UniformBlockBinding);               \
   PROC(BindBufferRange);                   \
   PROC(WaitSync);                          \
-  PROC(BlitFramebuffer);
+  PROC(BlitFramebuffer);                   \
+  PROC(GetProgramBinary);                  \
+  PROC(ProgramBinary);                     \
+  PROC(ProgramParameteri);
 
 #define FOR_EACH_IMPELLER_EXT_PROC(PROC)    \
   PROC(DebugMessageControlKHR);             \
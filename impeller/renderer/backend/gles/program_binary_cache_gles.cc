@@ -0,0 +1,256 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/gles/program_binary_cache_gles.h"
+
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/base/persistence.h"
+#include "impeller/base/validation.h"
+#include "impeller/renderer/backend/gles/description_gles.h"
+#include "impeller/renderer/backend/gles/proc_table_gles.h"
+
+namespace impeller {
+
+static constexpr const char* kProgramBinaryCacheDirectoryName =
+    "flutter.impeller.glcache";
+
+static constexpr const char* kProgramBinaryFileExtension = ".glprogram";
+
+// Binaries are only ever added as programs are linked, and shader changes in
+// application updates leave the binaries of the old programs behind. Past
+// this size the whole cache is discarded and rebuilt as programs are linked.
+static constexpr size_t kMaxProgramBinaryCacheSize = 32u * 1024u * 1024u;
+
+// The hashes name files that must be found again by the next launch of the
+// application.
+static uint64_t HashMapping(uint64_t hash, const fml::Mapping& mapping) {
+  const uint64_t size = mapping.GetSize();
+  hash = PersistentHash(&size, sizeof(size), hash);
+  if (mapping.GetMapping() == nullptr) {
+    return hash;
+  }
+  return PersistentHash(mapping.GetMapping(), mapping.GetSize(), hash);
+}
+
+static uint64_t ComputeDriverHash(const ProcTableGLES& gl) {
+  const DescriptionGLES* description = gl.GetDescription();
+  if (!description || !description->IsValid()) {
+    return 0u;
+  }
+  const std::string driver = description->GetString();
+  return PersistentHash(driver.data(), driver.size());
+}
+
+bool ProgramBinaryHeaderGLES::IsCompatibleWith(
+    const ProgramBinaryHeaderGLES& o) const {
+  // Check for everything but the binary format and size.
+  return magic == o.magic &&              //
+         abi == o.abi &&                  //
+         driver_hash == o.driver_hash &&  //
+         program_hash == o.program_hash;
+}
+
+ProgramBinaryCacheGLES::ProgramBinaryCacheGLES(
+    const ProcTableGLES& gl,
+    const fml::UniqueFD& cache_directory) {
+  if (!cache_directory.is_valid()) {
+    return;
+  }
+  if (!gl.GetProgramBinary.IsAvailable() || !gl.ProgramBinary.IsAvailable() ||
+      !gl.ProgramParameteri.IsAvailable()) {
+    return;
+  }
+  driver_hash_ = ComputeDriverHash(gl);
+  if (driver_hash_ == 0u) {
+    return;
+  }
+  directory_ =
+      fml::CreateDirectory(cache_directory, {kProgramBinaryCacheDirectoryName},
+                           fml::FilePermission::kReadWrite);
+  if (!directory_.is_valid()) {
+    FML_LOG(WARNING) << "Could not create the program binary cache directory.";
+    return;
+  }
+  is_valid_ = true;
+  RemoveStalePrograms();
+}
+
+ProgramBinaryCacheGLES::~ProgramBinaryCacheGLES() = default;
+
+bool ProgramBinaryCacheGLES::IsValid() const {
+  return is_valid_;
+}
+
+// static
+uint64_t ProgramBinaryCacheGLES::ComputeProgramHash(
+    const fml::Mapping& vertex_source,
+    const fml::Mapping& fragment_source,
+    const std::vector<Scalar>& specialization_constants) {
+  uint64_t hash = kPersistentHashSeed;
+  hash = HashMapping(hash, vertex_source);
+  hash = HashMapping(hash, fragment_source);
+  for (Scalar constant : specialization_constants) {
+    hash = PersistentHash(&constant, sizeof(constant), hash);
+  }
+  return hash;
+}
+
+// static
+std::string ProgramBinaryCacheGLES::GetFileName(uint64_t program_hash) {
+  std::stringstream stream;
+  stream << std::hex << std::setw(16) << std::setfill('0') << program_hash
+         << kProgramBinaryFileExtension;
+  return stream.str();
+}
+
+bool ProgramBinaryCacheGLES::LoadProgram(const ProcTableGLES& gl,
+                                         GLuint program,
+                                         uint64_t program_hash) const {
+  if (!is_valid_) {
+    return false;
+  }
+  TRACE_EVENT0("impeller", "LoadProgramBinary");
+  const std::string file_name = GetFileName(program_hash);
+  std::shared_ptr<fml::FileMapping> on_disk_data =
+      fml::FileMapping::CreateReadOnly(directory_, file_name);
+  if (!on_disk_data) {
+    return false;
+  }
+  ProgramBinaryHeaderGLES on_disk_header;
+  if (on_disk_data->GetSize() < sizeof(on_disk_header)) {
+    RemoveProgram(program_hash);
+    return false;
+  }
+  std::memcpy(&on_disk_header, on_disk_data->GetMapping(),
+              sizeof(on_disk_header));
+  ProgramBinaryHeaderGLES current_header;
+  current_header.driver_hash = driver_hash_;
+  current_header.program_hash = program_hash;
+  if (!on_disk_header.IsCompatibleWith(current_header) ||
+      on_disk_header.data_size == 0u ||
+      on_disk_header.data_size !=
+          on_disk_data->GetSize() - sizeof(on_disk_header)) {
+    FML_DLOG(INFO) << "Persisted program binary is not compatible with the "
+                      "current OpenGL context. Discarding it.";
+    RemoveProgram(program_hash);
+    return false;
+  }
+
+  gl.ProgramBinary(program, on_disk_header.format,
+                   on_disk_data->GetMapping() + sizeof(on_disk_header),
+                   static_cast<GLsizei>(on_disk_header.data_size));
+
+  // Drivers are allowed to reject any binary, for instance after a driver
+  // update that did not change the version strings.
+  GLint link_status = GL_FALSE;
+  gl.GetProgramiv(program, GL_LINK_STATUS, &link_status);
+  if (link_status != GL_TRUE) {
+    FML_DLOG(INFO) << "The driver rejected a persisted program binary. "
+                      "Discarding it.";
+    RemoveProgram(program_hash);
+    return false;
+  }
+  return true;
+}
+
+bool ProgramBinaryCacheGLES::StoreProgram(const ProcTableGLES& gl,
+                                          GLuint program,
+                                          uint64_t program_hash) const {
+  if (!is_valid_) {
+    return false;
+  }
+  TRACE_EVENT0("impeller", "StoreProgramBinary");
+  GLint binary_length = 0;
+  gl.GetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binary_length);
+  // Drivers that support no binary formats report a length of zero.
+  if (binary_length <= 0) {
+    return false;
+  }
+
+  ProgramBinaryHeaderGLES header;
+  header.driver_hash = driver_hash_;
+  header.program_hash = program_hash;
+
+  std::vector<uint8_t> data(sizeof(header) + binary_length);
+  GLsizei written_length = 0;
+  GLenum format = GL_NONE;
+  gl.GetProgramBinary(program, binary_length, &written_length, &format,
+                      data.data() + sizeof(header));
+  if (written_length <= 0) {
+    VALIDATION_LOG << "Could not fetch the program binary.";
+    return false;
+  }
+  header.format = format;
+  header.data_size = static_cast<uint64_t>(written_length);
+  std::memcpy(data.data(), &header, sizeof(header));
+  data.resize(sizeof(header) + written_length);
+
+  if (!fml::WriteAtomically(directory_, GetFileName(program_hash).c_str(),
+                            fml::DataMapping(std::move(data)))) {
+    VALIDATION_LOG << "Could not write the program binary to disk.";
+    return false;
+  }
+  return true;
+}
+
+void ProgramBinaryCacheGLES::RemoveProgram(uint64_t program_hash) const {
+  fml::UnlinkFile(directory_, GetFileName(program_hash).c_str());
+}
+
+void ProgramBinaryCacheGLES::RemoveStalePrograms() const {
+  TRACE_EVENT0("impeller", "RemoveStaleProgramBinaries");
+  ProgramBinaryHeaderGLES current_header;
+  current_header.driver_hash = driver_hash_;
+
+  std::vector<std::string> stale_files;
+  std::vector<std::string> current_files;
+  size_t current_size = 0u;
+  fml::VisitFiles(directory_, [&](const fml::UniqueFD& directory,
+                                  const std::string& file_name) {
+    const size_t extension_length = strlen(kProgramBinaryFileExtension);
+    if (file_name.size() < extension_length ||
+        file_name.compare(file_name.size() - extension_length,
+                          extension_length, kProgramBinaryFileExtension) != 0) {
+      return true;
+    }
+    auto mapping = fml::FileMapping::CreateReadOnly(directory, file_name);
+    ProgramBinaryHeaderGLES header;
+    if (!mapping || mapping->GetSize() < sizeof(header)) {
+      stale_files.push_back(file_name);
+      return true;
+    }
+    std::memcpy(&header, mapping->GetMapping(), sizeof(header));
+    // Binaries from other drivers, such as those left behind by a driver
+    // update, are never loaded again.
+    if (header.magic != current_header.magic ||
+        header.abi != current_header.abi ||
+        header.driver_hash != current_header.driver_hash) {
+      stale_files.push_back(file_name);
+      return true;
+    }
+    current_files.push_back(file_name);
+    current_size += mapping->GetSize();
+    return true;
+  });
+
+  if (current_size > kMaxProgramBinaryCacheSize) {
+    stale_files.insert(stale_files.end(), current_files.begin(),
+                       current_files.end());
+  }
+  if (!stale_files.empty()) {
+    FML_LOG(INFO) << "Discarding " << stale_files.size()
+                  << " stale program binaries.";
+  }
+  for (const auto& file_name : stale_files) {
+    fml::UnlinkFile(directory_, file_name.c_str());
+  }
+}
+
+}  // namespace impeller
@@ -0,0 +1,132 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_PROGRAM_BINARY_CACHE_GLES_H_
+#define FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_PROGRAM_BINARY_CACHE_GLES_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+#include "impeller/geometry/scalar.h"
+#include "impeller/renderer/backend/gles/gles.h"
+
+namespace impeller {
+
+class ProcTableGLES;
+
+//------------------------------------------------------------------------------
+/// @brief      An Impeller specific header prepended to every program binary
+///             that is persisted on disk. Drivers are supposed to reject
+///             binaries they cannot load, but these checks avoid handing them
+///             binaries from other drivers or from other programs in the first
+///             place.
+///
+struct ProgramBinaryHeaderGLES {
+  // This can be used by Impeller to manually invalidate all old binaries.
+  uint32_t magic = 0xC0DEB1A5;
+  // If applications are published as 32-bit and updated via the app store to be
+  // 64-bits, this check comes in handy to disregard previous binaries.
+  uint32_t abi = sizeof(void*);
+  // A hash of the vendor, renderer and version strings of the driver.
+  uint64_t driver_hash = 0;
+  // A hash of the shader sources and the defines they were compiled with.
+  uint64_t program_hash = 0;
+  // The driver specific binary format returned by |glGetProgramBinary|.
+  uint32_t format = 0;
+  uint32_t padding = 0;
+  uint64_t data_size = 0;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Determines whether a persisted binary with the other header
+  ///             may be loaded in place of the program described by this one.
+  ///
+  ///             The format and size of the data following the header are not
+  ///             part of compatibility checks.
+  ///
+  bool IsCompatibleWith(const ProgramBinaryHeaderGLES& other) const;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Persists linked program binaries in a cache directory so that
+///             programs don't have to be compiled and linked again on the
+///             next launch.
+///
+///             Binaries are stored one file per program, keyed by a hash of
+///             the shader sources and the specialization constants they are
+///             compiled with. Binaries from a different driver, and binaries
+///             the driver fails to load, are deleted and replaced by the
+///             binary of the freshly linked program. Binaries from other
+///             drivers are also deleted when the cache is opened, and the
+///             whole cache is discarded if it grows past a size limit.
+///
+///             Program binaries are only available on OpenGL ES 3.0 and later.
+///             The cache is invalid on other devices, or if there is no cache
+///             directory, and should not be used.
+///
+class ProgramBinaryCacheGLES {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a cache in a subdirectory of the cache directory.
+  ///
+  ProgramBinaryCacheGLES(const ProcTableGLES& gl,
+                         const fml::UniqueFD& cache_directory);
+
+  ~ProgramBinaryCacheGLES();
+
+  bool IsValid() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Computes the key of the program linked from the given shader
+  ///             sources. The hash is stable across launches.
+  ///
+  static uint64_t ComputeProgramHash(
+      const fml::Mapping& vertex_source,
+      const fml::Mapping& fragment_source,
+      const std::vector<Scalar>& specialization_constants);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Loads the persisted binary of a program into the given
+  ///             program object.
+  ///
+  ///             A binary that cannot be loaded is deleted.
+  ///
+  /// @return     Whether the program object was successfully linked from the
+  ///             persisted binary. If not, the program must be compiled and
+  ///             linked from source.
+  ///
+  bool LoadProgram(const ProcTableGLES& gl,
+                   GLuint program,
+                   uint64_t program_hash) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Persists the binary of a successfully linked program.
+  ///
+  /// @return     If the binary could be persisted to disk.
+  ///
+  bool StoreProgram(const ProcTableGLES& gl,
+                    GLuint program,
+                    uint64_t program_hash) const;
+
+ private:
+  fml::UniqueFD directory_;
+  uint64_t driver_hash_ = 0;
+  bool is_valid_ = false;
+
+  static std::string GetFileName(uint64_t program_hash);
+
+  void RemoveProgram(uint64_t program_hash) const;
+
+  void RemoveStalePrograms() const;
+
+  ProgramBinaryCacheGLES(const ProgramBinaryCacheGLES&) = delete;
+
+  ProgramBinaryCacheGLES& operator=(const ProgramBinaryCacheGLES&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_PROGRAM_BINARY_CACHE_GLES_H_
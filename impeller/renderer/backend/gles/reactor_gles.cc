@@ -124,6 +124,16 @@ const ProcTableGLES& ReactorGLES::GetProcTable() const {
   return *proc_table_;
 }
 
+StateCacheGLES& ReactorGLES::GetStateCache() const {
+  Lock lock(state_caches_mutex_);
+  std::unique_ptr<StateCacheGLES>& cache =
+      state_caches_[std::this_thread::get_id()];
+  if (!cache) {
+    cache = std::make_unique<StateCacheGLES>();
+  }
+  return *cache;
+}
+
 std::optional<ReactorGLES::GLStorage> ReactorGLES::GetHandle(
     const HandleGLES& handle) const {
   if (handle.untracked_id_.has_value()) {
@@ -365,6 +375,8 @@ bool ReactorGLES::FlushOps() {
     Lock ops_lock(ops_mutex_);
     std::swap(ops_[thread_id], ops);
   }
+  // Calls made outside of reactions may have changed any state.
+  GetStateCache().Invalidate();
   for (const auto& op : ops) {
     TRACE_EVENT0("impeller", "ReactorGLES::Operation");
     op(*this);
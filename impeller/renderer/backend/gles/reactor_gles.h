@@ -6,7 +6,9 @@
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_REACTOR_GLES_H_
 
 #include <functional>
+#include <map>
 #include <memory>
+#include <thread>
 #include <vector>
 
 #include "flutter/third_party/abseil-cpp/absl/container/flat_hash_map.h"
@@ -14,6 +16,7 @@
 #include "impeller/base/thread.h"
 #include "impeller/renderer/backend/gles/handle_gles.h"
 #include "impeller/renderer/backend/gles/proc_table_gles.h"
+#include "impeller/renderer/backend/gles/state_cache_gles.h"
 
 namespace impeller {
 
@@ -138,6 +141,23 @@ class ReactorGLES {
   ///
   const ProcTableGLES& GetProcTable() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Get the cache of the OpenGL state of the context current on
+  ///             the calling thread. State set through the cache is only sent
+  ///             to the driver if it differs from the last state set.
+  ///
+  ///             The cache is invalidated at the start of every reaction, so
+  ///             it only elides calls within a reaction. Operations that
+  ///             modify cached state without going through the cache must
+  ///             invalidate it.
+  ///
+  ///             This is only safe to call within a reaction. That is, within
+  ///             a `ReactorGLES::Operation`.
+  ///
+  /// @return     The state cache of the calling thread.
+  ///
+  StateCacheGLES& GetStateCache() const;
+
   //----------------------------------------------------------------------------
   /// @brief      Returns the OpenGL handle for a reactor handle if one is
   ///             available. This is typically only safe to call within a
@@ -295,6 +315,12 @@ class ReactorGLES {
   LiveHandles handles_ IPLR_GUARDED_BY(handles_mutex_);
   int32_t handles_to_collect_count_ IPLR_GUARDED_BY(handles_mutex_) = 0;
 
+  // OpenGL state is per context, and each thread that reacts has a context of
+  // its own current.
+  mutable Mutex state_caches_mutex_;
+  mutable std::map<std::thread::id, std::unique_ptr<StateCacheGLES>>
+      state_caches_ IPLR_GUARDED_BY(state_caches_mutex_);
+
   mutable Mutex workers_mutex_;
   mutable std::map<WorkerID, std::weak_ptr<Worker>> workers_ IPLR_GUARDED_BY(
       workers_mutex_);
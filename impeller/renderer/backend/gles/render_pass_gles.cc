@@ -44,21 +44,24 @@ void RenderPassGLES::OnSetLabel(std::string_view label) {
 }
 
 void ConfigureBlending(const ProcTableGLES& gl,
+                       StateCacheGLES& state,
                        const ColorAttachmentDescriptor* color) {
   if (color->blending_enabled) {
-    gl.Enable(GL_BLEND);
-    gl.BlendFuncSeparate(
+    state.Enable(gl, GL_BLEND);
+    state.BlendFuncSeparate(
+        gl,                                            //
         ToBlendFactor(color->src_color_blend_factor),  // src color
         ToBlendFactor(color->dst_color_blend_factor),  // dst color
         ToBlendFactor(color->src_alpha_blend_factor),  // src alpha
         ToBlendFactor(color->dst_alpha_blend_factor)   // dst alpha
     );
-    gl.BlendEquationSeparate(
+    state.BlendEquationSeparate(
+        gl,                                       //
         ToBlendOperation(color->color_blend_op),  // mode color
         ToBlendOperation(color->alpha_blend_op)   // mode alpha
     );
   } else {
-    gl.Disable(GL_BLEND);
+    state.Disable(gl, GL_BLEND);
   }
 
   {
@@ -67,7 +70,8 @@ void ConfigureBlending(const ProcTableGLES& gl,
       return (mask & check) ? GL_TRUE : GL_FALSE;
     };
 
-    gl.ColorMask(
+    state.ColorMask(
+        gl,                                                     //
         is_set(color->write_mask, ColorWriteMaskBits::kRed),    // red
         is_set(color->write_mask, ColorWriteMaskBits::kGreen),  // green
         is_set(color->write_mask, ColorWriteMaskBits::kBlue),   // blue
@@ -78,43 +82,48 @@ void ConfigureBlending(const ProcTableGLES& gl,
 
 void ConfigureStencil(GLenum face,
                       const ProcTableGLES& gl,
+                      StateCacheGLES& state,
                       const StencilAttachmentDescriptor& stencil,
                       uint32_t stencil_reference) {
-  gl.StencilOpSeparate(
+  state.StencilOpSeparate(
+      gl,                                      //
       face,                                    // face
       ToStencilOp(stencil.stencil_failure),    // stencil fail
       ToStencilOp(stencil.depth_failure),      // depth fail
       ToStencilOp(stencil.depth_stencil_pass)  // depth stencil pass
   );
-  gl.StencilFuncSeparate(face,                                        // face
-                         ToCompareFunction(stencil.stencil_compare),  // func
-                         stencil_reference,                           // ref
-                         stencil.read_mask                            // mask
+  state.StencilFuncSeparate(
+      gl,                                          //
+      face,                                        // face
+      ToCompareFunction(stencil.stencil_compare),  // func
+      stencil_reference,                           // ref
+      stencil.read_mask                            // mask
   );
-  gl.StencilMaskSeparate(face, stencil.write_mask);
+  state.StencilMaskSeparate(gl, face, stencil.write_mask);
 }
 
 void ConfigureStencil(const ProcTableGLES& gl,
+                      StateCacheGLES& state,
                       const PipelineDescriptor& pipeline,
                       uint32_t stencil_reference) {
   if (!pipeline.HasStencilAttachmentDescriptors()) {
-    gl.Disable(GL_STENCIL_TEST);
+    state.Disable(gl, GL_STENCIL_TEST);
     return;
   }
 
-  gl.Enable(GL_STENCIL_TEST);
+  state.Enable(gl, GL_STENCIL_TEST);
   const auto& front = pipeline.GetFrontStencilAttachmentDescriptor();
   const auto& back = pipeline.GetBackStencilAttachmentDescriptor();
 
   if (front.has_value() && back.has_value() && front == back) {
-    ConfigureStencil(GL_FRONT_AND_BACK, gl, *front, stencil_reference);
+    ConfigureStencil(GL_FRONT_AND_BACK, gl, state, *front, stencil_reference);
     return;
   }
   if (front.has_value()) {
-    ConfigureStencil(GL_FRONT, gl, *front, stencil_reference);
+    ConfigureStencil(GL_FRONT, gl, state, *front, stencil_reference);
   }
   if (back.has_value()) {
-    ConfigureStencil(GL_BACK, gl, *back, stencil_reference);
+    ConfigureStencil(GL_BACK, gl, state, *back, stencil_reference);
   }
 }
 
@@ -175,17 +184,18 @@ static bool BindVertexBuffer(const ProcTableGLES& gl,
   return true;
 }
 
-void RenderPassGLES::ResetGLState(const ProcTableGLES& gl) {
-  gl.Disable(GL_SCISSOR_TEST);
-  gl.Disable(GL_DEPTH_TEST);
-  gl.Disable(GL_STENCIL_TEST);
-  gl.Disable(GL_CULL_FACE);
-  gl.Disable(GL_BLEND);
-  gl.Disable(GL_DITHER);
-  gl.ColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
-  gl.DepthMask(GL_TRUE);
-  gl.StencilMaskSeparate(GL_FRONT, 0xFFFFFFFF);
-  gl.StencilMaskSeparate(GL_BACK, 0xFFFFFFFF);
+void RenderPassGLES::ResetGLState(const ProcTableGLES& gl,
+                                  StateCacheGLES& state) {
+  state.Disable(gl, GL_SCISSOR_TEST);
+  state.Disable(gl, GL_DEPTH_TEST);
+  state.Disable(gl, GL_STENCIL_TEST);
+  state.Disable(gl, GL_CULL_FACE);
+  state.Disable(gl, GL_BLEND);
+  state.Disable(gl, GL_DITHER);
+  state.ColorMask(gl, GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+  state.DepthMask(gl, GL_TRUE);
+  state.StencilMaskSeparate(gl, GL_FRONT, 0xFFFFFFFF);
+  state.StencilMaskSeparate(gl, GL_BACK, 0xFFFFFFFF);
 }
 
 [[nodiscard]] bool EncodeCommandsInReactor(
@@ -199,6 +209,7 @@ void RenderPassGLES::ResetGLState(const ProcTableGLES& gl) {
   TRACE_EVENT0("impeller", "RenderPassGLES::EncodeCommandsInReactor");
 
   const auto& gl = reactor.GetProcTable();
+  StateCacheGLES& state = reactor.GetStateCache();
 #ifdef IMPELLER_DEBUG
   tracer->MarkFrameStart(gl);
 
@@ -286,7 +297,7 @@ void RenderPassGLES::ResetGLState(const ProcTableGLES& gl) {
     clear_bits |= GL_STENCIL_BUFFER_BIT;
   }
 
-  RenderPassGLES::ResetGLState(gl);
+  RenderPassGLES::ResetGLState(gl, state);
 
   gl.Clear(clear_bits);
 
@@ -299,11 +310,12 @@ void RenderPassGLES::ResetGLState(const ProcTableGLES& gl) {
   /// Setup the viewport.
   ///
   const auto& viewport = pass_data.viewport;
-  gl.Viewport(viewport.rect.GetX(),  // x
-              target_size.height - viewport.rect.GetY() -
-                  viewport.rect.GetHeight(),  // y
-              viewport.rect.GetWidth(),       // width
-              viewport.rect.GetHeight()       // height
+  state.Viewport(gl,                    //
+                 viewport.rect.GetX(),  // x
+                 target_size.height - viewport.rect.GetY() -
+                     viewport.rect.GetHeight(),  // y
+                 viewport.rect.GetWidth(),       // width
+                 viewport.rect.GetHeight()       // height
   );
   if (pass_data.depth_attachment) {
     if (gl.DepthRangef.IsAvailable()) {
@@ -313,10 +325,6 @@ void RenderPassGLES::ResetGLState(const ProcTableGLES& gl) {
     }
   }
 
-  CullMode current_cull_mode = CullMode::kNone;
-  WindingOrder current_winding_order = WindingOrder::kClockwise;
-  gl.FrontFace(GL_CW);
-
   for (const auto& command : commands) {
 #ifdef IMPELLER_DEBUG
     fml::ScopedCleanupClosure pop_cmd_debug_marker(
@@ -341,12 +349,13 @@ void RenderPassGLES::ResetGLState(const ProcTableGLES& gl) {
     //--------------------------------------------------------------------------
     /// Configure blending.
     ///
-    ConfigureBlending(gl, color_attachment);
+    ConfigureBlending(gl, state, color_attachment);
 
     //--------------------------------------------------------------------------
     /// Setup stencil.
     ///
-    ConfigureStencil(gl, pipeline.GetDescriptor(), command.stencil_reference);
+    ConfigureStencil(gl, state, pipeline.GetDescriptor(),
+                     command.stencil_reference);
 
     //--------------------------------------------------------------------------
     /// Configure depth.
@@ -354,22 +363,23 @@ void RenderPassGLES::ResetGLState(const ProcTableGLES& gl) {
     if (auto depth =
             pipeline.GetDescriptor().GetDepthStencilAttachmentDescriptor();
         depth.has_value()) {
-      gl.Enable(GL_DEPTH_TEST);
-      gl.DepthFunc(ToCompareFunction(depth->depth_compare));
-      gl.DepthMask(depth->depth_write_enabled ? GL_TRUE : GL_FALSE);
+      state.Enable(gl, GL_DEPTH_TEST);
+      state.DepthFunc(gl, ToCompareFunction(depth->depth_compare));
+      state.DepthMask(gl, depth->depth_write_enabled ? GL_TRUE : GL_FALSE);
     } else {
-      gl.Disable(GL_DEPTH_TEST);
+      state.Disable(gl, GL_DEPTH_TEST);
     }
 
     //--------------------------------------------------------------------------
     /// Setup the viewport.
     ///
     if (command.viewport.has_value()) {
-      gl.Viewport(viewport.rect.GetX(),  // x
-                  target_size.height - viewport.rect.GetY() -
-                      viewport.rect.GetHeight(),  // y
-                  viewport.rect.GetWidth(),       // width
-                  viewport.rect.GetHeight()       // height
+      state.Viewport(gl,                    //
+                     viewport.rect.GetX(),  // x
+                     target_size.height - viewport.rect.GetY() -
+                         viewport.rect.GetHeight(),  // y
+                     viewport.rect.GetWidth(),       // width
+                     viewport.rect.GetHeight()       // height
       );
       if (pass_data.depth_attachment) {
         if (gl.DepthRangef.IsAvailable()) {
@@ -387,8 +397,9 @@ void RenderPassGLES::ResetGLState(const ProcTableGLES& gl) {
     ///
     if (command.scissor.has_value()) {
       const auto& scissor = command.scissor.value();
-      gl.Enable(GL_SCISSOR_TEST);
-      gl.Scissor(
+      state.Enable(gl, GL_SCISSOR_TEST);
+      state.Scissor(
+          gl,                                                         //
           scissor.GetX(),                                             // x
           target_size.height - scissor.GetY() - scissor.GetHeight(),  // y
           scissor.GetWidth(),                                         // width
@@ -399,39 +410,30 @@ void RenderPassGLES::ResetGLState(const ProcTableGLES& gl) {
     //--------------------------------------------------------------------------
     /// Setup culling.
     ///
-    CullMode pipeline_cull_mode = pipeline.GetDescriptor().GetCullMode();
-    if (current_cull_mode != pipeline_cull_mode) {
-      switch (pipeline_cull_mode) {
-        case CullMode::kNone:
-          gl.Disable(GL_CULL_FACE);
-          break;
-        case CullMode::kFrontFace:
-          gl.Enable(GL_CULL_FACE);
-          gl.CullFace(GL_FRONT);
-          break;
-        case CullMode::kBackFace:
-          gl.Enable(GL_CULL_FACE);
-          gl.CullFace(GL_BACK);
-          break;
-      }
-      current_cull_mode = pipeline_cull_mode;
+    switch (pipeline.GetDescriptor().GetCullMode()) {
+      case CullMode::kNone:
+        state.Disable(gl, GL_CULL_FACE);
+        break;
+      case CullMode::kFrontFace:
+        state.Enable(gl, GL_CULL_FACE);
+        state.CullFace(gl, GL_FRONT);
+        break;
+      case CullMode::kBackFace:
+        state.Enable(gl, GL_CULL_FACE);
+        state.CullFace(gl, GL_BACK);
+        break;
     }
 
     //--------------------------------------------------------------------------
     /// Setup winding order.
     ///
-    WindingOrder pipeline_winding_order =
-        pipeline.GetDescriptor().GetWindingOrder();
-    if (current_winding_order != pipeline_winding_order) {
-      switch (pipeline.GetDescriptor().GetWindingOrder()) {
-        case WindingOrder::kClockwise:
-          gl.FrontFace(GL_CW);
-          break;
-        case WindingOrder::kCounterClockwise:
-          gl.FrontFace(GL_CCW);
-          break;
-      }
-      current_winding_order = pipeline_winding_order;
+    switch (pipeline.GetDescriptor().GetWindingOrder()) {
+      case WindingOrder::kClockwise:
+        state.FrontFace(gl, GL_CW);
+        break;
+      case WindingOrder::kCounterClockwise:
+        state.FrontFace(gl, GL_CCW);
+        break;
     }
 
     BufferBindingsGLES* vertex_desc_gles = pipeline.GetBufferBindings();
@@ -454,7 +456,7 @@ void RenderPassGLES::ResetGLState(const ProcTableGLES& gl) {
     //--------------------------------------------------------------------------
     /// Bind the pipeline program.
     ///
-    if (!pipeline.BindProgram()) {
+    if (!pipeline.BindProgram(state)) {
       return false;
     }
 
@@ -548,6 +550,12 @@ void RenderPassGLES::ResetGLState(const ProcTableGLES& gl) {
   }
 #endif  // IMPELLER_DEBUG
 
+  FML_TRACE_COUNTER("impeller", "StateCacheGLES",
+                    reinterpret_cast<int64_t>(&state),  // Trace Counter ID
+                    "IssuedCalls", state.GetIssuedCallCount(),  //
+                    "ElidedCalls", state.GetElidedCallCount()   //
+  );
+
   return true;
 }
 
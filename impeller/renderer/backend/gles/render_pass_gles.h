@@ -8,6 +8,7 @@
 #include <memory>
 
 #include "flutter/impeller/renderer/backend/gles/reactor_gles.h"
+#include "flutter/impeller/renderer/backend/gles/state_cache_gles.h"
 #include "flutter/impeller/renderer/render_pass.h"
 
 namespace impeller {
@@ -19,7 +20,12 @@ class RenderPassGLES final
   // |RenderPass|
   ~RenderPassGLES() override;
 
-  static void ResetGLState(const ProcTableGLES& gl);
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the state that render passes expect to find at their
+  ///             start. Calls that would not change the state in |state| are
+  ///             elided.
+  ///
+  static void ResetGLState(const ProcTableGLES& gl, StateCacheGLES& state);
 
  private:
   friend class CommandBufferGLES;
@@ -0,0 +1,244 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/gles/state_cache_gles.h"
+
+#include "impeller/renderer/backend/gles/proc_table_gles.h"
+
+namespace impeller {
+
+StateCacheGLES::StateCacheGLES() = default;
+
+StateCacheGLES::~StateCacheGLES() = default;
+
+void StateCacheGLES::Invalidate() {
+  capabilities_.fill(std::nullopt);
+  blend_func_.reset();
+  blend_equation_.reset();
+  color_mask_.reset();
+  stencil_front_ = {};
+  stencil_back_ = {};
+  depth_func_.reset();
+  depth_mask_.reset();
+  viewport_.reset();
+  scissor_.reset();
+  cull_face_.reset();
+  front_face_.reset();
+  program_.reset();
+  array_buffer_.reset();
+}
+
+template <class T>
+bool StateCacheGLES::Update(std::optional<T>& shadow, const T& value) {
+  if (shadow.has_value() && shadow.value() == value) {
+    elided_call_count_++;
+    return false;
+  }
+  shadow = value;
+  issued_call_count_++;
+  return true;
+}
+
+template <class T>
+bool StateCacheGLES::UpdateStencilFace(
+    GLenum face,
+    std::optional<T> StencilFaceState::*member,
+    const T& value) {
+  const bool front = face == GL_FRONT || face == GL_FRONT_AND_BACK;
+  const bool back = face == GL_BACK || face == GL_FRONT_AND_BACK;
+  auto matches = [member, &value](const StencilFaceState& state) {
+    const std::optional<T>& shadow = state.*member;
+    return shadow.has_value() && shadow.value() == value;
+  };
+  if ((!front || matches(stencil_front_)) &&
+      (!back || matches(stencil_back_))) {
+    elided_call_count_++;
+    return false;
+  }
+  if (front) {
+    stencil_front_.*member = value;
+  }
+  if (back) {
+    stencil_back_.*member = value;
+  }
+  issued_call_count_++;
+  return true;
+}
+
+// static
+std::optional<StateCacheGLES::Capability> StateCacheGLES::ToCapability(
+    GLenum capability) {
+  switch (capability) {
+    case GL_BLEND:
+      return Capability::kBlend;
+    case GL_CULL_FACE:
+      return Capability::kCullFace;
+    case GL_DEPTH_TEST:
+      return Capability::kDepthTest;
+    case GL_DITHER:
+      return Capability::kDither;
+    case GL_SCISSOR_TEST:
+      return Capability::kScissorTest;
+    case GL_STENCIL_TEST:
+      return Capability::kStencilTest;
+  }
+  return std::nullopt;
+}
+
+void StateCacheGLES::SetCapability(const ProcTableGLES& gl,
+                                   GLenum capability,
+                                   bool enabled) {
+  std::optional<Capability> index = ToCapability(capability);
+  if (index.has_value()) {
+    if (!Update(capabilities_[static_cast<size_t>(index.value())], enabled)) {
+      return;
+    }
+  } else {
+    issued_call_count_++;
+  }
+  if (enabled) {
+    gl.Enable(capability);
+  } else {
+    gl.Disable(capability);
+  }
+}
+
+void StateCacheGLES::Enable(const ProcTableGLES& gl, GLenum capability) {
+  SetCapability(gl, capability, true);
+}
+
+void StateCacheGLES::Disable(const ProcTableGLES& gl, GLenum capability) {
+  SetCapability(gl, capability, false);
+}
+
+void StateCacheGLES::BlendFuncSeparate(const ProcTableGLES& gl,
+                                       GLenum src_rgb,
+                                       GLenum dst_rgb,
+                                       GLenum src_alpha,
+                                       GLenum dst_alpha) {
+  if (Update(blend_func_, {src_rgb, dst_rgb, src_alpha, dst_alpha})) {
+    gl.BlendFuncSeparate(src_rgb, dst_rgb, src_alpha, dst_alpha);
+  }
+}
+
+void StateCacheGLES::BlendEquationSeparate(const ProcTableGLES& gl,
+                                           GLenum mode_rgb,
+                                           GLenum mode_alpha) {
+  if (Update(blend_equation_, {mode_rgb, mode_alpha})) {
+    gl.BlendEquationSeparate(mode_rgb, mode_alpha);
+  }
+}
+
+void StateCacheGLES::ColorMask(const ProcTableGLES& gl,
+                               GLboolean red,
+                               GLboolean green,
+                               GLboolean blue,
+                               GLboolean alpha) {
+  if (Update(color_mask_, {red, green, blue, alpha})) {
+    gl.ColorMask(red, green, blue, alpha);
+  }
+}
+
+void StateCacheGLES::StencilOpSeparate(const ProcTableGLES& gl,
+                                       GLenum face,
+                                       GLenum stencil_fail,
+                                       GLenum depth_fail,
+                                       GLenum depth_pass) {
+  if (UpdateStencilFace(face, &StencilFaceState::op,
+                        {stencil_fail, depth_fail, depth_pass})) {
+    gl.StencilOpSeparate(face, stencil_fail, depth_fail, depth_pass);
+  }
+}
+
+void StateCacheGLES::StencilFuncSeparate(const ProcTableGLES& gl,
+                                         GLenum face,
+                                         GLenum func,
+                                         GLint ref,
+                                         GLuint mask) {
+  if (UpdateStencilFace(face, &StencilFaceState::func,
+                        {func, static_cast<GLuint>(ref), mask})) {
+    gl.StencilFuncSeparate(face, func, ref, mask);
+  }
+}
+
+void StateCacheGLES::StencilMaskSeparate(const ProcTableGLES& gl,
+                                         GLenum face,
+                                         GLuint mask) {
+  if (UpdateStencilFace(face, &StencilFaceState::write_mask, mask)) {
+    gl.StencilMaskSeparate(face, mask);
+  }
+}
+
+void StateCacheGLES::DepthFunc(const ProcTableGLES& gl, GLenum func) {
+  if (Update(depth_func_, func)) {
+    gl.DepthFunc(func);
+  }
+}
+
+void StateCacheGLES::DepthMask(const ProcTableGLES& gl, GLboolean flag) {
+  if (Update(depth_mask_, flag)) {
+    gl.DepthMask(flag);
+  }
+}
+
+void StateCacheGLES::Viewport(const ProcTableGLES& gl,
+                              GLint x,
+                              GLint y,
+                              GLsizei width,
+                              GLsizei height) {
+  if (Update(viewport_, {x, y, width, height})) {
+    gl.Viewport(x, y, width, height);
+  }
+}
+
+void StateCacheGLES::Scissor(const ProcTableGLES& gl,
+                             GLint x,
+                             GLint y,
+                             GLsizei width,
+                             GLsizei height) {
+  if (Update(scissor_, {x, y, width, height})) {
+    gl.Scissor(x, y, width, height);
+  }
+}
+
+void StateCacheGLES::CullFace(const ProcTableGLES& gl, GLenum mode) {
+  if (Update(cull_face_, mode)) {
+    gl.CullFace(mode);
+  }
+}
+
+void StateCacheGLES::FrontFace(const ProcTableGLES& gl, GLenum mode) {
+  if (Update(front_face_, mode)) {
+    gl.FrontFace(mode);
+  }
+}
+
+void StateCacheGLES::UseProgram(const ProcTableGLES& gl, GLuint program) {
+  if (Update(program_, program)) {
+    gl.UseProgram(program);
+  }
+}
+
+void StateCacheGLES::BindBuffer(const ProcTableGLES& gl,
+                                GLenum target,
+                                GLuint buffer) {
+  if (target != GL_ARRAY_BUFFER) {
+    issued_call_count_++;
+    gl.BindBuffer(target, buffer);
+    return;
+  }
+  if (Update(array_buffer_, buffer)) {
+    gl.BindBuffer(target, buffer);
+  }
+}
+
+size_t StateCacheGLES::GetIssuedCallCount() const {
+  return issued_call_count_;
+}
+
+size_t StateCacheGLES::GetElidedCallCount() const {
+  return elided_call_count_;
+}
+
+}  // namespace impeller
@@ -0,0 +1,179 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_STATE_CACHE_GLES_H_
+#define FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_STATE_CACHE_GLES_H_
+
+#include <array>
+#include <cstddef>
+#include <optional>
+
+#include "impeller/renderer/backend/gles/gles.h"
+
+namespace impeller {
+
+class ProcTableGLES;
+
+//------------------------------------------------------------------------------
+/// @brief      A shadow copy of the fixed function and binding state of an
+///             OpenGL context that elides calls which would not change that
+///             state.
+///
+///             Each state starts out unknown, so the first call that sets it
+///             is always issued. The cache must be invalidated whenever code
+///             that does not go through it may have modified the state of the
+///             context. The reactor does this at the start of each reaction.
+///
+///             The cache must only be used on the thread of the context whose
+///             state it shadows.
+///
+class StateCacheGLES {
+ public:
+  StateCacheGLES();
+
+  ~StateCacheGLES();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Forget all shadowed state so that the next call setting each
+  ///             state is issued.
+  ///
+  void Invalidate();
+
+  void Enable(const ProcTableGLES& gl, GLenum capability);
+
+  void Disable(const ProcTableGLES& gl, GLenum capability);
+
+  void BlendFuncSeparate(const ProcTableGLES& gl,
+                         GLenum src_rgb,
+                         GLenum dst_rgb,
+                         GLenum src_alpha,
+                         GLenum dst_alpha);
+
+  void BlendEquationSeparate(const ProcTableGLES& gl,
+                             GLenum mode_rgb,
+                             GLenum mode_alpha);
+
+  void ColorMask(const ProcTableGLES& gl,
+                 GLboolean red,
+                 GLboolean green,
+                 GLboolean blue,
+                 GLboolean alpha);
+
+  void StencilOpSeparate(const ProcTableGLES& gl,
+                         GLenum face,
+                         GLenum stencil_fail,
+                         GLenum depth_fail,
+                         GLenum depth_pass);
+
+  void StencilFuncSeparate(const ProcTableGLES& gl,
+                           GLenum face,
+                           GLenum func,
+                           GLint ref,
+                           GLuint mask);
+
+  void StencilMaskSeparate(const ProcTableGLES& gl, GLenum face, GLuint mask);
+
+  void DepthFunc(const ProcTableGLES& gl, GLenum func);
+
+  void DepthMask(const ProcTableGLES& gl, GLboolean flag);
+
+  void Viewport(const ProcTableGLES& gl,
+                GLint x,
+                GLint y,
+                GLsizei width,
+                GLsizei height);
+
+  void Scissor(const ProcTableGLES& gl,
+               GLint x,
+               GLint y,
+               GLsizei width,
+               GLsizei height);
+
+  void CullFace(const ProcTableGLES& gl, GLenum mode);
+
+  void FrontFace(const ProcTableGLES& gl, GLenum mode);
+
+  void UseProgram(const ProcTableGLES& gl, GLuint program);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Binds a buffer to a target.
+  ///
+  ///             Only `GL_ARRAY_BUFFER` bindings are shadowed. Element array
+  ///             bindings are part of the vertex array object state and
+  ///             uniform buffer bindings are also modified by
+  ///             `glBindBufferRange`, so binds to other targets are always
+  ///             issued.
+  ///
+  void BindBuffer(const ProcTableGLES& gl, GLenum target, GLuint buffer);
+
+  /// The number of calls made through the cache that were issued to the
+  /// driver.
+  size_t GetIssuedCallCount() const;
+
+  /// The number of calls made through the cache that were elided because
+  /// they would not have changed the state of the context.
+  size_t GetElidedCallCount() const;
+
+ private:
+  enum class Capability {
+    kBlend,
+    kCullFace,
+    kDepthTest,
+    kDither,
+    kScissorTest,
+    kStencilTest,
+  };
+  static constexpr size_t kCapabilityCount = 6u;
+
+  struct StencilFaceState {
+    std::optional<std::array<GLenum, 3>> op;
+    std::optional<std::array<GLuint, 3>> func;
+    std::optional<GLuint> write_mask;
+  };
+
+  std::array<std::optional<bool>, kCapabilityCount> capabilities_;
+  std::optional<std::array<GLenum, 4>> blend_func_;
+  std::optional<std::array<GLenum, 2>> blend_equation_;
+  std::optional<std::array<GLboolean, 4>> color_mask_;
+  StencilFaceState stencil_front_;
+  StencilFaceState stencil_back_;
+  std::optional<GLenum> depth_func_;
+  std::optional<GLboolean> depth_mask_;
+  std::optional<std::array<GLint, 4>> viewport_;
+  std::optional<std::array<GLint, 4>> scissor_;
+  std::optional<GLenum> cull_face_;
+  std::optional<GLenum> front_face_;
+  std::optional<GLuint> program_;
+  std::optional<GLuint> array_buffer_;
+  size_t issued_call_count_ = 0u;
+  size_t elided_call_count_ = 0u;
+
+  static std::optional<Capability> ToCapability(GLenum capability);
+
+  void SetCapability(const ProcTableGLES& gl, GLenum capability, bool enabled);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Updates the shadow state and returns true if the call setting
+  ///             it must be issued.
+  ///
+  template <class T>
+  bool Update(std::optional<T>& shadow, const T& value);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Like |Update|, for state that may be set for the front, back
+  ///             or both stencil faces in a single call.
+  ///
+  template <class T>
+  bool UpdateStencilFace(GLenum face,
+                         std::optional<T> StencilFaceState::*member,
+                         const T& value);
+
+  StateCacheGLES(const StateCacheGLES&) = delete;
+
+  StateCacheGLES& operator=(const StateCacheGLES&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_STATE_CACHE_GLES_H_
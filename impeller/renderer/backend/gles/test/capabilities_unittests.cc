@@ -30,6 +30,8 @@ TEST(CapabilitiesGLES, CanInitializeWithDefaults) {
   EXPECT_EQ(capabilities->GetDefaultStencilFormat(), PixelFormat::kS8UInt);
   EXPECT_EQ(capabilities->GetDefaultDepthStencilFormat(),
             PixelFormat::kD24UnormS8Uint);
+  EXPECT_EQ(capabilities->max_uniform_buffer_bindings, 24u);
+  EXPECT_EQ(capabilities->uniform_buffer_offset_alignment, 256u);
 }
 
 TEST(CapabilitiesGLES, SupportsDecalSamplerAddressMode) {
@@ -89,6 +89,12 @@ void mockGetIntegerv(GLenum name, int* value) {
     case GL_MAX_LABEL_LENGTH_KHR:
       *value = 64;
       break;
+    case GL_MAX_UNIFORM_BUFFER_BINDINGS:
+      *value = 24;
+      break;
+    case GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT:
+      *value = 256;
+      break;
     default:
       *value = 0;
       break;
@@ -194,6 +200,103 @@ void mockObjectLabelKHR(GLenum identifier,
 static_assert(CheckSameSignature<decltype(mockObjectLabelKHR),  //
                                  decltype(glObjectLabelKHR)>::value);
 
+void mockGetProgramiv(GLuint program, GLenum pname, GLint* params) {
+  CallMockMethod(&IMockGLESImpl::GetProgramiv, program, pname, params);
+}
+
+static_assert(CheckSameSignature<decltype(mockGetProgramiv),  //
+                                 decltype(glGetProgramiv)>::value);
+
+void mockGetProgramBinary(GLuint program,
+                          GLsizei buf_size,
+                          GLsizei* length,
+                          GLenum* binary_format,
+                          void* binary) {
+  CallMockMethod(&IMockGLESImpl::GetProgramBinary, program, buf_size, length,
+                 binary_format, binary);
+}
+
+static_assert(CheckSameSignature<decltype(mockGetProgramBinary),  //
+                                 decltype(glGetProgramBinary)>::value);
+
+void mockProgramBinary(GLuint program,
+                       GLenum binary_format,
+                       const void* binary,
+                       GLsizei length) {
+  CallMockMethod(&IMockGLESImpl::ProgramBinary, program, binary_format, binary,
+                 length);
+}
+
+static_assert(CheckSameSignature<decltype(mockProgramBinary),  //
+                                 decltype(glProgramBinary)>::value);
+
+void mockEnable(GLenum cap) {
+  CallMockMethod(&IMockGLESImpl::Enable, cap);
+}
+
+static_assert(CheckSameSignature<decltype(mockEnable),  //
+                                 decltype(glEnable)>::value);
+
+void mockDisable(GLenum cap) {
+  CallMockMethod(&IMockGLESImpl::Disable, cap);
+}
+
+static_assert(CheckSameSignature<decltype(mockDisable),  //
+                                 decltype(glDisable)>::value);
+
+void mockUseProgram(GLuint program) {
+  CallMockMethod(&IMockGLESImpl::UseProgram, program);
+}
+
+static_assert(CheckSameSignature<decltype(mockUseProgram),  //
+                                 decltype(glUseProgram)>::value);
+
+void mockGetActiveUniformBlockiv(GLuint program,
+                                 GLuint uniform_block_index,
+                                 GLenum pname,
+                                 GLint* params) {
+  CallMockMethod(&IMockGLESImpl::GetActiveUniformBlockiv, program,
+                 uniform_block_index, pname, params);
+}
+
+static_assert(CheckSameSignature<decltype(mockGetActiveUniformBlockiv),  //
+                                 decltype(glGetActiveUniformBlockiv)>::value);
+
+void mockGetActiveUniformBlockName(GLuint program,
+                                   GLuint uniform_block_index,
+                                   GLsizei buf_size,
+                                   GLsizei* length,
+                                   GLchar* uniform_block_name) {
+  CallMockMethod(&IMockGLESImpl::GetActiveUniformBlockName, program,
+                 uniform_block_index, buf_size, length, uniform_block_name);
+}
+
+static_assert(
+    CheckSameSignature<decltype(mockGetActiveUniformBlockName),  //
+                       decltype(glGetActiveUniformBlockName)>::value);
+
+void mockUniformBlockBinding(GLuint program,
+                             GLuint uniform_block_index,
+                             GLuint uniform_block_binding) {
+  CallMockMethod(&IMockGLESImpl::UniformBlockBinding, program,
+                 uniform_block_index, uniform_block_binding);
+}
+
+static_assert(CheckSameSignature<decltype(mockUniformBlockBinding),  //
+                                 decltype(glUniformBlockBinding)>::value);
+
+void mockBindBufferRange(GLenum target,
+                         GLuint index,
+                         GLuint buffer,
+                         GLintptr offset,
+                         GLsizeiptr size) {
+  CallMockMethod(&IMockGLESImpl::BindBufferRange, target, index, buffer,
+                 offset, size);
+}
+
+static_assert(CheckSameSignature<decltype(mockBindBufferRange),  //
+                                 decltype(glBindBufferRange)>::value);
+
 // static
 std::shared_ptr<MockGLES> MockGLES::Init(
     std::unique_ptr<MockGLESImpl> impl,
@@ -257,6 +360,26 @@ const ProcTableGLES::Resolver kMockResolverGLES = [](const char* name) {
     return reinterpret_cast<void*>(mockObjectLabelKHR);
   } else if (strcmp(name, "glGenBuffers") == 0) {
     return reinterpret_cast<void*>(mockGenBuffers);
+  } else if (strcmp(name, "glGetProgramiv") == 0) {
+    return reinterpret_cast<void*>(mockGetProgramiv);
+  } else if (strcmp(name, "glGetProgramBinary") == 0) {
+    return reinterpret_cast<void*>(mockGetProgramBinary);
+  } else if (strcmp(name, "glProgramBinary") == 0) {
+    return reinterpret_cast<void*>(mockProgramBinary);
+  } else if (strcmp(name, "glEnable") == 0) {
+    return reinterpret_cast<void*>(mockEnable);
+  } else if (strcmp(name, "glDisable") == 0) {
+    return reinterpret_cast<void*>(mockDisable);
+  } else if (strcmp(name, "glUseProgram") == 0) {
+    return reinterpret_cast<void*>(mockUseProgram);
+  } else if (strcmp(name, "glGetActiveUniformBlockiv") == 0) {
+    return reinterpret_cast<void*>(mockGetActiveUniformBlockiv);
+  } else if (strcmp(name, "glGetActiveUniformBlockName") == 0) {
+    return reinterpret_cast<void*>(mockGetActiveUniformBlockName);
+  } else if (strcmp(name, "glUniformBlockBinding") == 0) {
+    return reinterpret_cast<void*>(mockUniformBlockBinding);
+  } else if (strcmp(name, "glBindBufferRange") == 0) {
+    return reinterpret_cast<void*>(mockBindBufferRange);
   } else {
     return reinterpret_cast<void*>(&doNothing);
   }
@@ -36,6 +36,36 @@ class IMockGLESImpl {
                                       GLuint64* result) {}
   virtual void DeleteQueriesEXT(GLsizei size, const GLuint* queries) {}
   virtual void GenBuffers(GLsizei n, GLuint* buffers) {}
+  virtual void GetProgramiv(GLuint program, GLenum pname, GLint* params) {}
+  virtual void GetProgramBinary(GLuint program,
+                                GLsizei buf_size,
+                                GLsizei* length,
+                                GLenum* binary_format,
+                                void* binary) {}
+  virtual void ProgramBinary(GLuint program,
+                             GLenum binary_format,
+                             const void* binary,
+                             GLsizei length) {}
+  virtual void Enable(GLenum cap) {}
+  virtual void Disable(GLenum cap) {}
+  virtual void UseProgram(GLuint program) {}
+  virtual void GetActiveUniformBlockiv(GLuint program,
+                                       GLuint uniform_block_index,
+                                       GLenum pname,
+                                       GLint* params) {}
+  virtual void GetActiveUniformBlockName(GLuint program,
+                                         GLuint uniform_block_index,
+                                         GLsizei buf_size,
+                                         GLsizei* length,
+                                         GLchar* uniform_block_name) {}
+  virtual void UniformBlockBinding(GLuint program,
+                                   GLuint uniform_block_index,
+                                   GLuint uniform_block_binding) {}
+  virtual void BindBufferRange(GLenum target,
+                               GLuint index,
+                               GLuint buffer,
+                               GLintptr offset,
+                               GLsizeiptr size) {}
 };
 
 class MockGLESImpl : public IMockGLESImpl {
@@ -70,6 +100,57 @@ class MockGLESImpl : public IMockGLESImpl {
               (GLsizei size, const GLuint* queries),
               (override));
   MOCK_METHOD(void, GenBuffers, (GLsizei n, GLuint* buffers), (override));
+  MOCK_METHOD(void,
+              GetProgramiv,
+              (GLuint program, GLenum pname, GLint* params),
+              (override));
+  MOCK_METHOD(void,
+              GetProgramBinary,
+              (GLuint program,
+               GLsizei buf_size,
+               GLsizei* length,
+               GLenum* binary_format,
+               void* binary),
+              (override));
+  MOCK_METHOD(void,
+              ProgramBinary,
+              (GLuint program,
+               GLenum binary_format,
+               const void* binary,
+               GLsizei length),
+              (override));
+  MOCK_METHOD(void, Enable, (GLenum cap), (override));
+  MOCK_METHOD(void, Disable, (GLenum cap), (override));
+  MOCK_METHOD(void, UseProgram, (GLuint program), (override));
+  MOCK_METHOD(void,
+              GetActiveUniformBlockiv,
+              (GLuint program,
+               GLuint uniform_block_index,
+               GLenum pname,
+               GLint* params),
+              (override));
+  MOCK_METHOD(void,
+              GetActiveUniformBlockName,
+              (GLuint program,
+               GLuint uniform_block_index,
+               GLsizei buf_size,
+               GLsizei* length,
+               GLchar* uniform_block_name),
+              (override));
+  MOCK_METHOD(void,
+              UniformBlockBinding,
+              (GLuint program,
+               GLuint uniform_block_index,
+               GLuint uniform_block_binding),
+              (override));
+  MOCK_METHOD(void,
+              BindBufferRange,
+              (GLenum target,
+               GLuint index,
+               GLuint buffer,
+               GLintptr offset,
+               GLsizeiptr size),
+              (override));
 };
 
 /// @brief      Provides a mocked version of the |ProcTableGLES| class.
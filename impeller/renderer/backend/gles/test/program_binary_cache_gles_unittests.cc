@@ -0,0 +1,146 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstring>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/testing/testing.h"  // IWYU pragma: keep
+#include "gtest/gtest.h"
+#include "impeller/renderer/backend/gles/program_binary_cache_gles.h"
+#include "impeller/renderer/backend/gles/test/mock_gles.h"
+
+namespace impeller {
+namespace testing {
+
+using ::testing::_;
+
+static constexpr GLuint kProgram = 7u;
+static constexpr GLenum kBinaryFormat = 0x1234;
+static constexpr uint8_t kBinary[] = {1u, 2u, 3u, 4u, 5u};
+
+// Expects the program binary of |kProgram| to be fetched once.
+static void ExpectBinaryRetrieval(MockGLESImpl& impl) {
+  EXPECT_CALL(impl, GetProgramiv(kProgram, GL_PROGRAM_BINARY_LENGTH, _))
+      .WillOnce([](GLuint, GLenum, GLint* params) {
+        *params = sizeof(kBinary);
+      });
+  EXPECT_CALL(impl, GetProgramBinary(kProgram, sizeof(kBinary), _, _, _))
+      .WillOnce([](GLuint, GLsizei, GLsizei* length, GLenum* binary_format,
+                   void* binary) {
+        *length = sizeof(kBinary);
+        *binary_format = kBinaryFormat;
+        std::memcpy(binary, kBinary, sizeof(kBinary));
+      });
+}
+
+// Writes a binary to the cache directory the way a previous launch would have.
+static void StoreBinary(const fml::UniqueFD& directory,
+                        uint64_t program_hash,
+                        const std::vector<const char*>& extensions) {
+  auto mock_gles_impl = std::make_unique<MockGLESImpl>();
+  ExpectBinaryRetrieval(*mock_gles_impl);
+  auto mock_gles = MockGLES::Init(std::move(mock_gles_impl), extensions);
+  ProgramBinaryCacheGLES cache(mock_gles->GetProcTable(), directory);
+  ASSERT_TRUE(cache.IsValid());
+  EXPECT_TRUE(
+      cache.StoreProgram(mock_gles->GetProcTable(), kProgram, program_hash));
+}
+
+TEST(ProgramBinaryCacheGLES, IsInvalidWithoutCacheDirectory) {
+  auto mock_gles = MockGLES::Init();
+  ProgramBinaryCacheGLES cache(mock_gles->GetProcTable(), fml::UniqueFD());
+  EXPECT_FALSE(cache.IsValid());
+  EXPECT_FALSE(cache.LoadProgram(mock_gles->GetProcTable(), kProgram, 1u));
+}
+
+TEST(ProgramBinaryCacheGLES, ProgramHashDependsOnSourcesAndConstants) {
+  fml::DataMapping vertex(std::string("vertex"));
+  fml::DataMapping fragment(std::string("fragment"));
+
+  uint64_t hash =
+      ProgramBinaryCacheGLES::ComputeProgramHash(vertex, fragment, {});
+  EXPECT_EQ(hash,
+            ProgramBinaryCacheGLES::ComputeProgramHash(vertex, fragment, {}));
+  EXPECT_NE(hash,
+            ProgramBinaryCacheGLES::ComputeProgramHash(fragment, vertex, {}));
+  EXPECT_NE(hash,
+            ProgramBinaryCacheGLES::ComputeProgramHash(vertex, fragment, {1}));
+}
+
+TEST(ProgramBinaryCacheGLES, LoadsStoredProgramBinaries) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  StoreBinary(temp_dir.fd(), 42u, {"GL_KHR_debug"});
+
+  auto mock_gles_impl = std::make_unique<MockGLESImpl>();
+  EXPECT_CALL(*mock_gles_impl,
+              ProgramBinary(kProgram, kBinaryFormat, _, sizeof(kBinary)))
+      .WillOnce([](GLuint, GLenum, const void* binary, GLsizei length) {
+        EXPECT_EQ(std::memcmp(binary, kBinary, length), 0);
+      });
+  EXPECT_CALL(*mock_gles_impl, GetProgramiv(kProgram, GL_LINK_STATUS, _))
+      .WillOnce([](GLuint, GLenum, GLint* params) { *params = GL_TRUE; });
+  auto mock_gles =
+      MockGLES::Init(std::move(mock_gles_impl), {{"GL_KHR_debug"}});
+  ProgramBinaryCacheGLES cache(mock_gles->GetProcTable(), temp_dir.fd());
+
+  EXPECT_TRUE(cache.LoadProgram(mock_gles->GetProcTable(), kProgram, 42u));
+  // Other programs have not been stored.
+  EXPECT_FALSE(cache.LoadProgram(mock_gles->GetProcTable(), kProgram, 43u));
+}
+
+TEST(ProgramBinaryCacheGLES, DiscardsBinariesRejectedByTheDriver) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  StoreBinary(temp_dir.fd(), 42u, {"GL_KHR_debug"});
+
+  auto mock_gles_impl = std::make_unique<MockGLESImpl>();
+  EXPECT_CALL(*mock_gles_impl, ProgramBinary(kProgram, _, _, _)).Times(1);
+  EXPECT_CALL(*mock_gles_impl, GetProgramiv(kProgram, GL_LINK_STATUS, _))
+      .WillOnce([](GLuint, GLenum, GLint* params) { *params = GL_FALSE; });
+  auto mock_gles =
+      MockGLES::Init(std::move(mock_gles_impl), {{"GL_KHR_debug"}});
+  ProgramBinaryCacheGLES cache(mock_gles->GetProcTable(), temp_dir.fd());
+
+  EXPECT_FALSE(cache.LoadProgram(mock_gles->GetProcTable(), kProgram, 42u));
+  // The rejected binary is not handed to the driver again.
+  EXPECT_FALSE(cache.LoadProgram(mock_gles->GetProcTable(), kProgram, 42u));
+}
+
+TEST(ProgramBinaryCacheGLES, IgnoresBinariesFromOtherDrivers) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  StoreBinary(temp_dir.fd(), 42u, {"GL_KHR_debug"});
+
+  auto mock_gles_impl = std::make_unique<MockGLESImpl>();
+  EXPECT_CALL(*mock_gles_impl, ProgramBinary(_, _, _, _)).Times(0);
+  // A driver update that adds an extension changes the driver description.
+  auto mock_gles = MockGLES::Init(std::move(mock_gles_impl),
+                                  {{"GL_KHR_debug", "GL_EXT_debug_marker"}});
+  ProgramBinaryCacheGLES cache(mock_gles->GetProcTable(), temp_dir.fd());
+
+  EXPECT_FALSE(cache.LoadProgram(mock_gles->GetProcTable(), kProgram, 42u));
+}
+
+TEST(ProgramBinaryCacheGLES, RemovesBinariesFromOtherDriversWhenOpened) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  StoreBinary(temp_dir.fd(), 42u, {"GL_KHR_debug"});
+
+  // Opening the cache with another driver removes the binary.
+  {
+    auto mock_gles = MockGLES::Init(std::make_unique<MockGLESImpl>(),
+                                    {{"GL_KHR_debug", "GL_EXT_debug_marker"}});
+    ProgramBinaryCacheGLES cache(mock_gles->GetProcTable(), temp_dir.fd());
+    ASSERT_TRUE(cache.IsValid());
+  }
+
+  // So it is gone even after going back to the original driver.
+  auto mock_gles_impl = std::make_unique<MockGLESImpl>();
+  EXPECT_CALL(*mock_gles_impl, ProgramBinary(_, _, _, _)).Times(0);
+  auto mock_gles =
+      MockGLES::Init(std::move(mock_gles_impl), {{"GL_KHR_debug"}});
+  ProgramBinaryCacheGLES cache(mock_gles->GetProcTable(), temp_dir.fd());
+  EXPECT_FALSE(cache.LoadProgram(mock_gles->GetProcTable(), kProgram, 42u));
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -0,0 +1,102 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/testing/testing.h"  // IWYU pragma: keep
+#include "gtest/gtest.h"
+#include "impeller/renderer/backend/gles/state_cache_gles.h"
+#include "impeller/renderer/backend/gles/test/mock_gles.h"
+
+namespace impeller {
+namespace testing {
+
+TEST(StateCacheGLES, ElidesRedundantCapabilityChanges) {
+  auto mock_gles_impl = std::make_unique<MockGLESImpl>();
+  {
+    ::testing::InSequence seq;
+    EXPECT_CALL(*mock_gles_impl, Enable(GL_BLEND)).Times(1);
+    EXPECT_CALL(*mock_gles_impl, Disable(GL_BLEND)).Times(1);
+    EXPECT_CALL(*mock_gles_impl, Enable(GL_BLEND)).Times(1);
+  }
+  auto mock_gles = MockGLES::Init(std::move(mock_gles_impl));
+  const ProcTableGLES& gl = mock_gles->GetProcTable();
+
+  StateCacheGLES state;
+  state.Enable(gl, GL_BLEND);
+  state.Enable(gl, GL_BLEND);
+  state.Disable(gl, GL_BLEND);
+  state.Disable(gl, GL_BLEND);
+  state.Enable(gl, GL_BLEND);
+
+  EXPECT_EQ(state.GetIssuedCallCount(), 3u);
+  EXPECT_EQ(state.GetElidedCallCount(), 2u);
+}
+
+TEST(StateCacheGLES, IssuesCallsAgainAfterInvalidation) {
+  auto mock_gles_impl = std::make_unique<MockGLESImpl>();
+  EXPECT_CALL(*mock_gles_impl, UseProgram(1u)).Times(2);
+  EXPECT_CALL(*mock_gles_impl, Disable(GL_SCISSOR_TEST)).Times(2);
+  auto mock_gles = MockGLES::Init(std::move(mock_gles_impl));
+  const ProcTableGLES& gl = mock_gles->GetProcTable();
+
+  StateCacheGLES state;
+  state.UseProgram(gl, 1u);
+  state.Disable(gl, GL_SCISSOR_TEST);
+  state.UseProgram(gl, 1u);
+  state.Disable(gl, GL_SCISSOR_TEST);
+  state.Invalidate();
+  state.UseProgram(gl, 1u);
+  state.Disable(gl, GL_SCISSOR_TEST);
+
+  EXPECT_EQ(state.GetIssuedCallCount(), 4u);
+  EXPECT_EQ(state.GetElidedCallCount(), 2u);
+}
+
+TEST(StateCacheGLES, AlwaysIssuesUntrackedCapabilities) {
+  auto mock_gles_impl = std::make_unique<MockGLESImpl>();
+  EXPECT_CALL(*mock_gles_impl, Enable(GL_POLYGON_OFFSET_FILL)).Times(2);
+  auto mock_gles = MockGLES::Init(std::move(mock_gles_impl));
+  const ProcTableGLES& gl = mock_gles->GetProcTable();
+
+  StateCacheGLES state;
+  state.Enable(gl, GL_POLYGON_OFFSET_FILL);
+  state.Enable(gl, GL_POLYGON_OFFSET_FILL);
+
+  EXPECT_EQ(state.GetIssuedCallCount(), 2u);
+  EXPECT_EQ(state.GetElidedCallCount(), 0u);
+}
+
+TEST(StateCacheGLES, TracksStencilFacesSeparately) {
+  auto mock_gles = MockGLES::Init();
+  const ProcTableGLES& gl = mock_gles->GetProcTable();
+
+  StateCacheGLES state;
+  state.StencilMaskSeparate(gl, GL_FRONT, 0xFF);
+  // Only the front face is known.
+  state.StencilMaskSeparate(gl, GL_FRONT_AND_BACK, 0xFF);
+  state.StencilMaskSeparate(gl, GL_BACK, 0xFF);
+  state.StencilMaskSeparate(gl, GL_FRONT, 0xFF);
+  state.StencilMaskSeparate(gl, GL_FRONT, 0x0F);
+  // The back face still has the previous mask.
+  state.StencilMaskSeparate(gl, GL_FRONT_AND_BACK, 0x0F);
+
+  EXPECT_EQ(state.GetIssuedCallCount(), 4u);
+  EXPECT_EQ(state.GetElidedCallCount(), 2u);
+}
+
+TEST(StateCacheGLES, OnlyShadowsArrayBufferBindings) {
+  auto mock_gles = MockGLES::Init();
+  const ProcTableGLES& gl = mock_gles->GetProcTable();
+
+  StateCacheGLES state;
+  state.BindBuffer(gl, GL_ARRAY_BUFFER, 1u);
+  state.BindBuffer(gl, GL_ARRAY_BUFFER, 1u);
+  state.BindBuffer(gl, GL_ELEMENT_ARRAY_BUFFER, 2u);
+  state.BindBuffer(gl, GL_ELEMENT_ARRAY_BUFFER, 2u);
+
+  EXPECT_EQ(state.GetIssuedCallCount(), 3u);
+  EXPECT_EQ(state.GetElidedCallCount(), 1u);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -140,6 +140,14 @@ enum class OptionalDeviceExtensionVK : uint32_t {
   ///
   kEXTImageCompressionControl,
 
+  //----------------------------------------------------------------------------
+  /// To track the completion of submissions with a single semaphore instead
+  /// of a fence per submission. Core in Vulkan 1.2.
+  ///
+  /// https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VK_KHR_timeline_semaphore.html
+  ///
+  kKHRTimelineSemaphore,
+
   kLast,
 };
 
@@ -198,7 +206,8 @@ class CapabilitiesVK final : public Capabilities,
       vk::StructureChain<vk::PhysicalDeviceFeatures2,
                          vk::PhysicalDeviceSamplerYcbcrConversionFeaturesKHR,
                          vk::PhysicalDevice16BitStorageFeatures,
-                         vk::PhysicalDeviceImageCompressionControlFeaturesEXT>;
+                         vk::PhysicalDeviceImageCompressionControlFeaturesEXT,
+                         vk::PhysicalDeviceTimelineSemaphoreFeaturesKHR>;
 
   std::optional<PhysicalDeviceFeatures> GetEnabledDeviceFeatures(
       const vk::PhysicalDevice& physical_device) const;
@@ -268,6 +277,12 @@ class CapabilitiesVK final : public Capabilities,
   ///
   bool SupportsTextureFixedRateCompression() const;
 
+  //----------------------------------------------------------------------------
+  /// @return     If timeline semaphores are supported and enabled on the
+  ///             device.
+  ///
+  bool SupportsTimelineSemaphores() const;
+
   //----------------------------------------------------------------------------
   /// @brief      Get the fixed compression rate supported by the context for
   ///             the given format and usage.
@@ -296,6 +311,7 @@ class CapabilitiesVK final : public Capabilities,
   bool supports_compute_subgroups_ = false;
   bool supports_device_transient_textures_ = false;
   bool supports_texture_fixed_rate_compression_ = false;
+  bool supports_timeline_semaphores_ = false;
   ISize max_render_pass_attachment_size_ = ISize{0, 0};
   bool has_triangle_fans_ = true;
   bool is_valid_ = false;
@@ -143,6 +143,23 @@ bool CommandBufferVK::Track(
   return true;
 }
 
+bool CommandBufferVK::TrackSecondaryCommandBuffer(
+    const std::shared_ptr<CommandPoolVK>& pool,
+    vk::UniqueCommandBuffer buffer) {
+  if (!IsValid()) {
+    return false;
+  }
+  tracked_objects_->TrackSecondaryCommandBuffer(pool, std::move(buffer));
+  return true;
+}
+
+size_t CommandBufferVK::GetSecondaryCommandBufferCount() const {
+  if (!IsValid()) {
+    return 0u;
+  }
+  return tracked_objects_->GetSecondaryCommandBufferCount();
+}
+
 bool CommandBufferVK::Track(const std::shared_ptr<const Texture>& texture) {
   if (!IsValid()) {
     return false;
@@ -47,6 +47,12 @@ class CommandBufferVK final
   ///        completes execution.
   bool Track(const std::shared_ptr<const TextureSourceVK>& texture);
 
+  /// @brief Ensure that the pool of a secondary command buffer executed by
+  ///        this command buffer is kept alive until this command buffer
+  ///        completes execution, and return [buffer] to it afterwards.
+  bool TrackSecondaryCommandBuffer(const std::shared_ptr<CommandPoolVK>& pool,
+                                   vk::UniqueCommandBuffer buffer);
+
   /// @brief Retrieve the native command buffer from this object.
   vk::CommandBuffer GetCommandBuffer() const;
 
@@ -79,6 +85,12 @@ class CommandBufferVK final
   // Visible for testing.
   DescriptorPoolVK& GetDescriptorPool() const;
 
+  /// @brief The number of secondary command buffers executed by the render
+  ///        passes encoded into this command buffer so far.
+  ///
+  /// Visible for testing.
+  size_t GetSecondaryCommandBufferCount() const;
+
  private:
   friend class ContextVK;
   friend class CommandQueueVK;
@@ -29,12 +29,16 @@ class BackgroundCommandPoolVK final {
   explicit BackgroundCommandPoolVK(
       vk::UniqueCommandPool&& pool,
       std::vector<vk::UniqueCommandBuffer>&& buffers,
+      std::vector<vk::UniqueCommandBuffer>&& secondary_buffers,
       size_t unused_count,
-      std::weak_ptr<CommandPoolRecyclerVK> recycler)
+      std::weak_ptr<CommandPoolRecyclerVK> recycler,
+      std::weak_ptr<CommandPoolFreeListVK> free_list)
       : pool_(std::move(pool)),
         buffers_(std::move(buffers)),
+        secondary_buffers_(std::move(secondary_buffers)),
         unused_count_(unused_count),
-        recycler_(std::move(recycler)) {}
+        recycler_(std::move(recycler)),
+        free_list_(std::move(free_list)) {}
 
   ~BackgroundCommandPoolVK() {
     auto const recycler = recycler_.lock();
@@ -53,7 +57,8 @@ class BackgroundCommandPoolVK final {
       }
     }
 
-    recycler->Reclaim(std::move(pool_), std::move(buffers_));
+    recycler->Reclaim(std::move(pool_), std::move(buffers_),
+                      std::move(secondary_buffers_), free_list_);
   }
 
  private:
@@ -67,8 +72,10 @@ class BackgroundCommandPoolVK final {
   // wrapper type will attempt to reset the cmd buffer, and doing so may be a
   // thread safety violation as this may happen on the fence waiter thread.
   std::vector<vk::UniqueCommandBuffer> buffers_;
+  std::vector<vk::UniqueCommandBuffer> secondary_buffers_;
   const size_t unused_count_;
   std::weak_ptr<CommandPoolRecyclerVK> recycler_;
+  std::weak_ptr<CommandPoolFreeListVK> free_list_;
 };
 
 CommandPoolVK::~CommandPoolVK() {
@@ -91,16 +98,23 @@ CommandPoolVK::~CommandPoolVK() {
     collected_buffers_.push_back(std::move(unused_command_buffers_[i]));
   }
   unused_command_buffers_.clear();
+  for (auto& buffer : unused_secondary_command_buffers_) {
+    collected_secondary_buffers_.push_back(std::move(buffer));
+  }
+  unused_secondary_command_buffers_.clear();
 
   auto reset_pool_when_dropped = BackgroundCommandPoolVK(
-      std::move(pool_), std::move(collected_buffers_), unused_count, recycler);
+      std::move(pool_), std::move(collected_buffers_),
+      std::move(collected_secondary_buffers_), unused_count, recycler,
+      free_list_);
 
   UniqueResourceVKT<BackgroundCommandPoolVK> pool(
       context->GetResourceManager(), std::move(reset_pool_when_dropped));
 }
 
 // TODO(matanlurey): Return a status_or<> instead of {} when we have one.
-vk::UniqueCommandBuffer CommandPoolVK::CreateCommandBuffer() {
+vk::UniqueCommandBuffer CommandPoolVK::CreateCommandBuffer(
+    vk::CommandBufferLevel level) {
   auto const context = context_.lock();
   if (!context) {
     return {};
@@ -110,9 +124,13 @@ vk::UniqueCommandBuffer CommandPoolVK::CreateCommandBuffer() {
   if (!pool_) {
     return {};
   }
-  if (!unused_command_buffers_.empty()) {
-    vk::UniqueCommandBuffer buffer = std::move(unused_command_buffers_.back());
-    unused_command_buffers_.pop_back();
+  std::vector<vk::UniqueCommandBuffer>& unused_buffers =
+      level == vk::CommandBufferLevel::ePrimary
+          ? unused_command_buffers_
+          : unused_secondary_command_buffers_;
+  if (!unused_buffers.empty()) {
+    vk::UniqueCommandBuffer buffer = std::move(unused_buffers.back());
+    unused_buffers.pop_back();
     return buffer;
   }
 
@@ -120,7 +138,7 @@ vk::UniqueCommandBuffer CommandPoolVK::CreateCommandBuffer() {
   vk::CommandBufferAllocateInfo info;
   info.setCommandPool(pool_.get());
   info.setCommandBufferCount(1u);
-  info.setLevel(vk::CommandBufferLevel::ePrimary);
+  info.setLevel(level);
   auto [result, buffers] = device.allocateCommandBuffersUnique(info);
   if (result != vk::Result::eSuccess) {
     return {};
@@ -128,7 +146,8 @@ vk::UniqueCommandBuffer CommandPoolVK::CreateCommandBuffer() {
   return std::move(buffers[0]);
 }
 
-void CommandPoolVK::CollectCommandBuffer(vk::UniqueCommandBuffer&& buffer) {
+void CommandPoolVK::CollectCommandBuffer(vk::UniqueCommandBuffer&& buffer,
+                                         vk::CommandBufferLevel level) {
   Lock lock(pool_mutex_);
   if (!pool_) {
     // If the command pool has already been destroyed, then its buffers have
@@ -136,7 +155,11 @@ void CommandPoolVK::CollectCommandBuffer(vk::UniqueCommandBuffer&& buffer) {
     buffer.release();
     return;
   }
-  collected_buffers_.push_back(std::move(buffer));
+  if (level == vk::CommandBufferLevel::ePrimary) {
+    collected_buffers_.push_back(std::move(buffer));
+  } else {
+    collected_secondary_buffers_.push_back(std::move(buffer));
+  }
 }
 
 void CommandPoolVK::Destroy() {
@@ -151,8 +174,16 @@ void CommandPoolVK::Destroy() {
   for (auto& buffer : unused_command_buffers_) {
     buffer.release();
   }
+  for (auto& buffer : collected_secondary_buffers_) {
+    buffer.release();
+  }
+  for (auto& buffer : unused_secondary_command_buffers_) {
+    buffer.release();
+  }
   unused_command_buffers_.clear();
   collected_buffers_.clear();
+  unused_secondary_command_buffers_.clear();
+  collected_secondary_buffers_.clear();
 }
 
 // Associates a resource with a thread and context.
@@ -196,13 +227,16 @@ std::shared_ptr<CommandPoolVK> CommandPoolRecyclerVK::Get() {
   }
 
   // Otherwise, create a new resource and return it.
-  auto data = Create();
+  std::shared_ptr<CommandPoolFreeListVK> free_list =
+      free_lists_.GetForCurrentThread();
+  auto data = Create(*free_list);
   if (!data || !data->pool) {
     return nullptr;
   }
 
   auto const resource = std::make_shared<CommandPoolVK>(
-      std::move(data->pool), std::move(data->buffers), context_);
+      std::move(data->pool), std::move(data->buffers), context_, free_list,
+      std::move(data->secondary_buffers));
   pool_map.emplace(hash, resource);
 
   {
@@ -215,9 +249,9 @@ std::shared_ptr<CommandPoolVK> CommandPoolRecyclerVK::Get() {
 
 // TODO(matanlurey): Return a status_or<> instead of nullopt when we have one.
 std::optional<CommandPoolRecyclerVK::RecycledData>
-CommandPoolRecyclerVK::Create() {
+CommandPoolRecyclerVK::Create(CommandPoolFreeListVK& free_list) {
   // If we can reuse a command pool and its buffers, do so.
-  if (auto data = Reuse()) {
+  if (auto data = Reuse(free_list)) {
     return data;
   }
 
@@ -235,27 +269,29 @@ CommandPoolRecyclerVK::Create() {
   if (result != vk::Result::eSuccess) {
     return std::nullopt;
   }
-  return CommandPoolRecyclerVK::RecycledData{.pool = std::move(pool),
-                                             .buffers = {}};
+  return CommandPoolRecyclerVK::RecycledData{
+      .pool = std::move(pool), .buffers = {}, .secondary_buffers = {}};
 }
 
 std::optional<CommandPoolRecyclerVK::RecycledData>
-CommandPoolRecyclerVK::Reuse() {
-  // If there are no recycled pools, return nullopt.
-  Lock recycled_lock(recycled_mutex_);
-  if (recycled_.empty()) {
-    return std::nullopt;
+CommandPoolRecyclerVK::Reuse(CommandPoolFreeListVK& free_list) {
+  // Prefer the pools handed back to this thread, which doesn't need a lock.
+  if (auto data = free_list.Take()) {
+    return data;
   }
 
-  // Otherwise, remove and return a recycled pool.
-  auto data = std::move(recycled_.back());
-  recycled_.pop_back();
-  return std::move(data);
+  // Otherwise pick up the pools handed back to other threads, if any.
+  if (free_lists_.StealInto(free_list)) {
+    return free_list.Take();
+  }
+  return std::nullopt;
 }
 
 void CommandPoolRecyclerVK::Reclaim(
     vk::UniqueCommandPool&& pool,
-    std::vector<vk::UniqueCommandBuffer>&& buffers) {
+    std::vector<vk::UniqueCommandBuffer>&& buffers,
+    std::vector<vk::UniqueCommandBuffer>&& secondary_buffers,
+    const std::weak_ptr<CommandPoolFreeListVK>& free_list) {
   // Reset the pool on a background thread.
   auto strong_context = context_.lock();
   if (!strong_context) {
@@ -264,10 +300,16 @@ void CommandPoolRecyclerVK::Reclaim(
   auto device = strong_context->GetDevice();
   device.resetCommandPool(pool.get());
 
-  // Move the pool to the recycled list.
-  Lock recycled_lock(recycled_mutex_);
-  recycled_.push_back(
-      RecycledData{.pool = std::move(pool), .buffers = std::move(buffers)});
+  // Hand the pool back to the thread that used it, or to the calling thread
+  // if the pool was not handed out by |Get|.
+  auto strong_free_list = free_list.lock();
+  if (!strong_free_list) {
+    strong_free_list = free_lists_.GetForCurrentThread();
+  }
+  strong_free_list->Return(
+      RecycledData{.pool = std::move(pool),
+                   .buffers = std::move(buffers),
+                   .secondary_buffers = std::move(secondary_buffers)});
 }
 
 CommandPoolRecyclerVK::~CommandPoolRecyclerVK() {
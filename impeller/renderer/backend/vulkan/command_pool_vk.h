@@ -10,6 +10,7 @@
 #include <utility>
 
 #include "impeller/base/thread.h"
+#include "impeller/renderer/backend/vulkan/thread_free_list_vk.h"
 #include "impeller/renderer/backend/vulkan/vk.h"  // IWYU pragma: keep.
 #include "vulkan/vulkan_handles.hpp"
 
@@ -18,6 +19,15 @@ namespace impeller {
 class ContextVK;
 class CommandPoolRecyclerVK;
 
+/// A unique command pool and zero or more recycled command buffers.
+struct RecycledCommandPoolVK {
+  vk::UniqueCommandPool pool;
+  std::vector<vk::UniqueCommandBuffer> buffers;
+  std::vector<vk::UniqueCommandBuffer> secondary_buffers;
+};
+
+using CommandPoolFreeListVK = ThreadFreeListVK<RecycledCommandPoolVK>;
+
 //------------------------------------------------------------------------------
 /// @brief      Manages the lifecycle of a single |vk::CommandPool|.
 ///
@@ -34,29 +44,44 @@ class CommandPoolVK final {
 
   /// @brief      Creates a resource that manages the life of a command pool.
   ///
-  /// @param[in]  pool      The command pool to manage.
-  /// @param[in]  buffers   Zero or more command buffers in an initial state.
-  /// @param[in]  recycler  The context that will be notified on destruction.
+  /// @param[in]  pool       The command pool to manage.
+  /// @param[in]  buffers    Zero or more command buffers in an initial state.
+  /// @param[in]  recycler   The context that will be notified on destruction.
+  /// @param[in]  free_list  The free list the pool is returned to once it has
+  ///                        been reset.
+  /// @param[in]  secondary_buffers  Zero or more secondary command buffers in
+  ///                                an initial state.
   CommandPoolVK(vk::UniqueCommandPool pool,
                 std::vector<vk::UniqueCommandBuffer>&& buffers,
-                std::weak_ptr<ContextVK>& context)
+                std::weak_ptr<ContextVK>& context,
+                std::weak_ptr<CommandPoolFreeListVK> free_list = {},
+                std::vector<vk::UniqueCommandBuffer> secondary_buffers = {})
       : pool_(std::move(pool)),
         unused_command_buffers_(std::move(buffers)),
-        context_(context) {}
+        unused_secondary_command_buffers_(std::move(secondary_buffers)),
+        context_(context),
+        free_list_(std::move(free_list)) {}
 
   /// @brief      Creates and returns a new |vk::CommandBuffer|.
   ///
+  /// @param[in]  level  Whether to create a primary or secondary buffer.
+  ///                    Primary and secondary buffers are recycled separately.
+  ///
   /// @return     Always returns a new |vk::CommandBuffer|, but if for any
   ///             reason a valid command buffer could not be created, it will be
   ///             a `{}` default instance (i.e. while being torn down).
-  vk::UniqueCommandBuffer CreateCommandBuffer();
+  vk::UniqueCommandBuffer CreateCommandBuffer(
+      vk::CommandBufferLevel level = vk::CommandBufferLevel::ePrimary);
 
   /// @brief      Collects the given |vk::CommandBuffer| to be retained.
   ///
   /// @param[in]  buffer  The |vk::CommandBuffer| to collect.
+  /// @param[in]  level   The level the buffer was created with.
   ///
   /// @see        |GarbageCollectBuffersIfAble|
-  void CollectCommandBuffer(vk::UniqueCommandBuffer&& buffer);
+  void CollectCommandBuffer(
+      vk::UniqueCommandBuffer&& buffer,
+      vk::CommandBufferLevel level = vk::CommandBufferLevel::ePrimary);
 
   /// @brief      Delete all Vulkan objects in this command pool.
   void Destroy();
@@ -69,11 +94,15 @@ class CommandPoolVK final {
   Mutex pool_mutex_;
   vk::UniqueCommandPool pool_ IPLR_GUARDED_BY(pool_mutex_);
   std::vector<vk::UniqueCommandBuffer> unused_command_buffers_;
+  std::vector<vk::UniqueCommandBuffer> unused_secondary_command_buffers_;
   std::weak_ptr<ContextVK>& context_;
+  std::weak_ptr<CommandPoolFreeListVK> free_list_;
 
   // Used to retain a reference on these until the pool is reset.
   std::vector<vk::UniqueCommandBuffer> collected_buffers_ IPLR_GUARDED_BY(
       pool_mutex_);
+  std::vector<vk::UniqueCommandBuffer> collected_secondary_buffers_
+      IPLR_GUARDED_BY(pool_mutex_);
 };
 
 //------------------------------------------------------------------------------
@@ -87,8 +116,10 @@ class CommandPoolVK final {
 ///
 /// Every "frame", a single |CommandPoolResourceVk| is made available for each
 /// thread that calls |Get|. After calling |Dispose|, the current thread's pool
-/// is moved to a background thread, reset, and made available for the next time
-/// |Get| is called and needs to create a command pool.
+/// is moved to a background thread, reset, and handed back to the free list of
+/// that thread without locking for the next time |Get| is called and needs to
+/// create a command pool. Threads only take a lock to pick up pools handed
+/// back to other threads when their own free list is empty.
 ///
 /// Commands in the command pool are not necessarily done executing when the
 /// pool is recycled, when all references are dropped to the pool, they are
@@ -105,11 +136,11 @@ class CommandPoolRecyclerVK final
  public:
   ~CommandPoolRecyclerVK();
 
-  /// A unique command pool and zero or more recycled command buffers.
-  struct RecycledData {
-    vk::UniqueCommandPool pool;
-    std::vector<vk::UniqueCommandBuffer> buffers;
-  };
+  /// The maximum number of command pools this recycler will hold onto for each
+  /// thread.
+  static constexpr size_t kMaxRecycledPools = 16u;
+
+  using RecycledData = RecycledCommandPoolVK;
 
   /// @brief      Clean up resources held by all per-thread command pools
   ///             associated with the given context.
@@ -121,7 +152,7 @@ class CommandPoolRecyclerVK final
   ///
   /// @param[in]  context The context to create the recycler for.
   explicit CommandPoolRecyclerVK(std::weak_ptr<ContextVK> context)
-      : context_(std::move(context)) {}
+      : context_(std::move(context)), free_lists_(kMaxRecycledPools) {}
 
   /// @brief      Gets a command pool for the current thread.
   ///
@@ -130,28 +161,33 @@ class CommandPoolRecyclerVK final
 
   /// @brief      Returns a command pool to be reset on a background thread.
   ///
-  /// @param[in]  pool The pool to recycler.
+  /// @param[in]  pool       The pool to recycler.
+  /// @param[in]  buffers    The command buffers allocated from the pool.
+  /// @param[in]  secondary_buffers  The secondary command buffers allocated
+  ///                                from the pool.
+  /// @param[in]  free_list  The free list of the thread that used the pool.
   void Reclaim(vk::UniqueCommandPool&& pool,
-               std::vector<vk::UniqueCommandBuffer>&& buffers);
+               std::vector<vk::UniqueCommandBuffer>&& buffers,
+               std::vector<vk::UniqueCommandBuffer>&& secondary_buffers,
+               const std::weak_ptr<CommandPoolFreeListVK>& free_list = {});
 
   /// @brief      Clears all recycled command pools to let them be reclaimed.
   void Dispose();
 
  private:
   std::weak_ptr<ContextVK> context_;
-
-  Mutex recycled_mutex_;
-  std::vector<RecycledData> recycled_ IPLR_GUARDED_BY(recycled_mutex_);
+  ThreadFreeListsVK<RecycledData> free_lists_;
 
   /// @brief      Creates a new |vk::CommandPool|.
   ///
   /// @returns    Returns a |std::nullopt| if a pool could not be created.
-  std::optional<CommandPoolRecyclerVK::RecycledData> Create();
+  std::optional<CommandPoolRecyclerVK::RecycledData> Create(
+      CommandPoolFreeListVK& free_list);
 
   /// @brief      Reuses a recycled |RecycledData|, if available.
   ///
   /// @returns    Returns a |std::nullopt| if a pool was not available.
-  std::optional<RecycledData> Reuse();
+  std::optional<RecycledData> Reuse(CommandPoolFreeListVK& free_list);
 
   CommandPoolRecyclerVK(const CommandPoolRecyclerVK&) = delete;
 
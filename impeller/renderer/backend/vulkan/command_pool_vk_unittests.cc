@@ -162,5 +162,58 @@ TEST(CommandPoolRecyclerVKTest, CommandBuffersAreRecycled) {
   context->Shutdown();
 }
 
+TEST(CommandPoolRecyclerVKTest, SecondaryCommandBuffersAreRecycledSeparately) {
+  auto const context = MockVulkanContextBuilder().Build();
+
+  {
+    auto const recycler = context->GetCommandPoolRecycler();
+    auto pool = recycler->Get();
+
+    auto buffer = pool->CreateCommandBuffer();
+    auto secondary_buffer =
+        pool->CreateCommandBuffer(vk::CommandBufferLevel::eSecondary);
+    pool->CollectCommandBuffer(std::move(buffer));
+    pool->CollectCommandBuffer(std::move(secondary_buffer),
+                               vk::CommandBufferLevel::eSecondary);
+
+    // This normally is called at the end of a frame.
+    recycler->Dispose();
+  }
+
+  // Wait for the pool to be reclaimed.
+  for (auto i = 0u; i < 2u; i++) {
+    auto waiter = fml::AutoResetWaitableEvent();
+    auto rattle = DeathRattle([&waiter]() { waiter.Signal(); });
+    {
+      UniqueResourceVKT<DeathRattle> resource(context->GetResourceManager(),
+                                              std::move(rattle));
+    }
+    waiter.Wait();
+  }
+
+  {
+    // Both the primary and the secondary buffer are reused from the lists of
+    // their own level.
+    auto const recycler = context->GetCommandPoolRecycler();
+    auto pool = recycler->Get();
+
+    auto secondary_buffer =
+        pool->CreateCommandBuffer(vk::CommandBufferLevel::eSecondary);
+    auto buffer = pool->CreateCommandBuffer();
+    pool->CollectCommandBuffer(std::move(buffer));
+    pool->CollectCommandBuffer(std::move(secondary_buffer),
+                               vk::CommandBufferLevel::eSecondary);
+
+    recycler->Dispose();
+  }
+
+  auto const called = GetMockVulkanFunctions(context->GetDevice());
+  EXPECT_EQ(
+      std::count(called->begin(), called->end(), "vkAllocateCommandBuffers"),
+      2u);
+
+  context->Shutdown();
+}
+
 }  // namespace testing
 }  // namespace impeller
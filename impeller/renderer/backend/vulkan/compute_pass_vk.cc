@@ -101,9 +101,13 @@ fml::Status ComputePassVK::Compute(const ISize& grid_size) {
   int64_t width = grid_size.width;
   int64_t height = grid_size.height;
 
-  // Special case for linear processing.
+  // Special case for linear processing. Compute shaders are specialized to the
+  // maximum workgroup width, so a grid of |width| invocations needs enough
+  // workgroups to cover it, like on Metal.
   if (height == 1) {
-    command_buffer_vk.dispatch(width, 1, 1);
+    const int64_t workgroup_width = std::max(1u, max_wg_size_[0]);
+    command_buffer_vk.dispatch(
+        (width + workgroup_width - 1) / workgroup_width, 1, 1);
   } else {
     while (width > max_wg_size_[0]) {
       width = std::max(static_cast<int64_t>(1), width / 2);
@@ -251,12 +255,16 @@ bool ComputePassVK::EncodeCommands() const {
   // for anything.
   vk::MemoryBarrier barrier;
   barrier.srcAccessMask = vk::AccessFlagBits::eShaderWrite;
-  barrier.dstAccessMask =
-      vk::AccessFlagBits::eIndexRead | vk::AccessFlagBits::eVertexAttributeRead;
+  barrier.dstAccessMask = vk::AccessFlagBits::eIndexRead |
+                          vk::AccessFlagBits::eVertexAttributeRead |
+                          vk::AccessFlagBits::eShaderRead;
 
   command_buffer_->GetCommandBuffer().pipelineBarrier(
       vk::PipelineStageFlagBits::eComputeShader,
-      vk::PipelineStageFlagBits::eVertexInput, {}, 1, &barrier, 0, {}, 0, {});
+      vk::PipelineStageFlagBits::eVertexInput |
+          vk::PipelineStageFlagBits::eVertexShader |
+          vk::PipelineStageFlagBits::eFragmentShader,
+      {}, 1, &barrier, 0, {}, 0, {});
 
   return true;
 }
@@ -401,12 +401,6 @@ void ContextVK::Setup(Settings settings) {
     return;
   }
 
-  //----------------------------------------------------------------------------
-  /// Create the fence waiter.
-  ///
-  auto fence_waiter =
-      std::shared_ptr<FenceWaiterVK>(new FenceWaiterVK(device_holder));
-
   //----------------------------------------------------------------------------
   /// Create the resource manager and command pool recycler.
   ///
@@ -450,6 +444,14 @@ void ContextVK::Setup(Settings settings) {
     return;
   }
 
+  //----------------------------------------------------------------------------
+  /// Create the fence waiter. Submissions to the graphics queue are tracked
+  /// with a timeline semaphore where supported.
+  ///
+  auto fence_waiter = std::shared_ptr<FenceWaiterVK>(new FenceWaiterVK(
+      device_holder, caps->SupportsTimelineSemaphores() ? queues.graphics_queue
+                                                        : nullptr));
+
   VkPhysicalDeviceProperties physical_device_properties;
   dispatcher.vkGetPhysicalDeviceProperties(device_holder->physical_device,
                                            &physical_device_properties);
@@ -477,6 +479,8 @@ void ContextVK::Setup(Settings settings) {
   device_name_ = std::string(physical_device_properties.deviceName);
   command_queue_vk_ = std::make_shared<CommandQueueVK>(weak_from_this());
   should_disable_surface_control_ = settings.disable_surface_control;
+  enable_parallel_render_pass_encoding_ =
+      settings.enable_parallel_render_pass_encoding;
   should_batch_cmd_buffers_ = driver_info_->CanBatchSubmitCommandBuffers();
   is_valid_ = true;
 
@@ -722,6 +726,19 @@ bool ContextVK::GetShouldDisableSurfaceControlSwapchain() const {
   return should_disable_surface_control_;
 }
 
+size_t ContextVK::GetRenderPassEncodingWorkerCount() const {
+  // Waiting on the workers from a worker could deadlock.
+  if (!enable_parallel_render_pass_encoding_.load() ||
+      raster_message_loop_->RunsTasksOnCurrentThread()) {
+    return 0u;
+  }
+  return raster_message_loop_->GetWorkerCount();
+}
+
+void ContextVK::SetParallelRenderPassEncodingEnabled(bool enabled) {
+  enable_parallel_render_pass_encoding_.store(enabled);
+}
+
 RuntimeStageBackend ContextVK::GetRuntimeStageBackend() const {
   return RuntimeStageBackend::kVulkan;
 }
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_CONTEXT_VK_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_CONTEXT_VK_H_
 
+#include <atomic>
 #include <memory>
 
 #include "flutter/fml/concurrent_message_loop.h"
@@ -84,6 +85,9 @@ class ContextVK final : public Context,
     bool disable_surface_control = false;
     /// If validations are requested but cannot be enabled, log a fatal error.
     bool fatal_missing_validations = false;
+    /// Split render passes with many draws into ranges that are encoded into
+    /// secondary command buffers on the concurrent worker threads.
+    bool enable_parallel_render_pass_encoding = false;
 
     std::optional<EmbedderData> embedder_data;
 
@@ -223,6 +227,20 @@ class ContextVK final : public Context,
   /// disabled, even if the device is capable of supporting it.
   bool GetShouldDisableSurfaceControlSwapchain() const;
 
+  /// @brief The number of worker threads a render pass may be split across
+  ///        when it is encoded, or zero if render passes must be encoded on
+  ///        the calling thread.
+  ///
+  /// This is zero unless parallel render pass encoding was enabled in the
+  /// settings, and when called from one of the worker threads.
+  size_t GetRenderPassEncodingWorkerCount() const;
+
+  /// Overrides the setting that enables parallel render pass encoding for the
+  /// render passes created after this call.
+  ///
+  /// Visible for testing.
+  void SetParallelRenderPassEncodingEnabled(bool enabled);
+
   // | Context |
   bool EnqueueCommandBuffer(
       std::shared_ptr<CommandBuffer> command_buffer) override;
@@ -285,6 +303,7 @@ class ContextVK final : public Context,
   mutable DescriptorPoolMap IPLR_GUARDED_BY(desc_pool_mutex_)
       cached_descriptor_pool_;
   bool should_disable_surface_control_ = false;
+  std::atomic<bool> enable_parallel_render_pass_encoding_ = false;
   bool should_batch_cmd_buffers_ = false;
   std::vector<std::shared_ptr<CommandBuffer>> pending_command_buffers_;
 
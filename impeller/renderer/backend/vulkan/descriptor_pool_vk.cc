@@ -4,6 +4,7 @@
 
 #include "impeller/renderer/backend/vulkan/descriptor_pool_vk.h"
 
+#include <array>
 #include <optional>
 
 #include "impeller/base/validation.h"
@@ -20,14 +21,30 @@ struct DescriptorPoolSize {
   size_t subpass_bindings;
 };
 
-/// Descriptor pools are always allocated with the following sizes.
-static const constexpr DescriptorPoolSize kDefaultBindingSize =
-    DescriptorPoolSize{
-        .buffer_bindings = 512u,   // Buffer Bindings
-        .texture_bindings = 256u,  // Texture Bindings
-        .storage_bindings = 32,
-        .subpass_bindings = 4u  // Subpass Bindings
-    };
+/// Descriptor pools are allocated with one of the following sizes. The
+/// default size class is used until usage has been observed.
+static const constexpr std::array<DescriptorPoolSize,
+                                  DescriptorPoolRecyclerVK::kSizeClassCount>
+    kSizeClasses = {
+        DescriptorPoolSize{
+            .buffer_bindings = 64u,   // Buffer Bindings
+            .texture_bindings = 32u,  // Texture Bindings
+            .storage_bindings = 4u,
+            .subpass_bindings = 1u  // Subpass Bindings
+        },
+        DescriptorPoolSize{
+            .buffer_bindings = 512u,   // Buffer Bindings
+            .texture_bindings = 256u,  // Texture Bindings
+            .storage_bindings = 32,
+            .subpass_bindings = 4u  // Subpass Bindings
+        },
+        DescriptorPoolSize{
+            .buffer_bindings = 2048u,   // Buffer Bindings
+            .texture_bindings = 1024u,  // Texture Bindings
+            .storage_bindings = 128u,
+            .subpass_bindings = 16u  // Subpass Bindings
+        },
+};
 
 // Holds the command pool in a background thread, recyling it when not in use.
 class BackgroundDescriptorPoolVK final {
@@ -35,7 +52,7 @@ class BackgroundDescriptorPoolVK final {
   BackgroundDescriptorPoolVK(BackgroundDescriptorPoolVK&&) = default;
 
   explicit BackgroundDescriptorPoolVK(
-      vk::UniqueDescriptorPool&& pool,
+      DescriptorPoolRecyclerVK::RecycledPool&& pool,
       std::weak_ptr<DescriptorPoolRecyclerVK> recycler)
       : pool_(std::move(pool)), recycler_(std::move(recycler)) {}
 
@@ -59,8 +76,7 @@ class BackgroundDescriptorPoolVK final {
   BackgroundDescriptorPoolVK& operator=(const BackgroundDescriptorPoolVK&) =
       delete;
 
-  vk::UniqueDescriptorPool pool_;
-  uint32_t allocated_capacity_;
+  DescriptorPoolRecyclerVK::RecycledPool pool_;
   std::weak_ptr<DescriptorPoolRecyclerVK> recycler_;
 };
 
@@ -80,6 +96,7 @@ DescriptorPoolVK::~DescriptorPoolVK() {
   if (!recycler) {
     return;
   }
+  recycler->RecordUsage(allocated_set_count_);
 
   for (auto i = 0u; i < pools_.size(); i++) {
     auto reset_pool_when_dropped =
@@ -98,6 +115,11 @@ fml::StatusOr<vk::DescriptorSet> DescriptorPoolVK::AllocateDescriptorSets(
     CreateNewPool(context_vk);
   }
 
+  if (pools_.empty()) {
+    return fml::Status(fml::StatusCode::kUnknown,
+                       "Failed to create descriptor pool");
+  }
+
   vk::DescriptorSetAllocateInfo set_info;
   set_info.setDescriptorPool(pools_.back().get());
   set_info.setPSetLayouts(&layout);
@@ -107,7 +129,10 @@ fml::StatusOr<vk::DescriptorSet> DescriptorPoolVK::AllocateDescriptorSets(
   auto result = context_vk.GetDevice().allocateDescriptorSets(&set_info, &set);
   if (result == vk::Result::eErrorOutOfPoolMemory) {
     // If the pool ran out of memory, we need to create a new pool.
-    CreateNewPool(context_vk);
+    if (!CreateNewPool(context_vk).ok()) {
+      return fml::Status(fml::StatusCode::kUnknown,
+                         "Failed to create descriptor pool");
+    }
     set_info.setDescriptorPool(pools_.back().get());
     result = context_vk.GetDevice().allocateDescriptorSets(&set_info, &set);
   }
@@ -117,6 +142,7 @@ fml::StatusOr<vk::DescriptorSet> DescriptorPoolVK::AllocateDescriptorSets(
                    << vk::to_string(result);
     return fml::Status(fml::StatusCode::kUnknown, "");
   }
+  allocated_set_count_++;
   return set;
 }
 
@@ -130,7 +156,19 @@ fml::Status DescriptorPoolVK::CreateNewPool(const ContextVK& context_vk) {
   return fml::Status();
 }
 
-void DescriptorPoolRecyclerVK::Reclaim(vk::UniqueDescriptorPool&& pool) {
+DescriptorPoolRecyclerVK::DescriptorPoolRecyclerVK(
+    std::weak_ptr<ContextVK> context)
+    : context_(std::move(context)),
+      free_lists_(kMaxRecycledPools),
+      observed_set_count_(GetMaxSets(kDefaultSizeClass)) {}
+
+uint32_t DescriptorPoolRecyclerVK::GetMaxSets(size_t size_class) {
+  const DescriptorPoolSize& size = kSizeClasses[size_class];
+  return size.texture_bindings + size.buffer_bindings +
+         size.storage_bindings + size.subpass_bindings;
+}
+
+void DescriptorPoolRecyclerVK::Reclaim(RecycledPool&& pool) {
   // Reset the pool on a background thread.
   auto strong_context = context_.lock();
   if (!strong_context) {
@@ -139,63 +177,96 @@ void DescriptorPoolRecyclerVK::Reclaim(vk::UniqueDescriptorPool&& pool) {
   auto device = strong_context->GetDevice();
   device.resetDescriptorPool(pool.get());
 
-  // Move the pool to the recycled list.
-  Lock recycled_lock(recycled_mutex_);
-
-  if (recycled_.size() < kMaxRecycledPools) {
-    recycled_.push_back(std::move(pool));
+  // Hand the pool back to the thread that used it. If that thread's list is
+  // full, the pool is destroyed here instead.
+  auto owner = pool.owner.lock();
+  if (!owner) {
     return;
   }
+  owner->Return(std::move(pool));
+}
+
+void DescriptorPoolRecyclerVK::RecordUsage(size_t descriptor_set_count) {
+  // Track a peak that decays by an eighth for every lower count recorded, so
+  // that a single heavy frame doesn't pin the size class forever.
+  size_t observed = observed_set_count_.load(std::memory_order_relaxed);
+  size_t updated;
+  do {
+    updated = std::max(descriptor_set_count, observed - observed / 8u);
+  } while (!observed_set_count_.compare_exchange_weak(
+      observed, updated, std::memory_order_relaxed));
+}
+
+size_t DescriptorPoolRecyclerVK::GetPreferredSizeClass() const {
+  const size_t observed = observed_set_count_.load(std::memory_order_relaxed);
+  for (size_t size_class = 0u; size_class < kSizeClassCount; size_class++) {
+    if (observed <= GetMaxSets(size_class)) {
+      return size_class;
+    }
+  }
+  return kSizeClassCount - 1u;
 }
 
-vk::UniqueDescriptorPool DescriptorPoolRecyclerVK::Get() {
+DescriptorPoolRecyclerVK::RecycledPool DescriptorPoolRecyclerVK::Get() {
+  const size_t size_class = GetPreferredSizeClass();
+  std::shared_ptr<ThreadFreeListVK<RecycledPool>> free_list =
+      free_lists_.GetForCurrentThread();
+
   // Recycle a pool with a matching minumum capcity if it is available.
-  auto recycled_pool = Reuse();
-  if (recycled_pool.has_value()) {
-    return std::move(recycled_pool.value());
+  auto recycled_pool = Reuse(*free_list, size_class);
+  if (!recycled_pool.has_value() && free_lists_.StealInto(*free_list)) {
+    recycled_pool = Reuse(*free_list, size_class);
   }
-  return Create();
+  RecycledPool pool = recycled_pool.has_value()
+                          ? std::move(recycled_pool.value())
+                          : Create(size_class);
+  pool.owner = free_list;
+  return pool;
 }
 
-vk::UniqueDescriptorPool DescriptorPoolRecyclerVK::Create() {
+DescriptorPoolRecyclerVK::RecycledPool DescriptorPoolRecyclerVK::Create(
+    size_t size_class) {
   auto strong_context = context_.lock();
   if (!strong_context) {
     VALIDATION_LOG << "Unable to create a descriptor pool";
     return {};
   }
 
+  const DescriptorPoolSize& size = kSizeClasses[size_class];
   std::vector<vk::DescriptorPoolSize> pools = {
       vk::DescriptorPoolSize{vk::DescriptorType::eCombinedImageSampler,
-                             kDefaultBindingSize.texture_bindings},
+                             static_cast<uint32_t>(size.texture_bindings)},
       vk::DescriptorPoolSize{vk::DescriptorType::eUniformBuffer,
-                             kDefaultBindingSize.buffer_bindings},
+                             static_cast<uint32_t>(size.buffer_bindings)},
       vk::DescriptorPoolSize{vk::DescriptorType::eStorageBuffer,
-                             kDefaultBindingSize.storage_bindings},
+                             static_cast<uint32_t>(size.storage_bindings)},
       vk::DescriptorPoolSize{vk::DescriptorType::eInputAttachment,
-                             kDefaultBindingSize.subpass_bindings}};
+                             static_cast<uint32_t>(size.subpass_bindings)}};
   vk::DescriptorPoolCreateInfo pool_info;
-  pool_info.setMaxSets(kDefaultBindingSize.texture_bindings +
-                       kDefaultBindingSize.buffer_bindings +
-                       kDefaultBindingSize.storage_bindings +
-                       kDefaultBindingSize.subpass_bindings);
+  pool_info.setMaxSets(GetMaxSets(size_class));
   pool_info.setPoolSizes(pools);
   auto [result, pool] =
       strong_context->GetDevice().createDescriptorPoolUnique(pool_info);
   if (result != vk::Result::eSuccess) {
     VALIDATION_LOG << "Unable to create a descriptor pool";
   }
-  return std::move(pool);
+  return RecycledPool{.pool = std::move(pool), .size_class = size_class};
 }
 
-std::optional<vk::UniqueDescriptorPool> DescriptorPoolRecyclerVK::Reuse() {
-  Lock lock(recycled_mutex_);
-  if (recycled_.empty()) {
-    return std::nullopt;
+std::optional<DescriptorPoolRecyclerVK::RecycledPool>
+DescriptorPoolRecyclerVK::Reuse(ThreadFreeListVK<RecycledPool>& free_list,
+                                size_t size_class) {
+  // Prefer the smallest pool that is at least as large as requested.
+  for (size_t candidate = size_class; candidate < kSizeClassCount;
+       candidate++) {
+    auto recycled = free_list.Take([candidate](const RecycledPool& pool) {
+      return pool.size_class == candidate;
+    });
+    if (recycled.has_value()) {
+      return recycled;
+    }
   }
-
-  auto recycled = std::move(recycled_[recycled_.size() - 1]);
-  recycled_.pop_back();
-  return recycled;
+  return std::nullopt;
 }
 
 }  // namespace impeller
@@ -5,97 +5,141 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_DESCRIPTOR_POOL_VK_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_DESCRIPTOR_POOL_VK_H_
 
+#include <atomic>
 #include <cstdint>
 
 #include "fml/status_or.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
+#include "impeller/renderer/backend/vulkan/thread_free_list_vk.h"
 #include "vulkan/vulkan_handles.hpp"
 
 namespace impeller {
 
 //------------------------------------------------------------------------------
-/// @brief      A per-frame descriptor pool. Descriptors
-///             from this pool don't need to be freed individually. Instead, the
-///             pool must be collected after all the descriptors allocated from
-///             it are done being used.
+/// @brief      Creates and manages the lifecycle of |vk::DescriptorPoolVK|
+///             objects.
 ///
-///             The pool or it's descriptors may not be accessed from multiple
-///             threads.
+///             Pools are created in a few size classes. The class of new pools
+///             is picked from the number of descriptor sets recently allocated
+///             by each |DescriptorPoolVK|, so that light workloads don't hold
+///             on to large pools and heavy ones don't have to chain many small
+///             ones.
 ///
-///             Encoders create pools as necessary as they have the same
-///             threading and lifecycle restrictions.
-class DescriptorPoolVK {
+///             Reset pools are handed back to the thread that last used them
+///             without locking. Threads only take a lock to pick up pools
+///             handed back to other threads when they have none of their own.
+class DescriptorPoolRecyclerVK final
+    : public std::enable_shared_from_this<DescriptorPoolRecyclerVK> {
  public:
-  explicit DescriptorPoolVK(std::weak_ptr<const ContextVK> context);
-
-  ~DescriptorPoolVK();
-
-  fml::StatusOr<vk::DescriptorSet> AllocateDescriptorSets(
-      const vk::DescriptorSetLayout& layout,
-      const ContextVK& context_vk);
+  ~DescriptorPoolRecyclerVK() = default;
 
- private:
-  std::weak_ptr<const ContextVK> context_;
-  std::vector<vk::UniqueDescriptorPool> pools_;
+  /// The maximum number of descriptor pools this recycler will hold onto for
+  /// each thread.
+  static constexpr size_t kMaxRecycledPools = 32u;
 
-  fml::Status CreateNewPool(const ContextVK& context_vk);
+  /// The number of pool size classes.
+  static constexpr size_t kSizeClassCount = 3u;
 
-  DescriptorPoolVK(const DescriptorPoolVK&) = delete;
+  /// The size class of pools created before any usage has been observed.
+  static constexpr size_t kDefaultSizeClass = 1u;
 
-  DescriptorPoolVK& operator=(const DescriptorPoolVK&) = delete;
-};
+  /// A descriptor pool along with the size class it was created with and the
+  /// free list of the thread it was handed out to.
+  struct RecycledPool {
+    vk::UniqueDescriptorPool pool;
+    size_t size_class = kDefaultSizeClass;
+    std::weak_ptr<ThreadFreeListVK<RecycledPool>> owner;
 
-//------------------------------------------------------------------------------
-/// @brief      Creates and manages the lifecycle of |vk::DescriptorPoolVK|
-///             objects.
-class DescriptorPoolRecyclerVK final
-    : public std::enable_shared_from_this<DescriptorPoolRecyclerVK> {
- public:
-  ~DescriptorPoolRecyclerVK() = default;
+    vk::DescriptorPool get() const { return pool.get(); }
 
-  /// The maximum number of descriptor pools this recycler will hold onto.
-  static constexpr size_t kMaxRecycledPools = 32u;
+    explicit operator bool() const { return !!pool; }
+  };
 
   /// @brief      Creates a recycler for the given |ContextVK|.
   ///
   /// @param[in]  context The context to create the recycler for.
-  explicit DescriptorPoolRecyclerVK(std::weak_ptr<ContextVK> context)
-      : context_(std::move(context)) {}
+  explicit DescriptorPoolRecyclerVK(std::weak_ptr<ContextVK> context);
+
+  /// @brief      The maximum number of descriptor sets that can be allocated
+  ///             from a pool of the given size class.
+  static uint32_t GetMaxSets(size_t size_class);
 
   /// @brief      Gets a descriptor pool.
   ///
   ///             This may create a new descriptor pool if no existing pools had
   ///             the necessary capacity.
-  vk::UniqueDescriptorPool Get();
+  RecycledPool Get();
 
   /// @brief      Returns the descriptor pool to be reset on a background
   ///             thread.
   ///
   /// @param[in]  pool The pool to recycler.
-  void Reclaim(vk::UniqueDescriptorPool&& pool);
+  void Reclaim(RecycledPool&& pool);
+
+  /// @brief      Record the number of descriptor sets allocated by a
+  ///             |DescriptorPoolVK| over its lifetime.
+  void RecordUsage(size_t descriptor_set_count);
+
+  /// @brief      The size class new pools are created with.
+  size_t GetPreferredSizeClass() const;
 
  private:
   std::weak_ptr<ContextVK> context_;
+  ThreadFreeListsVK<RecycledPool> free_lists_;
+  // A peak of the descriptor set counts recorded with |RecordUsage| that
+  // decays as lower counts are recorded.
+  std::atomic<size_t> observed_set_count_;
 
-  Mutex recycled_mutex_;
-  std::vector<vk::UniqueDescriptorPool> recycled_ IPLR_GUARDED_BY(
-      recycled_mutex_);
-
-  /// @brief      Creates a new |vk::CommandPool|.
+  /// @brief      Creates a new |vk::DescriptorPool|.
   ///
-  /// @returns    Returns a |std::nullopt| if a pool could not be created.
-  vk::UniqueDescriptorPool Create();
+  /// @returns    Returns an empty pool if a pool could not be created.
+  RecycledPool Create(size_t size_class);
 
-  /// @brief      Reuses a recycled |vk::CommandPool|, if available.
+  /// @brief      Reuses a recycled pool of at least the given size class, if
+  ///             available.
   ///
   /// @returns    Returns a |std::nullopt| if a pool was not available.
-  std::optional<vk::UniqueDescriptorPool> Reuse();
+  std::optional<RecycledPool> Reuse(ThreadFreeListVK<RecycledPool>& free_list,
+                                    size_t size_class);
 
   DescriptorPoolRecyclerVK(const DescriptorPoolRecyclerVK&) = delete;
 
   DescriptorPoolRecyclerVK& operator=(const DescriptorPoolRecyclerVK&) = delete;
 };
 
+//------------------------------------------------------------------------------
+/// @brief      A per-frame descriptor pool. Descriptors
+///             from this pool don't need to be freed individually. Instead, the
+///             pool must be collected after all the descriptors allocated from
+///             it are done being used.
+///
+///             The pool or it's descriptors may not be accessed from multiple
+///             threads.
+///
+///             Encoders create pools as necessary as they have the same
+///             threading and lifecycle restrictions.
+class DescriptorPoolVK {
+ public:
+  explicit DescriptorPoolVK(std::weak_ptr<const ContextVK> context);
+
+  ~DescriptorPoolVK();
+
+  fml::StatusOr<vk::DescriptorSet> AllocateDescriptorSets(
+      const vk::DescriptorSetLayout& layout,
+      const ContextVK& context_vk);
+
+ private:
+  std::weak_ptr<const ContextVK> context_;
+  std::vector<DescriptorPoolRecyclerVK::RecycledPool> pools_;
+  size_t allocated_set_count_ = 0u;
+
+  fml::Status CreateNewPool(const ContextVK& context_vk);
+
+  DescriptorPoolVK(const DescriptorPoolVK&) = delete;
+
+  DescriptorPoolVK& operator=(const DescriptorPoolVK&) = delete;
+};
+
 }  // namespace impeller
 
 #endif  // FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_DESCRIPTOR_POOL_VK_H_
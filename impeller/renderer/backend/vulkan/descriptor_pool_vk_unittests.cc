@@ -124,6 +124,30 @@ TEST(DescriptorPoolRecyclerVKTest, ReclaimDropsDescriptorPoolIfSizeIsExceeded) {
   context->Shutdown();
 }
 
+TEST(DescriptorPoolRecyclerVKTest, NewPoolsAreSizedFromObservedUsage) {
+  auto const context = MockVulkanContextBuilder().Build();
+  auto const recycler = context->GetDescriptorPoolRecycler();
+
+  EXPECT_EQ(recycler->GetPreferredSizeClass(),
+            DescriptorPoolRecyclerVK::kDefaultSizeClass);
+
+  // Light usage shrinks new pools once the observed peak has decayed.
+  for (auto i = 0u; i < 64u; i++) {
+    recycler->RecordUsage(1u);
+  }
+  EXPECT_EQ(recycler->GetPreferredSizeClass(), 0u);
+  EXPECT_EQ(recycler->Get().size_class, 0u);
+
+  // Heavy usage grows them immediately.
+  recycler->RecordUsage(DescriptorPoolRecyclerVK::GetMaxSets(
+                            DescriptorPoolRecyclerVK::kDefaultSizeClass) +
+                        1u);
+  EXPECT_EQ(recycler->GetPreferredSizeClass(),
+            DescriptorPoolRecyclerVK::kSizeClassCount - 1u);
+
+  context->Shutdown();
+}
+
 TEST(DescriptorPoolRecyclerVKTest, MultipleCommandBuffersShareDescriptorPool) {
   auto const context = MockVulkanContextBuilder().Build();
 
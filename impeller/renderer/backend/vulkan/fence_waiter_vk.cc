@@ -52,8 +52,43 @@ class WaitSetEntry {
   WaitSetEntry& operator=(WaitSetEntry&&) = delete;
 };
 
-FenceWaiterVK::FenceWaiterVK(std::weak_ptr<DeviceHolderVK> device_holder)
+class TimelineWaitSetEntry {
+ public:
+  TimelineWaitSetEntry(uint64_t p_value, const fml::closure& p_callback)
+      : value_(p_value), callback_(fml::ScopedCleanupClosure{p_callback}) {}
+
+  uint64_t GetValue() const { return value_; }
+
+ private:
+  uint64_t value_;
+  fml::ScopedCleanupClosure callback_;
+
+  TimelineWaitSetEntry(const TimelineWaitSetEntry&) = delete;
+
+  TimelineWaitSetEntry& operator=(const TimelineWaitSetEntry&) = delete;
+};
+
+FenceWaiterVK::FenceWaiterVK(std::weak_ptr<DeviceHolderVK> device_holder,
+                             std::shared_ptr<QueueVK> timeline_queue)
     : device_holder_(std::move(device_holder)) {
+  auto strong_device_holder = device_holder_.lock();
+  if (timeline_queue && strong_device_holder) {
+    vk::StructureChain<vk::SemaphoreCreateInfo, vk::SemaphoreTypeCreateInfoKHR>
+        semaphore_info;
+    semaphore_info.get<vk::SemaphoreTypeCreateInfoKHR>()
+        .setSemaphoreType(vk::SemaphoreType::eTimeline)
+        .setInitialValue(0u);
+    auto [result, semaphore] =
+        strong_device_holder->GetDevice().createSemaphoreUnique(
+            semaphore_info.get());
+    if (result == vk::Result::eSuccess) {
+      timeline_semaphore_ = std::move(semaphore);
+      timeline_queue_ = std::move(timeline_queue);
+    } else {
+      VALIDATION_LOG << "Could not create timeline semaphore: "
+                     << vk::to_string(result) << ". Falling back to fences.";
+    }
+  }
   waiter_thread_ = std::make_unique<std::thread>([&]() { Main(); });
 }
 
@@ -79,6 +114,67 @@ bool FenceWaiterVK::AddFence(vk::UniqueFence fence,
   return true;
 }
 
+bool FenceWaiterVK::UsesTimelineSemaphore() const {
+  return !!timeline_semaphore_;
+}
+
+vk::Result FenceWaiterVK::Submit(const vk::SubmitInfo& submit_info,
+                                 const fml::closure& callback) {
+  if (!UsesTimelineSemaphore() || !callback) {
+    return vk::Result::eErrorInitializationFailed;
+  }
+  FML_DCHECK(submit_info.pNext == nullptr);
+  {
+    std::scoped_lock lock(wait_set_mutex_);
+    if (terminate_) {
+      return vk::Result::eErrorDeviceLost;
+    }
+  }
+
+  // The value must be reserved and submitted under the same lock. Otherwise,
+  // a submission with a larger value could reach the queue first and the
+  // semaphore would be signaled out of order.
+  std::scoped_lock submit_lock(timeline_submit_mutex_);
+  const uint64_t value = last_submitted_value_ + 1u;
+
+  std::vector<vk::Semaphore> signal_semaphores(
+      submit_info.pSignalSemaphores,
+      submit_info.pSignalSemaphores + submit_info.signalSemaphoreCount);
+  signal_semaphores.push_back(timeline_semaphore_.get());
+  // Values for binary semaphores are ignored.
+  std::vector<uint64_t> signal_values(signal_semaphores.size(), 0u);
+  signal_values.back() = value;
+  std::vector<uint64_t> wait_values(submit_info.waitSemaphoreCount, 0u);
+
+  vk::TimelineSemaphoreSubmitInfoKHR timeline_info;
+  timeline_info.setSignalSemaphoreValues(signal_values);
+  timeline_info.setWaitSemaphoreValues(wait_values);
+
+  vk::SubmitInfo info = submit_info;
+  info.setSignalSemaphores(signal_semaphores);
+  info.setPNext(&timeline_info);
+
+  auto result = timeline_queue_->Submit(info, {});
+  if (result != vk::Result::eSuccess) {
+    return result;
+  }
+  last_submitted_value_ = value;
+
+  {
+    // Values only increase under the submit lock, so the wait set stays
+    // sorted.
+    std::scoped_lock lock(wait_set_mutex_);
+    timeline_wait_set_.emplace_back(
+        std::make_unique<TimelineWaitSetEntry>(value, callback));
+  }
+  wait_set_cv_.notify_one();
+  return vk::Result::eSuccess;
+}
+
+uint64_t FenceWaiterVK::GetCompletedTimelineValue() const {
+  return completed_value_.load(std::memory_order_acquire);
+}
+
 static std::vector<vk::Fence> GetFencesForWaitSet(const WaitSet& set) {
   std::vector<vk::Fence> fences;
   for (const auto& entry : set) {
@@ -103,8 +199,10 @@ void FenceWaiterVK::Main() {
       std::unique_lock lock(wait_set_mutex_);
 
       // If there are no fences to wait on, wait on the condition variable.
-      wait_set_cv_.wait(lock,
-                        [&]() { return !wait_set_.empty() || terminate_; });
+      wait_set_cv_.wait(lock, [&]() {
+        return !wait_set_.empty() || !timeline_wait_set_.empty() ||
+               terminate_;
+      });
 
       // Still under the lock, check if the waiter has been terminated.
       terminate = terminate_;
@@ -125,7 +223,7 @@ void FenceWaiterVK::WaitUntilEmpty() {
   // Note, there is no lock because once terminate_ is set to true, no other
   // fence can be added to the wait set. Just in case, here's a FML_DCHECK:
   FML_DCHECK(terminate_) << "Fence waiter must be terminated.";
-  while (!wait_set_.empty() && Wait()) {
+  while ((!wait_set_.empty() || !timeline_wait_set_.empty()) && Wait()) {
     // Intentionally empty.
   }
 }
@@ -133,9 +231,13 @@ void FenceWaiterVK::WaitUntilEmpty() {
 bool FenceWaiterVK::Wait() {
   // Snapshot the wait set and wait on the fences.
   WaitSet wait_set;
+  uint64_t pending_timeline_value = 0u;
   {
     std::scoped_lock lock(wait_set_mutex_);
     wait_set = wait_set_;
+    if (!timeline_wait_set_.empty()) {
+      pending_timeline_value = timeline_wait_set_.front()->GetValue();
+    }
   }
 
   using namespace std::literals::chrono_literals;
@@ -153,6 +255,9 @@ bool FenceWaiterVK::Wait() {
   // a timeout will bail out the wait.
   auto fences = GetFencesForWaitSet(wait_set);
   if (fences.empty()) {
+    if (pending_timeline_value > 0u) {
+      return WaitForTimeline(device, pending_timeline_value);
+    }
     return true;
   }
 
@@ -201,9 +306,62 @@ bool FenceWaiterVK::Wait() {
     erased_entries.clear();  // Bit redundant because of scope but hey.
   }
 
+  if (pending_timeline_value > 0u) {
+    DispatchCompletedTimelineEntries(device);
+  }
+
+  return true;
+}
+
+bool FenceWaiterVK::WaitForTimeline(const vk::Device& device, uint64_t value) {
+  using namespace std::literals::chrono_literals;
+
+  // Only the oldest pending value is waited on. Every value up to the one the
+  // semaphore has actually reached is dispatched after the wait, so a single
+  // wake-up may retire many submissions.
+  vk::Semaphore semaphore = timeline_semaphore_.get();
+  vk::SemaphoreWaitInfoKHR wait_info;
+  wait_info.setSemaphores(semaphore);
+  wait_info.setValues(value);
+  auto result = device.waitSemaphoresKHR(
+      wait_info, /*timeout=*/std::chrono::nanoseconds{100ms}.count());
+  if (!(result == vk::Result::eSuccess || result == vk::Result::eTimeout)) {
+    VALIDATION_LOG << "Fence waiter encountered an unexpected error waiting "
+                      "on the timeline semaphore. Tearing down the waiter "
+                      "thread.";
+    return false;
+  }
+
+  DispatchCompletedTimelineEntries(device);
   return true;
 }
 
+void FenceWaiterVK::DispatchCompletedTimelineEntries(const vk::Device& device) {
+  auto [result, completed_value] =
+      device.getSemaphoreCounterValueKHR(timeline_semaphore_.get());
+  if (result != vk::Result::eSuccess) {
+    return;
+  }
+  completed_value_.store(completed_value, std::memory_order_release);
+
+  // As with fences, the callbacks must not be invoked under the lock.
+  TimelineWaitSet completed_entries;
+  {
+    std::scoped_lock lock(wait_set_mutex_);
+    auto pending = std::find_if(
+        timeline_wait_set_.begin(), timeline_wait_set_.end(),
+        [&](const auto& entry) { return entry->GetValue() > completed_value; });
+    std::move(timeline_wait_set_.begin(), pending,
+              std::back_inserter(completed_entries));
+    timeline_wait_set_.erase(timeline_wait_set_.begin(), pending);
+  }
+
+  {
+    TRACE_EVENT0("impeller", "ClearSignaledTimelineEntries");
+    completed_entries.clear();
+  }
+}
+
 void FenceWaiterVK::Terminate() {
   {
     std::scoped_lock lock(wait_set_mutex_);
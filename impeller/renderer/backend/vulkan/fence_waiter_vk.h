@@ -5,21 +5,37 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_FENCE_WAITER_VK_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_FENCE_WAITER_VK_H_
 
+#include <atomic>
 #include <condition_variable>
+#include <cstdint>
 #include <memory>
 #include <thread>
 #include <vector>
 
 #include "flutter/fml/closure.h"
 #include "impeller/renderer/backend/vulkan/device_holder_vk.h"
+#include "impeller/renderer/backend/vulkan/queue_vk.h"
 
 namespace impeller {
 
 class ContextVK;
 class WaitSetEntry;
+class TimelineWaitSetEntry;
 
 using WaitSet = std::vector<std::shared_ptr<WaitSetEntry>>;
-
+using TimelineWaitSet = std::vector<std::unique_ptr<TimelineWaitSetEntry>>;
+
+//------------------------------------------------------------------------------
+/// @brief      Invokes callbacks on a dedicated thread once the GPU work they
+///             are associated with has completed.
+///
+///             When the device supports timeline semaphores, submissions to
+///             the timeline queue signal one monotonically increasing value
+///             on a single semaphore. The waiter then blocks on the smallest
+///             pending value and dispatches the callbacks of every submission
+///             that has completed in one batch. Otherwise, each submission is
+///             tracked with its own fence.
+///
 class FenceWaiterVK {
  public:
   ~FenceWaiterVK();
@@ -30,21 +46,72 @@ class FenceWaiterVK {
 
   bool AddFence(vk::UniqueFence fence, const fml::closure& callback);
 
+  //----------------------------------------------------------------------------
+  /// @return     If submissions are tracked using a timeline semaphore. If
+  ///             not, callers must use |AddFence| instead of |Submit|.
+  ///
+  bool UsesTimelineSemaphore() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Submits work to the timeline queue and invokes the callback
+  ///             once the work has completed on the GPU.
+  ///
+  ///             The submission additionally signals the next value of the
+  ///             timeline semaphore. Values are assigned under the same lock
+  ///             as the queue submission so they are ordered the same way as
+  ///             the submissions themselves.
+  ///
+  /// @param[in]  submit_info  The submission. Must not chain its own
+  ///                          |vk::TimelineSemaphoreSubmitInfo|.
+  /// @param[in]  callback     The callback to invoke on completion.
+  ///
+  /// @return     The result of the queue submission. The callback is only
+  ///             retained if the submission succeeded.
+  ///
+  vk::Result Submit(const vk::SubmitInfo& submit_info,
+                    const fml::closure& callback);
+
+  //----------------------------------------------------------------------------
+  /// @return     The largest timeline value known to have been reached by the
+  ///             GPU. All work submitted via |Submit| with a value less than
+  ///             or equal to this one has completed. Always zero when timeline
+  ///             semaphores are not in use.
+  ///
+  uint64_t GetCompletedTimelineValue() const;
+
  private:
   friend class ContextVK;
 
   std::weak_ptr<DeviceHolderVK> device_holder_;
+  std::shared_ptr<QueueVK> timeline_queue_;
+  vk::UniqueSemaphore timeline_semaphore_;
+  std::mutex timeline_submit_mutex_;
+  uint64_t last_submitted_value_ = 0u;
+  std::atomic<uint64_t> completed_value_ = 0u;
   std::unique_ptr<std::thread> waiter_thread_;
   std::mutex wait_set_mutex_;
   std::condition_variable wait_set_cv_;
   WaitSet wait_set_;
+  TimelineWaitSet timeline_wait_set_;
   bool terminate_ = false;
 
-  explicit FenceWaiterVK(std::weak_ptr<DeviceHolderVK> device_holder);
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a fence waiter.
+  ///
+  /// @param[in]  device_holder   The device holder.
+  /// @param[in]  timeline_queue  If not null, the queue work submitted via
+  ///                             |Submit| goes to. A timeline semaphore is
+  ///                             created to track it. If the semaphore cannot
+  ///                             be created, the waiter falls back to fences.
+  ///
+  explicit FenceWaiterVK(std::weak_ptr<DeviceHolderVK> device_holder,
+                         std::shared_ptr<QueueVK> timeline_queue = nullptr);
 
   void Main();
 
   bool Wait();
+  bool WaitForTimeline(const vk::Device& device, uint64_t value);
+  void DispatchCompletedTimelineEntries(const vk::Device& device);
   void WaitUntilEmpty();
 
   FenceWaiterVK(const FenceWaiterVK&) = delete;
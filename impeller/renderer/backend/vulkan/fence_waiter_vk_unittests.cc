@@ -2,10 +2,13 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+
 #include "fml/synchronization/waitable_event.h"
 #include "gtest/gtest.h"  // IWYU pragma: keep
 #include "impeller/renderer/backend/vulkan/fence_waiter_vk.h"  // IWYU pragma: keep
 #include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+#include "impeller/renderer/command_buffer.h"
 
 namespace impeller {
 namespace testing {
@@ -126,5 +129,54 @@ TEST(FenceWaiterVKTest, InProgressFencesStillWaitIfTerminated) {
   signal.Wait();
 }
 
+static std::shared_ptr<ContextVK> CreateTimelineSemaphoreContext() {
+  return MockVulkanContextBuilder()
+      .SetDeviceExtensions({"VK_KHR_swapchain", "VK_KHR_timeline_semaphore"})
+      .Build();
+}
+
+TEST(FenceWaiterVKTest, UsesFencesWithoutTimelineSemaphoreExtension) {
+  auto const context = MockVulkanContextBuilder().Build();
+  auto const waiter = context->GetFenceWaiter();
+
+  EXPECT_FALSE(waiter->UsesTimelineSemaphore());
+  EXPECT_EQ(waiter->Submit({}, []() {}),
+            vk::Result::eErrorInitializationFailed);
+}
+
+TEST(FenceWaiterVKTest, ExecutesTimelineCallbacks) {
+  auto const context = CreateTimelineSemaphoreContext();
+  auto const waiter = context->GetFenceWaiter();
+  ASSERT_TRUE(waiter->UsesTimelineSemaphore());
+
+  auto signal = fml::ManualResetWaitableEvent();
+  auto signal2 = fml::ManualResetWaitableEvent();
+  EXPECT_EQ(waiter->Submit({}, [&signal]() { signal.Signal(); }),
+            vk::Result::eSuccess);
+  EXPECT_EQ(waiter->Submit({}, [&signal2]() { signal2.Signal(); }),
+            vk::Result::eSuccess);
+
+  signal.Wait();
+  signal2.Wait();
+  EXPECT_EQ(waiter->GetCompletedTimelineValue(), 2u);
+}
+
+TEST(FenceWaiterVKTest, CommandQueueSubmitsWithoutFenceOnTimeline) {
+  auto const context = CreateTimelineSemaphoreContext();
+
+  auto signal = fml::ManualResetWaitableEvent();
+  auto buffer = context->CreateCommandBuffer();
+  auto status = context->GetCommandQueue()->Submit(
+      {buffer}, [&signal](CommandBuffer::Status status) {
+        EXPECT_EQ(status, CommandBuffer::Status::kCompleted);
+        signal.Signal();
+      });
+  ASSERT_TRUE(status.ok());
+  signal.Wait();
+
+  auto const called = GetMockVulkanFunctions(context->GetDevice());
+  EXPECT_EQ(std::count(called->begin(), called->end(), "vkCreateFence"), 0);
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -4,11 +4,14 @@
 
 #include "impeller/renderer/backend/vulkan/render_pass_vk.h"
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
+#include <thread>
 #include <vector>
 
 #include "fml/status.h"
+#include "fml/synchronization/count_down_latch.h"
 #include "impeller/base/validation.h"
 #include "impeller/core/buffer_view.h"
 #include "impeller/core/device_buffer.h"
@@ -17,6 +20,7 @@
 #include "impeller/core/vertex_buffer.h"
 #include "impeller/renderer/backend/vulkan/barrier_vk.h"
 #include "impeller/renderer/backend/vulkan/command_buffer_vk.h"
+#include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/device_buffer_vk.h"
 #include "impeller/renderer/backend/vulkan/formats_vk.h"
@@ -191,18 +195,6 @@ RenderPassVK::RenderPassVK(const std::shared_ptr<const Context>& context,
     TextureVK::Cast(*resolve_image_vk_).SetCachedRenderPass(render_pass_);
   }
 
-  auto clear_values = GetVKClearValues(render_target_);
-
-  vk::RenderPassBeginInfo pass_info;
-  pass_info.renderPass = *render_pass_;
-  pass_info.framebuffer = *framebuffer;
-  pass_info.renderArea.extent.width = static_cast<uint32_t>(target_size.width);
-  pass_info.renderArea.extent.height =
-      static_cast<uint32_t>(target_size.height);
-  pass_info.setClearValues(clear_values);
-
-  command_buffer_vk_.beginRenderPass(pass_info, vk::SubpassContents::eInline);
-
   // Set the initial viewport.
   const auto vp = Viewport{.rect = Rect::MakeSize(target_size)};
   vk::Viewport viewport = vk::Viewport()
@@ -211,7 +203,6 @@ RenderPassVK::RenderPassVK(const std::shared_ptr<const Context>& context,
                               .setY(vp.rect.GetHeight())
                               .setMinDepth(0.0f)
                               .setMaxDepth(1.0f);
-  command_buffer_vk_.setViewport(0, 1, &viewport);
 
   // Set the initial scissor.
   const auto sc = IRect::MakeSize(target_size);
@@ -219,6 +210,25 @@ RenderPassVK::RenderPassVK(const std::shared_ptr<const Context>& context,
       vk::Rect2D()
           .setOffset(vk::Offset2D(sc.GetX(), sc.GetY()))
           .setExtent(vk::Extent2D(sc.GetWidth(), sc.GetHeight()));
+
+  // When encoding may be split across threads, the pass is only begun once
+  // all of its draws have been recorded.
+  encoding_worker_count_ = vk_context.GetRenderPassEncodingWorkerCount();
+  if (IsEncodingDeferred()) {
+    framebuffer_ = framebuffer;
+    pending_draw_.viewport = viewport;
+    pending_draw_.scissor = scissor;
+    pending_draw_.stencil_reference = 0u;
+    is_valid_ = true;
+    return;
+  }
+
+  auto clear_values = GetVKClearValues(render_target_);
+  command_buffer_vk_.beginRenderPass(
+      GetRenderPassBeginInfo(*framebuffer, clear_values),
+      vk::SubpassContents::eInline);
+
+  command_buffer_vk_.setViewport(0, 1, &viewport);
   command_buffer_vk_.setScissor(0, 1, &scissor);
 
   // Set the initial stencil reference.
@@ -230,6 +240,21 @@ RenderPassVK::RenderPassVK(const std::shared_ptr<const Context>& context,
 
 RenderPassVK::~RenderPassVK() = default;
 
+vk::RenderPassBeginInfo RenderPassVK::GetRenderPassBeginInfo(
+    const vk::Framebuffer& framebuffer,
+    const std::vector<vk::ClearValue>& clear_values) const {
+  const auto& target_size = render_target_.GetRenderTargetSize();
+
+  vk::RenderPassBeginInfo pass_info;
+  pass_info.renderPass = *render_pass_;
+  pass_info.framebuffer = framebuffer;
+  pass_info.renderArea.extent.width = static_cast<uint32_t>(target_size.width);
+  pass_info.renderArea.extent.height =
+      static_cast<uint32_t>(target_size.height);
+  pass_info.setClearValues(clear_values);
+  return pass_info;
+}
+
 bool RenderPassVK::IsValid() const {
   return is_valid_;
 }
@@ -326,6 +351,10 @@ void RenderPassVK::SetPipeline(PipelineRef pipeline) {
 // |RenderPass|
 void RenderPassVK::SetCommandLabel(std::string_view label) {
 #ifdef IMPELLER_DEBUG
+  if (IsEncodingDeferred()) {
+    pending_draw_.label = label;
+    return;
+  }
   command_buffer_->PushDebugGroup(label);
   has_label_ = true;
 #endif  // IMPELLER_DEBUG
@@ -333,6 +362,10 @@ void RenderPassVK::SetCommandLabel(std::string_view label) {
 
 // |RenderPass|
 void RenderPassVK::SetStencilReference(uint32_t value) {
+  if (IsEncodingDeferred()) {
+    pending_draw_.stencil_reference = value;
+    return;
+  }
   command_buffer_vk_.setStencilReference(
       vk::StencilFaceFlagBits::eVkStencilFrontAndBack, value);
 }
@@ -350,6 +383,10 @@ void RenderPassVK::SetViewport(Viewport viewport) {
                                  .setY(viewport.rect.GetHeight())
                                  .setMinDepth(0.0f)
                                  .setMaxDepth(1.0f);
+  if (IsEncodingDeferred()) {
+    pending_draw_.viewport = viewport_vk;
+    return;
+  }
   command_buffer_vk_.setViewport(0, 1, &viewport_vk);
 }
 
@@ -359,6 +396,10 @@ void RenderPassVK::SetScissor(IRect scissor) {
       vk::Rect2D()
           .setOffset(vk::Offset2D(scissor.GetX(), scissor.GetY()))
           .setExtent(vk::Extent2D(scissor.GetWidth(), scissor.GetHeight()));
+  if (IsEncodingDeferred()) {
+    pending_draw_.scissor = scissor_vk;
+    return;
+  }
   command_buffer_vk_.setScissor(0, 1, &scissor_vk);
 }
 
@@ -392,6 +433,15 @@ bool RenderPassVK::SetVertexBuffer(BufferView vertex_buffers[],
     }
   }
 
+  if (IsEncodingDeferred()) {
+    std::copy_n(buffers, vertex_buffer_count,
+                pending_draw_.vertex_buffers.begin());
+    std::copy_n(vertex_buffer_offsets, vertex_buffer_count,
+                pending_draw_.vertex_buffer_offsets.begin());
+    pending_draw_.vertex_buffer_count = vertex_buffer_count;
+    return true;
+  }
+
   // Bind the vertex buffers.
   command_buffer_vk_.bindVertexBuffers(0u, vertex_buffer_count, buffers,
                                        vertex_buffer_offsets);
@@ -428,6 +478,12 @@ bool RenderPassVK::SetIndexBuffer(BufferView index_buffer,
 
     vk::Buffer index_buffer_handle =
         DeviceBufferVK::Cast(*index_buffer_view.GetBuffer()).GetBuffer();
+    if (IsEncodingDeferred()) {
+      pending_draw_.index_buffer = index_buffer_handle;
+      pending_draw_.index_buffer_offset = index_buffer_view.GetRange().offset;
+      pending_draw_.index_type = ToVKIndexType(index_type);
+      return true;
+    }
     command_buffer_vk_.bindIndexBuffer(index_buffer_handle,
                                        index_buffer_view.GetRange().offset,
                                        ToVKIndexType(index_type));
@@ -485,8 +541,6 @@ fml::Status RenderPassVK::Draw() {
   }
   const auto descriptor_set = descriptor_result.value();
   const auto pipeline_layout = pipeline_vk.GetPipelineLayout();
-  command_buffer_vk_.bindPipeline(vk::PipelineBindPoint::eGraphics,
-                                  pipeline_vk.GetPipeline());
 
   for (auto i = 0u; i < descriptor_write_offset_; i++) {
     write_workspace_[i].dstSet = descriptor_set;
@@ -495,34 +549,51 @@ fml::Status RenderPassVK::Draw() {
   context_vk.GetDevice().updateDescriptorSets(descriptor_write_offset_,
                                               write_workspace_.data(), 0u, {});
 
-  command_buffer_vk_.bindDescriptorSets(
-      vk::PipelineBindPoint::eGraphics,  // bind point
-      pipeline_layout,                   // layout
-      0,                                 // first set
-      1,                                 // set count
-      &descriptor_set,                   // sets
-      0,                                 // offset count
-      nullptr                            // offsets
-  );
-
-  if (pipeline_uses_input_attachments_) {
-    InsertBarrierForInputAttachmentRead(
-        command_buffer_vk_, TextureVK::Cast(*color_image_vk_).GetImage());
-  }
-
-  if (has_index_buffer_) {
-    command_buffer_vk_.drawIndexed(element_count_,   // index count
-                                   instance_count_,  // instance count
-                                   0u,               // first index
-                                   base_vertex_,     // vertex offset
-                                   0u                // first instance
-    );
+  if (IsEncodingDeferred()) {
+    DeferredDrawVK& draw = deferred_draws_.emplace_back(pending_draw_);
+    draw.pipeline = pipeline_vk.GetPipeline();
+    draw.pipeline_layout = pipeline_layout;
+    draw.descriptor_set = descriptor_set;
+    draw.has_index_buffer = has_index_buffer_;
+    draw.uses_input_attachments = pipeline_uses_input_attachments_;
+    draw.element_count = element_count_;
+    draw.instance_count = instance_count_;
+    draw.base_vertex = base_vertex_;
+#ifdef IMPELLER_DEBUG
+    pending_draw_.label.clear();
+#endif  // IMPELLER_DEBUG
   } else {
-    command_buffer_vk_.draw(element_count_,   // vertex count
-                            instance_count_,  // instance count
-                            base_vertex_,     // vertex offset
-                            0u                // first instance
+    command_buffer_vk_.bindPipeline(vk::PipelineBindPoint::eGraphics,
+                                    pipeline_vk.GetPipeline());
+    command_buffer_vk_.bindDescriptorSets(
+        vk::PipelineBindPoint::eGraphics,  // bind point
+        pipeline_layout,                   // layout
+        0,                                 // first set
+        1,                                 // set count
+        &descriptor_set,                   // sets
+        0,                                 // offset count
+        nullptr                            // offsets
     );
+
+    if (pipeline_uses_input_attachments_) {
+      InsertBarrierForInputAttachmentRead(
+          command_buffer_vk_, TextureVK::Cast(*color_image_vk_).GetImage());
+    }
+
+    if (has_index_buffer_) {
+      command_buffer_vk_.drawIndexed(element_count_,   // index count
+                                     instance_count_,  // instance count
+                                     0u,               // first index
+                                     base_vertex_,     // vertex offset
+                                     0u                // first instance
+      );
+    } else {
+      command_buffer_vk_.draw(element_count_,   // vertex count
+                              instance_count_,  // instance count
+                              base_vertex_,     // vertex offset
+                              0u                // first instance
+      );
+    }
   }
 
 #ifdef IMPELLER_DEBUG
@@ -646,7 +717,200 @@ bool RenderPassVK::BindResource(ShaderStage stage,
   return true;
 }
 
+void RenderPassVK::EncodeDraws(const vk::CommandBuffer& buffer,
+                               const DeferredDrawVK* draws,
+                               size_t draw_count,
+                               const vk::Image& color_image) {
+  const DeferredDrawVK* previous = nullptr;
+  for (size_t i = 0u; i < draw_count; i++) {
+    const DeferredDrawVK& draw = draws[i];
+#ifdef IMPELLER_DEBUG
+    const bool has_label = !draw.label.empty() && HasValidationLayers();
+    if (has_label) {
+      vk::DebugUtilsLabelEXT label_info;
+      label_info.pLabelName = draw.label.c_str();
+      buffer.beginDebugUtilsLabelEXT(label_info);
+    }
+#endif  // IMPELLER_DEBUG
+
+    // Dynamic state is not inherited by secondary command buffers, so it is
+    // always set before the first draw of a range.
+    if (!previous || previous->viewport != draw.viewport) {
+      buffer.setViewport(0, 1, &draw.viewport);
+    }
+    if (!previous || previous->scissor != draw.scissor) {
+      buffer.setScissor(0, 1, &draw.scissor);
+    }
+    if (!previous || previous->stencil_reference != draw.stencil_reference) {
+      buffer.setStencilReference(
+          vk::StencilFaceFlagBits::eVkStencilFrontAndBack,
+          draw.stencil_reference);
+    }
+    if (!previous || previous->pipeline != draw.pipeline) {
+      buffer.bindPipeline(vk::PipelineBindPoint::eGraphics, draw.pipeline);
+    }
+    buffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics,  // bind point
+                              draw.pipeline_layout,              // layout
+                              0,                                 // first set
+                              1,                                 // set count
+                              &draw.descriptor_set,              // sets
+                              0,                                 // offset count
+                              nullptr                            // offsets
+    );
+    if (draw.vertex_buffer_count > 0u) {
+      buffer.bindVertexBuffers(0u, draw.vertex_buffer_count,
+                               draw.vertex_buffers.data(),
+                               draw.vertex_buffer_offsets.data());
+    }
+    if (draw.has_index_buffer) {
+      buffer.bindIndexBuffer(draw.index_buffer, draw.index_buffer_offset,
+                             draw.index_type);
+    }
+    if (draw.uses_input_attachments) {
+      InsertBarrierForInputAttachmentRead(buffer, color_image);
+    }
+
+    if (draw.has_index_buffer) {
+      buffer.drawIndexed(draw.element_count,   // index count
+                         draw.instance_count,  // instance count
+                         0u,                   // first index
+                         draw.base_vertex,     // vertex offset
+                         0u                    // first instance
+      );
+    } else {
+      buffer.draw(draw.element_count,   // vertex count
+                  draw.instance_count,  // instance count
+                  draw.base_vertex,     // vertex offset
+                  0u                    // first instance
+      );
+    }
+
+#ifdef IMPELLER_DEBUG
+    if (has_label) {
+      buffer.endDebugUtilsLabelEXT();
+    }
+#endif  // IMPELLER_DEBUG
+    previous = &draw;
+  }
+}
+
+bool RenderPassVK::EncodeDeferredDrawsInParallel(
+    const ContextVK& context,
+    size_t range_count,
+    std::vector<vk::CommandBuffer>& secondary_buffers) const {
+  std::shared_ptr<CommandPoolRecyclerVK> recycler =
+      context.GetCommandPoolRecycler();
+  if (!recycler) {
+    return false;
+  }
+
+  vk::CommandBufferInheritanceInfo inheritance_info;
+  inheritance_info.renderPass = *render_pass_;
+  inheritance_info.subpass = 0u;
+  inheritance_info.framebuffer = *framebuffer_;
+
+  struct EncodedRange {
+    std::shared_ptr<CommandPoolVK> pool;
+    vk::UniqueCommandBuffer buffer;
+    bool encoded = false;
+  };
+  std::vector<EncodedRange> ranges(range_count);
+
+  const vk::Image color_image = TextureVK::Cast(*color_image_vk_).GetImage();
+  const size_t draw_count = deferred_draws_.size();
+  const std::thread::id calling_thread = std::this_thread::get_id();
+  auto encode_range = [&](size_t index) {
+    EncodedRange& range = ranges[index];
+    range.pool = recycler->Get();
+    if (range.pool) {
+      range.buffer =
+          range.pool->CreateCommandBuffer(vk::CommandBufferLevel::eSecondary);
+    }
+    if (range.buffer) {
+      vk::CommandBufferBeginInfo begin_info;
+      begin_info.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit |
+                         vk::CommandBufferUsageFlagBits::eRenderPassContinue;
+      begin_info.pInheritanceInfo = &inheritance_info;
+      if (range.buffer->begin(begin_info) == vk::Result::eSuccess) {
+        const size_t first = draw_count * index / range_count;
+        const size_t last = draw_count * (index + 1u) / range_count;
+        EncodeDraws(*range.buffer, deferred_draws_.data() + first,
+                    last - first, color_image);
+        range.encoded = range.buffer->end() == vk::Result::eSuccess;
+      }
+    }
+    // The workers never reach the end of a frame, so hand their pools back
+    // to be reset once the GPU is done with this command buffer.
+    if (std::this_thread::get_id() != calling_thread) {
+      recycler->Dispose();
+    }
+  };
+
+  // The calling thread encodes the first range instead of idling.
+  fml::CountDownLatch latch(range_count - 1u);
+  const auto task_runner = context.GetConcurrentWorkerTaskRunner();
+  for (size_t i = 1u; i < range_count; i++) {
+    task_runner->PostTask([&encode_range, &latch, i]() {
+      encode_range(i);
+      latch.CountDown();
+    });
+  }
+  encode_range(0u);
+  latch.Wait();
+
+  bool encoded = true;
+  for (EncodedRange& range : ranges) {
+    encoded = encoded && range.encoded;
+    if (range.buffer) {
+      secondary_buffers.push_back(*range.buffer);
+    }
+    command_buffer_->TrackSecondaryCommandBuffer(range.pool,
+                                                 std::move(range.buffer));
+  }
+  if (!encoded) {
+    secondary_buffers.clear();
+  }
+  return encoded;
+}
+
+void RenderPassVK::EncodeDeferredDraws(const ContextVK& context) const {
+  auto clear_values = GetVKClearValues(render_target_);
+  const vk::RenderPassBeginInfo pass_info =
+      GetRenderPassBeginInfo(*framebuffer_, clear_values);
+
+  // Reading the color attachment as an input needs a barrier within the pass,
+  // so those passes are always encoded inline.
+  const bool uses_input_attachments =
+      std::any_of(deferred_draws_.begin(), deferred_draws_.end(),
+                  [](const DeferredDrawVK& draw) {
+                    return draw.uses_input_attachments;
+                  });
+  const size_t range_count =
+      std::min(encoding_worker_count_ + 1u,
+               deferred_draws_.size() / kMinDrawsPerEncodingRange);
+
+  std::vector<vk::CommandBuffer> secondary_buffers;
+  if (range_count > 1u && !uses_input_attachments &&
+      EncodeDeferredDrawsInParallel(context, range_count, secondary_buffers)) {
+    // The ranges are executed in the order they were recorded in, so the
+    // draws (and their clip depths) are submitted exactly as they would be
+    // when encoded inline.
+    command_buffer_vk_.beginRenderPass(
+        pass_info, vk::SubpassContents::eSecondaryCommandBuffers);
+    command_buffer_vk_.executeCommands(secondary_buffers);
+    return;
+  }
+
+  command_buffer_vk_.beginRenderPass(pass_info, vk::SubpassContents::eInline);
+  EncodeDraws(command_buffer_vk_, deferred_draws_.data(),
+              deferred_draws_.size(),
+              TextureVK::Cast(*color_image_vk_).GetImage());
+}
+
 bool RenderPassVK::OnEncodeCommands(const Context& context) const {
+  if (IsEncodingDeferred()) {
+    EncodeDeferredDraws(ContextVK::Cast(*context_));
+  }
   command_buffer_->GetCommandBuffer().endRenderPass();
 
   // If this render target will be consumed by a subsequent render pass,
@@ -5,7 +5,12 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_RENDER_PASS_VK_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_RENDER_PASS_VK_H_
 
+#include <array>
+#include <string>
+#include <vector>
+
 #include "impeller/core/buffer_view.h"
+#include "impeller/core/vertex_buffer.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/pipeline_vk.h"
 #include "impeller/renderer/backend/vulkan/shared_object_vk.h"
@@ -27,6 +32,40 @@ class RenderPassVK final : public RenderPass {
  private:
   friend class CommandBufferVK;
 
+  /// The fewest draws worth encoding into a secondary command buffer on
+  /// another thread.
+  static constexpr size_t kMinDrawsPerEncodingRange = 64u;
+
+  /// Everything needed to encode a draw after it has been recorded.
+  ///
+  /// When parallel encoding is enabled, draws are recorded into a list and
+  /// only encoded once the pass is encoded, at which point the number of
+  /// draws is known and the list may be split into ranges that are encoded
+  /// on different threads. Descriptor sets are allocated and updated when the
+  /// draw is recorded.
+  struct DeferredDrawVK {
+    vk::Pipeline pipeline;
+    vk::PipelineLayout pipeline_layout;
+    vk::DescriptorSet descriptor_set;
+    std::array<vk::Buffer, kMaxVertexBuffers> vertex_buffers;
+    std::array<vk::DeviceSize, kMaxVertexBuffers> vertex_buffer_offsets;
+    uint32_t vertex_buffer_count = 0u;
+    vk::Buffer index_buffer;
+    vk::DeviceSize index_buffer_offset = 0u;
+    vk::IndexType index_type = vk::IndexType::eUint16;
+    bool has_index_buffer = false;
+    bool uses_input_attachments = false;
+    vk::Viewport viewport;
+    vk::Rect2D scissor;
+    uint32_t stencil_reference = 0u;
+    uint32_t element_count = 0u;
+    uint32_t instance_count = 1u;
+    int32_t base_vertex = 0;
+#ifdef IMPELLER_DEBUG
+    std::string label;
+#endif  // IMPELLER_DEBUG
+  };
+
   std::shared_ptr<CommandBufferVK> command_buffer_;
   std::string debug_label_;
   SharedHandleVK<vk::RenderPass> render_pass_;
@@ -53,6 +92,13 @@ class RenderPassVK final : public RenderPass {
   bool pipeline_uses_input_attachments_ = false;
   std::shared_ptr<SamplerVK> immutable_sampler_;
 
+  // Parallel encoding state.
+  size_t encoding_worker_count_ = 0u;
+  SharedHandleVK<vk::Framebuffer> framebuffer_;
+  // The bound state that the next deferred draw will use.
+  DeferredDrawVK pending_draw_;
+  std::vector<DeferredDrawVK> deferred_draws_;
+
   RenderPassVK(const std::shared_ptr<const Context>& context,
                const RenderTarget& target,
                std::shared_ptr<CommandBufferVK> command_buffer);
@@ -142,6 +188,29 @@ class RenderPassVK final : public RenderPass {
       const ContextVK& context,
       const vk::RenderPass& pass) const;
 
+  bool IsEncodingDeferred() const { return encoding_worker_count_ > 0u; }
+
+  vk::RenderPassBeginInfo GetRenderPassBeginInfo(
+      const vk::Framebuffer& framebuffer,
+      const std::vector<vk::ClearValue>& clear_values) const;
+
+  /// Begin the pass and encode the deferred draws, either inline or in
+  /// secondary command buffers encoded on the concurrent workers.
+  void EncodeDeferredDraws(const ContextVK& context) const;
+
+  /// Encode the deferred draws into secondary command buffers on the calling
+  /// thread and the concurrent workers. Returns false if any of the ranges
+  /// could not be encoded, in which case none of them may be executed.
+  bool EncodeDeferredDrawsInParallel(
+      const ContextVK& context,
+      size_t range_count,
+      std::vector<vk::CommandBuffer>& secondary_buffers) const;
+
+  static void EncodeDraws(const vk::CommandBuffer& buffer,
+                          const DeferredDrawVK* draws,
+                          size_t draw_count,
+                          const vk::Image& color_image);
+
   RenderPassVK(const RenderPassVK&) = delete;
 
   RenderPassVK& operator=(const RenderPassVK&) = delete;
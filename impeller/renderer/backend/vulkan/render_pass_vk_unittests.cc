@@ -0,0 +1,168 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstring>
+#include <vector>
+
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/testing/testing.h"  // IWYU pragma: keep
+#include "gtest/gtest.h"
+#include "impeller/core/device_buffer_descriptor.h"
+#include "impeller/core/host_buffer.h"
+#include "impeller/fixtures/instanced_draw.frag.h"
+#include "impeller/fixtures/instanced_draw.vert.h"
+#include "impeller/playground/playground_test.h"
+#include "impeller/renderer/backend/vulkan/command_buffer_vk.h"
+#include "impeller/renderer/backend/vulkan/context_vk.h"
+#include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/pipeline_builder.h"
+#include "impeller/renderer/pipeline_library.h"
+#include "impeller/renderer/render_target.h"
+#include "impeller/renderer/vertex_buffer_builder.h"
+
+namespace impeller {
+namespace testing {
+
+using RenderPassVKTest = PlaygroundTest;
+INSTANTIATE_VULKAN_PLAYGROUND_SUITE(RenderPassVKTest);
+
+namespace {
+
+using VS = InstancedDrawVertexShader;
+using FS = InstancedDrawFragmentShader;
+
+constexpr ISize kTargetSize = {256, 256};
+
+// Draws a grid of overlapping squares, each in its own color, with the
+// scissor changing between rows. Returns the pixels of the resolved target,
+// or an empty vector if the frame could not be rendered. The number of
+// secondary command buffers the pass was encoded into is written to
+// |secondary_buffer_count|.
+std::vector<uint8_t> RenderOverlappingDraws(
+    const std::shared_ptr<Context>& context,
+    const std::shared_ptr<Pipeline<PipelineDescriptor>>& pipeline,
+    size_t* secondary_buffer_count) {
+  VertexBufferBuilder<VS::PerVertexData> builder;
+  builder.AddVertices({
+      VS::PerVertexData{Point{0, 0}},
+      VS::PerVertexData{Point{0, 20}},
+      VS::PerVertexData{Point{20, 0}},
+      VS::PerVertexData{Point{0, 20}},
+      VS::PerVertexData{Point{20, 0}},
+      VS::PerVertexData{Point{20, 20}},
+  });
+
+  RenderTargetAllocator allocator(context->GetResourceAllocator());
+  RenderTarget target = allocator.CreateOffscreenMSAA(*context, kTargetSize, 1);
+  std::shared_ptr<Texture> resolve_texture =
+      target.GetColorAttachment(0).resolve_texture;
+
+  DeviceBufferDescriptor buffer_desc;
+  buffer_desc.storage_mode = StorageMode::kHostVisible;
+  buffer_desc.size =
+      resolve_texture->GetTextureDescriptor().GetByteSizeOfBaseMipLevel();
+  std::shared_ptr<DeviceBuffer> readback =
+      context->GetResourceAllocator()->CreateBuffer(buffer_desc);
+
+  auto host_buffer = HostBuffer::Create(context->GetResourceAllocator(),
+                                        context->GetIdleWaiter());
+  auto cmd_buffer = context->CreateCommandBuffer();
+  auto pass = cmd_buffer->CreateRenderPass(target);
+  if (!readback || !pass) {
+    return {};
+  }
+
+  // Enough draws to be split into several ranges. Every draw covers parts of
+  // its neighbours, so encoding any of them out of order changes the result.
+  static constexpr size_t kGridSize = 24u;
+  auto vertex_buffer = builder.CreateVertexBuffer(*host_buffer);
+  for (size_t i = 0; i < kGridSize; i++) {
+    pass->SetScissor(IRect::MakeXYWH(0, 0, kTargetSize.width, (i + 1) * 12));
+    for (size_t j = 0; j < kGridSize; j++) {
+      pass->SetPipeline(pipeline);
+
+      VS::FrameInfo frame_info;
+      frame_info.mvp = pass->GetOrthographicTransform() *
+                       Matrix::MakeTranslation({j * 10.0f, i * 10.0f, 0.0f});
+      VS::InstanceInfo<1> instances;
+      instances.colors[0] = Color(i / static_cast<Scalar>(kGridSize),
+                                  j / static_cast<Scalar>(kGridSize),
+                                  (i + j) % 2 == 0 ? 1.0f : 0.0f, 1.0f);
+      VS::BindFrameInfo(*pass, host_buffer->EmplaceUniform(frame_info));
+      VS::BindInstanceInfo(*pass, host_buffer->EmplaceStorageBuffer(instances));
+      pass->SetVertexBuffer(vertex_buffer);
+      if (!pass->Draw().ok()) {
+        return {};
+      }
+    }
+  }
+  if (!pass->EncodeCommands()) {
+    return {};
+  }
+  *secondary_buffer_count =
+      CommandBufferVK::Cast(*cmd_buffer).GetSecondaryCommandBufferCount();
+
+  auto blit_pass = cmd_buffer->CreateBlitPass();
+  if (!blit_pass || !blit_pass->AddCopy(resolve_texture, readback) ||
+      !blit_pass->EncodeCommands(context->GetResourceAllocator())) {
+    return {};
+  }
+
+  fml::AutoResetWaitableEvent latch;
+  bool completed = false;
+  if (!context->GetCommandQueue()
+           ->Submit({cmd_buffer},
+                    [&latch, &completed](CommandBuffer::Status status) {
+                      completed = status == CommandBuffer::Status::kCompleted;
+                      latch.Signal();
+                    })
+           .ok()) {
+    return {};
+  }
+  latch.Wait();
+  if (!completed) {
+    return {};
+  }
+
+  std::vector<uint8_t> pixels(buffer_desc.size);
+  std::memcpy(pixels.data(), readback->OnGetContents(), pixels.size());
+  return pixels;
+}
+
+}  // namespace
+
+TEST_P(RenderPassVKTest, ParallelEncodingMatchesInlineEncoding) {
+  auto& context_vk = ContextVK::Cast(*GetContext());
+
+  auto pipeline =
+      GetContext()
+          ->GetPipelineLibrary()
+          ->GetPipeline(PipelineBuilder<VS, FS>::MakeDefaultPipelineDescriptor(
+                            *GetContext())
+                            ->SetSampleCount(SampleCount::kCount4)
+                            .SetStencilAttachmentDescriptors(std::nullopt))
+          .Get();
+  ASSERT_TRUE(pipeline && pipeline->IsValid());
+
+  size_t inline_secondary_buffers = 0u;
+  context_vk.SetParallelRenderPassEncodingEnabled(false);
+  std::vector<uint8_t> inline_pixels = RenderOverlappingDraws(
+      GetContext(), pipeline, &inline_secondary_buffers);
+  EXPECT_EQ(inline_secondary_buffers, 0u);
+
+  size_t parallel_secondary_buffers = 0u;
+  context_vk.SetParallelRenderPassEncodingEnabled(true);
+  ASSERT_GT(context_vk.GetRenderPassEncodingWorkerCount(), 0u);
+  std::vector<uint8_t> parallel_pixels = RenderOverlappingDraws(
+      GetContext(), pipeline, &parallel_secondary_buffers);
+  // A silent fallback to inline encoding would also match the inline pixels.
+  EXPECT_GT(parallel_secondary_buffers, 1u);
+
+  ASSERT_FALSE(inline_pixels.empty());
+  ASSERT_EQ(parallel_pixels.size(), inline_pixels.size());
+  EXPECT_TRUE(parallel_pixels == inline_pixels);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -48,14 +48,13 @@ void ResourceManagerVK::Start() {
     std::unique_lock lock(reclaimables_mutex_);
 
     // Wait until there are reclaimable resource or if the manager should be
-    // torn down.
+    // torn down. Announce that the thread is idle before checking for
+    // resources so that a concurrent |Reclaim| either sees the announcement
+    // and wakes the thread or pushes a resource that the check below sees.
+    waiter_idle_ = true;
     reclaimables_cv_.wait(
-        lock, [&]() { return !reclaimables_.empty() || should_exit_; });
-
-    // Don't reclaim resources when the lock is being held as this may gate
-    // further reclaimables from being registered.
-    Reclaimables resources_to_collect;
-    std::swap(resources_to_collect, reclaimables_);
+        lock, [&]() { return !reclaimables_.IsEmpty() || should_exit_; });
+    waiter_idle_ = false;
 
     // We can't read the ivar outside the lock. Read it here instead.
     should_exit = should_exit_;
@@ -63,6 +62,9 @@ void ResourceManagerVK::Start() {
     // We know what to collect. Unlock before doing anything else.
     lock.unlock();
 
+    Reclaimables resources_to_collect;
+    reclaimables_.TakeAll(resources_to_collect);
+
     // Claim all resources while tracing.
     {
       TRACE_EVENT0("Impeller", "ReclaimResources");
@@ -76,11 +78,13 @@ void ResourceManagerVK::Reclaim(std::unique_ptr<ResourceVK> resource) {
   if (!resource) {
     return;
   }
-  {
-    std::scoped_lock lock(reclaimables_mutex_);
-    reclaimables_.emplace_back(std::move(resource));
+  reclaimables_.Push(std::move(resource));
+  if (waiter_idle_) {
+    // Taking the lock ensures the collection thread is either waiting or has
+    // not checked for resources yet.
+    { std::scoped_lock lock(reclaimables_mutex_); }
+    reclaimables_cv_.notify_one();
   }
-  reclaimables_cv_.notify_one();
 }
 
 void ResourceManagerVK::Terminate() {
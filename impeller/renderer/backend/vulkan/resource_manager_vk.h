@@ -5,12 +5,15 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_RESOURCE_MANAGER_VK_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_RESOURCE_MANAGER_VK_H_
 
+#include <atomic>
 #include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <thread>
 #include <vector>
 
+#include "impeller/renderer/backend/vulkan/thread_free_list_vk.h"
+
 namespace impeller {
 
 //------------------------------------------------------------------------------
@@ -31,8 +34,10 @@ class ResourceVK {
 ///             reclaimed.
 ///
 ///             Reclaimed resources are collected in a batch on a separate
-///             thread. In the future, the resource manager may allow resource
-///             pooling/reuse, delaying reclamation past frame workloads, etc...
+///             thread. Reclaiming a resource doesn't take a lock unless the
+///             collection thread is idle and has to be woken up. In the
+///             future, the resource manager may allow resource pooling/reuse,
+///             delaying reclamation past frame workloads, etc...
 ///
 class ResourceManagerVK final
     : public std::enable_shared_from_this<ResourceManagerVK> {
@@ -74,9 +79,12 @@ class ResourceManagerVK final
   using Reclaimables = std::vector<std::unique_ptr<ResourceVK>>;
 
   ResourceManagerVK();
+  HandoffStackVK<std::unique_ptr<ResourceVK>> reclaimables_;
+  // Set while the collection thread is about to wait or is waiting for
+  // resources to be reclaimed.
+  std::atomic_bool waiter_idle_ = false;
   std::mutex reclaimables_mutex_;
   std::condition_variable reclaimables_cv_;
-  Reclaimables reclaimables_;
   bool should_exit_ = false;
   // This should be initialized last since it references the other instance
   // variables.
@@ -4,6 +4,7 @@
 
 #include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
 
+#include <atomic>
 #include <cstdint>
 #include <cstring>
 #include <utility>
@@ -42,7 +43,9 @@ struct MockSwapchainKHR {
   size_t current_image = 0;
 };
 
-struct MockSemaphore {};
+struct MockSemaphore {
+  std::atomic<uint64_t> value = 0u;
+};
 
 struct MockFramebuffer {};
 
@@ -198,20 +201,41 @@ void vkGetPhysicalDeviceQueueFamilyProperties(
   }
 }
 
+static thread_local std::vector<std::string> g_device_extensions;
+
 VkResult vkEnumerateDeviceExtensionProperties(
     VkPhysicalDevice physicalDevice,
     const char* pLayerName,
     uint32_t* pPropertyCount,
     VkExtensionProperties* pProperties) {
   if (!pProperties) {
-    *pPropertyCount = 1;
+    *pPropertyCount = g_device_extensions.size();
   } else {
-    strcpy(pProperties[0].extensionName, "VK_KHR_swapchain");
-    pProperties[0].specVersion = 0;
+    uint32_t count = 0;
+    for (const std::string& ext : g_device_extensions) {
+      strncpy(pProperties[count].extensionName, ext.c_str(),
+              sizeof(VkExtensionProperties::extensionName));
+      pProperties[count].specVersion = 0;
+      count++;
+    }
   }
   return VK_SUCCESS;
 }
 
+void vkGetPhysicalDeviceFeatures2(VkPhysicalDevice physicalDevice,
+                                  VkPhysicalDeviceFeatures2* pFeatures) {
+  auto* next = reinterpret_cast<VkBaseOutStructure*>(pFeatures->pNext);
+  while (next) {
+    // Only linked when the extension is advertised.
+    if (next->sType ==
+        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES) {
+      reinterpret_cast<VkPhysicalDeviceTimelineSemaphoreFeatures*>(next)
+          ->timelineSemaphore = VK_TRUE;
+    }
+    next = next->pNext;
+  }
+}
+
 VkResult vkCreateDevice(VkPhysicalDevice physicalDevice,
                         const VkDeviceCreateInfo* pCreateInfo,
                         const VkAllocationCallbacks* pAllocator,
@@ -510,6 +534,21 @@ VkResult vkQueueSubmit(VkQueue queue,
                        uint32_t submitCount,
                        const VkSubmitInfo* pSubmits,
                        VkFence fence) {
+  // Submissions complete immediately.
+  for (uint32_t i = 0; i < submitCount; i++) {
+    auto* next = reinterpret_cast<const VkBaseInStructure*>(pSubmits[i].pNext);
+    for (; next; next = next->pNext) {
+      if (next->sType != VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO) {
+        continue;
+      }
+      auto* timeline_info =
+          reinterpret_cast<const VkTimelineSemaphoreSubmitInfo*>(next);
+      for (uint32_t j = 0; j < timeline_info->signalSemaphoreValueCount; j++) {
+        reinterpret_cast<MockSemaphore*>(pSubmits[i].pSignalSemaphores[j])
+            ->value = timeline_info->pSignalSemaphoreValues[j];
+      }
+    }
+  }
   return VK_SUCCESS;
 }
 
@@ -715,7 +754,16 @@ VkResult vkCreateSemaphore(VkDevice device,
                            const VkSemaphoreCreateInfo* pCreateInfo,
                            const VkAllocationCallbacks* pAllocator,
                            VkSemaphore* pSemaphore) {
-  *pSemaphore = reinterpret_cast<VkSemaphore>(new MockSemaphore());
+  auto semaphore = new MockSemaphore();
+  auto* next = reinterpret_cast<const VkBaseInStructure*>(pCreateInfo->pNext);
+  for (; next; next = next->pNext) {
+    if (next->sType == VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO) {
+      semaphore->value =
+          reinterpret_cast<const VkSemaphoreTypeCreateInfo*>(next)
+              ->initialValue;
+    }
+  }
+  *pSemaphore = reinterpret_cast<VkSemaphore>(semaphore);
   return VK_SUCCESS;
 }
 
@@ -725,6 +773,25 @@ void vkDestroySemaphore(VkDevice device,
   delete reinterpret_cast<MockSemaphore*>(semaphore);
 }
 
+VkResult vkGetSemaphoreCounterValueKHR(VkDevice device,
+                                       VkSemaphore semaphore,
+                                       uint64_t* pValue) {
+  *pValue = reinterpret_cast<MockSemaphore*>(semaphore)->value;
+  return VK_SUCCESS;
+}
+
+VkResult vkWaitSemaphoresKHR(VkDevice device,
+                             const VkSemaphoreWaitInfo* pWaitInfo,
+                             uint64_t timeout) {
+  for (uint32_t i = 0; i < pWaitInfo->semaphoreCount; i++) {
+    if (reinterpret_cast<MockSemaphore*>(pWaitInfo->pSemaphores[i])->value <
+        pWaitInfo->pValues[i]) {
+      return VK_TIMEOUT;
+    }
+  }
+  return VK_SUCCESS;
+}
+
 VkResult vkAcquireNextImageKHR(VkDevice device,
                                VkSwapchainKHR swapchain,
                                uint64_t timeout,
@@ -767,6 +834,9 @@ PFN_vkVoidFunction GetMockVulkanProcAddress(VkInstance instance,
     return (PFN_vkVoidFunction)vkGetPhysicalDeviceQueueFamilyProperties;
   } else if (strcmp("vkEnumerateDeviceExtensionProperties", pName) == 0) {
     return (PFN_vkVoidFunction)vkEnumerateDeviceExtensionProperties;
+  } else if (strcmp("vkGetPhysicalDeviceFeatures2", pName) == 0 ||
+             strcmp("vkGetPhysicalDeviceFeatures2KHR", pName) == 0) {
+    return (PFN_vkVoidFunction)vkGetPhysicalDeviceFeatures2;
   } else if (strcmp("vkCreateDevice", pName) == 0) {
     return (PFN_vkVoidFunction)vkCreateDevice;
   } else if (strcmp("vkCreateInstance", pName) == 0) {
@@ -883,6 +953,10 @@ PFN_vkVoidFunction GetMockVulkanProcAddress(VkInstance instance,
     return (PFN_vkVoidFunction)vkCreateSemaphore;
   } else if (strcmp("vkDestroySemaphore", pName) == 0) {
     return (PFN_vkVoidFunction)vkDestroySemaphore;
+  } else if (strcmp("vkGetSemaphoreCounterValueKHR", pName) == 0) {
+    return (PFN_vkVoidFunction)vkGetSemaphoreCounterValueKHR;
+  } else if (strcmp("vkWaitSemaphoresKHR", pName) == 0) {
+    return (PFN_vkVoidFunction)vkWaitSemaphoresKHR;
   } else if (strcmp("vkDestroySurfaceKHR", pName) == 0) {
     return (PFN_vkVoidFunction)vkDestroySurfaceKHR;
   } else if (strcmp("vkAcquireNextImageKHR", pName) == 0) {
@@ -899,6 +973,7 @@ PFN_vkVoidFunction GetMockVulkanProcAddress(VkInstance instance,
 
 MockVulkanContextBuilder::MockVulkanContextBuilder()
     : instance_extensions_({"VK_KHR_surface", "VK_MVK_macos_surface"}),
+      device_extensions_({"VK_KHR_swapchain"}),
       format_properties_callback_([](VkPhysicalDevice physicalDevice,
                                      VkFormat format,
                                      VkFormatProperties* pFormatProperties) {
@@ -926,6 +1001,7 @@ std::shared_ptr<ContextVK> MockVulkanContextBuilder::Build() {
   }
   g_instance_extensions = instance_extensions_;
   g_instance_layers = instance_layers_;
+  g_device_extensions = device_extensions_;
   g_format_properties_callback = format_properties_callback_;
   g_physical_device_properties_callback = physical_properties_callback_;
   settings.embedder_data = embedder_data_;
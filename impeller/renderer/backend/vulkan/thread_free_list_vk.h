@@ -0,0 +1,260 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_THREAD_FREE_LIST_VK_H_
+#define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_THREAD_FREE_LIST_VK_H_
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "impeller/base/thread.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A stack that any number of threads may push items to, and take
+///             all items from, without locking.
+///
+///             Items are only ever removed all at once by swapping out the head
+///             of the stack, which avoids the ABA problem of lock-free stacks
+///             that pop single items.
+///
+template <typename T>
+class HandoffStackVK {
+ public:
+  HandoffStackVK() = default;
+
+  ~HandoffStackVK() { DeleteNodes(head_.exchange(nullptr)); }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Push an item onto the stack.
+  ///
+  /// @return     Whether the stack was empty before the push.
+  ///
+  bool Push(T item) {
+    Node* node = new Node{std::move(item), head_.load()};
+    while (!head_.compare_exchange_weak(node->next, node)) {
+    }
+    return node->next == nullptr;
+  }
+
+  bool IsEmpty() const { return head_.load() == nullptr; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Move all items on the stack to the end of the given vector in
+  ///             the order they were pushed.
+  ///
+  /// @return     The number of items moved.
+  ///
+  size_t TakeAll(std::vector<T>& items) {
+    Node* node = head_.exchange(nullptr);
+    const size_t first = items.size();
+    while (node != nullptr) {
+      items.push_back(std::move(node->item));
+      Node* next = node->next;
+      delete node;
+      node = next;
+    }
+    std::reverse(items.begin() + first, items.end());
+    return items.size() - first;
+  }
+
+ private:
+  struct Node {
+    T item;
+    Node* next = nullptr;
+  };
+
+  std::atomic<Node*> head_ = nullptr;
+
+  static void DeleteNodes(Node* node) {
+    while (node != nullptr) {
+      Node* next = node->next;
+      delete node;
+      node = next;
+    }
+  }
+
+  HandoffStackVK(const HandoffStackVK&) = delete;
+
+  HandoffStackVK& operator=(const HandoffStackVK&) = delete;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      The recycled objects available to a single thread.
+///
+///             Objects are returned to the list from any thread (usually the
+///             resource manager thread once the GPU is done with them) without
+///             locking, and are handed out again on the thread that owns the
+///             list.
+///
+template <typename T>
+class ThreadFreeListVK {
+ public:
+  explicit ThreadFreeListVK(size_t max_count) : max_count_(max_count) {}
+
+  ~ThreadFreeListVK() = default;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Return an object to the list. The object is dropped on the
+  ///             calling thread if the list is full.
+  ///
+  ///             This may be called from any thread.
+  ///
+  void Return(T item) {
+    if (count_.fetch_add(1u) >= max_count_) {
+      count_.fetch_sub(1u);
+      return;
+    }
+    returned_.Push(std::move(item));
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Take the first object in the list that matches the predicate.
+  ///
+  ///             This may only be called on the thread that owns the list.
+  ///
+  template <typename Predicate>
+  std::optional<T> Take(const Predicate& predicate) {
+    returned_.TakeAll(available_);
+    for (auto it = available_.begin(); it != available_.end(); ++it) {
+      if (predicate(*it)) {
+        T item = std::move(*it);
+        available_.erase(it);
+        count_.fetch_sub(1u);
+        return item;
+      }
+    }
+    return std::nullopt;
+  }
+
+  std::optional<T> Take() {
+    return Take([](const T&) { return true; });
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Move the objects that were returned to this list, but have not
+  ///             been seen by its owner yet, to the given vector.
+  ///
+  ///             This may be called from any thread.
+  ///
+  size_t Steal(std::vector<T>& items) {
+    const size_t count = returned_.TakeAll(items);
+    count_.fetch_sub(count);
+    return count;
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Add objects taken from other lists to this list, dropping the
+  ///             objects that do not fit.
+  ///
+  ///             This may only be called on the thread that owns the list.
+  ///
+  void Adopt(std::vector<T> items) {
+    for (T& item : items) {
+      if (count_.fetch_add(1u) >= max_count_) {
+        count_.fetch_sub(1u);
+        return;
+      }
+      available_.push_back(std::move(item));
+    }
+  }
+
+  /// The number of objects in the list.
+  size_t GetCount() const { return count_.load(); }
+
+ private:
+  const size_t max_count_;
+  std::atomic<size_t> count_ = 0u;
+  HandoffStackVK<T> returned_;
+  // Only accessed by the owning thread.
+  std::vector<T> available_;
+
+  ThreadFreeListVK(const ThreadFreeListVK&) = delete;
+
+  ThreadFreeListVK& operator=(const ThreadFreeListVK&) = delete;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      The per-thread free lists of a recycler.
+///
+///             The lists are owned by this object so that the objects in them
+///             are collected along with the recycler rather than when the
+///             threads that used them exit.
+///
+template <typename T>
+class ThreadFreeListsVK {
+ public:
+  using List = ThreadFreeListVK<T>;
+
+  explicit ThreadFreeListsVK(size_t max_count_per_thread)
+      : max_count_per_thread_(max_count_per_thread) {}
+
+  ~ThreadFreeListsVK() = default;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The free list of the calling thread, which is created the
+  ///             first time a thread asks for it.
+  ///
+  std::shared_ptr<List> GetForCurrentThread() {
+    static thread_local std::unordered_map<const ThreadFreeListsVK*,
+                                           std::weak_ptr<List>>
+        tls_lists;
+    std::weak_ptr<List>& weak_list = tls_lists[this];
+    if (std::shared_ptr<List> list = weak_list.lock()) {
+      return list;
+    }
+    auto list = std::make_shared<List>(max_count_per_thread_);
+    {
+      Lock lock(lists_mutex_);
+      lists_.push_back(list);
+    }
+    weak_list = list;
+    return list;
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Move the objects returned to the lists of other threads, that
+  ///             their owners have not picked up yet, into the given list.
+  ///
+  ///             This takes a lock and should only be used when the list of
+  ///             the calling thread is empty, before creating a new object.
+  ///
+  /// @return     Whether any objects were moved.
+  ///
+  bool StealInto(List& list) {
+    std::vector<T> stolen;
+    {
+      Lock lock(lists_mutex_);
+      for (const std::shared_ptr<List>& other : lists_) {
+        if (other.get() != &list) {
+          other->Steal(stolen);
+        }
+      }
+    }
+    if (stolen.empty()) {
+      return false;
+    }
+    list.Adopt(std::move(stolen));
+    return true;
+  }
+
+ private:
+  const size_t max_count_per_thread_;
+  Mutex lists_mutex_;
+  std::vector<std::shared_ptr<List>> lists_ IPLR_GUARDED_BY(lists_mutex_);
+
+  ThreadFreeListsVK(const ThreadFreeListsVK&) = delete;
+
+  ThreadFreeListsVK& operator=(const ThreadFreeListsVK&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_THREAD_FREE_LIST_VK_H_
@@ -0,0 +1,93 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "impeller/renderer/backend/vulkan/thread_free_list_vk.h"
+
+namespace impeller {
+namespace testing {
+
+TEST(HandoffStackVKTest, TakeAllReturnsItemsInPushOrder) {
+  HandoffStackVK<std::unique_ptr<int>> stack;
+  EXPECT_TRUE(stack.IsEmpty());
+  EXPECT_TRUE(stack.Push(std::make_unique<int>(1)));
+  EXPECT_FALSE(stack.Push(std::make_unique<int>(2)));
+  EXPECT_FALSE(stack.Push(std::make_unique<int>(3)));
+
+  std::vector<std::unique_ptr<int>> items;
+  EXPECT_EQ(stack.TakeAll(items), 3u);
+  EXPECT_TRUE(stack.IsEmpty());
+  ASSERT_EQ(items.size(), 3u);
+  EXPECT_EQ(*items[0], 1);
+  EXPECT_EQ(*items[1], 2);
+  EXPECT_EQ(*items[2], 3);
+}
+
+TEST(HandoffStackVKTest, ConcurrentPushesAreAllTaken) {
+  HandoffStackVK<int> stack;
+  constexpr int kThreadCount = 4;
+  constexpr int kPushCount = 1000;
+
+  std::vector<int> taken;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreadCount; i++) {
+    threads.emplace_back([&stack, i]() {
+      for (int j = 0; j < kPushCount; j++) {
+        stack.Push(i * kPushCount + j);
+      }
+    });
+  }
+  while (taken.size() < kThreadCount * kPushCount) {
+    stack.TakeAll(taken);
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  std::vector<bool> seen(kThreadCount * kPushCount, false);
+  for (int item : taken) {
+    EXPECT_FALSE(seen[item]);
+    seen[item] = true;
+  }
+}
+
+TEST(ThreadFreeListVKTest, ReturnDropsItemsWhenFull) {
+  ThreadFreeListVK<int> list(2u);
+  list.Return(1);
+  list.Return(2);
+  list.Return(3);
+  EXPECT_EQ(list.GetCount(), 2u);
+
+  EXPECT_EQ(list.Take([](int item) { return item == 2; }), 2);
+  EXPECT_EQ(list.Take(), 1);
+  EXPECT_FALSE(list.Take().has_value());
+  EXPECT_EQ(list.GetCount(), 0u);
+}
+
+TEST(ThreadFreeListVKTest, ListsArePerThread) {
+  ThreadFreeListsVK<int> lists(4u);
+  auto list = lists.GetForCurrentThread();
+  EXPECT_EQ(list, lists.GetForCurrentThread());
+
+  std::shared_ptr<ThreadFreeListVK<int>> other_list;
+  std::thread thread([&]() { other_list = lists.GetForCurrentThread(); });
+  thread.join();
+  ASSERT_TRUE(other_list);
+  EXPECT_NE(list, other_list);
+
+  // Items returned to another thread's list are only picked up by stealing.
+  other_list->Return(42);
+  EXPECT_FALSE(list->Take().has_value());
+  EXPECT_TRUE(lists.StealInto(*list));
+  EXPECT_EQ(other_list->GetCount(), 0u);
+  EXPECT_EQ(list->Take(), 42);
+  EXPECT_FALSE(lists.StealInto(*list));
+}
+
+}  // namespace testing
+}  // namespace impeller
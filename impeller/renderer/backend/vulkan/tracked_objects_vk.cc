@@ -33,6 +33,10 @@ TrackedObjectsVK::TrackedObjectsVK(
 }
 
 TrackedObjectsVK::~TrackedObjectsVK() {
+  for (auto& [pool, buffer] : secondary_buffers_) {
+    pool->CollectCommandBuffer(std::move(buffer),
+                               vk::CommandBufferLevel::eSecondary);
+  }
   if (!buffer_) {
     return;
   }
@@ -69,6 +73,19 @@ void TrackedObjectsVK::Track(
   tracked_textures_.emplace_back(texture);
 }
 
+void TrackedObjectsVK::TrackSecondaryCommandBuffer(
+    const std::shared_ptr<CommandPoolVK>& pool,
+    vk::UniqueCommandBuffer buffer) {
+  if (!pool || !buffer) {
+    return;
+  }
+  secondary_buffers_.emplace_back(pool, std::move(buffer));
+}
+
+size_t TrackedObjectsVK::GetSecondaryCommandBufferCount() const {
+  return secondary_buffers_.size();
+}
+
 vk::CommandBuffer TrackedObjectsVK::GetCommandBuffer() const {
   return *buffer_;
 }
@@ -33,6 +33,14 @@ class TrackedObjectsVK {
 
   void Track(const std::shared_ptr<const TextureSourceVK>& texture);
 
+  /// Keep the pool of a secondary command buffer executed by this command
+  /// buffer alive, and return the secondary buffer to it on destruction.
+  void TrackSecondaryCommandBuffer(const std::shared_ptr<CommandPoolVK>& pool,
+                                   vk::UniqueCommandBuffer buffer);
+
+  /// The number of secondary command buffers tracked so far.
+  size_t GetSecondaryCommandBufferCount() const;
+
   vk::CommandBuffer GetCommandBuffer() const;
 
   DescriptorPoolVK& GetDescriptorPool();
@@ -47,6 +55,9 @@ class TrackedObjectsVK {
   std::vector<std::shared_ptr<SharedObjectVK>> tracked_objects_;
   std::vector<std::shared_ptr<const DeviceBuffer>> tracked_buffers_;
   std::vector<std::shared_ptr<const TextureSourceVK>> tracked_textures_;
+  std::vector<std::pair<std::shared_ptr<CommandPoolVK>,
+                        vk::UniqueCommandBuffer>>
+      secondary_buffers_;
   std::unique_ptr<GPUProbe> probe_;
   bool is_valid_ = false;
 
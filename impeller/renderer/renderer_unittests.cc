@@ -524,6 +524,70 @@ TEST_P(RendererTest, CanRenderInstanced) {
   }));
 }
 
+TEST_P(RendererTest, CanRenderManyDrawsWithParallelEncoding) {
+  if (GetBackend() != PlaygroundBackend::kVulkan) {
+    GTEST_SKIP() << "Only Vulkan encodes render passes in parallel.";
+  }
+  using VS = InstancedDrawVertexShader;
+  using FS = InstancedDrawFragmentShader;
+
+  VertexBufferBuilder<VS::PerVertexData> builder;
+  builder.AddVertices({
+      VS::PerVertexData{Point{0, 0}},
+      VS::PerVertexData{Point{0, 20}},
+      VS::PerVertexData{Point{20, 0}},
+      VS::PerVertexData{Point{0, 20}},
+      VS::PerVertexData{Point{20, 0}},
+      VS::PerVertexData{Point{20, 20}},
+  });
+
+  ASSERT_NE(GetContext(), nullptr);
+  auto pipeline =
+      GetContext()
+          ->GetPipelineLibrary()
+          ->GetPipeline(PipelineBuilder<VS, FS>::MakeDefaultPipelineDescriptor(
+                            *GetContext())
+                            ->SetSampleCount(SampleCount::kCount4)
+                            .SetStencilAttachmentDescriptors(std::nullopt))
+          .Get();
+  ASSERT_TRUE(pipeline && pipeline->IsValid());
+
+  VS::InstanceInfo<1> instances;
+  instances.colors[0] = Color::Random();
+
+  // Enough draws to be split into several ranges, with the dynamic state
+  // changing between draws so that every range has to set its own.
+  static constexpr size_t kGridSize = 24u;
+  auto host_buffer = HostBuffer::Create(GetContext()->GetResourceAllocator(),
+                                        GetContext()->GetIdleWaiter());
+  ASSERT_TRUE(OpenPlaygroundHere([&](RenderPass& pass) -> bool {
+    auto vertex_buffer = builder.CreateVertexBuffer(*host_buffer);
+    auto instance_info = host_buffer->EmplaceStorageBuffer(instances);
+    for (size_t i = 0; i < kGridSize; i++) {
+      pass.SetScissor(IRect::MakeXYWH(0, 0, pass.GetRenderTargetSize().width,
+                                      (i + 1) * 30));
+      for (size_t j = 0; j < kGridSize; j++) {
+        pass.SetPipeline(pipeline);
+        pass.SetCommandLabel("ParallelDraw");
+
+        VS::FrameInfo frame_info;
+        frame_info.mvp = pass.GetOrthographicTransform() *
+                         Matrix::MakeScale(GetContentScale()) *
+                         Matrix::MakeTranslation({j * 25.0f, i * 25.0f, 0.0f});
+        VS::BindFrameInfo(pass, host_buffer->EmplaceUniform(frame_info));
+        VS::BindInstanceInfo(pass, instance_info);
+        pass.SetVertexBuffer(vertex_buffer);
+        if (!pass.Draw().ok()) {
+          return false;
+        }
+      }
+    }
+
+    host_buffer->Reset();
+    return true;
+  }));
+}
+
 TEST_P(RendererTest, CanBlitTextureToTexture) {
   if (GetBackend() == PlaygroundBackend::kOpenGLES) {
     GTEST_SKIP() << "Mipmap test shader not supported on GLES.";
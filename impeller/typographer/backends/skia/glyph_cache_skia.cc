@@ -0,0 +1,348 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/typographer/backends/skia/glyph_cache_skia.h"
+
+#include <cstring>
+#include <utility>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/typographer/backends/skia/typeface_skia.h"
+#include "third_party/skia/include/core/SkFontStyle.h"
+#include "third_party/skia/include/core/SkString.h"
+
+namespace impeller {
+
+static constexpr const char* kGlyphCacheFileName =
+    "flutter.impeller.glyphcache";
+
+namespace {
+
+struct GlyphCacheHeader {
+  uint32_t magic = 0x474C5943;
+  // Bump this to invalidate caches when the way glyphs are rasterized
+  // changes.
+  uint32_t version = 1u;
+  uint32_t abi = sizeof(void*);
+  uint32_t entry_count = 0u;
+  uint64_t data_size = 0u;
+
+  bool IsCompatibleWith(const GlyphCacheHeader& o) const {
+    return magic == o.magic && version == o.version && abi == o.abi;
+  }
+};
+
+size_t BytesPerPixelForAtlasType(uint8_t type) {
+  switch (static_cast<GlyphAtlas::Type>(type)) {
+    case GlyphAtlas::Type::kAlphaBitmap:
+      return 1u;
+    case GlyphAtlas::Type::kColorBitmap:
+      return 4u;
+  }
+  return 0u;
+}
+
+// Returns a hash identifying the contents of the typeface, or zero if the
+// typeface cannot be identified across launches.
+uint64_t ComputeTypefaceHash(const SkTypeface& typeface) {
+  // Instances of a variable font share all of their tables.
+  if (typeface.getVariationDesignPosition(nullptr, 0) > 0) {
+    return 0u;
+  }
+
+  // The 'head' table records a checksum of the whole font file along with
+  // the font revision, so the font contents can be identified without
+  // reading the entire file.
+  static constexpr SkFontTableTag kHeadTag =
+      SkSetFourByteTag('h', 'e', 'a', 'd');
+  const size_t head_size = typeface.getTableSize(kHeadTag);
+  if (head_size == 0u) {
+    return 0u;
+  }
+  std::vector<uint8_t> head(head_size);
+  if (typeface.getTableData(kHeadTag, 0u, head_size, head.data()) !=
+      head_size) {
+    return 0u;
+  }
+  uint64_t hash = PersistentHash(head.data(), head.size());
+
+  // Faces of a font collection may share their 'head' table.
+  SkString family_name;
+  typeface.getFamilyName(&family_name);
+  hash = PersistentHash(family_name.c_str(), family_name.size(), hash);
+  const SkFontStyle style = typeface.fontStyle();
+  const int32_t style_values[] = {style.weight(), style.width(),
+                                  static_cast<int32_t>(style.slant()),
+                                  typeface.countGlyphs()};
+  hash = PersistentHash(style_values, sizeof(style_values), hash);
+  return hash == 0u ? 1u : hash;
+}
+
+}  // namespace
+
+struct GlyphCacheSkia::FileEntry {
+  Key key;
+  uint32_t width = 0u;
+  uint32_t height = 0u;
+  uint64_t offset = 0u;
+};
+
+std::size_t GlyphCacheSkia::Key::Hash::operator()(const Key& key) const {
+  return PersistentHash(&key, sizeof(Key));
+}
+
+bool GlyphCacheSkia::Key::Equal::operator()(const Key& lhs,
+                                            const Key& rhs) const {
+  // Keys are compared bytewise, so they must not contain implicit padding.
+  static_assert(sizeof(Key) == 56u);
+  static_assert(sizeof(FileEntry) == sizeof(Key) + 16u);
+  return std::memcmp(&lhs, &rhs, sizeof(Key)) == 0;
+}
+
+std::shared_ptr<GlyphCacheSkia> GlyphCacheSkia::Create(
+    fml::UniqueFD cache_directory) {
+  if (!cache_directory.is_valid()) {
+    return nullptr;
+  }
+  auto cache = std::shared_ptr<GlyphCacheSkia>(
+      new GlyphCacheSkia(std::move(cache_directory)));
+  cache->Load();
+  return cache;
+}
+
+GlyphCacheSkia::GlyphCacheSkia(fml::UniqueFD cache_directory)
+    : cache_directory_(std::move(cache_directory)) {}
+
+GlyphCacheSkia::~GlyphCacheSkia() = default;
+
+void GlyphCacheSkia::Load() {
+  TRACE_EVENT0("impeller", "GlyphCacheSkia::Load");
+  std::shared_ptr<fml::FileMapping> mapping =
+      fml::FileMapping::CreateReadOnly(cache_directory_, kGlyphCacheFileName);
+  if (!mapping || mapping->GetSize() < sizeof(GlyphCacheHeader)) {
+    return;
+  }
+  GlyphCacheHeader header;
+  std::memcpy(&header, mapping->GetMapping(), sizeof(header));
+  if (!header.IsCompatibleWith(GlyphCacheHeader{})) {
+    FML_LOG(WARNING) << "Persisted glyph cache is not compatible. Ignoring.";
+    return;
+  }
+  const uint64_t entries_size =
+      static_cast<uint64_t>(header.entry_count) * sizeof(FileEntry);
+  if (mapping->GetSize() - sizeof(header) < entries_size ||
+      mapping->GetSize() - sizeof(header) - entries_size < header.data_size) {
+    FML_LOG(WARNING) << "Persisted glyph cache is truncated. Ignoring.";
+    return;
+  }
+
+  const uint8_t* entries = mapping->GetMapping() + sizeof(header);
+  const uint8_t* data = entries + entries_size;
+
+  std::scoped_lock lock(mutex_);
+  for (uint32_t i = 0; i < header.entry_count; i++) {
+    FileEntry file_entry;
+    std::memcpy(&file_entry, entries + i * sizeof(FileEntry),
+                sizeof(FileEntry));
+    const uint64_t length = static_cast<uint64_t>(file_entry.width) *
+                            file_entry.height *
+                            BytesPerPixelForAtlasType(file_entry.key.type);
+    if (length == 0u || file_entry.offset > header.data_size ||
+        header.data_size - file_entry.offset < length) {
+      continue;
+    }
+    auto [_, inserted] = entries_.try_emplace(
+        file_entry.key, Entry{.width = file_entry.width,
+                              .height = file_entry.height,
+                              .pixels = data + file_entry.offset});
+    if (inserted) {
+      data_size_ += length;
+    }
+  }
+  mapping_ = std::move(mapping);
+}
+
+bool GlyphCacheSkia::MakeKey(GlyphAtlas::Type type,
+                             const FontGlyphPair& pair,
+                             Key& key) const {
+  const ScaledFont& scaled_font = pair.scaled_font;
+  const sk_sp<SkTypeface>& typeface =
+      TypefaceSkia::Cast(*scaled_font.font.GetTypeface()).GetSkiaTypeface();
+  if (!typeface) {
+    return false;
+  }
+  key.typeface_hash = GetTypefaceHash(*typeface);
+  if (key.typeface_hash == 0u) {
+    return false;
+  }
+
+  static constexpr uint8_t kEmbolden = 1u << 0;
+  static constexpr uint8_t kHasProperties = 1u << 1;
+  static constexpr uint8_t kStroke = 1u << 2;
+
+  const Font::Metrics& metrics = scaled_font.font.GetMetrics();
+  key.point_size = metrics.point_size;
+  key.scale_x = metrics.scaleX;
+  key.skew_x = metrics.skewX;
+  key.scale = scaled_font.scale;
+  key.subpixel_x = pair.glyph.subpixel_offset.x;
+  key.subpixel_y = pair.glyph.subpixel_offset.y;
+  key.glyph_index = pair.glyph.glyph.index;
+  key.type = static_cast<uint8_t>(type);
+  key.flags = metrics.embolden ? kEmbolden : 0u;
+  if (pair.glyph.properties.has_value()) {
+    const GlyphProperties& properties = pair.glyph.properties.value();
+    key.flags |= kHasProperties;
+    key.color = properties.color.ToARGB();
+    if (properties.stroke) {
+      key.flags |= kStroke;
+      key.stroke_width = properties.stroke_width;
+      key.stroke_miter = properties.stroke_miter;
+      key.stroke_cap = static_cast<uint8_t>(properties.stroke_cap);
+      key.stroke_join = static_cast<uint8_t>(properties.stroke_join);
+    }
+  }
+  return true;
+}
+
+uint64_t GlyphCacheSkia::GetTypefaceHash(const SkTypeface& typeface) const {
+  {
+    std::scoped_lock lock(mutex_);
+    auto found = typeface_hashes_.find(typeface.uniqueID());
+    if (found != typeface_hashes_.end()) {
+      return found->second;
+    }
+  }
+  const uint64_t hash = ComputeTypefaceHash(typeface);
+  std::scoped_lock lock(mutex_);
+  typeface_hashes_[typeface.uniqueID()] = hash;
+  return hash;
+}
+
+bool GlyphCacheSkia::Read(GlyphAtlas::Type type,
+                          const FontGlyphPair& pair,
+                          const SkPixmap& pixmap) const {
+  Key key;
+  if (!MakeKey(type, pair, key)) {
+    return false;
+  }
+  Entry entry;
+  {
+    std::scoped_lock lock(mutex_);
+    auto found = entries_.find(key);
+    if (found == entries_.end()) {
+      return false;
+    }
+    entry = found->second;
+  }
+  const size_t row_bytes = entry.width * BytesPerPixelForAtlasType(key.type);
+  if (static_cast<uint32_t>(pixmap.width()) != entry.width ||
+      static_cast<uint32_t>(pixmap.height()) != entry.height ||
+      pixmap.info().minRowBytes() != row_bytes) {
+    return false;
+  }
+  for (uint32_t y = 0; y < entry.height; y++) {
+    std::memcpy(pixmap.writable_addr(0, y), entry.pixels + y * row_bytes,
+                row_bytes);
+  }
+  return true;
+}
+
+void GlyphCacheSkia::Write(GlyphAtlas::Type type,
+                           const FontGlyphPair& pair,
+                           const SkPixmap& pixmap) {
+  Key key;
+  if (!MakeKey(type, pair, key) || pixmap.width() <= 0 ||
+      pixmap.height() <= 0) {
+    return;
+  }
+  const size_t row_bytes = pixmap.info().minRowBytes();
+  if (row_bytes != pixmap.width() * BytesPerPixelForAtlasType(key.type)) {
+    return;
+  }
+  const size_t length = row_bytes * pixmap.height();
+  {
+    std::scoped_lock lock(mutex_);
+    if (data_size_ + length > kMaxDataSize || entries_.count(key) != 0u) {
+      return;
+    }
+  }
+
+  auto pixels = std::make_shared<std::vector<uint8_t>>(length);
+  for (int y = 0; y < pixmap.height(); y++) {
+    std::memcpy(pixels->data() + y * row_bytes, pixmap.addr(0, y), row_bytes);
+  }
+
+  std::scoped_lock lock(mutex_);
+  if (data_size_ + length > kMaxDataSize) {
+    return;
+  }
+  auto [_, inserted] = entries_.try_emplace(
+      key, Entry{.width = static_cast<uint32_t>(pixmap.width()),
+                 .height = static_cast<uint32_t>(pixmap.height()),
+                 .pixels = pixels->data(),
+                 .owned = pixels});
+  if (inserted) {
+    data_size_ += length;
+    pending_glyph_count_++;
+  }
+}
+
+size_t GlyphCacheSkia::GetPendingGlyphCount() const {
+  std::scoped_lock lock(mutex_);
+  return pending_glyph_count_;
+}
+
+size_t GlyphCacheSkia::GetGlyphCount() const {
+  std::scoped_lock lock(mutex_);
+  return entries_.size();
+}
+
+bool GlyphCacheSkia::Persist() {
+  TRACE_EVENT0("impeller", "GlyphCacheSkia::Persist");
+  std::vector<uint8_t> contents;
+  {
+    std::scoped_lock lock(mutex_);
+    GlyphCacheHeader header;
+    header.entry_count = static_cast<uint32_t>(entries_.size());
+    header.data_size = data_size_;
+    const size_t entries_size = entries_.size() * sizeof(FileEntry);
+    contents.resize(sizeof(header) + entries_size + data_size_);
+
+    std::memcpy(contents.data(), &header, sizeof(header));
+    uint8_t* entries = contents.data() + sizeof(header);
+    uint8_t* data = entries + entries_size;
+    uint64_t offset = 0u;
+    for (const auto& [key, entry] : entries_) {
+      const FileEntry file_entry{.key = key,
+                                 .width = entry.width,
+                                 .height = entry.height,
+                                 .offset = offset};
+      std::memcpy(entries, &file_entry, sizeof(file_entry));
+      entries += sizeof(file_entry);
+      const size_t length = static_cast<size_t>(entry.width) * entry.height *
+                            BytesPerPixelForAtlasType(key.type);
+      std::memcpy(data + offset, entry.pixels, length);
+      offset += length;
+    }
+    FML_DCHECK(offset == data_size_);
+    pending_glyph_count_ = 0u;
+  }
+
+  fml::DataMapping mapping(std::move(contents));
+  if (!fml::WriteAtomically(cache_directory_, kGlyphCacheFileName, mapping)) {
+    FML_LOG(ERROR) << "Could not write glyph cache to disk.";
+    return false;
+  }
+  return true;
+}
+
+void GlyphCacheSkia::PersistLater(
+    const std::shared_ptr<fml::BasicTaskRunner>& task_runner) {
+  persist_scheduler_.Schedule(task_runner, weak_from_this());
+}
+
+}  // namespace impeller
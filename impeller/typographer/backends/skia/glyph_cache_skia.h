@@ -0,0 +1,168 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_TYPOGRAPHER_BACKENDS_SKIA_GLYPH_CACHE_SKIA_H_
+#define FLUTTER_IMPELLER_TYPOGRAPHER_BACKENDS_SKIA_GLYPH_CACHE_SKIA_H_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/unique_fd.h"
+#include "impeller/base/persistence.h"
+#include "impeller/typographer/font_glyph_pair.h"
+#include "impeller/typographer/glyph_atlas.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+#include "third_party/skia/include/core/SkTypeface.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A cache of rasterized glyph bitmaps that is persisted to disk so
+///             that glyphs drawn in a previous launch of the application do
+///             not need to be rasterized again.
+///
+///             Glyphs are keyed by a hash of the contents of their typeface
+///             along with the font metrics, scale, subpixel offset and glyph
+///             properties used to draw them. Typefaces whose contents cannot
+///             be hashed are not cached.
+///
+///             The persisted cache is memory mapped and all methods are safe
+///             to call concurrently.
+///
+class GlyphCacheSkia : public std::enable_shared_from_this<GlyphCacheSkia> {
+ public:
+  /// The maximum number of bitmap bytes held by the cache. Glyphs written
+  /// once the cache is full are not recorded.
+  static constexpr size_t kMaxDataSize = 8u * 1024u * 1024u;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Create a glyph cache backed by a file in the given directory,
+  ///             loading the glyphs persisted there if they are compatible.
+  ///
+  /// @param[in]  cache_directory  The cache directory.
+  ///
+  static std::shared_ptr<GlyphCacheSkia> Create(fml::UniqueFD cache_directory);
+
+  ~GlyphCacheSkia();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Copy the cached bitmap of a glyph into a pixmap.
+  ///
+  /// @param[in]  type    The type of the atlas the glyph is drawn into.
+  /// @param[in]  pair    The font-glyph pair.
+  /// @param[in]  pixmap  The destination, which must be the size of the glyph
+  ///                     bounds including the 1px atlas padding.
+  ///
+  /// @return     True if the glyph was found and copied into the pixmap.
+  ///
+  bool Read(GlyphAtlas::Type type,
+            const FontGlyphPair& pair,
+            const SkPixmap& pixmap) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Record the bitmap of a freshly rasterized glyph.
+  ///
+  void Write(GlyphAtlas::Type type,
+             const FontGlyphPair& pair,
+             const SkPixmap& pixmap);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of glyphs written since the cache was last
+  ///             persisted.
+  ///
+  size_t GetPendingGlyphCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of glyphs in the cache.
+  ///
+  size_t GetGlyphCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Write all cached glyphs to disk.
+  ///
+  /// @return     If the cache could be persisted.
+  ///
+  bool Persist();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Persist the cache on the given task runner unless a persist
+  ///             is already pending.
+  ///
+  void PersistLater(const std::shared_ptr<fml::BasicTaskRunner>& task_runner);
+
+ private:
+  // The identity of a rasterized glyph. Compared bytewise, so all fields
+  // including the reserved bytes are zero initialized.
+  struct Key {
+    uint64_t typeface_hash = 0;
+    float point_size = 0;
+    float scale_x = 0;
+    float skew_x = 0;
+    float scale = 0;
+    float subpixel_x = 0;
+    float subpixel_y = 0;
+    float stroke_width = 0;
+    float stroke_miter = 0;
+    uint32_t color = 0;
+    uint16_t glyph_index = 0;
+    uint8_t type = 0;
+    uint8_t flags = 0;
+    uint8_t stroke_cap = 0;
+    uint8_t stroke_join = 0;
+    uint8_t reserved[6] = {};
+
+    struct Hash {
+      std::size_t operator()(const Key& key) const;
+    };
+
+    struct Equal {
+      bool operator()(const Key& lhs, const Key& rhs) const;
+    };
+  };
+
+  struct Entry {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    // Tightly packed rows, either within the persisted mapping or |owned|.
+    const uint8_t* pixels = nullptr;
+    std::shared_ptr<std::vector<uint8_t>> owned;
+  };
+
+  // The on-disk record of an entry.
+  struct FileEntry;
+
+  using EntryMap = std::unordered_map<Key, Entry, Key::Hash, Key::Equal>;
+
+  const fml::UniqueFD cache_directory_;
+  std::shared_ptr<fml::FileMapping> mapping_;
+  mutable std::mutex mutex_;
+  EntryMap entries_;
+  mutable std::unordered_map<SkTypefaceID, uint64_t> typeface_hashes_;
+  size_t data_size_ = 0u;
+  size_t pending_glyph_count_ = 0u;
+  PersistScheduler persist_scheduler_;
+
+  explicit GlyphCacheSkia(fml::UniqueFD cache_directory);
+
+  void Load();
+
+  bool MakeKey(GlyphAtlas::Type type,
+               const FontGlyphPair& pair,
+               Key& key) const;
+
+  uint64_t GetTypefaceHash(const SkTypeface& typeface) const;
+
+  GlyphCacheSkia(const GlyphCacheSkia&) = delete;
+
+  GlyphCacheSkia& operator=(const GlyphCacheSkia&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_TYPOGRAPHER_BACKENDS_SKIA_GLYPH_CACHE_SKIA_H_
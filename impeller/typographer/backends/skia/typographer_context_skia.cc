@@ -4,14 +4,18 @@
 
 #include "impeller/typographer/backends/skia/typographer_context_skia.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <numeric>
 #include <utility>
 #include <vector>
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/task_group.h"
 #include "flutter/fml/trace_event.h"
 #include "fml/closure.h"
 
@@ -36,6 +40,8 @@
 #include "include/core/SkColor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPaint.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkRect.h"
 #include "include/core/SkSize.h"
 
 #include "third_party/skia/include/core/SkBitmap.h"
@@ -48,6 +54,14 @@ namespace impeller {
 
 constexpr auto kPadding = 2;
 
+/// The number of glyphs rasterized by each task when the glyphs of an atlas
+/// update are spread over the worker task runner.
+constexpr size_t kGlyphsPerRasterTask = 16u;
+
+/// The number of glyphs recorded into the glyph cache after which it is
+/// persisted in the background.
+constexpr size_t kGlyphCachePersistThreshold = 32u;
+
 namespace {
 SkPaint::Cap ToSkiaCap(Cap cap) {
   switch (cap) {
@@ -74,13 +88,33 @@ SkPaint::Join ToSkiaJoin(Join join) {
 }
 }  // namespace
 
-std::shared_ptr<TypographerContext> TypographerContextSkia::Make() {
-  return std::make_shared<TypographerContextSkia>();
+std::shared_ptr<TypographerContext> TypographerContextSkia::Make(
+    std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner,
+    std::shared_ptr<GlyphCacheSkia> glyph_cache) {
+  return std::make_shared<TypographerContextSkia>(
+      std::move(worker_task_runner), std::move(glyph_cache));
 }
 
 TypographerContextSkia::TypographerContextSkia() = default;
 
-TypographerContextSkia::~TypographerContextSkia() = default;
+TypographerContextSkia::TypographerContextSkia(
+    std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner,
+    std::shared_ptr<GlyphCacheSkia> glyph_cache)
+    : worker_task_runner_(std::move(worker_task_runner)),
+      glyph_cache_(std::move(glyph_cache)) {}
+
+TypographerContextSkia::~TypographerContextSkia() {
+  if (glyph_cache_ && glyph_cache_->GetPendingGlyphCount() > 0u) {
+    glyph_cache_->Persist();
+  }
+}
+
+void TypographerContextSkia::MaybePersistGlyphCache() const {
+  if (glyph_cache_ && glyph_cache_->GetPendingGlyphCount() >=
+                          kGlyphCachePersistThreshold) {
+    glyph_cache_->PersistLater(worker_task_runner_);
+  }
+}
 
 std::shared_ptr<GlyphAtlasContext>
 TypographerContextSkia::CreateGlyphAtlasContext(GlyphAtlas::Type type) const {
@@ -249,82 +283,162 @@ static void DrawGlyph(SkCanvas* canvas,
   canvas->restore();
 }
 
-/// @brief Batch render to a single surface.
+/// Invoke |rasterize| over consecutive sub-ranges of [start_index,
+/// end_index), in parallel on |worker_task_runner| if one is provided and
+/// there are enough glyphs to split.
 ///
-/// This is only safe for use when updating a fresh texture.
-static bool BulkUpdateAtlasBitmap(const GlyphAtlas& atlas,
-                                  std::shared_ptr<BlitPass>& blit_pass,
-                                  HostBuffer& host_buffer,
-                                  const std::shared_ptr<Texture>& texture,
-                                  const std::vector<FontGlyphPair>& new_pairs,
-                                  size_t start_index,
-                                  size_t end_index) {
+/// Skia's glyph caches are thread safe, so each invocation only needs its
+/// own canvas.
+static void RasterizeGlyphRanges(
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner,
+    size_t start_index,
+    size_t end_index,
+    const std::function<void(size_t start, size_t end)>& rasterize) {
+  const size_t task_count =
+      (end_index - start_index + kGlyphsPerRasterTask - 1) /
+      kGlyphsPerRasterTask;
+  if (!worker_task_runner || task_count < 2u) {
+    rasterize(start_index, end_index);
+    return;
+  }
+  fml::ParallelFor(worker_task_runner, task_count, [&](size_t task) {
+    const size_t start = start_index + task * kGlyphsPerRasterTask;
+    rasterize(start, std::min(start + kGlyphsPerRasterTask, end_index));
+  });
+}
+
+/// @brief Batch render to a single surface covering the rows of the texture
+///        at and below |band_top|, and upload those rows with one copy.
+///
+/// This is only safe for use when updating a fresh texture whose rows above
+/// |band_top| are filled by other means.
+static bool BulkUpdateAtlasBitmap(
+    const GlyphAtlas& atlas,
+    std::shared_ptr<BlitPass>& blit_pass,
+    HostBuffer& host_buffer,
+    const std::shared_ptr<Texture>& texture,
+    const std::vector<FontGlyphPair>& new_pairs,
+    size_t start_index,
+    size_t end_index,
+    int64_t band_top,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner,
+    GlyphCacheSkia* glyph_cache) {
   TRACE_EVENT0("impeller", __FUNCTION__);
 
   bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
 
+  const ISize texture_size = texture->GetSize();
+  FML_DCHECK(band_top >= 0 && band_top < texture_size.height);
+  const ISize band_size(texture_size.width, texture_size.height - band_top);
+
   SkBitmap bitmap;
-  bitmap.setInfo(GetImageInfo(atlas, Size(texture->GetSize())));
+  bitmap.setInfo(GetImageInfo(atlas, Size(band_size)));
   if (!bitmap.tryAllocPixels()) {
     return false;
   }
 
-  auto surface = SkSurfaces::WrapPixels(bitmap.pixmap());
-  if (!surface) {
-    return false;
-  }
-  auto canvas = surface->getCanvas();
-  if (!canvas) {
+  // Glyphs never overlap, so each task draws into its own surface wrapping
+  // the shared pixels.
+  std::atomic_bool failed = false;
+  RasterizeGlyphRanges(
+      worker_task_runner, start_index, end_index,
+      [&](size_t start, size_t end) {
+        auto surface = SkSurfaces::WrapPixels(bitmap.pixmap());
+        auto canvas = surface ? surface->getCanvas() : nullptr;
+        if (!canvas) {
+          failed = true;
+          return;
+        }
+        for (size_t i = start; i < end; i++) {
+          const FontGlyphPair& pair = new_pairs[i];
+          auto data = atlas.FindFontGlyphBounds(pair);
+          if (!data.has_value()) {
+            continue;
+          }
+          auto [pos, bounds, placeholder] = data.value();
+          FML_DCHECK(!placeholder);
+          FML_DCHECK(pos.GetTop() >= band_top);
+          Size size = pos.GetSize();
+          if (size.IsEmpty()) {
+            continue;
+          }
+
+          const SkPoint position =
+              SkPoint::Make(pos.GetLeft(), pos.GetTop() - band_top);
+          const SkIRect padded_bounds =
+              SkIRect::MakeXYWH(static_cast<int32_t>(position.x()) - 1,
+                                static_cast<int32_t>(position.y()) - 1,
+                                static_cast<int32_t>(size.width) + 2,
+                                static_cast<int32_t>(size.height) + 2);
+          SkPixmap glyph_pixmap;
+          const bool cacheable =
+              glyph_cache &&
+              bitmap.pixmap().extractSubset(&glyph_pixmap, padded_bounds);
+          if (cacheable &&
+              glyph_cache->Read(atlas.GetType(), pair, glyph_pixmap)) {
+            continue;
+          }
+
+          canvas->save();
+          canvas->clipRect(SkRect::Make(padded_bounds));
+          DrawGlyph(canvas, position, pair.scaled_font, pair.glyph, bounds,
+                    pair.glyph.properties, has_color);
+          canvas->restore();
+
+          if (cacheable) {
+            glyph_cache->Write(atlas.GetType(), pair, glyph_pixmap);
+          }
+        }
+      });
+  if (failed) {
     return false;
   }
 
-  for (size_t i = start_index; i < end_index; i++) {
-    const FontGlyphPair& pair = new_pairs[i];
-    auto data = atlas.FindFontGlyphBounds(pair);
-    if (!data.has_value()) {
-      continue;
-    }
-    auto [pos, bounds, placeholder] = data.value();
-    FML_DCHECK(!placeholder);
-    Size size = pos.GetSize();
-    if (size.IsEmpty()) {
-      continue;
-    }
-
-    DrawGlyph(canvas, SkPoint::Make(pos.GetLeft(), pos.GetTop()),
-              pair.scaled_font, pair.glyph, bounds, pair.glyph.properties,
-              has_color);
-  }
-
   // Writing to a malloc'd buffer and then copying to the staging buffers
   // benchmarks as substantially faster on a number of Android devices.
   BufferView buffer_view = host_buffer.Emplace(
       bitmap.getAddr(0, 0),
-      texture->GetSize().Area() *
-          BytesPerPixelForPixelFormat(
-              atlas.GetTexture()->GetTextureDescriptor().format),
+      band_size.Area() * BytesPerPixelForPixelFormat(
+                             texture->GetTextureDescriptor().format),
       DefaultUniformAlignment());
 
   return blit_pass->AddCopy(std::move(buffer_view),  //
                             texture,                 //
-                            IRect::MakeXYWH(0, 0, texture->GetSize().width,
-                                            texture->GetSize().height));
+                            IRect::MakeXYWH(0, band_top, band_size.width,
+                                            band_size.height));
 }
 
-static bool UpdateAtlasBitmap(const GlyphAtlas& atlas,
-                              std::shared_ptr<BlitPass>& blit_pass,
-                              HostBuffer& host_buffer,
-                              const std::shared_ptr<Texture>& texture,
-                              const std::vector<FontGlyphPair>& new_pairs,
-                              size_t start_index,
-                              size_t end_index) {
+static bool UpdateAtlasBitmap(
+    const GlyphAtlas& atlas,
+    std::shared_ptr<BlitPass>& blit_pass,
+    HostBuffer& host_buffer,
+    const std::shared_ptr<Texture>& texture,
+    const std::vector<FontGlyphPair>& new_pairs,
+    size_t start_index,
+    size_t end_index,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner,
+    GlyphCacheSkia* glyph_cache) {
   TRACE_EVENT0("impeller", __FUNCTION__);
 
   bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
-
+  const size_t bytes_per_pixel =
+      BytesPerPixelForPixelFormat(texture->GetTextureDescriptor().format);
+  const size_t alignment = DefaultUniformAlignment();
+
+  // The glyph bitmaps, each expanded by 1px of padding on every side, are
+  // laid out back to back in a single staging allocation so that they can
+  // be rasterized in parallel and uploaded with one host buffer emplace.
+  struct GlyphSlot {
+    size_t pair_index;
+    Rect bounds;
+    IRect region;
+    size_t offset;
+  };
+  std::vector<GlyphSlot> slots;
+  slots.reserve(end_index - start_index);
+  size_t staging_length = 0u;
   for (size_t i = start_index; i < end_index; i++) {
-    const FontGlyphPair& pair = new_pairs[i];
-    auto data = atlas.FindFontGlyphBounds(pair);
+    auto data = atlas.FindFontGlyphBounds(new_pairs[i]);
     if (!data.has_value()) {
       continue;
     }
@@ -335,49 +449,70 @@ static bool UpdateAtlasBitmap(const GlyphAtlas& atlas,
     if (size.IsEmpty()) {
       continue;
     }
-    // The uploaded bitmap is expanded by 1px of padding
-    // on each side.
-    size.width += 2;
-    size.height += 2;
-
-    SkBitmap bitmap;
-    bitmap.setInfo(GetImageInfo(atlas, size));
-    if (!bitmap.tryAllocPixels()) {
-      return false;
-    }
-
-    auto surface = SkSurfaces::WrapPixels(bitmap.pixmap());
-    if (!surface) {
-      return false;
-    }
-    auto canvas = surface->getCanvas();
-    if (!canvas) {
-      return false;
-    }
+    IRect region = IRect::MakeXYWH(pos.GetLeft() - 1, pos.GetTop() - 1,
+                                   size.width + 2, size.height + 2);
+    slots.push_back(GlyphSlot{i, bounds, region, staging_length});
+    staging_length += region.Area() * bytes_per_pixel;
+    staging_length = (staging_length + alignment - 1) / alignment * alignment;
+  }
+  if (slots.empty()) {
+    return blit_pass->ConvertTextureToShaderRead(texture);
+  }
 
-    DrawGlyph(canvas, SkPoint::Make(1, 1), pair.scaled_font, pair.glyph, bounds,
-              pair.glyph.properties, has_color);
+  // Writing to a malloc'd buffer and then copying to the staging buffers
+  // benchmarks as substantially faster on a number of Android devices.
+  std::vector<uint8_t> staging(staging_length);
+  std::atomic_bool failed = false;
+  RasterizeGlyphRanges(
+      worker_task_runner, 0u, slots.size(), [&](size_t start, size_t end) {
+        for (size_t i = start; i < end; i++) {
+          const GlyphSlot& slot = slots[i];
+          const FontGlyphPair& pair = new_pairs[slot.pair_index];
+          SkImageInfo info = GetImageInfo(atlas, Size(slot.region.GetSize()));
+          SkPixmap pixmap(info, staging.data() + slot.offset,
+                          info.minRowBytes());
+          if (glyph_cache &&
+              glyph_cache->Read(atlas.GetType(), pair, pixmap)) {
+            continue;
+          }
+          auto surface = SkSurfaces::WrapPixels(pixmap);
+          auto canvas = surface ? surface->getCanvas() : nullptr;
+          if (!canvas) {
+            failed = true;
+            return;
+          }
+          DrawGlyph(canvas, SkPoint::Make(1, 1), pair.scaled_font,
+                    pair.glyph, slot.bounds, pair.glyph.properties,
+                    has_color);
+          if (glyph_cache) {
+            glyph_cache->Write(atlas.GetType(), pair, pixmap);
+          }
+        }
+      });
+  if (failed) {
+    return false;
+  }
 
-    // Writing to a malloc'd buffer and then copying to the staging buffers
-    // benchmarks as substantially faster on a number of Android devices.
-    BufferView buffer_view = host_buffer.Emplace(
-        bitmap.getAddr(0, 0),
-        size.Area() * BytesPerPixelForPixelFormat(
-                          atlas.GetTexture()->GetTextureDescriptor().format),
-        DefaultUniformAlignment());
+  BufferView staging_view =
+      host_buffer.Emplace(staging.data(), staging_length, alignment);
+  if (!staging_view) {
+    return false;
+  }
 
-    // convert_to_read is set to false so that the texture remains in a transfer
-    // dst layout until we finish writing to it below. This only has an impact
-    // on Vulkan where we are responsible for managing image layouts.
+  for (const GlyphSlot& slot : slots) {
+    BufferView buffer_view = staging_view.GetSubView(
+        Range(slot.offset, slot.region.Area() * bytes_per_pixel));
+    // convert_to_read is set to false so that the texture remains in a
+    // transfer dst layout until we finish writing to it below. This only has
+    // an impact on Vulkan where we are responsible for managing image
+    // layouts.
     if (!blit_pass->AddCopy(std::move(buffer_view),  //
                             texture,                 //
-                            IRect::MakeXYWH(pos.GetLeft() - 1, pos.GetTop() - 1,
-                                            size.width, size.height),  //
-                            /*label=*/"",                              //
-                            /*mip_level=*/0,                           //
-                            /*slice=*/0,                               //
-                            /*convert_to_read=*/false                  //
-                            )) {
+                            slot.region,             //
+                            /*label=*/"",            //
+                            /*mip_level=*/0,         //
+                            /*slice=*/0,             //
+                            /*convert_to_read=*/false)) {
       return false;
     }
   }
@@ -508,6 +643,9 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
     return last_atlas;
   }
 
+  fml::ScopedCleanupClosure persist_glyph_cache(
+      [&]() { MaybePersistGlyphCache(); });
+
   // ---------------------------------------------------------------------------
   // Step 2: Determine if the additional missing glyphs can be appended to the
   //         existing bitmap without recreating the atlas.
@@ -548,7 +686,8 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
     // ---------------------------------------------------------------------------
     if (!UpdateAtlasBitmap(*last_atlas, blit_pass, host_buffer,
                            last_atlas->GetTexture(), new_glyphs, 0,
-                           first_missing_index)) {
+                           first_missing_index, worker_task_runner_,
+                           glyph_cache_.get())) {
       return nullptr;
     }
 
@@ -650,19 +789,24 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
 
   // ---------------------------------------------------------------------------
   // Step 4a: Draw new font-glyph pairs into the a host buffer and encode
-  // the uploads into the blit pass.
+  // the uploads into the blit pass. When the old atlas is blitted into the
+  // new one, only the rows added below it are rasterized and uploaded.
   // ---------------------------------------------------------------------------
+  if (!blit_old_atlas || !old_texture) {
+    height_adjustment = 0;
+  }
   if (!BulkUpdateAtlasBitmap(*new_atlas, blit_pass, host_buffer,
                              new_atlas->GetTexture(), new_glyphs,
-                             first_missing_index, new_glyphs.size())) {
+                             first_missing_index, new_glyphs.size(),
+                             height_adjustment, worker_task_runner_,
+                             glyph_cache_.get())) {
     return nullptr;
   }
 
   // Blit the old texture to the top left of the new atlas.
   if (blit_old_atlas && old_texture) {
     blit_pass->AddCopy(old_texture, new_atlas->GetTexture(),
-                       IRect::MakeSize(new_atlas->GetTexture()->GetSize()),
-                       {0, 0});
+                       IRect::MakeSize(old_texture->GetSize()), {0, 0});
   }
 
   // ---------------------------------------------------------------------------
@@ -5,16 +5,34 @@
 #ifndef FLUTTER_IMPELLER_TYPOGRAPHER_BACKENDS_SKIA_TYPOGRAPHER_CONTEXT_SKIA_H_
 #define FLUTTER_IMPELLER_TYPOGRAPHER_BACKENDS_SKIA_TYPOGRAPHER_CONTEXT_SKIA_H_
 
+#include "flutter/fml/concurrent_message_loop.h"
+#include "impeller/typographer/backends/skia/glyph_cache_skia.h"
 #include "impeller/typographer/typographer_context.h"
 
 namespace impeller {
 
 class TypographerContextSkia : public TypographerContext {
  public:
-  static std::shared_ptr<TypographerContext> Make();
+  //----------------------------------------------------------------------------
+  /// @brief      Create a typographer context.
+  ///
+  /// @param[in]  worker_task_runner  If provided, the glyphs added to an atlas
+  ///                                 are rasterized in parallel on this task
+  ///                                 runner.
+  /// @param[in]  glyph_cache         If provided, glyph bitmaps are read from
+  ///                                 and recorded into this persistent cache
+  ///                                 instead of always being rasterized.
+  ///
+  static std::shared_ptr<TypographerContext> Make(
+      std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner = nullptr,
+      std::shared_ptr<GlyphCacheSkia> glyph_cache = nullptr);
 
   TypographerContextSkia();
 
+  explicit TypographerContextSkia(
+      std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner,
+      std::shared_ptr<GlyphCacheSkia> glyph_cache = nullptr);
+
   ~TypographerContextSkia() override;
 
   // |TypographerContext|
@@ -35,6 +53,11 @@ class TypographerContextSkia : public TypographerContext {
   CollectNewGlyphs(const std::shared_ptr<GlyphAtlas>& atlas,
                    const std::vector<std::shared_ptr<TextFrame>>& text_frames);
 
+  void MaybePersistGlyphCache() const;
+
+  std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner_;
+  std::shared_ptr<GlyphCacheSkia> glyph_cache_;
+
   TypographerContextSkia(const TypographerContextSkia&) = delete;
 
   TypographerContextSkia& operator=(const TypographerContextSkia&) = delete;
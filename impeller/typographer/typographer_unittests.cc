@@ -3,11 +3,14 @@
 // found in the LICENSE file.
 
 #include "flutter/display_list/testing/dl_test_snippets.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/file.h"
 #include "flutter/testing/testing.h"
 #include "gtest/gtest.h"
 #include "impeller/core/host_buffer.h"
 #include "impeller/playground/playground.h"
 #include "impeller/playground/playground_test.h"
+#include "impeller/typographer/backends/skia/glyph_cache_skia.h"
 #include "impeller/typographer/backends/skia/text_frame_skia.h"
 #include "impeller/typographer/backends/skia/typographer_context_skia.h"
 #include "impeller/typographer/font_glyph_pair.h"
@@ -253,6 +256,154 @@ TEST_P(TypographerTest, GlyphAtlasWithLotsOfdUniqueGlyphSize) {
   EXPECT_TRUE(atlas->GetTexture()->GetSize().height > 0);
 }
 
+TEST_P(TypographerTest, GlyphAtlasWithWorkerTaskRunnerMatchesSerial) {
+  auto host_buffer = HostBuffer::Create(GetContext()->GetResourceAllocator(),
+                                        GetContext()->GetIdleWaiter());
+  auto loop = fml::ConcurrentMessageLoop::Create(4u);
+  auto serial_context = TypographerContextSkia::Make();
+  auto parallel_context = TypographerContextSkia::Make(loop->GetTaskRunner());
+  ASSERT_TRUE(parallel_context && parallel_context->IsValid());
+
+  SkFont sk_font = flutter::testing::CreateTestFontOfSize(12);
+  auto blob = SkTextBlob::MakeFromString(
+      "QWERTYUIOPASDFGHJKLZXCVBNMqewrtyuiopasdfghjklzxcvbnm", sk_font);
+  ASSERT_TRUE(blob);
+
+  auto make_atlas = [&](const TypographerContext& context) {
+    auto atlas_context =
+        context.CreateGlyphAtlasContext(GlyphAtlas::Type::kAlphaBitmap);
+    std::vector<std::shared_ptr<TextFrame>> frames;
+    for (size_t index = 0; index < 4; index += 1) {
+      frames.push_back(MakeTextFrameFromTextBlobSkia(blob));
+      frames.back()->SetPerFrameData(1.0 + index, {0, 0}, {});
+    }
+    // The first atlas is bulk rasterized, the second appends to it.
+    auto atlas = context.CreateGlyphAtlas(*GetContext(),
+                                          GlyphAtlas::Type::kAlphaBitmap,
+                                          *host_buffer, atlas_context, frames);
+    frames.push_back(MakeTextFrameFromTextBlobSkia(blob));
+    frames.back()->SetPerFrameData(7.0, {0, 0}, {});
+    return context.CreateGlyphAtlas(*GetContext(),
+                                    GlyphAtlas::Type::kAlphaBitmap,
+                                    *host_buffer, atlas_context, frames);
+  };
+
+  auto serial_atlas = make_atlas(*serial_context);
+  auto parallel_atlas = make_atlas(*parallel_context);
+  ASSERT_NE(serial_atlas, nullptr);
+  ASSERT_NE(parallel_atlas, nullptr);
+  ASSERT_NE(parallel_atlas->GetTexture(), nullptr);
+
+  EXPECT_GT(parallel_atlas->GetGlyphCount(), 64u);
+  EXPECT_EQ(parallel_atlas->GetGlyphCount(), serial_atlas->GetGlyphCount());
+  EXPECT_EQ(parallel_atlas->GetTexture()->GetSize(),
+            serial_atlas->GetTexture()->GetSize());
+}
+
+TEST_P(TypographerTest, GlyphCacheIsReusedAcrossContexts) {
+  auto host_buffer = HostBuffer::Create(GetContext()->GetResourceAllocator(),
+                                        GetContext()->GetIdleWaiter());
+  fml::ScopedTemporaryDirectory temp_dir;
+  auto open_cache = [&]() {
+    return GlyphCacheSkia::Create(fml::OpenDirectory(
+        temp_dir.path().c_str(), false, fml::FilePermission::kReadWrite));
+  };
+
+  SkFont sk_font = flutter::testing::CreateTestFontOfSize(12);
+  auto blob = SkTextBlob::MakeFromString("spooky skellingtons", sk_font);
+  ASSERT_TRUE(blob);
+
+  auto glyph_cache = open_cache();
+  ASSERT_TRUE(glyph_cache);
+  EXPECT_EQ(glyph_cache->GetGlyphCount(), 0u);
+  {
+    auto context = TypographerContextSkia::Make(nullptr, glyph_cache);
+    auto atlas_context =
+        context->CreateGlyphAtlasContext(GlyphAtlas::Type::kAlphaBitmap);
+    auto atlas =
+        CreateGlyphAtlas(*GetContext(), context.get(), *host_buffer,
+                         GlyphAtlas::Type::kAlphaBitmap, 1.0f, atlas_context,
+                         MakeTextFrameFromTextBlobSkia(blob));
+    ASSERT_NE(atlas, nullptr);
+    EXPECT_GT(glyph_cache->GetGlyphCount(), 0u);
+    EXPECT_EQ(glyph_cache->GetPendingGlyphCount(),
+              glyph_cache->GetGlyphCount());
+    // Destroying the context persists the pending glyphs.
+  }
+  EXPECT_EQ(glyph_cache->GetPendingGlyphCount(), 0u);
+
+  // A cache opened from the same directory is seeded with the glyphs and
+  // satisfies the next atlas without rasterizing anything new.
+  auto reloaded_cache = open_cache();
+  ASSERT_TRUE(reloaded_cache);
+  EXPECT_EQ(reloaded_cache->GetGlyphCount(), glyph_cache->GetGlyphCount());
+
+  auto context = TypographerContextSkia::Make(nullptr, reloaded_cache);
+  auto atlas_context =
+      context->CreateGlyphAtlasContext(GlyphAtlas::Type::kAlphaBitmap);
+  auto atlas =
+      CreateGlyphAtlas(*GetContext(), context.get(), *host_buffer,
+                       GlyphAtlas::Type::kAlphaBitmap, 1.0f, atlas_context,
+                       MakeTextFrameFromTextBlobSkia(blob));
+  ASSERT_NE(atlas, nullptr);
+  EXPECT_EQ(reloaded_cache->GetPendingGlyphCount(), 0u);
+}
+
+// Opens the glyph cache from a caches directory the way the Android embedder
+// does on each launch of the application.
+TEST_P(TypographerTest, FreshContextStartsWithSeededAtlas) {
+  auto host_buffer = HostBuffer::Create(GetContext()->GetResourceAllocator(),
+                                        GetContext()->GetIdleWaiter());
+  fml::ScopedTemporaryDirectory caches_dir;
+  auto open_cache = [&]() {
+    return GlyphCacheSkia::Create(fml::OpenDirectory(
+        caches_dir.path().c_str(), false, fml::FilePermission::kRead));
+  };
+
+  SkFont sk_font = flutter::testing::CreateTestFontOfSize(12);
+  auto blob = SkTextBlob::MakeFromString("the quick brown fox", sk_font);
+  ASSERT_TRUE(blob);
+  auto frame = MakeTextFrameFromTextBlobSkia(blob);
+
+  std::shared_ptr<GlyphAtlas> first_atlas;
+  {
+    auto context = TypographerContextSkia::Make(nullptr, open_cache());
+    auto atlas_context =
+        context->CreateGlyphAtlasContext(GlyphAtlas::Type::kAlphaBitmap);
+    first_atlas = CreateGlyphAtlas(*GetContext(), context.get(), *host_buffer,
+                                   GlyphAtlas::Type::kAlphaBitmap, 1.0f,
+                                   atlas_context, frame);
+    ASSERT_NE(first_atlas, nullptr);
+  }
+
+  auto glyph_cache = open_cache();
+  ASSERT_TRUE(glyph_cache);
+  EXPECT_GT(glyph_cache->GetGlyphCount(), 0u);
+
+  // Every glyph of the first atlas of the next launch comes from the cache
+  // and lands where it did in the previous launch.
+  auto context = TypographerContextSkia::Make(nullptr, glyph_cache);
+  auto atlas_context =
+      context->CreateGlyphAtlasContext(GlyphAtlas::Type::kAlphaBitmap);
+  auto atlas = CreateGlyphAtlas(*GetContext(), context.get(), *host_buffer,
+                                GlyphAtlas::Type::kAlphaBitmap, 1.0f,
+                                atlas_context, frame);
+  ASSERT_NE(atlas, nullptr);
+  EXPECT_EQ(glyph_cache->GetPendingGlyphCount(), 0u);
+  EXPECT_EQ(atlas->GetTexture()->GetSize(),
+            first_atlas->GetTexture()->GetSize());
+  EXPECT_EQ(atlas->GetGlyphCount(), first_atlas->GetGlyphCount());
+  first_atlas->IterateGlyphs([&](const ScaledFont& scaled_font,
+                                 const SubpixelGlyph& glyph, const Rect& rect) {
+    auto bounds = atlas->FindFontGlyphBounds(FontGlyphPair{scaled_font, glyph});
+    EXPECT_TRUE(bounds.has_value());
+    if (bounds.has_value()) {
+      EXPECT_EQ(bounds->atlas_bounds, rect);
+    }
+    return true;
+  });
+}
+
 TEST_P(TypographerTest, GlyphAtlasTextureIsRecycledIfUnchanged) {
   auto host_buffer = HostBuffer::Create(GetContext()->GetResourceAllocator(),
                                         GetContext()->GetIdleWaiter());
@@ -255,6 +255,19 @@ void createPath() {
 @pragma('vm:external-name', 'ValidatePath')
 external void _validatePath(Path path);
 
+@pragma('vm:entry-point')
+void recordPicture() {
+  final PictureRecorder recorder = PictureRecorder();
+  final Canvas canvas = Canvas(recorder);
+  canvas.drawRect(const Rect.fromLTRB(10, 10, 20, 20), Paint());
+  final Picture picture = recorder.endRecording();
+  _validatePicture(picture);
+  picture.dispose();
+}
+
+@pragma('vm:external-name', 'ValidatePicture')
+external void _validatePicture(Picture picture);
+
 @pragma('vm:entry-point')
 void frameCallback(Object? image, int durationMilliseconds, String decodeError) {
   validateFrameCallback(image, durationMilliseconds, decodeError);
@@ -6,6 +6,7 @@
 
 #include "flutter/lib/ui/painting/canvas.h"
 #include "flutter/lib/ui/painting/picture.h"
+#include "flutter/lib/ui/ui_dart_state.h"
 #include "third_party/tonic/converter/dart_converter.h"
 #include "third_party/tonic/dart_args.h"
 #include "third_party/tonic/dart_binding_macros.h"
@@ -26,8 +27,12 @@ PictureRecorder::PictureRecorder() {}
 PictureRecorder::~PictureRecorder() {}
 
 sk_sp<DisplayListBuilder> PictureRecorder::BeginRecording(SkRect bounds) {
-  display_list_builder_ =
-      sk_make_sp<DisplayListBuilder>(bounds, /*prepare_rtree=*/true);
+  DlStorageMode storage_mode =
+      UIDartState::Current()->IsChunkedDisplayListStorageEnabled()
+          ? DlStorageMode::kChunked
+          : DlStorageMode::kContiguous;
+  display_list_builder_ = sk_make_sp<DisplayListBuilder>(
+      bounds, /*prepare_rtree=*/true, storage_mode);
   return display_list_builder_;
 }
 
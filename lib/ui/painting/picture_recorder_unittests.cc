@@ -0,0 +1,78 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/picture_recorder.h"
+#include "flutter/lib/ui/painting/picture.h"
+#include "flutter/shell/common/shell_test.h"
+#include "flutter/shell/common/thread_host.h"
+
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+class PictureRecorderTest : public ShellTest {
+ public:
+  /// Records a picture in a shell with the given setting and returns the
+  /// storage mode of its display list.
+  DlStorageMode RecordPictureStorageMode(bool chunked_storage_enabled);
+};
+
+DlStorageMode PictureRecorderTest::RecordPictureStorageMode(
+    bool chunked_storage_enabled) {
+  auto message_latch = std::make_shared<fml::AutoResetWaitableEvent>();
+  DlStorageMode storage_mode = DlStorageMode::kContiguous;
+
+  auto native_validate_picture = [message_latch,
+                                  &storage_mode](Dart_NativeArguments args) {
+    intptr_t peer = 0;
+    Dart_Handle result = Dart_GetNativeInstanceField(
+        Dart_GetNativeArgument(args, 0), tonic::DartWrappable::kPeerIndex,
+        &peer);
+    EXPECT_FALSE(Dart_IsError(result));
+    Picture* picture = reinterpret_cast<Picture*>(peer);
+    EXPECT_TRUE(picture);
+    if (picture) {
+      storage_mode = picture->display_list()->GetStorage().mode();
+    }
+    message_latch->Signal();
+  };
+
+  Settings settings = CreateSettingsForFixture();
+  settings.enable_chunked_display_list_storage = chunked_storage_enabled;
+  TaskRunners task_runners("test",                  // label
+                           GetCurrentTaskRunner(),  // platform
+                           CreateNewThread(),       // raster
+                           CreateNewThread(),       // ui
+                           CreateNewThread()        // io
+  );
+
+  AddNativeCallback("ValidatePicture",
+                    CREATE_NATIVE_ENTRY(native_validate_picture));
+
+  std::unique_ptr<Shell> shell = CreateShell(settings, task_runners);
+
+  EXPECT_TRUE(shell->IsSetup());
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("recordPicture");
+
+  shell->RunEngine(std::move(configuration), [](auto result) {
+    ASSERT_EQ(result, Engine::RunStatus::Success);
+  });
+
+  message_latch->Wait();
+  DestroyShell(std::move(shell), task_runners);
+  return storage_mode;
+}
+
+TEST_F(PictureRecorderTest, UsesContiguousStorageByDefault) {
+  EXPECT_EQ(RecordPictureStorageMode(false), DlStorageMode::kContiguous);
+}
+
+TEST_F(PictureRecorderTest, UsesChunkedStorageWhenEnabled) {
+  EXPECT_EQ(RecordPictureStorageMode(true), DlStorageMode::kChunked);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -87,6 +87,10 @@ bool UIDartState::IsDeterministicRenderingEnabled() const {
   return context_.deterministic_rendering_enabled;
 }
 
+bool UIDartState::IsChunkedDisplayListStorageEnabled() const {
+  return context_.chunked_display_list_storage_enabled;
+}
+
 bool UIDartState::IsImpellerEnabled() const {
   return context_.enable_impeller;
 }
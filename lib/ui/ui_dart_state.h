@@ -94,6 +94,9 @@ class UIDartState : public tonic::DartState {
     /// Whether deterministic rendering practices should be used.
     bool deterministic_rendering_enabled = false;
 
+    /// Whether pictures should be recorded into chunked display list storage.
+    bool chunked_display_list_storage_enabled = false;
+
     /// The task runner whose tasks may be executed concurrently on a pool
     /// of shared worker threads.
     std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner;
@@ -167,6 +170,9 @@ class UIDartState : public tonic::DartState {
   /// Whether deterministic rendering practices are enabled for this application
   bool IsDeterministicRenderingEnabled() const;
 
+  /// Whether pictures are recorded into chunked display list storage.
+  bool IsChunkedDisplayListStorageEnabled() const;
+
   /// Whether Impeller is enabled for this application.
   bool IsImpellerEnabled() const;
 
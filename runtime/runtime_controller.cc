@@ -71,6 +71,8 @@ std::unique_ptr<RuntimeController> RuntimeController::Spawn(
                                        context_.concurrent_task_runner,
                                        context_.enable_impeller,
                                        context_.runtime_stage_backend};
+  spawned_context.chunked_display_list_storage_enabled =
+      context_.chunked_display_list_storage_enabled;
   auto result =
       std::make_unique<RuntimeController>(p_client,                      //
                                           vm_,                           //
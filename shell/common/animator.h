@@ -45,9 +45,13 @@ class Animator final {
         std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) = 0;
   };
 
+  /// Creates an animator whose frame pipeline holds up to |pipeline_depth|
+  /// frames, or the default for the platform if it is 0.
   Animator(Delegate& delegate,
            const TaskRunners& task_runners,
-           std::unique_ptr<VsyncWaiter> waiter);
+           std::unique_ptr<VsyncWaiter> waiter,
+           uint32_t pipeline_depth = 0,
+           PipelineMode pipeline_mode = PipelineMode::kThroughput);
 
   ~Animator();
 
@@ -81,6 +81,22 @@ Engine::Engine(Delegate& delegate,
              std::make_shared<FontCollection>(),
              nullptr,
              gpu_disabled_switch) {
+  UIDartState::Context context{
+      task_runners_,                           // task runners
+      std::move(snapshot_delegate),            // snapshot delegate
+      std::move(io_manager),                   // io manager
+      unref_queue,                             // Skia unref queue
+      image_decoder_->GetWeakPtr(),            // image decoder
+      image_generator_registry_.GetWeakPtr(),  // image generator registry
+      settings_.advisory_script_uri,           // advisory script uri
+      settings_.advisory_script_entrypoint,    // advisory script entrypoint
+      settings_.skia_deterministic_rendering_on_cpu,  // deterministic rendering
+      vm.GetConcurrentWorkerTaskRunner(),             // concurrent task runner
+      settings_.enable_impeller,                      // enable impeller
+      runtime_stage_type,                             // runtime stage type
+  };
+  context.chunked_display_list_storage_enabled =
+      settings_.enable_chunked_display_list_storage;
   runtime_controller_ = std::make_unique<RuntimeController>(
       *this,                                 // runtime delegate
       &vm,                                   // VM
@@ -90,21 +106,7 @@ Engine::Engine(Delegate& delegate,
       settings_.isolate_create_callback,     // isolate create callback
       settings_.isolate_shutdown_callback,   // isolate shutdown callback
       settings_.persistent_isolate_data,     // persistent isolate data
-      UIDartState::Context{
-          task_runners_,                           // task runners
-          std::move(snapshot_delegate),            // snapshot delegate
-          std::move(io_manager),                   // io manager
-          unref_queue,                             // Skia unref queue
-          image_decoder_->GetWeakPtr(),            // image decoder
-          image_generator_registry_.GetWeakPtr(),  // image generator registry
-          settings_.advisory_script_uri,           // advisory script uri
-          settings_.advisory_script_entrypoint,    // advisory script entrypoint
-          settings_
-              .skia_deterministic_rendering_on_cpu,  // deterministic rendering
-          vm.GetConcurrentWorkerTaskRunner(),        // concurrent task runner
-          settings_.enable_impeller,                 // enable impeller
-          runtime_stage_type,                        // runtime stage type
-      });
+      context);                              // context
 }
 
 std::unique_ptr<Engine> Engine::Spawn(
@@ -8,12 +8,14 @@
 #include <deque>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include "flutter/flow/frame_timings.h"
 #include "flutter/flow/layers/layer_tree.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/synchronization/semaphore.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
@@ -34,6 +36,42 @@ enum class PipelineConsumeResult {
   // NOLINTEND(readability-identifier-naming)
 };
 
+/// What the consumer of a |Pipeline| is handed when more than one resource
+/// is queued.
+enum class PipelineMode {
+  /// Every resource is consumed in the order it was produced.
+  kThroughput,
+  /// Resources whose target time has already passed are dropped when a
+  /// newer queued resource supersedes them, so that a consumer that fell
+  /// behind catches up with the producer instead of presenting stale
+  /// results.
+  kLatency,
+};
+
+/// Describes a resource at the time it was handed to the consumer.
+struct PipelineItemStats {
+  /// The time from the producer completing the resource to the consumer
+  /// being handed it.
+  fml::TimeDelta age;
+  /// The number of resources still queued behind this one.
+  size_t queued_behind = 0;
+  /// The number of stale resources that were dropped in favor of this one.
+  size_t dropped_before = 0;
+};
+
+/// Customizes how a |Pipeline| in |PipelineMode::kLatency| decides that a
+/// resource is stale. By default resources have no target time and are
+/// never dropped.
+template <class R>
+struct PipelineItemTraits {
+  /// The time by which the resource was meant to be consumed, or a zero
+  /// time point if it has none.
+  static fml::TimePoint GetTargetTime(const R& resource) { return {}; }
+
+  /// Whether consuming |newer| makes consuming |older| unnecessary.
+  static bool Supersedes(const R& newer, const R& older) { return true; }
+};
+
 size_t GetNextPipelineTraceID();
 
 /// A thread-safe queue of resources for a single consumer and a single
@@ -50,6 +88,9 @@ size_t GetNextPipelineTraceID();
 /// calls `Complete` on the continuation, which enqueues the resource and
 /// signals the waiting consumer.
 ///
+/// In |PipelineMode::kLatency| the consumer skips over queued resources that
+/// have missed their target time, see |PipelineItemTraits|.
+///
 /// Pipelines generate the following tracing information:
 /// * PipelineItem: async flow tracking time taken from the time a producer
 ///   calls |Produce| to the time a consumer consumes calls |Consume|.
@@ -57,6 +98,8 @@ size_t GetNextPipelineTraceID();
 ///   calls |Produce| to the time they complete the `ProducerContinuation` with
 ///   a resource.
 /// * Pipeline Depth: counter of inflight resource producers.
+/// * PipelineItemDropped: instant event for every stale resource dropped in
+///   |PipelineMode::kLatency|.
 ///
 /// The primary use of this class is as the frame pipeline used in Flutter's
 /// animator/rasterizer.
@@ -128,13 +171,22 @@ class Pipeline {
     FML_DISALLOW_COPY_AND_ASSIGN(ProducerContinuation);
   };
 
-  explicit Pipeline(uint32_t depth)
-      : empty_(depth), available_(0), inflight_(0) {}
+  explicit Pipeline(uint32_t depth,
+                    PipelineMode mode = PipelineMode::kThroughput)
+      : depth_(depth),
+        mode_(mode),
+        empty_(depth),
+        available_(0),
+        inflight_(0) {}
 
   ~Pipeline() = default;
 
   bool IsValid() const { return empty_.IsValid() && available_.IsValid(); }
 
+  uint32_t GetDepth() const { return depth_; }
+
+  PipelineMode GetMode() const { return mode_; }
+
   /// Creates a `ProducerContinuation` that a producer can use to add a
   /// resource to the queue.
   ///
@@ -178,46 +230,115 @@ class Pipeline {
   }
 
   using Consumer = std::function<void(ResourcePtr)>;
+  using ConsumerWithStats =
+      std::function<void(ResourcePtr, const PipelineItemStats&)>;
 
   /// @note Procedure doesn't copy all closures.
   [[nodiscard]] PipelineConsumeResult Consume(const Consumer& consumer) {
     if (consumer == nullptr) {
       return PipelineConsumeResult::NoneAvailable;
     }
+    return Consume(ConsumerWithStats(
+        [&consumer](ResourcePtr resource, const PipelineItemStats& stats) {
+          consumer(std::move(resource));
+        }));
+  }
+
+  /// Like |Consume|, but also hands the consumer the statistics of the
+  /// consumed resource.
+  [[nodiscard]] PipelineConsumeResult Consume(
+      const ConsumerWithStats& consumer) {
+    if (consumer == nullptr) {
+      return PipelineConsumeResult::NoneAvailable;
+    }
 
     if (!available_.TryWait()) {
       return PipelineConsumeResult::NoneAvailable;
     }
 
-    ResourcePtr resource;
-    size_t trace_id = 0;
+    QueueItem item;
+    std::vector<QueueItem> dropped_items;
     size_t items_count = 0;
 
     {
       std::scoped_lock lock(queue_mutex_);
-      std::tie(resource, trace_id) = std::move(queue_.front());
+      if (mode_ == PipelineMode::kLatency) {
+        DropStaleItemsLocked(fml::TimePoint::Now(), dropped_items);
+      }
+      item = std::move(queue_.front());
       queue_.pop_front();
       items_count = queue_.size();
     }
 
-    consumer(std::move(resource));
+    // Release the slots of the dropped items before running the consumer,
+    // without holding the lock as their resources are destroyed here.
+    for (QueueItem& dropped : dropped_items) {
+      TRACE_EVENT_INSTANT0("flutter", "PipelineItemDropped");
+      dropped.resource.reset();
+      empty_.Signal();
+      --inflight_;
+      TRACE_FLOW_END("flutter", "PipelineItem", dropped.trace_id);
+      TRACE_EVENT_ASYNC_END0("flutter", "PipelineItem", dropped.trace_id);
+    }
+
+    PipelineItemStats stats;
+    stats.age = fml::TimePoint::Now() - item.commit_time;
+    stats.queued_behind = items_count;
+    stats.dropped_before = dropped_items.size();
+    consumer(std::move(item.resource), stats);
 
     empty_.Signal();
     --inflight_;
 
-    TRACE_FLOW_END("flutter", "PipelineItem", trace_id);
-    TRACE_EVENT_ASYNC_END0("flutter", "PipelineItem", trace_id);
+    TRACE_FLOW_END("flutter", "PipelineItem", item.trace_id);
+    TRACE_EVENT_ASYNC_END0("flutter", "PipelineItem", item.trace_id);
 
     return items_count > 0 ? PipelineConsumeResult::MoreAvailable
                            : PipelineConsumeResult::Done;
   }
 
  private:
+  struct QueueItem {
+    ResourcePtr resource;
+    size_t trace_id = 0;
+    fml::TimePoint commit_time;
+  };
+
+  const uint32_t depth_;
+  const PipelineMode mode_;
   fml::Semaphore empty_;
   fml::Semaphore available_;
   std::atomic<int> inflight_;
   std::mutex queue_mutex_;
-  std::deque<std::pair<ResourcePtr, size_t>> queue_;
+  std::deque<QueueItem> queue_;
+
+  /// Moves the items at the front of the queue that have missed their target
+  /// time and are superseded by the item behind them into |dropped_items|.
+  ///
+  /// The front item has already been accounted for by the caller. Every
+  /// dropped item after it takes one more count from |available_|, and an
+  /// item whose count hasn't been signaled yet stops the dropping.
+  void DropStaleItemsLocked(fml::TimePoint now,
+                            std::vector<QueueItem>& dropped_items) {
+    using Traits = PipelineItemTraits<Resource>;
+    while (queue_.size() > 1u) {
+      const ResourcePtr& front = queue_[0].resource;
+      const ResourcePtr& next = queue_[1].resource;
+      if (!front || !next) {
+        return;
+      }
+      fml::TimePoint target_time = Traits::GetTargetTime(*front);
+      if (target_time == fml::TimePoint() || target_time > now ||
+          !Traits::Supersedes(*next, *front)) {
+        return;
+      }
+      if (!available_.TryWait()) {
+        return;
+      }
+      dropped_items.push_back(std::move(queue_.front()));
+      queue_.pop_front();
+    }
+  }
 
   /// Commits a produced resource to the queue and signals the consumer that a
   /// resource is available.
@@ -226,7 +347,7 @@ class Pipeline {
     {
       std::scoped_lock lock(queue_mutex_);
       is_first_item = queue_.empty();
-      queue_.emplace_back(std::move(resource), trace_id);
+      queue_.push_back({std::move(resource), trace_id, fml::TimePoint::Now()});
     }
 
     // Ensure the queue mutex is not held as that would be a pessimization.
@@ -244,7 +365,7 @@ class Pipeline {
         empty_.Signal();
         return {.success = false, .is_first_item = false};
       }
-      queue_.emplace_back(std::move(resource), trace_id);
+      queue_.push_back({std::move(resource), trace_id, fml::TimePoint::Now()});
     }
 
     // Ensure the queue mutex is not held as that would be a pessimization.
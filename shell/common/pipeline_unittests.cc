@@ -9,6 +9,7 @@
 #include <functional>
 #include <future>
 #include <memory>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -18,6 +19,59 @@ namespace testing {
 using IntPipeline = Pipeline<int>;
 using Continuation = IntPipeline::ProducerContinuation;
 
+struct TimedItem {
+  int value;
+  fml::TimePoint target_time;
+  bool supersedes_previous = true;
+};
+
+using TimedPipeline = Pipeline<TimedItem>;
+
+}  // namespace testing
+
+template <>
+struct PipelineItemTraits<testing::TimedItem> {
+  static fml::TimePoint GetTargetTime(const testing::TimedItem& item) {
+    return item.target_time;
+  }
+  static bool Supersedes(const testing::TimedItem& newer,
+                         const testing::TimedItem& older) {
+    return newer.supersedes_previous;
+  }
+};
+
+namespace testing {
+
+static void ProduceTimedItem(TimedPipeline& pipeline,
+                             int value,
+                             fml::TimePoint target_time,
+                             bool supersedes_previous = true) {
+  auto timed_continuation = pipeline.Produce();
+  ASSERT_TRUE(timed_continuation);
+  PipelineProduceResult result =
+      timed_continuation.Complete(std::make_unique<TimedItem>(
+          TimedItem{value, target_time, supersedes_previous}));
+  ASSERT_TRUE(result.success);
+}
+
+static std::vector<int> ConsumeAllTimedItems(
+    TimedPipeline& pipeline,
+    std::vector<PipelineItemStats>* stats = nullptr) {
+  std::vector<int> values;
+  PipelineConsumeResult consume_result;
+  do {
+    consume_result = pipeline.Consume(TimedPipeline::ConsumerWithStats(
+        [&](std::unique_ptr<TimedItem> item,
+            const PipelineItemStats& item_stats) {
+          values.push_back(item->value);
+          if (stats) {
+            stats->push_back(item_stats);
+          }
+        }));
+  } while (consume_result == PipelineConsumeResult::MoreAvailable);
+  return values;
+}
+
 TEST(PipelineTest, ConsumeOneVal) {
   std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(2);
 
@@ -144,5 +198,86 @@ TEST(PipelineTest, ProduceIfEmptySuccessfulIfQueueIsEmpty) {
   ASSERT_EQ(consume_result_1, PipelineConsumeResult::Done);
 }
 
+TEST(PipelineTest, ConfiguredDepthBoundsItemsInFlight) {
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(3);
+  ASSERT_EQ(pipeline->GetDepth(), 3u);
+  ASSERT_EQ(pipeline->GetMode(), PipelineMode::kThroughput);
+
+  Continuation continuation_1 = pipeline->Produce();
+  Continuation continuation_2 = pipeline->Produce();
+  Continuation continuation_3 = pipeline->Produce();
+  Continuation continuation_4 = pipeline->Produce();
+  ASSERT_TRUE(continuation_1);
+  ASSERT_TRUE(continuation_2);
+  ASSERT_TRUE(continuation_3);
+  ASSERT_FALSE(continuation_4);
+}
+
+TEST(PipelineTest, ThroughputModeConsumesStaleItems) {
+  TimedPipeline pipeline(3);
+  fml::TimePoint past = fml::TimePoint::Now() - fml::TimeDelta::FromSeconds(1);
+  ProduceTimedItem(pipeline, 1, past);
+  ProduceTimedItem(pipeline, 2, past);
+  ProduceTimedItem(pipeline, 3, past);
+
+  EXPECT_EQ(ConsumeAllTimedItems(pipeline), std::vector<int>({1, 2, 3}));
+}
+
+TEST(PipelineTest, LatencyModeDropsStaleItems) {
+  TimedPipeline pipeline(3, PipelineMode::kLatency);
+  fml::TimePoint now = fml::TimePoint::Now();
+  fml::TimePoint past = now - fml::TimeDelta::FromSeconds(1);
+  fml::TimePoint future = now + fml::TimeDelta::FromSeconds(10);
+  ProduceTimedItem(pipeline, 1, past);
+  ProduceTimedItem(pipeline, 2, past);
+  ProduceTimedItem(pipeline, 3, future);
+
+  std::vector<PipelineItemStats> stats;
+  EXPECT_EQ(ConsumeAllTimedItems(pipeline, &stats), std::vector<int>({3}));
+  ASSERT_EQ(stats.size(), 1u);
+  EXPECT_EQ(stats[0].dropped_before, 2u);
+  EXPECT_EQ(stats[0].queued_behind, 0u);
+
+  // The slots of the dropped items are available again.
+  ProduceTimedItem(pipeline, 4, future);
+  ProduceTimedItem(pipeline, 5, future);
+  ProduceTimedItem(pipeline, 6, future);
+  EXPECT_EQ(ConsumeAllTimedItems(pipeline), std::vector<int>({4, 5, 6}));
+}
+
+TEST(PipelineTest, LatencyModeKeepsLastStaleItem) {
+  TimedPipeline pipeline(2, PipelineMode::kLatency);
+  fml::TimePoint past = fml::TimePoint::Now() - fml::TimeDelta::FromSeconds(1);
+  ProduceTimedItem(pipeline, 1, past);
+  ProduceTimedItem(pipeline, 2, past);
+
+  EXPECT_EQ(ConsumeAllTimedItems(pipeline), std::vector<int>({2}));
+}
+
+TEST(PipelineTest, LatencyModeKeepsItemsThatAreNotSuperseded) {
+  TimedPipeline pipeline(3, PipelineMode::kLatency);
+  fml::TimePoint past = fml::TimePoint::Now() - fml::TimeDelta::FromSeconds(1);
+  ProduceTimedItem(pipeline, 1, past);
+  ProduceTimedItem(pipeline, 2, past, /*supersedes_previous=*/false);
+  ProduceTimedItem(pipeline, 3, past);
+
+  EXPECT_EQ(ConsumeAllTimedItems(pipeline), std::vector<int>({1, 3}));
+}
+
+TEST(PipelineTest, ConsumeReportsItemStats) {
+  TimedPipeline pipeline(2);
+  ProduceTimedItem(pipeline, 1, fml::TimePoint());
+  ProduceTimedItem(pipeline, 2, fml::TimePoint());
+
+  std::vector<PipelineItemStats> stats;
+  EXPECT_EQ(ConsumeAllTimedItems(pipeline, &stats), std::vector<int>({1, 2}));
+  ASSERT_EQ(stats.size(), 2u);
+  EXPECT_EQ(stats[0].queued_behind, 1u);
+  EXPECT_EQ(stats[1].queued_behind, 0u);
+  EXPECT_EQ(stats[0].dropped_before, 0u);
+  EXPECT_GE(stats[0].age, fml::TimeDelta::Zero());
+  EXPECT_GE(stats[1].age, fml::TimeDelta::Zero());
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -242,6 +242,33 @@ void Rasterizer::DrawLastLayerTrees(
   }
 }
 
+fml::TimePoint PipelineItemTraits<FrameItem>::GetTargetTime(
+    const FrameItem& item) {
+  if (!item.frame_timings_recorder) {
+    return {};
+  }
+  return item.frame_timings_recorder->GetVsyncTargetTime();
+}
+
+bool PipelineItemTraits<FrameItem>::Supersedes(const FrameItem& newer,
+                                               const FrameItem& older) {
+  for (const auto& older_task : older.layer_tree_tasks) {
+    if (!older_task) {
+      continue;
+    }
+    auto found = std::find_if(
+        newer.layer_tree_tasks.begin(), newer.layer_tree_tasks.end(),
+        [&older_task](const std::unique_ptr<LayerTreeTask>& newer_task) {
+          return newer_task && newer_task->layer_tree &&
+                 newer_task->view_id == older_task->view_id;
+        });
+    if (found == newer.layer_tree_tasks.end()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 DrawStatus Rasterizer::Draw(const std::shared_ptr<FramePipeline>& pipeline) {
   TRACE_EVENT0("flutter", "GPURasterizer::Draw");
   if (raster_thread_merger_ &&
@@ -254,11 +281,14 @@ DrawStatus Rasterizer::Draw(const std::shared_ptr<FramePipeline>& pipeline) {
                  ->RunsTasksOnCurrentThread());
 
   DoDrawResult draw_result;
-  FramePipeline::Consumer consumer = [&draw_result,
-                                      this](std::unique_ptr<FrameItem> item) {
-    draw_result = DoDraw(std::move(item->frame_timings_recorder),
-                         std::move(item->layer_tree_tasks));
-  };
+  FramePipeline::ConsumerWithStats consumer =
+      [&draw_result, this](std::unique_ptr<FrameItem> item,
+                           const PipelineItemStats& stats) {
+        item->frame_timings_recorder->RecordPipelineStatistics(
+            stats.age, stats.queued_behind, stats.dropped_before);
+        draw_result = DoDraw(std::move(item->frame_timings_recorder),
+                             std::move(item->layer_tree_tasks));
+      };
 
   PipelineConsumeResult consume_result = pipeline->Consume(consumer);
   if (consume_result == PipelineConsumeResult::NoneAvailable) {
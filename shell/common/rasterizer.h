@@ -95,6 +95,14 @@ struct FrameItem {
   std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder;
 };
 
+/// A frame is stale once its vsync target time has passed, and it is
+/// superseded by a newer frame that draws to all of its views.
+template <>
+struct PipelineItemTraits<FrameItem> {
+  static fml::TimePoint GetTargetTime(const FrameItem& item);
+  static bool Supersedes(const FrameItem& newer, const FrameItem& older);
+};
+
 using FramePipeline = Pipeline<FrameItem>;
 
 //------------------------------------------------------------------------------
@@ -327,8 +327,13 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
 
         // The animator is owned by the UI thread but it gets its vsync pulses
         // from the platform.
-        auto animator = std::make_unique<Animator>(*shell, task_runners,
-                                                   std::move(vsync_waiter));
+        const Settings& shell_settings = shell->GetSettings();
+        auto animator = std::make_unique<Animator>(
+            *shell, task_runners, std::move(vsync_waiter),
+            shell_settings.frame_pipeline_depth,
+            shell_settings.frame_pipeline_low_latency
+                ? PipelineMode::kLatency
+                : PipelineMode::kThroughput);
 
         engine_promise.set_value(on_create_engine(
             *shell,                               //
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include <algorithm>
+#include <charconv>
 #include <iomanip>
 #include <iostream>
 #include <iterator>
@@ -86,6 +87,10 @@ static std::unique_ptr<fml::Mapping> GetICUStaticMapping() {
 
 namespace flutter {
 
+// Deeper pipelines only add latency since the raster thread can never catch up
+// with more than a few frames queued.
+static constexpr int64_t kMaxFramePipelineDepth = 8;
+
 void PrintUsage(const std::string& executable_name) {
   std::cerr << std::endl << "  " << executable_name << std::endl << std::endl;
 
@@ -357,6 +362,9 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.skia_deterministic_rendering_on_cpu =
       command_line.HasOption(FlagForSwitch(Switch::SkiaDeterministicRendering));
 
+  settings.enable_chunked_display_list_storage = command_line.HasOption(
+      FlagForSwitch(Switch::EnableChunkedDisplayListStorage));
+
   settings.verbose_logging =
       command_line.HasOption(FlagForSwitch(Switch::VerboseLogging));
 
@@ -473,6 +481,10 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
       command_line.HasOption(FlagForSwitch(Switch::EnableOpenGLGPUTracing));
   settings.enable_vulkan_gpu_tracing =
       command_line.HasOption(FlagForSwitch(Switch::EnableVulkanGPUTracing));
+  settings.enable_impeller_glyph_cache =
+      command_line.HasOption(FlagForSwitch(Switch::EnableImpellerGlyphCache));
+  settings.enable_impeller_pipeline_variant_manifest = command_line.HasOption(
+      FlagForSwitch(Switch::EnableImpellerPipelineVariantManifest));
 
   settings.enable_embedder_api =
       command_line.HasOption(FlagForSwitch(Switch::EnableEmbedderAPI));
@@ -523,6 +535,26 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
         std::stoi(resource_cache_max_bytes_threshold);
   }
 
+  if (command_line.HasOption(FlagForSwitch(Switch::FramePipelineDepth))) {
+    std::string frame_pipeline_depth;
+    command_line.GetOptionValue(FlagForSwitch(Switch::FramePipelineDepth),
+                                &frame_pipeline_depth);
+    int64_t depth = 0;
+    const char* end = frame_pipeline_depth.data() + frame_pipeline_depth.size();
+    auto [parsed_end, error] =
+        std::from_chars(frame_pipeline_depth.data(), end, depth);
+    if (error != std::errc() || parsed_end != end || depth < 1) {
+      FML_LOG(ERROR) << "Ignoring invalid frame pipeline depth \""
+                     << frame_pipeline_depth << "\".";
+    } else {
+      settings.frame_pipeline_depth = static_cast<uint32_t>(
+          std::min<int64_t>(depth, kMaxFramePipelineDepth));
+    }
+  }
+
+  settings.frame_pipeline_low_latency =
+      command_line.HasOption(FlagForSwitch(Switch::FramePipelineLowLatency));
+
   settings.enable_platform_isolates =
       command_line.HasOption(FlagForSwitch(Switch::EnablePlatformIsolates));
 
@@ -141,6 +141,11 @@ DEF_SWITCH(SkiaDeterministicRendering,
            "Skips the call to SkGraphics::Init(), thus avoiding swapping out "
            "some Skia function pointers based on available CPU features. This "
            "is used to obtain 100% deterministic behavior in Skia rendering.")
+DEF_SWITCH(EnableChunkedDisplayListStorage,
+           "enable-chunked-display-list-storage",
+           "Store the records of the display lists recorded by the framework "
+           "in fixed size chunks that are recycled between frames instead of "
+           "in a single buffer that is grown by copying.")
 DEF_SWITCH(FlutterAssetsDir,
            "flutter-assets-dir",
            "Path to the Flutter assets directory.")
@@ -262,10 +267,29 @@ DEF_SWITCH(OldGenHeapSize,
 DEF_SWITCH(ResourceCacheMaxBytesThreshold,
            "resource-cache-max-bytes-threshold",
            "The max bytes threshold of resource cache, or 0 for unlimited.")
+DEF_SWITCH(FramePipelineDepth,
+           "frame-pipeline-depth",
+           "The maximum number of frames that the UI thread may build ahead "
+           "of the raster thread. Defaults to 2, or 1 when the platform and "
+           "raster threads are merged.")
+DEF_SWITCH(FramePipelineLowLatency,
+           "frame-pipeline-low-latency",
+           "Skip frames queued for the raster thread that have missed their "
+           "vsync target when a newer frame is already queued.")
 DEF_SWITCH(EnableImpeller,
            "enable-impeller",
            "Enable the Impeller renderer on supported platforms. Ignored if "
            "Impeller is not supported on the platform.")
+DEF_SWITCH(EnableImpellerGlyphCache,
+           "enable-impeller-glyph-cache",
+           "Persist the glyph bitmaps rasterized by Impeller in the caches "
+           "directory so that text drawn in a previous launch does not need "
+           "to be rasterized again.")
+DEF_SWITCH(EnableImpellerPipelineVariantManifest,
+           "enable-impeller-pipeline-variant-manifest",
+           "Record the pipeline variants created by Impeller in the caches "
+           "directory so that they are compiled in the background before the "
+           "first frame of the next launch.")
 DEF_SWITCH(ImpellerBackend,
            "impeller-backend",
            "Requests a particular Impeller backend on platforms that support "
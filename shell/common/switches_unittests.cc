@@ -105,6 +105,65 @@ TEST(SwitchesTest, NoEnableImpeller) {
   }
 }
 
+TEST(SwitchesTest, EnableChunkedDisplayListStorage) {
+  fml::CommandLine command_line =
+      fml::CommandLineFromInitializerList({"command"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_FALSE(settings.enable_chunked_display_list_storage);
+
+  command_line = fml::CommandLineFromInitializerList(
+      {"command", "--enable-chunked-display-list-storage"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_TRUE(settings.enable_chunked_display_list_storage);
+}
+
+TEST(SwitchesTest, EnableImpellerGlyphCache) {
+  fml::CommandLine command_line =
+      fml::CommandLineFromInitializerList({"command"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_FALSE(settings.enable_impeller_glyph_cache);
+
+  command_line = fml::CommandLineFromInitializerList(
+      {"command", "--enable-impeller-glyph-cache"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_TRUE(settings.enable_impeller_glyph_cache);
+}
+
+TEST(SwitchesTest, EnableImpellerPipelineVariantManifest) {
+  fml::CommandLine command_line =
+      fml::CommandLineFromInitializerList({"command"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_FALSE(settings.enable_impeller_pipeline_variant_manifest);
+
+  command_line = fml::CommandLineFromInitializerList(
+      {"command", "--enable-impeller-pipeline-variant-manifest"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_TRUE(settings.enable_impeller_pipeline_variant_manifest);
+}
+
+TEST(SwitchesTest, FramePipelineDepth) {
+  {
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--frame-pipeline-depth=3"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.frame_pipeline_depth, 3u);
+  }
+  {
+    // Clamped to the maximum.
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--frame-pipeline-depth=1000"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.frame_pipeline_depth, 8u);
+  }
+  // Invalid values keep the platform default.
+  for (const char* value : {"0", "-1", "two", "2x", ""}) {
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", (std::string("--frame-pipeline-depth=") + value).c_str()});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.frame_pipeline_depth, 0u) << value;
+  }
+}
+
 #if !FLUTTER_RELEASE
 TEST(SwitchesTest, EnableAsserts) {
   fml::CommandLine command_line = fml::CommandLineFromInitializerList(
@@ -8,6 +8,7 @@
 #include "flutter/shell/gpu/gpu_surface_metal_impeller.h"
 #include "gtest/gtest.h"
 #include "impeller/display_list/aiks_context.h"
+#include "impeller/entity/mtl/compute_entity_shaders.h"
 #include "impeller/entity/mtl/entity_shaders.h"
 #include "impeller/entity/mtl/framebuffer_blend_shaders.h"
 #include "impeller/entity/mtl/modern_shaders.h"
@@ -50,6 +51,9 @@ static std::shared_ptr<impeller::ContextMTL> CreateImpellerContext() {
                                              impeller_entity_shaders_length),
       std::make_shared<fml::NonOwnedMapping>(impeller_modern_shaders_data,
                                              impeller_modern_shaders_length),
+      std::make_shared<fml::NonOwnedMapping>(
+          impeller_compute_entity_shaders_data,
+          impeller_compute_entity_shaders_length),
       std::make_shared<fml::NonOwnedMapping>(impeller_framebuffer_blend_shaders_data,
                                              impeller_framebuffer_blend_shaders_length),
   };
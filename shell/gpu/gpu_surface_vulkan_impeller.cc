@@ -48,14 +48,22 @@ class WrappedTextureSourceVK : public impeller::TextureSourceVK {
 
 GPUSurfaceVulkanImpeller::GPUSurfaceVulkanImpeller(
     GPUSurfaceVulkanDelegate* delegate,
-    std::shared_ptr<impeller::Context> context)
+    std::shared_ptr<impeller::Context> context,
+    std::shared_ptr<impeller::GlyphCacheSkia> glyph_cache,
+    std::shared_ptr<impeller::PipelineVariantManifest> variant_manifest)
     : delegate_(delegate) {
   if (!context || !context->IsValid()) {
     return;
   }
 
+  auto worker_task_runner = impeller::SurfaceContextVK::Cast(*context)
+                                .GetParent()
+                                ->GetConcurrentWorkerTaskRunner();
   auto aiks_context = std::make_shared<impeller::AiksContext>(
-      context, impeller::TypographerContextSkia::Make());
+      context,
+      impeller::TypographerContextSkia::Make(worker_task_runner,
+                                             std::move(glyph_cache)),
+      /*render_target_allocator=*/std::nullopt, std::move(variant_manifest));
   if (!aiks_context->IsValid()) {
     return;
   }
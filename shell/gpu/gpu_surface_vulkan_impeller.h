@@ -10,7 +10,9 @@
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/impeller/display_list/aiks_context.h"
+#include "flutter/impeller/entity/contents/pipeline_variant_manifest.h"
 #include "flutter/impeller/renderer/context.h"
+#include "flutter/impeller/typographer/backends/skia/glyph_cache_skia.h"
 #include "flutter/shell/gpu/gpu_surface_vulkan_delegate.h"
 #include "impeller/renderer/backend/vulkan/swapchain/swapchain_transients_vk.h"
 
@@ -18,8 +20,15 @@ namespace flutter {
 
 class GPUSurfaceVulkanImpeller final : public Surface {
  public:
-  explicit GPUSurfaceVulkanImpeller(GPUSurfaceVulkanDelegate* delegate,
-                                    std::shared_ptr<impeller::Context> context);
+  /// Creates a surface whose typographer context reads and records glyph
+  /// bitmaps in |glyph_cache| if one is provided. The pipeline variants the
+  /// surface creates are recorded in |variant_manifest| if one is provided.
+  explicit GPUSurfaceVulkanImpeller(
+      GPUSurfaceVulkanDelegate* delegate,
+      std::shared_ptr<impeller::Context> context,
+      std::shared_ptr<impeller::GlyphCacheSkia> glyph_cache = nullptr,
+      std::shared_ptr<impeller::PipelineVariantManifest> variant_manifest =
+          nullptr);
 
   // |Surface|
   ~GPUSurfaceVulkanImpeller() override;
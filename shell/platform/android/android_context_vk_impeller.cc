@@ -6,6 +6,7 @@
 
 #include "flutter/fml/logging.h"
 #include "flutter/fml/paths.h"
+#include "flutter/impeller/entity/vk/compute_entity_shaders_vk.h"
 #include "flutter/impeller/entity/vk/entity_shaders_vk.h"
 #include "flutter/impeller/entity/vk/framebuffer_blend_shaders_vk.h"
 #include "flutter/impeller/entity/vk/modern_shaders_vk.h"
@@ -30,6 +31,9 @@ static std::shared_ptr<impeller::Context> CreateImpellerContext(
           impeller_framebuffer_blend_shaders_vk_length),
       std::make_shared<fml::NonOwnedMapping>(impeller_modern_shaders_vk_data,
                                              impeller_modern_shaders_vk_length),
+      std::make_shared<fml::NonOwnedMapping>(
+          impeller_compute_entity_shaders_vk_data,
+          impeller_compute_entity_shaders_vk_length),
   };
 
   auto instance_proc_addr =
@@ -76,6 +80,16 @@ AndroidContextVKImpeller::AndroidContextVKImpeller(
   auto impeller_context = CreateImpellerContext(vulkan_dylib_, settings);
   SetImpellerContext(impeller_context);
   is_valid_ = !!impeller_context;
+  if (is_valid_ && settings.enable_glyph_cache) {
+    glyph_cache_ =
+        impeller::GlyphCacheSkia::Create(fml::paths::GetCachesDirectory());
+  }
+  if (is_valid_ && settings.enable_pipeline_variant_manifest) {
+    variant_manifest_ = impeller::PipelineVariantManifest::Create(
+        fml::paths::GetCachesDirectory(),
+        impeller::ContextVK::Cast(*impeller_context)
+            .GetConcurrentWorkerTaskRunner());
+  }
 }
 
 AndroidContextVKImpeller::~AndroidContextVKImpeller() = default;
@@ -8,6 +8,8 @@
 #include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/native_library.h"
+#include "flutter/impeller/entity/contents/pipeline_variant_manifest.h"
+#include "flutter/impeller/typographer/backends/skia/glyph_cache_skia.h"
 #include "flutter/shell/platform/android/context/android_context.h"
 
 namespace flutter {
@@ -22,8 +24,23 @@ class AndroidContextVKImpeller : public AndroidContext {
   // |AndroidContext|
   bool IsValid() const override;
 
+  /// The persistent glyph cache shared by the surfaces created from this
+  /// context, or null if the glyph cache is disabled.
+  const std::shared_ptr<impeller::GlyphCacheSkia>& GetGlyphCache() const {
+    return glyph_cache_;
+  }
+
+  /// The manifest of pipeline variants shared by the surfaces created from
+  /// this context, or null if the manifest is disabled.
+  const std::shared_ptr<impeller::PipelineVariantManifest>&
+  GetPipelineVariantManifest() const {
+    return variant_manifest_;
+  }
+
  private:
   fml::RefPtr<fml::NativeLibrary> vulkan_dylib_;
+  std::shared_ptr<impeller::GlyphCacheSkia> glyph_cache_;
+  std::shared_ptr<impeller::PipelineVariantManifest> variant_manifest_;
   bool is_valid_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(AndroidContextVKImpeller);
@@ -24,8 +24,10 @@ AndroidSurfaceVKImpeller::AndroidSurfaceVKImpeller(
   auto& context_vk =
       impeller::ContextVK::Cast(*android_context->GetImpellerContext());
   surface_context_vk_ = context_vk.CreateSurfaceContext();
-  eager_gpu_surface_ =
-      std::make_unique<GPUSurfaceVulkanImpeller>(nullptr, surface_context_vk_);
+  glyph_cache_ = android_context->GetGlyphCache();
+  variant_manifest_ = android_context->GetPipelineVariantManifest();
+  eager_gpu_surface_ = std::make_unique<GPUSurfaceVulkanImpeller>(
+      nullptr, surface_context_vk_, glyph_cache_, variant_manifest_);
 }
 
 AndroidSurfaceVKImpeller::~AndroidSurfaceVKImpeller() = default;
@@ -57,7 +59,8 @@ std::unique_ptr<Surface> AndroidSurfaceVKImpeller::CreateGPUSurface(
   }
 
   std::unique_ptr<GPUSurfaceVulkanImpeller> gpu_surface =
-      std::make_unique<GPUSurfaceVulkanImpeller>(nullptr, surface_context_vk_);
+      std::make_unique<GPUSurfaceVulkanImpeller>(
+          nullptr, surface_context_vk_, glyph_cache_, variant_manifest_);
 
   if (!gpu_surface->IsValid()) {
     return nullptr;
@@ -49,6 +49,8 @@ class AndroidSurfaceVKImpeller : public AndroidSurface {
 
  private:
   std::shared_ptr<impeller::SurfaceContextVK> surface_context_vk_;
+  std::shared_ptr<impeller::GlyphCacheSkia> glyph_cache_;
+  std::shared_ptr<impeller::PipelineVariantManifest> variant_manifest_;
   fml::RefPtr<AndroidNativeWindow> native_window_;
   // The first GPU Surface is initialized as soon as the
   // AndroidSurfaceVulkanImpeller is created. This ensures that the pipelines
@@ -26,6 +26,8 @@ class AndroidContext {
     bool enable_validation = false;
     bool enable_gpu_tracing = false;
     bool disable_surface_control = false;
+    bool enable_glyph_cache = false;
+    bool enable_pipeline_variant_manifest = false;
     bool quiet = false;
   };
 
@@ -47,6 +47,10 @@ public class FlutterLoader {
       "io.flutter.embedding.android.EnableOpenGLGPUTracing";
   private static final String IMPELLER_VULKAN_GPU_TRACING_DATA_KEY =
       "io.flutter.embedding.android.EnableVulkanGPUTracing";
+  private static final String IMPELLER_GLYPH_CACHE_DATA_KEY =
+      "io.flutter.embedding.android.EnableImpellerGlyphCache";
+  private static final String IMPELLER_PIPELINE_VARIANT_MANIFEST_DATA_KEY =
+      "io.flutter.embedding.android.EnableImpellerPipelineVariantManifest";
   private static final String DISABLE_MERGED_PLATFORM_UI_THREAD_KEY =
       "io.flutter.embedding.android.DisableMergedPlatformUIThread";
   private static final String DISABLE_SURFACE_CONTROL =
@@ -363,6 +367,12 @@ public class FlutterLoader {
         if (metaData.getBoolean(IMPELLER_VULKAN_GPU_TRACING_DATA_KEY, false)) {
           shellArgs.add("--enable-vulkan-gpu-tracing");
         }
+        if (metaData.getBoolean(IMPELLER_GLYPH_CACHE_DATA_KEY, false)) {
+          shellArgs.add("--enable-impeller-glyph-cache");
+        }
+        if (metaData.getBoolean(IMPELLER_PIPELINE_VARIANT_MANIFEST_DATA_KEY, false)) {
+          shellArgs.add("--enable-impeller-pipeline-variant-manifest");
+        }
         if (metaData.containsKey(DISABLE_MERGED_PLATFORM_UI_THREAD_KEY)) {
           if (metaData.getBoolean(DISABLE_MERGED_PLATFORM_UI_THREAD_KEY)) {
             shellArgs.add("--no-enable-merged-platform-ui-thread");
@@ -45,6 +45,9 @@ AndroidContext::ContextSettings CreateContextSettings(
   settings.enable_gpu_tracing = p_settings.enable_vulkan_gpu_tracing;
   settings.enable_validation = p_settings.enable_vulkan_validation;
   settings.disable_surface_control = p_settings.disable_surface_control;
+  settings.enable_glyph_cache = p_settings.enable_impeller_glyph_cache;
+  settings.enable_pipeline_variant_manifest =
+      p_settings.enable_impeller_pipeline_variant_manifest;
   return settings;
 }
 }  // namespace
@@ -9,6 +9,7 @@
 #include "flutter/impeller/renderer/backend/metal/context_mtl.h"
 #include "flutter/shell/common/context_options.h"
 #import "flutter/shell/platform/darwin/common/framework/Headers/FlutterMacros.h"
+#include "impeller/entity/mtl/compute_entity_shaders.h"
 #include "impeller/entity/mtl/entity_shaders.h"
 #include "impeller/entity/mtl/framebuffer_blend_shaders.h"
 #include "impeller/entity/mtl/modern_shaders.h"
@@ -22,6 +23,9 @@ static std::shared_ptr<impeller::ContextMTL> CreateImpellerContext(
                                              impeller_entity_shaders_length),
       std::make_shared<fml::NonOwnedMapping>(impeller_modern_shaders_data,
                                              impeller_modern_shaders_length),
+      std::make_shared<fml::NonOwnedMapping>(
+          impeller_compute_entity_shaders_data,
+          impeller_compute_entity_shaders_length),
       std::make_shared<fml::NonOwnedMapping>(impeller_framebuffer_blend_shaders_data,
                                              impeller_framebuffer_blend_shaders_length),
   };
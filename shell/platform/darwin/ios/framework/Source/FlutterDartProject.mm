@@ -209,6 +209,13 @@ flutter::Settings FLTDefaultSettingsForBundle(NSBundle* bundle, NSProcessInfo* p
     settings.merged_platform_ui_thread = enableMergedPlatformUIThread.boolValue;
   }
 
+  NSNumber* enablePipelineVariantManifest =
+      [mainBundle objectForInfoDictionaryKey:@"FLTEnableImpellerPipelineVariantManifest"];
+  // Change the default only if the option is present.
+  if (enablePipelineVariantManifest != nil) {
+    settings.enable_impeller_pipeline_variant_manifest = enablePipelineVariantManifest.boolValue;
+  }
+
 #if FLUTTER_RUNTIME_MODE == FLUTTER_RUNTIME_MODE_DEBUG
   // There are no ownership concerns here as all mappings are owned by the
   // embedder and not the engine.
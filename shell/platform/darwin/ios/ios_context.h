@@ -49,13 +49,16 @@ class IOSContext {
   ///                       engine/platform.
   /// @param[in]  backend   A client rendering backend supported by the
   ///                       engine/platform.
+  /// @param[in]  variant_manifest  Records the pipeline variants created by an
+  ///                               Impeller context. Optional.
   ///
   /// @return     A valid context on success. `nullptr` on failure.
   ///
   static std::unique_ptr<IOSContext> Create(
       IOSRenderingAPI api,
       IOSRenderingBackend backend,
-      const std::shared_ptr<const fml::SyncSwitch>& is_gpu_disabled_sync_switch);
+      const std::shared_ptr<const fml::SyncSwitch>& is_gpu_disabled_sync_switch,
+      const std::shared_ptr<impeller::PipelineVariantManifest>& variant_manifest = nullptr);
 
   //----------------------------------------------------------------------------
   /// @brief      Collects the context object. This must happen on the thread on
@@ -23,7 +23,8 @@ IOSContext::~IOSContext() = default;
 std::unique_ptr<IOSContext> IOSContext::Create(
     IOSRenderingAPI api,
     IOSRenderingBackend backend,
-    const std::shared_ptr<const fml::SyncSwitch>& is_gpu_disabled_sync_switch) {
+    const std::shared_ptr<const fml::SyncSwitch>& is_gpu_disabled_sync_switch,
+    const std::shared_ptr<impeller::PipelineVariantManifest>& variant_manifest) {
   switch (api) {
     case IOSRenderingAPI::kSoftware:
       if (backend == IOSRenderingBackend::kImpeller) {
@@ -46,7 +47,8 @@ std::unique_ptr<IOSContext> IOSContext::Create(
           return nullptr;
 #endif  //  !SLIMPELLER
         case IOSRenderingBackend::kImpeller:
-          return std::make_unique<IOSContextMetalImpeller>(is_gpu_disabled_sync_switch);
+          return std::make_unique<IOSContextMetalImpeller>(is_gpu_disabled_sync_switch,
+                                                           variant_manifest);
       }
     default:
       break;
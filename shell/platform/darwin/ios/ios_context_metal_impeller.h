@@ -22,7 +22,8 @@ namespace flutter {
 class IOSContextMetalImpeller final : public IOSContext {
  public:
   explicit IOSContextMetalImpeller(
-      const std::shared_ptr<const fml::SyncSwitch>& is_gpu_disabled_sync_switch);
+      const std::shared_ptr<const fml::SyncSwitch>& is_gpu_disabled_sync_switch,
+      const std::shared_ptr<impeller::PipelineVariantManifest>& variant_manifest = nullptr);
 
   ~IOSContextMetalImpeller();
 
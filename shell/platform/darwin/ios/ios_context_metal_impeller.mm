@@ -14,12 +14,14 @@ FLUTTER_ASSERT_ARC
 namespace flutter {
 
 IOSContextMetalImpeller::IOSContextMetalImpeller(
-    const std::shared_ptr<const fml::SyncSwitch>& is_gpu_disabled_sync_switch)
+    const std::shared_ptr<const fml::SyncSwitch>& is_gpu_disabled_sync_switch,
+    const std::shared_ptr<impeller::PipelineVariantManifest>& variant_manifest)
     : darwin_context_metal_impeller_(
           [[FlutterDarwinContextMetalImpeller alloc] init:is_gpu_disabled_sync_switch]) {
   if (darwin_context_metal_impeller_.context) {
     aiks_context_ = std::make_shared<impeller::AiksContext>(
-        darwin_context_metal_impeller_.context, impeller::TypographerContextSkia::Make());
+        darwin_context_metal_impeller_.context, impeller::TypographerContextSkia::Make(),
+        /*render_target_allocator=*/std::nullopt, variant_manifest);
   }
 }
 
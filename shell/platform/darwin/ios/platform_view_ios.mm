@@ -8,6 +8,7 @@
 #include <utility>
 
 #include "flutter/common/task_runners.h"
+#include "flutter/fml/paths.h"
 #include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/shell/common/shell_io_manager.h"
@@ -52,6 +53,20 @@ PlatformViewIOS::PlatformViewIOS(PlatformView::Delegate& delegate,
       platform_message_handler_(
           new PlatformMessageHandlerIos(task_runners.GetPlatformTaskRunner())) {}
 
+namespace {
+
+std::shared_ptr<impeller::PipelineVariantManifest> CreateVariantManifest(
+    const Settings& settings,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner) {
+  if (!settings.enable_impeller || !settings.enable_impeller_pipeline_variant_manifest) {
+    return nullptr;
+  }
+  return impeller::PipelineVariantManifest::Create(fml::paths::GetCachesDirectory(),
+                                                   worker_task_runner);
+}
+
+}  // namespace
+
 PlatformViewIOS::PlatformViewIOS(
     PlatformView::Delegate& delegate,
     IOSRenderingAPI rendering_api,
@@ -64,7 +79,10 @@ PlatformViewIOS::PlatformViewIOS(
                                          delegate.OnPlatformViewGetSettings().enable_impeller
                                              ? IOSRenderingBackend::kImpeller
                                              : IOSRenderingBackend::kSkia,
-                                         is_gpu_disabled_sync_switch),
+                                         is_gpu_disabled_sync_switch,
+                                         CreateVariantManifest(
+                                             delegate.OnPlatformViewGetSettings(),
+                                             worker_task_runner)),
                       platform_views_controller,
                       task_runners) {}
 
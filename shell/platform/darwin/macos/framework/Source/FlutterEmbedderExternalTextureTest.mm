@@ -21,6 +21,7 @@
 #include "flutter/testing/autoreleasepool_test.h"
 #include "flutter/testing/testing.h"
 #include "impeller/display_list/aiks_context.h"             // nogncheck
+#include "impeller/entity/mtl/compute_entity_shaders.h"     // nogncheck
 #include "impeller/entity/mtl/entity_shaders.h"             // nogncheck
 #include "impeller/entity/mtl/framebuffer_blend_shaders.h"  // nogncheck
 #include "impeller/entity/mtl/modern_shaders.h"             // nogncheck
@@ -37,6 +38,9 @@ static std::shared_ptr<impeller::ContextMTL> CreateImpellerContext() {
                                              impeller_entity_shaders_length),
       std::make_shared<fml::NonOwnedMapping>(impeller_modern_shaders_data,
                                              impeller_modern_shaders_length),
+      std::make_shared<fml::NonOwnedMapping>(
+          impeller_compute_entity_shaders_data,
+          impeller_compute_entity_shaders_length),
       std::make_shared<fml::NonOwnedMapping>(impeller_framebuffer_blend_shaders_data,
                                              impeller_framebuffer_blend_shaders_length),
   };
@@ -235,8 +235,7 @@ class Layer {
   void AddFlutterContents(EmbedderExternalView* contents,
                           const DlRegion& contents_region) {
     flutter_contents_.push_back(contents);
-    flutter_contents_region_ =
-        DlRegion::MakeUnion(flutter_contents_region_, contents_region);
+    flutter_contents_region_.addRegion(contents_region);
   }
 
   bool has_flutter_contents() const { return !flutter_contents_.empty(); }
@@ -269,13 +268,13 @@ class Layer {
   EmbedderRenderTarget* render_target() { return render_target_.get(); }
 
   std::vector<SkIRect> coverage() {
-    return flutter_contents_region_.getRects();
+    return flutter_contents_region_.region().getRects();
   }
 
  private:
   std::vector<PlatformView> platform_views_;
   std::vector<EmbedderExternalView*> flutter_contents_;
-  DlRegion flutter_contents_region_;
+  DlRegionAccumulator flutter_contents_region_;
   std::unique_ptr<EmbedderRenderTarget> render_target_;
   friend class LayerBuilder;
 };
@@ -6,6 +6,7 @@
 
 #include <utility>
 
+#include "flutter/impeller/entity/vk/compute_entity_shaders_vk.h"
 #include "flutter/impeller/entity/vk/entity_shaders_vk.h"
 #include "flutter/impeller/entity/vk/framebuffer_blend_shaders_vk.h"
 #include "flutter/impeller/entity/vk/modern_shaders_vk.h"
@@ -45,6 +46,9 @@ EmbedderSurfaceVulkanImpeller::EmbedderSurfaceVulkanImpeller(
                                              impeller_entity_shaders_vk_length),
       std::make_shared<fml::NonOwnedMapping>(impeller_modern_shaders_vk_data,
                                              impeller_modern_shaders_vk_length),
+      std::make_shared<fml::NonOwnedMapping>(
+          impeller_compute_entity_shaders_vk_data,
+          impeller_compute_entity_shaders_vk_length),
       std::make_shared<fml::NonOwnedMapping>(
           impeller_framebuffer_blend_shaders_vk_data,
           impeller_framebuffer_blend_shaders_vk_length),